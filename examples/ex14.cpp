@@ -19,13 +19,19 @@
 //               ex14 -m ../data/amr-hex.mesh
 //               ex14 -m ../data/fichera-amr.mesh
 //
+// Device sample runs:
+//               ex14 -pa
+//               ex14 -m ../data/fichera.mesh -pa -s 1 -k 1
+//               ex14 -pa -d cuda
+//
 // Description:  This example code demonstrates the use of MFEM to define a
 //               discontinuous Galerkin (DG) finite element discretization of
 //               the Laplace problem -Delta u = 1 with homogeneous Dirichlet
 //               boundary conditions. Finite element spaces of any order,
 //               including zero on regular grids, are supported. The example
 //               highlights the use of discontinuous spaces and DG-specific face
-//               integrators.
+//               integrators. The operator can also be partially assembled, in
+//               which case the system is solved without a preconditioner.
 //
 //               We recommend viewing examples 1 and 9 before viewing this
 //               example.
@@ -46,6 +52,8 @@ int main(int argc, char *argv[])
    double sigma = -1.0;
    double kappa = -1.0;
    double eta = 0.0;
+   bool pa = false;
+   const char *device_config = "cpu";
    bool visualization = 1;
 
    OptionsParser args(argc, argv);
@@ -62,6 +70,10 @@ int main(int argc, char *argv[])
                   "One of the three DG penalty parameters, should be positive."
                   " Negative values are replaced with (order+1)^2.");
    args.AddOption(&eta, "-e", "--eta", "BR2 penalty parameter.");
+   args.AddOption(&pa, "-pa", "--partial-assembly", "-no-pa",
+                  "--no-partial-assembly", "Enable Partial Assembly.");
+   args.AddOption(&device_config, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
    args.AddOption(&visualization, "-vis", "--visualization", "-no-vis",
                   "--no-visualization",
                   "Enable or disable GLVis visualization.");
@@ -75,8 +87,16 @@ int main(int argc, char *argv[])
    {
       kappa = (order+1)*(order+1);
    }
+   if (pa && (order < 1 || eta > 0))
+   {
+      cout << "Partial assembly requires order >= 1 and no BR2 penalty.\n";
+      return 3;
+   }
    args.PrintOptions(cout);
 
+   Device device(device_config);
+   device.Print();
+
    // 2. Read the mesh from the given mesh file. We can handle triangular,
    //    quadrilateral, tetrahedral and hexahedral meshes with the same code.
    //    NURBS meshes are projected to second order meshes.
@@ -103,8 +123,10 @@ int main(int argc, char *argv[])
    }
 
    // 4. Define a finite element space on the mesh. Here we use discontinuous
-   //    finite elements of the specified order >= 0.
-   FiniteElementCollection *fec = new DG_FECollection(order, dim);
+   //    finite elements of the specified order >= 0. Partial assembly uses
+   //    nodal basis functions at the Gauss-Lobatto points.
+   const int btype = pa ? BasisType::GaussLobatto : BasisType::GaussLegendre;
+   FiniteElementCollection *fec = new DG_FECollection(order, dim, btype);
    FiniteElementSpace *fespace = new FiniteElementSpace(mesh, fec);
    cout << "Number of unknowns: " << fespace->GetVSize() << endl;
 
@@ -128,7 +150,8 @@ int main(int argc, char *argv[])
    //    domain integrator and the interior and boundary DG face integrators.
    //    Note that boundary conditions are imposed weakly in the form, so there
    //    is no need for dof elimination. After assembly and finalizing we
-   //    extract the corresponding sparse matrix A.
+   //    extract the corresponding sparse matrix A, unless the operator is
+   //    partially assembled.
    BilinearForm *a = new BilinearForm(fespace);
    a->AddDomainIntegrator(new DiffusionIntegrator(one));
    a->AddInteriorFaceIntegrator(new DGDiffusionIntegrator(one, sigma, kappa));
@@ -138,30 +161,59 @@ int main(int argc, char *argv[])
       a->AddInteriorFaceIntegrator(new DGDiffusionBR2Integrator(fespace, eta));
       a->AddBdrFaceIntegrator(new DGDiffusionBR2Integrator(fespace, eta));
    }
+   if (pa) { a->SetAssemblyLevel(AssemblyLevel::PARTIAL); }
    a->Assemble();
-   a->Finalize();
-   const SparseMatrix &A = a->SpMat();
 
-#ifndef MFEM_USE_SUITESPARSE
-   // 8. Define a simple symmetric Gauss-Seidel preconditioner and use it to
-   //    solve the system Ax=b with PCG in the symmetric case, and GMRES in the
-   //    non-symmetric one.
-   GSSmoother M(A);
-   if (sigma == -1.0)
+   if (pa)
    {
-      PCG(A, M, *b, x, 1, 500, 1e-12, 0.0);
+      // 8. With partial assembly, solve the system with unpreconditioned CG
+      //    in the symmetric case, and GMRES in the non-symmetric one.
+      OperatorPtr A;
+      Vector B, X;
+      Array<int> ess_tdof_list;
+      a->FormLinearSystem(ess_tdof_list, x, *b, A, X, B);
+      if (sigma == -1.0)
+      {
+         CG(*A, B, X, 1, 2000, 1e-12, 0.0);
+      }
+      else
+      {
+         GMRESSolver gmres;
+         gmres.SetOperator(*A);
+         gmres.SetRelTol(1e-12);
+         gmres.SetMaxIter(2000);
+         gmres.SetKDim(50);
+         gmres.SetPrintLevel(1);
+         gmres.Mult(B, X);
+      }
+      a->RecoverFEMSolution(X, *b, x);
    }
    else
    {
-      GMRES(A, M, *b, x, 1, 500, 10, 1e-12, 0.0);
-   }
+      a->Finalize();
+      const SparseMatrix &A = a->SpMat();
+#ifndef MFEM_USE_SUITESPARSE
+      // 8. Define a simple symmetric Gauss-Seidel preconditioner and use it to
+      //    solve the system Ax=b with PCG in the symmetric case, and GMRES in
+      //    the non-symmetric one.
+      GSSmoother M(A);
+      if (sigma == -1.0)
+      {
+         PCG(A, M, *b, x, 1, 500, 1e-12, 0.0);
+      }
+      else
+      {
+         GMRES(A, M, *b, x, 1, 500, 10, 1e-12, 0.0);
+      }
 #else
-   // 8. If MFEM was compiled with SuiteSparse, use UMFPACK to solve the system.
-   UMFPackSolver umf_solver;
-   umf_solver.Control[UMFPACK_ORDERING] = UMFPACK_ORDERING_METIS;
-   umf_solver.SetOperator(A);
-   umf_solver.Mult(*b, x);
+      // 8. If MFEM was compiled with SuiteSparse, use UMFPACK to solve the
+      //    system.
+      UMFPackSolver umf_solver;
+      umf_solver.Control[UMFPACK_ORDERING] = UMFPACK_ORDERING_METIS;
+      umf_solver.SetOperator(A);
+      umf_solver.Mult(*b, x);
 #endif
+   }
 
    // 9. Save the refined mesh and the solution. This output can be viewed later
    //    using GLVis: "glvis -m refined.mesh -g sol.gf".
@@ -14,6 +14,9 @@
 #include "fem.hpp"
 #include "../general/device.hpp"
 #include <cmath>
+#ifdef MFEM_USE_LEGACY_OPENMP
+#include <omp.h>
+#endif
 
 namespace mfem
 {
@@ -74,6 +77,10 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   use_scatter_map = 0;
+   fused_restriction = false;
+   scatter_map_J = NULL;
+   scatter_map_nnz = -1;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACYFULL;
@@ -92,6 +99,10 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = ps;
+   use_scatter_map = 0;
+   fused_restriction = false;
+   scatter_map_J = NULL;
+   scatter_map_nnz = -1;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACYFULL;
@@ -390,17 +401,24 @@ void BilinearForm::Assemble(int skip_zeros)
       AllocMat();
    }
 
-#ifdef MFEM_USE_LEGACY_OPENMP
-   int free_element_matrices = 0;
-   if (!element_matrices)
+   const bool scatter = (dbfi.Size() > 0) && UpdateScatterMap();
+   if (scatter && element_matrices)
    {
-      ComputeElementMatrices();
-      free_element_matrices = 1;
+      ScatterElementMatrices();
    }
-#endif
-
-   if (dbfi.Size())
+   else if (scatter)
    {
+      ComputeAndScatterElementMatrices();
+   }
+   else if (dbfi.Size())
+   {
+#ifdef MFEM_USE_LEGACY_OPENMP
+      // The element matrices are computed in parallel for batches of elements
+      // and added sequentially.
+      const int batch_size = 64*omp_get_max_threads();
+      DenseMatrix *batch =
+         element_matrices ? NULL : new DenseMatrix[batch_size];
+#endif
       for (int i = 0; i < fes -> GetNE(); i++)
       {
          fes->GetElementVDofs(i, vdofs);
@@ -408,6 +426,17 @@ void BilinearForm::Assemble(int skip_zeros)
          {
             elmat_p = &(*element_matrices)(i);
          }
+#ifdef MFEM_USE_LEGACY_OPENMP
+         else
+         {
+            if (i % batch_size == 0)
+            {
+               const int last = std::min(i + batch_size, fes->GetNE());
+               ComputeElementMatrices(i, last, batch);
+            }
+            elmat_p = &batch[i % batch_size];
+         }
+#else
          else
          {
             const FiniteElement &fe = *fes->GetFE(i);
@@ -420,6 +449,7 @@ void BilinearForm::Assemble(int skip_zeros)
             }
             elmat_p = &elmat;
          }
+#endif
          if (static_cond)
          {
             static_cond->AssembleMatrix(i, *elmat_p);
@@ -433,6 +463,9 @@ void BilinearForm::Assemble(int skip_zeros)
             }
          }
       }
+#ifdef MFEM_USE_LEGACY_OPENMP
+      delete [] batch;
+#endif
    }
 
    if (bbfi.Size())
@@ -575,13 +608,193 @@ void BilinearForm::Assemble(int skip_zeros)
          }
       }
    }
+}
 
-#ifdef MFEM_USE_LEGACY_OPENMP
-   if (free_element_matrices)
+bool BilinearForm::UpdateScatterMap()
+{
+   if (!use_scatter_map || static_cond || hybridization || !mat ||
+       !mat->Finalized())
+   {
+      return false;
+   }
+   if (scatter_map_J == mat->GetJ() &&
+       scatter_map_nnz == mat->NumNonZeroElems())
    {
-      FreeElementMatrices();
+      return (scatter_map.Size() > 0);
+   }
+
+   ResetScatterMap();
+   scatter_map_J = mat->GetJ();
+   scatter_map_nnz = mat->NumNonZeroElems();
+
+   const int ne = fes->GetNE();
+   const int *I = mat->HostReadI(), *J = mat->HostReadJ();
+   Array<int> map_offsets(ne + 1), map;
+   map_offsets[0] = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      map_offsets[i+1] = map_offsets[i] + vdofs.Size()*vdofs.Size();
+   }
+   map.SetSize(map_offsets[ne]);
+
+   // Find the CSR offset of each element matrix entry, using a marker array
+   // which maps the columns of the current row to their offsets.
+   Array<int> col_pos(mat->Width());
+   col_pos = -1;
+   for (int i = 0; i < ne; i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      const int n = vdofs.Size();
+      int *emap = map.GetData() + map_offsets[i];
+      for (int r = 0; r < n; r++)
+      {
+         const int row = (vdofs[r] >= 0) ? vdofs[r] : -1-vdofs[r];
+         for (int k = I[row]; k < I[row+1]; k++) { col_pos[J[k]] = k; }
+         bool found = true;
+         for (int c = 0; c < n; c++)
+         {
+            const int col = (vdofs[c] >= 0) ? vdofs[c] : -1-vdofs[c];
+            const int k = col_pos[col];
+            found = found && (k >= 0);
+            emap[r + c*n] = ((vdofs[r] >= 0) == (vdofs[c] >= 0)) ? k : -1-k;
+         }
+         for (int k = I[row]; k < I[row+1]; k++) { col_pos[J[k]] = -1; }
+         // An entry is missing from the sparsity pattern: do not use the map
+         if (!found) { return false; }
+      }
+   }
+
+   // Greedy coloring of the elements such that the elements of each color
+   // share no dofs and can be added to the matrix concurrently.
+   // The dofs of the element-to-dof table may be signed, e.g. for ND spaces.
+   const Table &elem_dof = fes->GetElementToDofTable();
+   const int *ed_I = elem_dof.GetI(), *ed_J = elem_dof.GetJ();
+   Table dof_elem;
+   dof_elem.MakeI(fes->GetNDofs());
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int i = 0; i < ne; i++)
+      {
+         for (int d = ed_I[i]; d < ed_I[i+1]; d++)
+         {
+            const int dof = (ed_J[d] >= 0) ? ed_J[d] : -1-ed_J[d];
+            if (pass == 0) { dof_elem.AddAColumnInRow(dof); }
+            else { dof_elem.AddConnection(dof, i); }
+         }
+      }
+      if (pass == 0) { dof_elem.MakeJ(); }
+   }
+   dof_elem.ShiftUpI();
+   Array<int> color(ne), used;
+   color = -1;
+   int num_colors = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      for (int d = ed_I[i]; d < ed_I[i+1]; d++)
+      {
+         const int dof = (ed_J[d] >= 0) ? ed_J[d] : -1-ed_J[d];
+         for (int k = dof_elem.GetI()[dof]; k < dof_elem.GetI()[dof+1]; k++)
+         {
+            const int nc = color[dof_elem.GetJ()[k]];
+            if (nc >= 0) { used[nc] = i; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && used[c] == i) { c++; }
+      if (c == num_colors) { used.Append(-1); num_colors++; }
+      color[i] = c;
+   }
+   scatter_color_offsets.SetSize(num_colors + 1);
+   scatter_color_offsets = 0;
+   for (int i = 0; i < ne; i++) { scatter_color_offsets[color[i]+1]++; }
+   scatter_color_offsets.PartialSum();
+   scatter_elements.SetSize(ne);
+   for (int c = 0; c < num_colors; c++) { used[c] = scatter_color_offsets[c]; }
+   for (int i = 0; i < ne; i++) { scatter_elements[used[color[i]]++] = i; }
+
+   Swap(scatter_map, map);
+   Swap(scatter_map_offsets, map_offsets);
+   return true;
+}
+
+void BilinearForm::ScatterElementMatrices()
+{
+   const int nn = element_matrices->SizeI()*element_matrices->SizeJ();
+   const int *d_map = scatter_map.Read();
+   const int *d_elem = scatter_elements.Read();
+   const double *d_elmat = element_matrices->Read();
+   double *d_data = mat->ReadWriteData();
+   for (int c = 0; c < scatter_color_offsets.Size() - 1; c++)
+   {
+      // Elements of the same color share no dofs: no write conflicts
+      const int offset = scatter_color_offsets[c];
+      const int num_elem = scatter_color_offsets[c+1] - offset;
+      MFEM_FORALL(k, num_elem,
+      {
+         const int e = d_elem[offset + k];
+         for (int p = 0; p < nn; p++)
+         {
+            const int o = d_map[e*nn + p];
+            const double v = d_elmat[e*nn + p];
+            if (o >= 0) { d_data[o] += v; }
+            else { d_data[-1-o] -= v; }
+         }
+      });
    }
+}
+
+void BilinearForm::ComputeAndScatterElementMatrices()
+{
+   double *data = mat->HostReadWriteData();
+   for (int c = 0; c < scatter_color_offsets.Size() - 1; c++)
+   {
+      // Elements of the same color share no dofs: no write conflicts
+      const int first = scatter_color_offsets[c];
+      const int last = scatter_color_offsets[c+1];
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel
+#endif
+      {
+         // The ElementTransformation of the mesh is shared: use one per thread
+         IsoparametricTransformation eltrans;
+         DenseMatrix elmat, tmp;
+#ifdef MFEM_USE_LEGACY_OPENMP
+         #pragma omp for schedule(static)
 #endif
+         for (int k = first; k < last; k++)
+         {
+            const int i = scatter_elements[k];
+            const FiniteElement &fe = *fes->GetFE(i);
+            fes->GetElementTransformation(i, &eltrans);
+            dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+            for (int j = 1; j < dbfi.Size(); j++)
+            {
+               dbfi[j]->AssembleElementMatrix(fe, eltrans, tmp);
+               elmat += tmp;
+            }
+            const int *map = scatter_map.GetData() + scatter_map_offsets[i];
+            const int nn = scatter_map_offsets[i+1] - scatter_map_offsets[i];
+            const double *e = elmat.Data();
+            for (int p = 0; p < nn; p++)
+            {
+               const int o = map[p];
+               if (o >= 0) { data[o] += e[p]; }
+               else { data[-1-o] -= e[p]; }
+            }
+         }
+      }
+   }
+}
+
+void BilinearForm::ResetScatterMap()
+{
+   scatter_map.DeleteAll();
+   scatter_map_offsets.DeleteAll();
+   scatter_elements.DeleteAll();
+   scatter_color_offsets.DeleteAll();
+   scatter_map_J = NULL;
+   scatter_map_nnz = -1;
 }
 
 void BilinearForm::ConformingAssemble()
@@ -882,6 +1095,34 @@ void BilinearForm::ComputeElementMatrices()
    }
 }
 
+void BilinearForm::ComputeElementMatrices(int first, int last,
+                                          DenseMatrix *elmats)
+{
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      // The ElementTransformation of the mesh is shared: use one per thread
+      IsoparametricTransformation eltrans;
+      DenseMatrix tmp;
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int i = first; i < last; i++)
+      {
+         const FiniteElement &fe = *fes->GetFE(i);
+         DenseMatrix &elmat = elmats[i - first];
+         fes->GetElementTransformation(i, &eltrans);
+         dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+         for (int k = 1; k < dbfi.Size(); k++)
+         {
+            dbfi[k]->AssembleElementMatrix(fe, eltrans, tmp);
+            elmat += tmp;
+         }
+      }
+   }
+}
+
 void BilinearForm::EliminateEssentialBC(const Array<int> &bdr_attr_is_ess,
                                         const Vector &sol, Vector &rhs,
                                         DiagonalPolicy dpolicy)
@@ -1032,6 +1273,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::ArrayMult(const Array<const Vector *> &X,
+                             Array<Vector *> &Y) const
+{
+   if (ext)
+   {
+      ext->ArrayMult(X, Y);
+   }
+   else
+   {
+      Operator::ArrayMult(X, Y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -1052,6 +1306,7 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
    delete mat_e;
    mat_e = NULL;
    FreeElementMatrices();
+   ResetScatterMap();
    delete static_cond;
    static_cond = NULL;
 
@@ -1154,15 +1409,13 @@ void MixedBilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
          // Use the original BilinearForm implementation for now
          break;
       case AssemblyLevel::ELEMENT:
-         mfem_error("Element assembly not supported yet... stay tuned!");
-         // ext = new EAMixedBilinearFormExtension(this);
+         ext = new EAMixedBilinearFormExtension(this);
          break;
       case AssemblyLevel::PARTIAL:
          ext = new PAMixedBilinearFormExtension(this);
          break;
       case AssemblyLevel::NONE:
-         mfem_error("Matrix-free action not supported yet... stay tuned!");
-         // ext = new MFMixedBilinearFormExtension(this);
+         ext = new MFMixedBilinearFormExtension(this);
          break;
       default:
          mfem_error("Unknown assembly level");
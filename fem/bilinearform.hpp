@@ -112,6 +112,43 @@ protected:
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
+   /** @brief Flag for the reassembly of the domain integrators using
+       #scatter_map, see UseScatterMap(). */
+   int use_scatter_map;
+   /** @brief Signed offsets into the data array of #mat for all entries of the
+       element matrices (column-major); a negative offset o stands for the
+       entry -1-o with a negative sign. */
+   Array<int> scatter_map;
+   Array<int> scatter_map_offsets; ///< Element offsets in #scatter_map.
+   /// Elements sorted by color; elements of the same color share no dofs.
+   Array<int> scatter_elements, scatter_color_offsets;
+   /// The J array and the number of nonzeros of #mat used by #scatter_map.
+   const int *scatter_map_J;
+   int scatter_map_nnz;
+
+   /// Flag for the fused partially assembled action, see UseFusedRestriction().
+   bool fused_restriction;
+
+   /** @brief Return true if the domain integrators can be assembled using the
+       scatter map, building the map if necessary. */
+   bool UpdateScatterMap();
+   /// Add the stored element matrices to #mat using the scatter map.
+   void ScatterElementMatrices();
+   /** @brief Compute the element matrices of the domain integrators and add
+       them to #mat using the scatter map, in parallel over the elements of
+       each color when MFEM is built with MFEM_USE_LEGACY_OPENMP. */
+   void ComputeAndScatterElementMatrices();
+   /// Free the scatter map, e.g. when #mat is replaced.
+   void ResetScatterMap();
+
+   /** @brief Compute the element matrices of the domain integrators for the
+       elements @a first, ..., @a last-1 in @a elmats.
+
+       The elements are processed in parallel when MFEM is built with
+       MFEM_USE_LEGACY_OPENMP, each thread using its own ElementTransformation.
+       Used by Assemble() in that case. */
+   void ComputeElementMatrices(int first, int last, DenseMatrix *elmats);
+
    void ConformingAssemble();
 
    // may be used in the construction of derived classes
@@ -121,6 +158,10 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      use_scatter_map = 0;
+      fused_restriction = false;
+      scatter_map_J = NULL;
+      scatter_map_nnz = -1;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::LEGACYFULL;
       batch = 1;
@@ -196,6 +237,40 @@ public:
        present in the bilinear form. */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
+   /** @brief Enable fast reassembly of the domain integrators for matrices in
+       CSR format with fixed sparsity, e.g. for nonlinear or time-dependent
+       problems.
+
+       When Assemble() is called with a finalized matrix (e.g. after
+       UsePrecomputedSparsity() or after a previous assembly followed by
+       Finalize() and reset with operator=(0.0)), the CSR offsets of all element
+       matrix entries are computed once and subsequent calls add the element
+       matrices directly into the data array of the matrix, without searching
+       the rows. If the element matrices are stored, see
+       ComputeElementMatrices(), they are added in parallel (with the device
+       backend) over groups of elements that share no dofs. Otherwise, the
+       element matrices are computed and added on the host, in parallel over the
+       same groups when MFEM is built with MFEM_USE_LEGACY_OPENMP. The map is
+       not used with static condensation or hybridization, or if the sparsity
+       pattern does not contain all element matrix entries, e.g. when zeros
+       were skipped in the first assembly. */
+   void UseScatterMap(int sm = 1)
+   { use_scatter_map = sm; if (!sm) { ResetScatterMap(); } }
+
+   /** @brief Fuse the partially assembled action of the domain integrators
+       with the element restriction.
+
+       When enabled and supported by all domain integrators, see
+       BilinearFormIntegrator::SupportsFusedPA(), the action gathers the element
+       values directly from the input L-vector and adds the results directly to
+       the output L-vector, without storing the E-vectors. Elements sharing dofs
+       are processed in separate groups on parallel backends. This method should
+       be called before Assemble(). */
+   void UseFusedRestriction(bool use = true) { fused_restriction = use; }
+
+   /// Returns true if the fused action is requested, see UseFusedRestriction().
+   bool FusedRestriction() const { return fused_restriction; }
+
    /** @brief Use the given CSR sparsity pattern to allocate the internal
        SparseMatrix.
 
@@ -248,6 +323,11 @@ public:
    /// Matrix vector multiplication:  \f$ y = M x \f$
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Matrix vector multiplication for a set of vectors, see
+       Operator::ArrayMult(). */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /** @brief Matrix vector multiplication with the original uneliminated
        matrix.  The original matrix is \f$ M + M_e \f$ so we have:
        \f$ y = M x + M_e x \f$ */
@@ -757,7 +837,12 @@ public:
    void operator=(const double a) { *mat = a; }
 
    /// Set the desired assembly level. The default is AssemblyLevel::LEGACYFULL.
-   /** This method must be called before assembly. */
+   /** This method must be called before assembly.
+
+       With AssemblyLevel::ELEMENT, any domain integrator is supported through
+       its AssembleElementMatrix2() method; AssemblyLevel::PARTIAL and
+       AssemblyLevel::NONE require integrators with partial and matrix-free
+       assembly, respectively. */
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
    void Assemble(int skip_zeros = 1);
@@ -244,8 +244,28 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
      testFes(a->FESpace())
 {
    elem_restrict = NULL;
+   fused_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   int_face_restrict_dn = NULL;
+   bdr_face_restrict_dn = NULL;
+}
+
+PABilinearFormExtension::~PABilinearFormExtension()
+{
+   delete int_face_restrict_dn;
+   delete bdr_face_restrict_dn;
+}
+
+// Returns true if one of the face integrators uses the face normal derivatives
+static bool RequireFaceNormalDerivatives(
+   const Array<BilinearFormIntegrator*> &integrators)
+{
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (integrators[i]->RequiresFaceNormalDerivatives()) { return true; }
+   }
+   return false;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -254,11 +274,23 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
                                  ElementDofOrdering::LEXICOGRAPHIC:
                                  ElementDofOrdering::NATIVE;
    elem_restrict = trialFes->GetElementRestriction(ordering);
-   if (elem_restrict)
+
+   // The fused action is used only by the partial assembly level and requires
+   // all domain integrators to support it.
+   fused_restrict = NULL;
+   if (a->FusedRestriction() && !DeviceCanUseCeed() &&
+       a->GetAssemblyLevel() == AssemblyLevel::PARTIAL)
    {
-      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
-      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
-      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+      fused_restrict = dynamic_cast<const ElementRestriction*>(elem_restrict);
+      Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+      for (int i = 0; i < integrators.Size(); ++i)
+      {
+         if (!integrators[i]->SupportsFusedPA()) { fused_restrict = NULL; }
+      }
+   }
+   if (elem_restrict && !fused_restrict)
+   {
+      AllocateElementVectors();
    }
 
    // Construct face restriction operators only if the bilinear form has
@@ -283,6 +315,41 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
       faceBdrY.SetSize(bdr_face_restrict_lex->Height(), Device::GetMemoryType());
       faceBdrY.UseDevice(true); // ensure 'faceBoundY = 0.0' is done on device
    }
+
+   if (int_face_restrict_dn == NULL &&
+       RequireFaceNormalDerivatives(*a->GetFBFI()))
+   {
+      int_face_restrict_dn =
+         new L2NormalDerivativeFaceRestriction(*trialFes, FaceType::Interior);
+      faceIntDX.SetSize(int_face_restrict_dn->Height(),
+                        Device::GetMemoryType());
+      faceIntDY.SetSize(int_face_restrict_dn->Height(),
+                        Device::GetMemoryType());
+      faceIntDY.UseDevice(true);
+   }
+
+   if (bdr_face_restrict_dn == NULL &&
+       RequireFaceNormalDerivatives(*a->GetBFBFI()))
+   {
+      bdr_face_restrict_dn =
+         new L2NormalDerivativeFaceRestriction(*trialFes, FaceType::Boundary,
+                                               m);
+      faceBdrDX.SetSize(bdr_face_restrict_dn->Height(),
+                        Device::GetMemoryType());
+      faceBdrDY.SetSize(bdr_face_restrict_dn->Height(),
+                        Device::GetMemoryType());
+      faceBdrDY.UseDevice(true);
+   }
+}
+
+void PABilinearFormExtension::AllocateElementVectors() const
+{
+   if (localX.Size() != elem_restrict->Height())
+   {
+      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+   }
 }
 
 void PABilinearFormExtension::Assemble()
@@ -321,6 +388,7 @@ void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
    const int iSz = integrators.Size();
    if (elem_restrict && !DeviceCanUseCeed())
    {
+      AllocateElementVectors();
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
       {
@@ -356,8 +424,13 @@ void PABilinearFormExtension::Update()
    testFes = fes;
 
    elem_restrict = nullptr;
+   fused_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   delete int_face_restrict_dn;
+   delete bdr_face_restrict_dn;
+   int_face_restrict_dn = nullptr;
+   bdr_face_restrict_dn = nullptr;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -393,6 +466,15 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          integrators[i]->AddMultPA(x, y);
       }
    }
+   else if (fused_restrict)
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultPAFused(*fused_restrict, x, y);
+      }
+   }
    else
    {
       elem_restrict->Mult(x, localX);
@@ -404,36 +486,45 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
       elem_restrict->MultTranspose(localY, y);
    }
 
-   Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
-   const int iFISz = intFaceIntegrators.Size();
-   if (int_face_restrict_lex && iFISz>0)
-   {
-      int_face_restrict_lex->Mult(x, faceIntX);
-      if (faceIntX.Size()>0)
-      {
-         faceIntY = 0.0;
-         for (int i = 0; i < iFISz; ++i)
-         {
-            intFaceIntegrators[i]->AddMultPA(faceIntX, faceIntY);
-         }
-         int_face_restrict_lex->MultTranspose(faceIntY, y);
-      }
+   AddMultFaces(x, y, false);
+}
+
+void PABilinearFormExtension::ArrayMult(const Array<const Vector *> &X,
+                                        Array<Vector *> &Y) const
+{
+   const int nvec = X.Size();
+   MFEM_ASSERT(Y.Size() == nvec, "incompatible arrays of Vectors");
+   const bool faces = (int_face_restrict_lex && a->GetFBFI()->Size() > 0) ||
+                      (bdr_face_restrict_lex && a->GetBFBFI()->Size() > 0);
+   if (DeviceCanUseCeed() || !elem_restrict || faces || nvec == 1)
+   {
+      Operator::ArrayMult(X, Y);
+      return;
    }
 
-   Array<BilinearFormIntegrator*> &bdrFaceIntegrators = *a->GetBFBFI();
-   const int bFISz = bdrFaceIntegrators.Size();
-   if (bdr_face_restrict_lex && bFISz>0)
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   const int ne_size = elem_restrict->Height();
+   localXb.SetSize(nvec*ne_size, Device::GetDeviceMemoryType());
+   localYb.SetSize(nvec*ne_size, Device::GetDeviceMemoryType());
+   localXb.UseDevice(true);
+   localYb.UseDevice(true);
+   Vector xe, ye;
+   for (int i = 0; i < nvec; i++)
+   {
+      xe.MakeRef(localXb, i*ne_size, ne_size);
+      elem_restrict->Mult(*X[i], xe);
+      xe.SyncAliasMemory(localXb);
+   }
+   localYb = 0.0;
+   for (int i = 0; i < iSz; ++i)
    {
-      bdr_face_restrict_lex->Mult(x, faceBdrX);
-      if (faceBdrX.Size()>0)
-      {
-         faceBdrY = 0.0;
-         for (int i = 0; i < bFISz; ++i)
-         {
-            bdrFaceIntegrators[i]->AddMultPA(faceBdrX, faceBdrY);
-         }
-         bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
-      }
+      integrators[i]->AddMultBatchedPA(nvec, localXb, localYb);
+   }
+   for (int i = 0; i < nvec; i++)
+   {
+      ye.MakeRef(localYb, i*ne_size, ne_size);
+      elem_restrict->MultTranspose(ye, *Y[i]);
    }
 }
 
@@ -443,6 +534,7 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    const int iSz = integrators.Size();
    if (elem_restrict)
    {
+      AllocateElementVectors();
       elem_restrict->Mult(x, localX);
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
@@ -461,37 +553,63 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
       }
    }
 
-   Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
-   const int iFISz = intFaceIntegrators.Size();
-   if (int_face_restrict_lex && iFISz>0)
+   AddMultFaces(x, y, true);
+}
+
+// Apply the face integrators of @a integrators: the face values, and the normal
+// derivatives if needed, are gathered with the given restrictions into the
+// face E-vectors and the results are added to @a y.
+static void AddMultFaceIntegrators(
+   const Array<BilinearFormIntegrator*> &integrators,
+   const Operator *restrict_lex, const Operator *restrict_dn,
+   Vector &faceX, Vector &faceY, Vector &faceDX, Vector &faceDY,
+   const Vector &x, Vector &y, const bool transpose, const bool dn_only)
+{
+   const int iSz = integrators.Size();
+   if (!restrict_lex || iSz == 0 || (dn_only && !restrict_dn)) { return; }
+   restrict_lex->Mult(x, faceX);
+   if (faceX.Size() == 0) { return; }
+   faceY = 0.0;
+   if (restrict_dn)
+   {
+      restrict_dn->Mult(x, faceDX);
+      faceDY = 0.0;
+   }
+   for (int i = 0; i < iSz; ++i)
    {
-      int_face_restrict_lex->Mult(x, faceIntX);
-      if (faceIntX.Size()>0)
+      BilinearFormIntegrator &integ = *integrators[i];
+      if (integ.RequiresFaceNormalDerivatives())
       {
-         faceIntY = 0.0;
-         for (int i = 0; i < iFISz; ++i)
+         if (transpose)
          {
-            intFaceIntegrators[i]->AddMultTransposePA(faceIntX, faceIntY);
+            integ.AddMultTransposePAFaceNormalDerivatives(faceX, faceDX,
+                                                          faceY, faceDY);
          }
-         int_face_restrict_lex->MultTranspose(faceIntY, y);
-      }
-   }
-
-   Array<BilinearFormIntegrator*> &bdrFaceIntegrators = *a->GetBFBFI();
-   const int bFISz = bdrFaceIntegrators.Size();
-   if (bdr_face_restrict_lex && bFISz>0)
-   {
-      bdr_face_restrict_lex->Mult(x, faceBdrX);
-      if (faceBdrX.Size()>0)
-      {
-         faceBdrY = 0.0;
-         for (int i = 0; i < bFISz; ++i)
+         else
          {
-            bdrFaceIntegrators[i]->AddMultTransposePA(faceBdrX, faceBdrY);
+            integ.AddMultPAFaceNormalDerivatives(faceX, faceDX, faceY, faceDY);
          }
-         bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
+      }
+      else if (!dn_only)
+      {
+         if (transpose) { integ.AddMultTransposePA(faceX, faceY); }
+         else { integ.AddMultPA(faceX, faceY); }
       }
    }
+   restrict_lex->MultTranspose(faceY, y);
+   if (restrict_dn) { restrict_dn->MultTranspose(faceDY, y); }
+}
+
+void PABilinearFormExtension::AddMultFaces(const Vector &x, Vector &y,
+                                           const bool transpose,
+                                           const bool dn_only) const
+{
+   AddMultFaceIntegrators(*a->GetFBFI(), int_face_restrict_lex,
+                          int_face_restrict_dn, faceIntX, faceIntY,
+                          faceIntDX, faceIntDY, x, y, transpose, dn_only);
+   AddMultFaceIntegrators(*a->GetBFBFI(), bdr_face_restrict_lex,
+                          bdr_face_restrict_dn, faceBdrX, faceBdrY,
+                          faceBdrDX, faceBdrDY, x, y, transpose, dn_only);
 }
 
 // Data and methods for element-assembled bilinear forms
@@ -506,7 +624,7 @@ void EABilinearFormExtension::Assemble()
    SetupRestrictionOperators(L2FaceValues::SingleValued);
 
    ne = trialFes->GetMesh()->GetNE();
-   elemDofs = trialFes->GetFE(0)->GetDof();
+   elemDofs = trialFes->GetFE(0)->GetDof() * trialFes->GetVDim();
 
    ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
    ea_data.UseDevice(true);
@@ -532,6 +650,8 @@ void EABilinearFormExtension::Assemble()
       nf_int = trialFes->GetNFbyType(FaceType::Interior);
       ea_data_int.SetSize(2*nf_int*faceDofs*faceDofs, Device::GetMemoryType());
       ea_data_ext.SetSize(2*nf_int*faceDofs*faceDofs, Device::GetMemoryType());
+      ea_data_int = 0.0;
+      ea_data_ext = 0.0;
    }
    for (int i = 0; i < intFaceIntegratorCount; ++i)
    {
@@ -690,6 +810,9 @@ void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
          bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
       }
    }
+
+   // Face integrators using normal derivatives are not element assembled
+   AddMultFaces(x, y, false, true);
 }
 
 void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
@@ -816,6 +939,9 @@ void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
          bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
       }
    }
+
+   // Face integrators using normal derivatives are not element assembled
+   AddMultFaces(x, y, true, true);
 }
 
 // Data and methods for fully-assembled bilinear forms
@@ -839,9 +965,24 @@ FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
 #endif
 }
 
+// The rows of @a mat are filled using the row offsets in I as insertion
+// cursors, so that in the end I[i] is the offset of the row i+1: shift them
+// back to the row offsets.
+static void ShiftRowOffsets(const int n, SparseMatrix &mat)
+{
+   Array<int> next_offsets(n);
+   auto d_next = next_offsets.Write();
+   auto I = mat.ReadWriteI();
+   MFEM_FORALL(i, n, d_next[i] = I[i];);
+   MFEM_FORALL(i, n+1, I[i] = (i == 0) ? 0 : d_next[i-1];);
+}
+
 void FABilinearFormExtension::Assemble()
 {
    EABilinearFormExtension::Assemble();
+   MFEM_VERIFY(!int_face_restrict_dn && !bdr_face_restrict_dn,
+               "Full assembly does not support face integrators using normal "
+               "derivatives, see RequiresFaceNormalDerivatives().");
    FiniteElementSpace &fes = *a->FESpace();
    if (fes.IsDGSpace())
    {
@@ -855,32 +996,13 @@ void FABilinearFormExtension::Assemble()
       //  1.2 Increment with restF
       if (restF) { restF->FillI(mat, face_mat); }
       //  1.3 Sum the non-zeros in I
-      auto h_I = mat.HostReadWriteI();
-      int cpt = 0;
-      const int vd = fes.GetVDim();
-      const int ndofs = ne*elemDofs*vd;
-      for (int i = 0; i < ndofs; i++)
-      {
-         const int nnz = h_I[i];
-         h_I[i] = cpt;
-         cpt += nnz;
-      }
-      const int nnz = cpt;
-      h_I[ndofs] = nnz;
+      const int ndofs = ne*elemDofs;
+      const int nnz = ExclusiveScan(ndofs, mat.ReadWriteI());
       mat.GetMemoryJ().New(nnz, mat.GetMemoryJ().GetMemoryType());
       mat.GetMemoryData().New(nnz, mat.GetMemoryData().GetMemoryType());
       if (use_face_mat && restF)
       {
-         auto h_I_face = face_mat.HostReadWriteI();
-         int cpt = 0;
-         for (int i = 0; i < ndofs; i++)
-         {
-            const int nnz = h_I_face[i];
-            h_I_face[i] = cpt;
-            cpt += nnz;
-         }
-         const int nnz_face = cpt;
-         h_I_face[ndofs] = nnz_face;
+         const int nnz_face = ExclusiveScan(ndofs, face_mat.ReadWriteI());
          face_mat.GetMemoryJ().New(nnz_face,
                                    face_mat.GetMemoryJ().GetMemoryType());
          face_mat.GetMemoryData().New(nnz_face,
@@ -892,21 +1014,8 @@ void FABilinearFormExtension::Assemble()
       // 2.2 Fill J and Data with Face ea_data_ext
       if (restF) { restF->FillJAndData(ea_data_ext, mat, face_mat); }
       // 2.3 Shift indirections in I back to original
-      auto I = mat.HostReadWriteI();
-      for (int i = ndofs; i > 0; i--)
-      {
-         I[i] = I[i-1];
-      }
-      I[0] = 0;
-      if (use_face_mat && restF)
-      {
-         auto I_face = face_mat.HostReadWriteI();
-         for (int i = ndofs; i > 0; i--)
-         {
-            I_face[i] = I_face[i-1];
-         }
-         I_face[0] = 0;
-      }
+      ShiftRowOffsets(ndofs, mat);
+      if (use_face_mat && restF) { ShiftRowOffsets(ndofs, face_mat); }
    }
    else // continuous Galerkin case
    {
@@ -981,11 +1090,17 @@ const Operator *MixedBilinearFormExtension::GetOutputRestriction() const
 
 PAMixedBilinearFormExtension::PAMixedBilinearFormExtension(
    MixedBilinearForm *form)
+   : PAMixedBilinearFormExtension(form, ElementDofOrdering::LEXICOGRAPHIC)
+{ }
+
+PAMixedBilinearFormExtension::PAMixedBilinearFormExtension(
+   MixedBilinearForm *form, ElementDofOrdering ordering)
    : MixedBilinearFormExtension(form),
      trialFes(form->TrialFESpace()),
      testFes(form->TestFESpace()),
      elem_restrict_trial(NULL),
-     elem_restrict_test(NULL)
+     elem_restrict_test(NULL),
+     e_ordering(ordering)
 {
    Update();
 }
@@ -1012,10 +1127,8 @@ void PAMixedBilinearFormExtension::Update()
    testFes  = a->TestFESpace();
    height = testFes->GetVSize();
    width = trialFes->GetVSize();
-   elem_restrict_trial = trialFes->GetElementRestriction(
-                            ElementDofOrdering::LEXICOGRAPHIC);
-   elem_restrict_test  =  testFes->GetElementRestriction(
-                             ElementDofOrdering::LEXICOGRAPHIC);
+   elem_restrict_trial = trialFes->GetElementRestriction(e_ordering);
+   elem_restrict_test  =  testFes->GetElementRestriction(e_ordering);
    if (elem_restrict_trial)
    {
       localTrial.UseDevice(true);
@@ -1100,21 +1213,48 @@ void PAMixedBilinearFormExtension::Mult(const Vector &x, Vector &y) const
    AddMult(x, y);
 }
 
-void PAMixedBilinearFormExtension::AddMult(const Vector &x, Vector &y,
-                                           const double c) const
+void PAMixedBilinearFormExtension::AddMultElements(const Vector &x,
+                                                   Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultPA(x, y);
+   }
+}
+
+void PAMixedBilinearFormExtension::AddMultTransposeElements(const Vector &x,
+                                                            Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultTransposePA(x, y);
+   }
+}
 
+void PAMixedBilinearFormExtension::AssembleDiagonalElements_ADAt(
+   const Vector &D, Vector &diag) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AssembleDiagonalPA_ADAt(D, diag);
+   }
+}
+
+void PAMixedBilinearFormExtension::AddMult(const Vector &x, Vector &y,
+                                           const double c) const
+{
    // * G operation
    SetupMultInputs(elem_restrict_trial, x, localTrial,
                    elem_restrict_test, y, localTest, c);
 
    // * B^TDB operation
-   for (int i = 0; i < iSz; ++i)
-   {
-      integrators[i]->AddMultPA(localTrial, localTest);
-   }
+   AddMultElements(localTrial, localTest);
 
    // * G^T operation
    if (elem_restrict_test)
@@ -1135,18 +1275,12 @@ void PAMixedBilinearFormExtension::MultTranspose(const Vector &x,
 void PAMixedBilinearFormExtension::AddMultTranspose(const Vector &x, Vector &y,
                                                     const double c) const
 {
-   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
-   const int iSz = integrators.Size();
-
    // * G operation
    SetupMultInputs(elem_restrict_test, x, localTest,
                    elem_restrict_trial, y, localTrial, c);
 
    // * B^TD^TB operation
-   for (int i = 0; i < iSz; ++i)
-   {
-      integrators[i]->AddMultTransposePA(localTest, localTrial);
-   }
+   AddMultTransposeElements(localTest, localTrial);
 
    // * G^T operation
    if (elem_restrict_trial)
@@ -1160,10 +1294,6 @@ void PAMixedBilinearFormExtension::AddMultTranspose(const Vector &x, Vector &y,
 void PAMixedBilinearFormExtension::AssembleDiagonal_ADAt(const Vector &D,
                                                          Vector &diag) const
 {
-   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
-
-   const int iSz = integrators.Size();
-
    if (elem_restrict_trial)
    {
       const ElementRestriction* H1elem_restrict_trial =
@@ -1177,21 +1307,12 @@ void PAMixedBilinearFormExtension::AssembleDiagonal_ADAt(const Vector &D,
          elem_restrict_trial->Mult(D, localTrial);
       }
    }
+   const Vector &localD = elem_restrict_trial ? localTrial : D;
 
    if (elem_restrict_test)
    {
       localTest = 0.0;
-      for (int i = 0; i < iSz; ++i)
-      {
-         if (elem_restrict_trial)
-         {
-            integrators[i]->AssembleDiagonalPA_ADAt(localTrial, localTest);
-         }
-         else
-         {
-            integrators[i]->AssembleDiagonalPA_ADAt(D, localTest);
-         }
-      }
+      AssembleDiagonalElements_ADAt(localD, localTest);
       const ElementRestriction* H1elem_restrict_test =
          dynamic_cast<const ElementRestriction*>(elem_restrict_test);
       if (H1elem_restrict_test)
@@ -1207,18 +1328,189 @@ void PAMixedBilinearFormExtension::AssembleDiagonal_ADAt(const Vector &D,
    {
       diag.UseDevice(true); // typically this is a large vector, so store on device
       diag = 0.0;
-      for (int i = 0; i < iSz; ++i)
+      AssembleDiagonalElements_ADAt(localD, diag);
+   }
+}
+
+// Compute in elmat the sum of the element matrices of the domain integrators of
+// the mixed form 'a' on the element e.
+static void AssembleMixedElementMatrix(MixedBilinearForm &a, const int e,
+                                       DenseMatrix &elmat,
+                                       DenseMatrix &elmat_i)
+{
+   const FiniteElementSpace &trial_fes = *a.TrialFESpace();
+   const FiniteElementSpace &test_fes = *a.TestFESpace();
+   const FiniteElement &trial_fe = *trial_fes.GetFE(e);
+   const FiniteElement &test_fe = *test_fes.GetFE(e);
+   ElementTransformation *T = test_fes.GetElementTransformation(e);
+   Array<BilinearFormIntegrator*> &integrators = *a.GetDBFI();
+   elmat.SetSize(test_fe.GetDof()*test_fes.GetVDim(),
+                 trial_fe.GetDof()*trial_fes.GetVDim());
+   elmat = 0.0;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AssembleElementMatrix2(trial_fe, test_fe, *T, elmat_i);
+      elmat += elmat_i;
+   }
+}
+
+static void VerifyMixedDomainIntegratorsOnly(MixedBilinearForm &a,
+                                             const char *level)
+{
+   MFEM_VERIFY(a.GetBBFI()->Size() == 0, level <<
+               " does not support AddBoundaryIntegrator yet.");
+   MFEM_VERIFY(a.GetTFBFI()->Size() == 0, level <<
+               " does not support AddTraceFaceIntegrator yet.");
+   MFEM_VERIFY(a.GetBTFBFI()->Size() == 0, level <<
+               " does not support AddBdrTraceFaceIntegrator yet.");
+}
+
+// Data and methods for element-assembled mixed bilinear forms
+EAMixedBilinearFormExtension::EAMixedBilinearFormExtension(
+   MixedBilinearForm *form)
+   : PAMixedBilinearFormExtension(form, ElementDofOrdering::NATIVE),
+     ne(0), trialElemDofs(0), testElemDofs(0)
+{ }
+
+void EAMixedBilinearFormExtension::Assemble()
+{
+   VerifyMixedDomainIntegratorsOnly(*a, "Element assembly");
+   ne = trialFes->GetNE();
+   if (ne == 0) { return; }
+   trialElemDofs = trialFes->GetFE(0)->GetDof() * trialFes->GetVDim();
+   testElemDofs = testFes->GetFE(0)->GetDof() * testFes->GetVDim();
+
+   // The element matrices are stored transposed, as in EABilinearFormExtension
+   ea_data.SetSize(ne*trialElemDofs*testElemDofs, Device::GetMemoryType());
+   auto A = Reshape(ea_data.HostWrite(), trialElemDofs, testElemDofs, ne);
+   DenseMatrix elmat, elmat_i;
+   for (int e = 0; e < ne; ++e)
+   {
+      AssembleMixedElementMatrix(*a, e, elmat, elmat_i);
+      for (int j = 0; j < testElemDofs; j++)
       {
-         if (elem_restrict_trial)
+         for (int i = 0; i < trialElemDofs; i++)
          {
-            integrators[i]->AssembleDiagonalPA_ADAt(localTrial, diag);
-         }
-         else
-         {
-            integrators[i]->AssembleDiagonalPA_ADAt(D, diag);
+            A(i, j, e) = elmat(j, i);
          }
       }
    }
 }
 
+void EAMixedBilinearFormExtension::AddMultElements(const Vector &x,
+                                                   Vector &y) const
+{
+   const int NE = ne;
+   const int TR_DOFS = trialElemDofs;
+   const int TE_DOFS = testElemDofs;
+   auto X = Reshape(x.Read(), TR_DOFS, NE);
+   auto Y = Reshape(y.ReadWrite(), TE_DOFS, NE);
+   auto A = Reshape(ea_data.Read(), TR_DOFS, TE_DOFS, NE);
+   MFEM_FORALL(glob_j, NE*TE_DOFS,
+   {
+      const int e = glob_j/TE_DOFS;
+      const int j = glob_j%TE_DOFS;
+      double res = 0.0;
+      for (int i = 0; i < TR_DOFS; i++)
+      {
+         res += A(i, j, e)*X(i, e);
+      }
+      Y(j, e) += res;
+   });
+}
+
+void EAMixedBilinearFormExtension::AddMultTransposeElements(const Vector &x,
+                                                            Vector &y) const
+{
+   const int NE = ne;
+   const int TR_DOFS = trialElemDofs;
+   const int TE_DOFS = testElemDofs;
+   auto X = Reshape(x.Read(), TE_DOFS, NE);
+   auto Y = Reshape(y.ReadWrite(), TR_DOFS, NE);
+   auto A = Reshape(ea_data.Read(), TR_DOFS, TE_DOFS, NE);
+   MFEM_FORALL(glob_i, NE*TR_DOFS,
+   {
+      const int e = glob_i/TR_DOFS;
+      const int i = glob_i%TR_DOFS;
+      double res = 0.0;
+      for (int j = 0; j < TE_DOFS; j++)
+      {
+         res += A(i, j, e)*X(j, e);
+      }
+      Y(i, e) += res;
+   });
+}
+
+void EAMixedBilinearFormExtension::AssembleDiagonalElements_ADAt(
+   const Vector &D, Vector &diag) const
+{
+   const int NE = ne;
+   const int TR_DOFS = trialElemDofs;
+   const int TE_DOFS = testElemDofs;
+   auto d = Reshape(D.Read(), TR_DOFS, NE);
+   auto Y = Reshape(diag.ReadWrite(), TE_DOFS, NE);
+   auto A = Reshape(ea_data.Read(), TR_DOFS, TE_DOFS, NE);
+   MFEM_FORALL(glob_j, NE*TE_DOFS,
+   {
+      const int e = glob_j/TE_DOFS;
+      const int j = glob_j%TE_DOFS;
+      double res = 0.0;
+      for (int i = 0; i < TR_DOFS; i++)
+      {
+         res += A(i, j, e)*A(i, j, e)*d(i, e);
+      }
+      Y(j, e) += res;
+   });
+}
+
+// Data and methods for matrix-free mixed bilinear forms
+MFMixedBilinearFormExtension::MFMixedBilinearFormExtension(
+   MixedBilinearForm *form)
+   : PAMixedBilinearFormExtension(form)
+{ }
+
+void MFMixedBilinearFormExtension::Assemble()
+{
+   VerifyMixedDomainIntegratorsOnly(*a, "Matrix-free action");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AssembleMF(*trialFes, *testFes);
+   }
+}
+
+void MFMixedBilinearFormExtension::AddMultElements(const Vector &x,
+                                                   Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultMF(x, y);
+   }
+}
+
+void MFMixedBilinearFormExtension::AddMultTransposeElements(const Vector &x,
+                                                            Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultTransposeMF(x, y);
+   }
+}
+
+void MFMixedBilinearFormExtension::AssembleDiagonalElements_ADAt(
+   const Vector &D, Vector &diag) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AssembleDiagonalMF_ADAt(D, diag);
+   }
+}
+
 } // namespace mfem
@@ -68,14 +68,23 @@ class PABilinearFormExtension : public BilinearFormExtension
 protected:
    const FiniteElementSpace *trialFes, *testFes; // Not owned
    mutable Vector localX, localY;
+   mutable Vector localXb, localYb; // batched E-vectors, see ArrayMult()
    mutable Vector faceIntX, faceIntY;
    mutable Vector faceBdrX, faceBdrY;
    const Operator *elem_restrict; // Not owned
+   /// Set if the action is fused with the restriction, see UseFusedRestriction
+   const ElementRestriction *fused_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   /** Normal derivatives on the faces, used by the face integrators for which
+       RequiresFaceNormalDerivatives() is true. */
+   Operator *int_face_restrict_dn, *bdr_face_restrict_dn; // Owned
+   mutable Vector faceIntDX, faceIntDY;
+   mutable Vector faceBdrDX, faceBdrDY;
 
 public:
    PABilinearFormExtension(BilinearForm*);
+   ~PABilinearFormExtension();
 
    void Assemble();
    void AssembleDiagonal(Vector &diag) const;
@@ -85,11 +94,22 @@ public:
                          OperatorHandle &A, Vector &X, Vector &B,
                          int copy_interior = 0);
    void Mult(const Vector &x, Vector &y) const;
+   /** @brief Apply the operator to all vectors in @a X at once, using the
+       batched action AddMultBatchedPA() of the domain integrators. */
+   void ArrayMult(const Array<const Vector *> &X, Array<Vector *> &Y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+   /** @brief Allocate the E-vectors #localX and #localY, which are not needed
+       by the action when it is fused with the element restriction. */
+   void AllocateElementVectors() const;
+   /** @brief Add the (transposed) action of the interior and boundary face
+       integrators to @a y. If @a dn_only is true, only the integrators using
+       the face normal derivatives are applied. */
+   void AddMultFaces(const Vector &x, Vector &y, const bool transpose,
+                     const bool dn_only = false) const;
 };
 
 /// Data and methods for element-assembled bilinear forms
@@ -128,6 +148,9 @@ public:
    void Assemble();
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+
+   /// Return the assembled matrix, see Assemble().
+   const SparseMatrix &SpMat() const { return mat; }
 };
 
 /// Data and methods for matrix-free bilinear forms
@@ -212,13 +235,26 @@ protected:
    mutable Vector localTrial, localTest, tempY;
    const Operator *elem_restrict_trial; // Not owned
    const Operator *elem_restrict_test;  // Not owned
-private:
+   const ElementDofOrdering e_ordering;
+
    /// Helper function to set up inputs/outputs for Mult or MultTranspose
    void SetupMultInputs(const Operator *elem_restrict_x,
                         const Vector &x, Vector &localX,
                         const Operator *elem_restrict_y,
                         Vector &y, Vector &localY, const double c) const;
 
+   /// Add the action of the element operators on the E-vector @a x to @a y.
+   virtual void AddMultElements(const Vector &x, Vector &y) const;
+   /// Add the transposed action of the element operators to @a y.
+   virtual void AddMultTransposeElements(const Vector &x, Vector &y) const;
+   /// Add the element diagonals of ADA^T, for the E-vector @a D, to @a diag.
+   virtual void AssembleDiagonalElements_ADAt(const Vector &D,
+                                              Vector &diag) const;
+
+   /// Constructor using the given ordering of the element restrictions.
+   PAMixedBilinearFormExtension(MixedBilinearForm *form,
+                                ElementDofOrdering ordering);
+
 public:
    PAMixedBilinearFormExtension(MixedBilinearForm *form);
 
@@ -258,6 +294,43 @@ public:
    void Update();
 };
 
+/// Data and methods for element-assembled mixed bilinear forms
+/** The element matrices are computed with the AssembleElementMatrix2() method
+    of the domain integrators, so any integrator is supported. They are stored
+    in the native element dof ordering and applied on the device. */
+class EAMixedBilinearFormExtension : public PAMixedBilinearFormExtension
+{
+protected:
+   int ne, trialElemDofs, testElemDofs;
+   Vector ea_data;
+
+   void AddMultElements(const Vector &x, Vector &y) const;
+   void AddMultTransposeElements(const Vector &x, Vector &y) const;
+   void AssembleDiagonalElements_ADAt(const Vector &D, Vector &diag) const;
+
+public:
+   EAMixedBilinearFormExtension(MixedBilinearForm *form);
+
+   void Assemble();
+};
+
+/// Data and methods for matrix-free mixed bilinear forms
+/** The domain integrators must support matrix-free assembly, see
+    BilinearFormIntegrator::AssembleMF(): they recompute their quadrature data
+    on the device every time the action of the form is computed. */
+class MFMixedBilinearFormExtension : public PAMixedBilinearFormExtension
+{
+protected:
+   void AddMultElements(const Vector &x, Vector &y) const;
+   void AddMultTransposeElements(const Vector &x, Vector &y) const;
+   void AssembleDiagonalElements_ADAt(const Vector &D, Vector &diag) const;
+
+public:
+   MFMixedBilinearFormExtension(MixedBilinearForm *form);
+
+   void Assemble();
+};
+
 }
 
 #endif
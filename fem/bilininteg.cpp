@@ -12,6 +12,7 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -90,18 +91,96 @@ void BilinearFormIntegrator::AddMultPA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAFused(const ElementRestriction &,
+                                            const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAFused(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultBatchedPA(const int nvec, const Vector &x,
+                                              Vector &y) const
+{
+   MFEM_ASSERT(x.Size() % nvec == 0 && y.Size() % nvec == 0,
+               "invalid batch size");
+   const int nx = x.Size()/nvec, ny = y.Size()/nvec;
+   Vector xi, yi;
+   for (int i = 0; i < nvec; i++)
+   {
+      xi.MakeRef(const_cast<Vector&>(x), i*nx, nx);
+      yi.MakeRef(y, i*ny, ny);
+      AddMultPA(xi, yi);
+      yi.SyncAliasMemory(y);
+   }
+}
+
+void BilinearFormIntegrator::AddMultComplexPA(
+   const BilinearFormIntegrator &imag, const Vector &x, Vector &y) const
+{
+   const int nx = x.Size()/2, ny = y.Size()/2;
+   // x_ri = [x_r, x_i]
+   Vector x_ri(2*nx, Device::GetDeviceMemoryType());
+   Vector y_r(2*ny, Device::GetDeviceMemoryType());
+   Vector y_i(2*ny, Device::GetDeviceMemoryType());
+   x_ri.UseDevice(true);
+   y_r.UseDevice(true);
+   y_i.UseDevice(true);
+   const auto d_x = Reshape(x.Read(), 2, nx);
+   auto d_x_ri = Reshape(x_ri.Write(), nx, 2);
+   MFEM_FORALL(i, nx,
+   {
+      d_x_ri(i,0) = d_x(0,i);
+      d_x_ri(i,1) = d_x(1,i);
+   });
+   // y_r = [A_r x_r, A_r x_i], y_i = [A_i x_r, A_i x_i]
+   y_r = 0.0;
+   y_i = 0.0;
+   AddMultBatchedPA(2, x_ri, y_r);
+   imag.AddMultBatchedPA(2, x_ri, y_i);
+   const auto d_y_r = Reshape(y_r.Read(), ny, 2);
+   const auto d_y_i = Reshape(y_i.Read(), ny, 2);
+   auto d_y = Reshape(y.ReadWrite(), 2, ny);
+   MFEM_FORALL(i, ny,
+   {
+      d_y(0,i) += d_y_r(i,0) - d_y_i(i,1);
+      d_y(1,i) += d_y_i(i,0) + d_y_r(i,1);
+   });
+}
+
 void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
 {
    mfem_error ("BilinearFormIntegrator::MultAssembledTranspose(...)\n"
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAFaceNormalDerivatives(
+   const Vector &, const Vector &, Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAFaceNormalDerivatives(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAFaceNormalDerivatives(
+   const Vector &, const Vector &, Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::"
+               "AddMultTransposePAFaceNormalDerivatives(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
 {
    mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &trial_fes,
+                                        const FiniteElementSpace &test_fes)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AddMultMF(const Vector &, Vector &) const
 {
    mfem_error ("BilinearFormIntegrator::AddMultMF(...)\n"
@@ -120,6 +199,12 @@ void BilinearFormIntegrator::AssembleDiagonalMF(Vector &)
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AssembleDiagonalMF_ADAt(const Vector &, Vector &)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleDiagonalMF_ADAt(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
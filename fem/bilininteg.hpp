@@ -76,6 +76,50 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Returns true if the integrator implements AddMultPAFused().
+   virtual bool SupportsFusedPA() const { return false; }
+
+   /// Method for partially assembled action fused with the element restriction.
+   /** Perform the action of the integrator on the L-vector @a x and add the
+       result to the L-vector @a y, gathering and scattering the element values
+       through the element restriction @a R without forming E-vectors.
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                               Vector &y) const;
+
+   /// Method for partially assembled action on a batch of vectors.
+   /** Perform the action of the integrator on the @a nvec E-vectors stored
+       consecutively in @a x and add the results to the corresponding E-vectors
+       stored in @a y.
+
+       The default implementation calls AddMultPA() for every vector. Derived
+       classes can override it to read the partially assembled data only once
+       for all vectors.
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AddMultBatchedPA(const int nvec, const Vector &x,
+                                 Vector &y) const;
+
+   /// Method for partially assembled action of a complex integrator.
+   /** Perform the action of the complex integrator with real part given by
+       this integrator and imaginary part given by @a imag on the complex
+       E-vector @a x and add the result to @a y. The real and imaginary parts of
+       the E-vectors are interleaved: x(2*i) and x(2*i+1) are the real and
+       imaginary parts of the i-th E-vector entry.
+
+       The default implementation separates the real and imaginary parts and
+       calls AddMultBatchedPA() for both integrators. Derived classes can
+       override it to read the E-vectors and the partially assembled data of
+       both integrators in a single pass.
+
+       This method can be called only after the method AssemblePA() has been
+       called for both integrators, with the same FiniteElementSpace. */
+   virtual void AddMultComplexPA(const BilinearFormIntegrator &imag,
+                                 const Vector &x, Vector &y) const;
+
    /// Method for partially assembled transposed action.
    /** Perform the transpose action of integrator on the input @a x and add the
        result to the output @a y. Both @a x and @a y are E-vectors, i.e. they
@@ -85,6 +129,30 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /** Returns true if the partially assembled face action of the integrator
+       needs the normal derivatives of the face values, in which case it is
+       implemented by AddMultPAFaceNormalDerivatives(). */
+   virtual bool RequiresFaceNormalDerivatives() const { return false; }
+
+   /// Method for partially assembled face action using normal derivatives.
+   /** Perform the action of the face integrator on the face E-vectors @a x,
+       with the face values, and @a dxdn, with the derivatives with respect to
+       the reference coordinate normal to the face, see
+       L2NormalDerivativeFaceRestriction. The results are added to the face
+       E-vectors @a y and @a dydn, respectively.
+
+       This method can be called only after the method AssemblePAInteriorFaces()
+       or AssemblePABoundaryFaces() has been called. */
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const;
+
+   /// Transpose of AddMultPAFaceNormalDerivatives().
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -99,6 +167,9 @@ public:
    /** The result of fully matrix-free assembly is stored internally so that it
        can be used later in the methods AddMultMF() and AddMultTransposeMF(). */
    virtual void AssembleMF(const FiniteElementSpace &fes);
+   /** Used with BilinearFormIntegrators that have different spaces. */
+   virtual void AssembleMF(const FiniteElementSpace &trial_fes,
+                           const FiniteElementSpace &test_fes);
 
    /** Perform the action of integrator on the input @a x and add the result to
        the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
@@ -119,6 +190,10 @@ public:
    /// Assemble diagonal and add it to Vector @a diag.
    virtual void AssembleDiagonalMF(Vector &diag);
 
+   /** @brief Assemble diagonal of ADA^T (A is this integrator) and add it to
+       @a diag, after AssembleMF(). */
+   virtual void AssembleDiagonalMF_ADAt(const Vector &D, Vector &diag);
+
    virtual void AssembleEAInteriorFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_int,
                                         Vector &ea_data_ext,
@@ -300,6 +375,26 @@ public:
       bfi->AddMultTransposePA(x, y);
    }
 
+   virtual bool RequiresFaceNormalDerivatives() const
+   {
+      return bfi->RequiresFaceNormalDerivatives();
+   }
+
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const
+   {
+      bfi->AddMultTransposePAFaceNormalDerivatives(x, dxdn, y, dydn);
+   }
+
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const
+   {
+      bfi->AddMultPAFaceNormalDerivatives(x, dxdn, y, dydn);
+   }
+
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
                            const bool add);
 
@@ -706,11 +801,43 @@ protected:
 class MixedScalarDivergenceIntegrator : public MixedScalarIntegrator
 {
 public:
-   MixedScalarDivergenceIntegrator() {}
+   MixedScalarDivergenceIntegrator() : pa_integ(NULL) {}
    MixedScalarDivergenceIntegrator(Coefficient &q)
-      : MixedScalarIntegrator(q) {}
+      : MixedScalarIntegrator(q), pa_integ(NULL) {}
+
+   virtual ~MixedScalarDivergenceIntegrator();
+
+   using BilinearFormIntegrator::AssemblePA;
+   /** @brief Partial assembly for tensor-product H(div) trial and L2 test
+       spaces, with the test order one less than the trial order. */
+   virtual void AssemblePA(const FiniteElementSpace &trial_fes,
+                           const FiniteElementSpace &test_fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleDiagonalPA_ADAt(const Vector &D, Vector &diag);
+
+   using BilinearFormIntegrator::AssembleMF;
+   /// Matrix-free assembly, for the same spaces as AssemblePA().
+   virtual void AssembleMF(const FiniteElementSpace &trial_fes,
+                           const FiniteElementSpace &test_fes);
+
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
+   virtual void AssembleDiagonalMF_ADAt(const Vector &D, Vector &diag);
 
 protected:
+   /// Integrator performing the partial and matrix-free assembly.
+   BilinearFormIntegrator *pa_integ;
+
+   /// Create #pa_integ with the quadrature rule of this integrator.
+   void NewPAIntegrator(const FiniteElementSpace &trial_fes,
+                        const FiniteElementSpace &test_fes);
+
    inline virtual bool VerifyFiniteElementTypes(
       const FiniteElement & trial_fe,
       const FiniteElement & test_fe) const
@@ -1857,22 +1984,30 @@ private:
    DenseMatrix gshape;
    DenseMatrix Jadj;
    DenseMatrix elmat_comp;
-   // PA extension
+   // PA and MF extensions
    Vector pa_data;
    const DofToQuad *trial_maps, *test_maps; ///< Not owned
    const GeometricFactors *geom;            ///< Not owned
+   const IntegrationRule *ir;               ///< Not owned
+   Vector coeff; // coefficient values at the quadrature points, or constant
    int dim, ne, nq;
    int trial_dofs1D, test_dofs1D, quad1D;
 
+   /// Set up the maps, the geometric factors and the coefficient values.
+   void SetupPA(const FiniteElementSpace &trial_fes,
+                const FiniteElementSpace &test_fes);
+   /// Compute the quadrature data used by the PA kernels in @a op.
+   void ComputeQuadratureData(Vector &op) const;
+
 public:
    GradientIntegrator() :
-      Q{NULL}, trial_maps{NULL}, test_maps{NULL}, geom{NULL}
+      Q{NULL}, trial_maps{NULL}, test_maps{NULL}, geom{NULL}, ir{NULL}
    { }
    GradientIntegrator(Coefficient *_q) :
-      Q{_q}, trial_maps{NULL}, test_maps{NULL}, geom{NULL}
+      Q{_q}, trial_maps{NULL}, test_maps{NULL}, geom{NULL}, ir{NULL}
    { }
    GradientIntegrator(Coefficient &q) :
-      Q{&q}, trial_maps{NULL}, test_maps{NULL}, geom{NULL}
+      Q{&q}, trial_maps{NULL}, test_maps{NULL}, geom{NULL}, ir{NULL}
    { }
 
    virtual void AssembleElementMatrix2(const FiniteElement &trial_fe,
@@ -1887,6 +2022,16 @@ public:
    virtual void AddMultPA(const Vector &x, Vector &y) const;
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   using BilinearFormIntegrator::AssembleMF;
+   /** @brief Matrix-free assembly: the quadrature data is recomputed on the
+       device, from the Jacobians and the coefficient values, in every call of
+       AddMultMF() and AddMultTransposeMF(). */
+   virtual void AssembleMF(const FiniteElementSpace &trial_fes,
+                           const FiniteElementSpace &test_fes);
+
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -1917,6 +2062,13 @@ private:
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
+
+   // PA extension for simplices, see bilininteg_simplex_pa.cpp
+   bool simplex = false; ///< True if the PA data uses the non-tensor kernels
+   Vector bernstein;     ///< 1D Bernstein bases at the collapsed quad points
+   void AssemblePASimplex(const FiniteElementSpace &fes);
+   void AssembleDiagonalPASimplex(Vector &diag) const;
+   void AddMultPASimplex(const Vector &x, Vector &y) const;
    // CEED extension
    CeedData* ceedDataPtr;
 
@@ -1979,6 +2131,7 @@ public:
 
    using BilinearFormIntegrator::AssemblePA;
 
+   using BilinearFormIntegrator::AssembleMF;
    virtual void AssembleMF(const FiniteElementSpace &fes);
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
@@ -1994,6 +2147,17 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsFusedPA() const { return !simplex; }
+
+   virtual void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                               Vector &y) const;
+
+   virtual void AddMultBatchedPA(const int nvec, const Vector &x,
+                                 Vector &y) const;
+
+   virtual void AddMultComplexPA(const BilinearFormIntegrator &imag,
+                                 const Vector &x, Vector &y) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 };
@@ -2013,6 +2177,13 @@ protected:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
 
+   // PA extension for simplices, see bilininteg_simplex_pa.cpp
+   bool simplex = false; ///< True if the PA data uses the non-tensor kernels
+   Vector bernstein;     ///< 1D Bernstein bases at the collapsed quad points
+   void AssemblePASimplex(const FiniteElementSpace &fes);
+   void AssembleDiagonalPASimplex(Vector &diag) const;
+   void AddMultPASimplex(const Vector &x, Vector &y) const;
+
    // CEED extension
    CeedData* ceedDataPtr;
 
@@ -2042,6 +2213,7 @@ public:
 
    using BilinearFormIntegrator::AssemblePA;
 
+   using BilinearFormIntegrator::AssembleMF;
    virtual void AssembleMF(const FiniteElementSpace &fes);
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
@@ -2057,6 +2229,17 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsFusedPA() const { return !simplex; }
+
+   virtual void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                               Vector &y) const;
+
+   virtual void AddMultBatchedPA(const int nvec, const Vector &x,
+                                 Vector &y) const;
+
+   virtual void AddMultComplexPA(const BilinearFormIntegrator &imag,
+                                 const Vector &x, Vector &y) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2200,6 +2383,7 @@ public:
                                        DenseMatrix &elmat);
    using BilinearFormIntegrator::AssemblePA;
    virtual void AssemblePA(const FiniteElementSpace &fes);
+   using BilinearFormIntegrator::AssembleMF;
    virtual void AssembleMF(const FiniteElementSpace &fes);
    virtual void AssembleDiagonalPA(Vector &diag);
    virtual void AssembleDiagonalMF(Vector &diag);
@@ -2227,17 +2411,34 @@ protected:
    virtual void AddMultPA(const Vector&, Vector&) const;
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
+   using BilinearFormIntegrator::AssembleMF;
+   /** @brief Matrix-free assembly: the quadrature data is recomputed on the
+       device from the coefficient values in every application. */
+   virtual void AssembleMF(const FiniteElementSpace &trial_fes,
+                           const FiniteElementSpace &test_fes);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+   virtual void AddMultTransposeMF(const Vector&, Vector&) const;
+
 private:
 #ifndef MFEM_THREAD_SAFE
    Vector divshape, shape;
 #endif
 
-   // PA extension
+   // PA and MF extensions
    Vector pa_data;
    const DofToQuad *mapsO;         ///< Not owned. DOF-to-quad map, open.
    const DofToQuad *L2mapsO;       ///< Not owned. DOF-to-quad map, open.
    const DofToQuad *mapsC;         ///< Not owned. DOF-to-quad map, closed.
-   int dim, ne, dofs1D, L2dofs1D, quad1D;
+   const IntegrationRule *ir;      ///< Not owned
+   Vector coeff;                   ///< Coefficient at the quadrature points.
+   int dim, ne, nq, dofs1D, L2dofs1D, quad1D;
+
+   /// Set up the maps and the coefficient values.
+   void SetupPA(const FiniteElementSpace &trial_fes,
+                const FiniteElementSpace &test_fes);
+   /// Compute the quadrature data used by the PA kernels in @a op.
+   void ComputeQuadratureData(Vector &op) const;
 
 public:
    VectorFEDivergenceIntegrator() { Q = NULL; }
@@ -2251,6 +2452,7 @@ public:
                                        DenseMatrix &elmat);
 
    virtual void AssembleDiagonalPA_ADAt(const Vector &D, Vector &diag);
+   virtual void AssembleDiagonalMF_ADAt(const Vector &D, Vector &diag);
 };
 
 
@@ -2493,22 +2695,30 @@ private:
    DenseMatrix dshape;
    DenseMatrix gshape;
    DenseMatrix Jadj;
-   // PA extension
+   // PA and MF extensions
    Vector pa_data;
    const DofToQuad *trial_maps, *test_maps; ///< Not owned
    const GeometricFactors *geom;            ///< Not owned
+   const IntegrationRule *ir;               ///< Not owned
+   Vector coeff; // coefficient values at the quadrature points, or constant
    int dim, ne, nq;
    int trial_dofs1D, test_dofs1D, quad1D;
 
+   /// Set up the maps, the geometric factors and the coefficient values.
+   void SetupPA(const FiniteElementSpace &trial_fes,
+                const FiniteElementSpace &test_fes);
+   /// Compute the quadrature data used by the PA kernels in @a op.
+   void ComputeQuadratureData(Vector &op) const;
+
 public:
    VectorDivergenceIntegrator() :
-      Q(NULL), trial_maps(NULL), test_maps(NULL), geom(NULL)
+      Q(NULL), trial_maps(NULL), test_maps(NULL), geom(NULL), ir(NULL)
    {  }
    VectorDivergenceIntegrator(Coefficient *_q) :
-      Q(_q), trial_maps(NULL), test_maps(NULL), geom(NULL)
+      Q(_q), trial_maps(NULL), test_maps(NULL), geom(NULL), ir(NULL)
    { }
    VectorDivergenceIntegrator(Coefficient &q) :
-      Q(&q), trial_maps(NULL), test_maps(NULL), geom(NULL)
+      Q(&q), trial_maps(NULL), test_maps(NULL), geom(NULL), ir(NULL)
    { }
 
    virtual void AssembleElementMatrix2(const FiniteElement &trial_fe,
@@ -2523,6 +2733,14 @@ public:
    virtual void AddMultPA(const Vector &x, Vector &y) const;
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   using BilinearFormIntegrator::AssembleMF;
+   /// Matrix-free assembly, see GradientIntegrator::AssembleMF().
+   virtual void AssembleMF(const FiniteElementSpace &trial_fes,
+                           const FiniteElementSpace &test_fes);
+
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2603,10 +2821,14 @@ public:
                                       const Vector &elfun, Vector &elvect);
    using BilinearFormIntegrator::AssemblePA;
    virtual void AssemblePA(const FiniteElementSpace &fes);
+   using BilinearFormIntegrator::AssembleMF;
    virtual void AssembleMF(const FiniteElementSpace &fes);
    virtual void AssembleDiagonalPA(Vector &diag);
    virtual void AssembleDiagonalMF(Vector &diag);
    virtual void AddMultPA(const Vector &x, Vector &y) const;
+   virtual bool SupportsFusedPA() const { return true; }
+   virtual void AddMultPAFused(const ElementRestriction &R, const Vector &x,
+                               Vector &y) const;
    virtual void AddMultMF(const Vector &x, Vector &y) const;
 };
 
@@ -2621,6 +2843,12 @@ protected:
    double q_lambda, q_mu;
    Coefficient *lambda, *mu;
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 private:
 #ifndef MFEM_THREAD_SAFE
    Vector shape;
@@ -2640,6 +2868,13 @@ public:
                                       ElementTransformation &,
                                       DenseMatrix &);
 
+   using BilinearFormIntegrator::AssemblePA;
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+   virtual void AssembleDiagonalPA(Vector &diag);
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat,
+                           const bool add);
+
    /** Compute the stress corresponding to the local displacement @a u and
        interpolate it at the nodes of the given @a fluxelem. Only the symmetric
        part of the stress is stored, so that the size of @a flux is equal to
@@ -2755,18 +2990,52 @@ protected:
    Vector shape1, shape2, dshape1dn, dshape2dn, nor, nh, ni;
    DenseMatrix jmat, dshape1, dshape2, mq, adjJ;
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   int dim, nf, dofs1D, quad1D;
+   Vector pa_data;
+
+private:
+   void SetupPA(const FiniteElementSpace &fes, FaceType type);
+
 public:
    DGDiffusionIntegrator(const double s, const double k)
-      : Q(NULL), MQ(NULL), sigma(s), kappa(k) { }
+      : Q(NULL), MQ(NULL), sigma(s), kappa(k), maps(NULL), nf(0) { }
    DGDiffusionIntegrator(Coefficient &q, const double s, const double k)
-      : Q(&q), MQ(NULL), sigma(s), kappa(k) { }
+      : Q(&q), MQ(NULL), sigma(s), kappa(k), maps(NULL), nf(0) { }
    DGDiffusionIntegrator(MatrixCoefficient &q, const double s, const double k)
-      : Q(NULL), MQ(&q), sigma(s), kappa(k) { }
+      : Q(NULL), MQ(&q), sigma(s), kappa(k), maps(NULL), nf(0) { }
    using BilinearFormIntegrator::AssembleFaceMatrix;
    virtual void AssembleFaceMatrix(const FiniteElement &el1,
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
+
+   using BilinearFormIntegrator::AssemblePA;
+
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
+   virtual bool RequiresFaceNormalDerivatives() const { return true; }
+
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const;
+
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const;
+
+   virtual void AssembleEAInteriorFaces(const FiniteElementSpace &fes,
+                                        Vector &ea_data_int,
+                                        Vector &ea_data_ext,
+                                        const bool add);
+
+   virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
+                                        Vector &ea_data_bdr,
+                                        const bool add);
 };
 
 /** Integrator for the "BR2" diffusion stabilization term
@@ -0,0 +1,454 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "restriction.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA DG Diffusion Integrator
+
+// The face terms of the interior penalty method are
+//
+//    -<{Q grad(u).n}, [v]> + sigma <[u], {Q grad(v).n}> + kappa <{Q/h}[u], [v]>
+//
+// At each face quadrature point, the flux {Q grad(u).n} is expressed in terms
+// of the normal derivatives of u, with respect to the reference coordinate
+// normal to the face, see L2NormalDerivativeFaceRestriction, and the tangential
+// derivatives of the face values of u, with respect to the reference
+// coordinates of the first element of the face. The PA data stores, for each
+// quadrature point and each side, the dim coefficients of these derivatives,
+// followed by the penalty coefficient.
+void DGDiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
+                                    FaceType type)
+{
+   MFEM_VERIFY(MQ == NULL, "MatrixCoefficient is not supported with partial "
+               "assembly");
+   nf = fes.GetNFbyType(type);
+   if (nf == 0) { return; }
+   Mesh &mesh = *fes.GetMesh();
+   dim = mesh.Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Unsupported dimension.");
+   const FiniteElement &el = *fes.GetTraceElement(0,
+                                                  mesh.GetFaceBaseGeometry(0));
+   const int order = fes.GetFE(0)->GetOrder();
+   // Same rule as AssembleFaceMatrix()
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(), 2*order);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   const int nq = ir->GetNPoints();
+   const int nc = 2*dim + 1;
+   pa_data.SetSize(nq*nc*nf, Device::GetMemoryType());
+   auto C = Reshape(pa_data.HostWrite(), nq, nc, nf);
+
+   // Normal axis of the local faces of the reference square and cube
+   const int axis2D[] = {1, 0, 1, 0};
+   const int axis3D[] = {2, 1, 0, 1, 0, 2};
+   const int *axis = (dim == 2) ? axis2D : axis3D;
+   Vector nor(dim), v(dim);
+   DenseMatrix t(dim, dim-1), gram(dim-1);
+   Vector rhs(dim-1), beta(dim-1);
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2, inf1, inf2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      mesh.GetFaceInfos(f, &inf1, &inf2);
+      if (!((type==FaceType::Interior && (e2>=0 || (e2<0 && inf2>=0))) ||
+            (type==FaceType::Boundary && e2<0 && inf2<0)))
+      {
+         continue;
+      }
+      MFEM_VERIFY(type==FaceType::Boundary || e2>=0,
+                  "Shared faces are not supported with partial assembly.");
+      const bool interior = (type == FaceType::Interior);
+      const int face_id[2] = {inf1 / 64, inf2 / 64};
+      FaceElementTransformations &T = *mesh.GetFaceElementTransformations(f);
+      for (int q = 0; q < nq; ++q)
+      {
+         // Convert to lexicographic ordering
+         const int iq = ToLexOrdering(dim, face_id[0], quad1D, q);
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         T.SetAllIntPoints(&ip);
+         CalcOrtho(T.Jacobian(), nor);
+         const double nor2 = nor * nor;
+
+         // Tangents along the reference coordinates of element 1
+         const DenseMatrix &J1 = T.Elem1->Jacobian();
+         for (int a = 0, k = 0; k < dim; ++k)
+         {
+            if (k == axis[face_id[0]]) { continue; }
+            for (int i = 0; i < dim; ++i) { t(i,a) = J1(i,k); }
+            a++;
+         }
+         MultAtB(t, t, gram);
+         gram.Invert();
+
+         double kq = 0.0;
+         for (int s = 0; s < 2; ++s)
+         {
+            if (s == 1 && !interior)
+            {
+               for (int k = 0; k < dim; ++k) { C(iq,dim+k,f_ind) = 0.0; }
+               continue;
+            }
+            ElementTransformation &Ts = s ? *T.Elem2 : *T.Elem1;
+            const IntegrationPoint &eip = s ? T.GetElement2IntPoint() :
+                                          T.GetElement1IntPoint();
+            double w = interior ? ip.weight/2 : ip.weight;
+            if (Q) { w *= Q->Eval(Ts, eip); }
+            kq += w*nor2/Ts.Weight();
+
+            // Decompose v = J_s e_n = alpha nor + sum_a beta_a t_a, where e_n
+            // is the reference normal direction of side s. Then, with g the
+            // gradient of u: g.v = du/dn and g.t_a = du/dt_a give g.nor.
+            Ts.Jacobian().GetColumn(axis[face_id[s]], v);
+            const double alpha = (v * nor)/nor2;
+            v.Add(-alpha, nor);
+            t.MultTranspose(v, rhs);
+            gram.Mult(rhs, beta);
+            C(iq,s*dim,f_ind) = w/alpha;
+            for (int a = 0; a < dim-1; ++a)
+            {
+               C(iq,s*dim+1+a,f_ind) = -w*beta(a)/alpha;
+            }
+         }
+         C(iq,2*dim,f_ind) = kappa*kq;
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind==nf, "Incorrect number of faces.");
+}
+
+void DGDiffusionIntegrator::AssemblePAInteriorFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGDiffusionIntegrator::AssemblePABoundaryFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+void DGDiffusionIntegrator::AssembleEAInteriorFaces(
+   const FiniteElementSpace &fes, Vector &, Vector &, const bool)
+{
+   // The face matrices couple all the element dofs, they do not fit in the
+   // face E-vector format: the partially assembled action is used instead.
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGDiffusionIntegrator::AssembleEABoundaryFaces(
+   const FiniteElementSpace &fes, Vector &, const bool)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+// PA DGDiffusion Apply 2D kernel for Gauss-Lobatto/Bernstein. The action is
+//    y = a_jf [v] {Q grad(u).n} + a_fj {Q grad(v).n} [u] + kappa {Q/h} [u] [v]
+// i.e. a_jf = -1, a_fj = sigma for the operator and the opposite for its
+// transpose.
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADGDiffusionApply2D(const int NF,
+                          const Array<double> &b,
+                          const Array<double> &g,
+                          const Vector &_op,
+                          const double a_jf,
+                          const double a_fj,
+                          const Vector &_x,
+                          const Vector &_dxdn,
+                          Vector &_y,
+                          Vector &_dydn,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   // Number of sides stored in the face E-vectors
+   const int NS = _x.Size()/(D1D*NF);
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, 5, NF);
+   auto x = Reshape(_x.Read(), D1D, NS, NF);
+   auto dxdn = Reshape(_dxdn.Read(), D1D, NS, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, NS, NF);
+   auto dydn = Reshape(_dydn.ReadWrite(), D1D, NS, NF);
+
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // values, tangential and normal derivatives at the quadrature points
+      double u[2][max_Q1D], ut[2][max_Q1D], un[2][max_Q1D];
+      for (int s = 0; s < 2; ++s)
+      {
+         for (int q = 0; q < Q1D; ++q)
+         {
+            u[s][q] = ut[s][q] = un[s][q] = 0.0;
+            if (s >= NS) { continue; }
+            for (int d = 0; d < D1D; ++d)
+            {
+               u[s][q] += B(q,d)*x(d,s,f);
+               ut[s][q] += G(q,d)*x(d,s,f);
+               un[s][q] += B(q,d)*dxdn(d,s,f);
+            }
+         }
+      }
+      for (int q = 0; q < Q1D; ++q)
+      {
+         const double flux = op(q,0,f)*un[0][q] + op(q,1,f)*ut[0][q] +
+                             op(q,2,f)*un[1][q] + op(q,3,f)*ut[1][q];
+         const double jump = u[0][q] - u[1][q];
+         const double rv = a_jf*flux + op(q,4,f)*jump;
+         const double rf = a_fj*jump;
+         for (int s = 0; s < 2; ++s)
+         {
+            u[s][q] = s ? -rv : rv;
+            un[s][q] = rf*op(q,2*s,f);
+            ut[s][q] = rf*op(q,2*s+1,f);
+         }
+      }
+      for (int s = 0; s < NS; ++s)
+      {
+         for (int d = 0; d < D1D; ++d)
+         {
+            double yv = 0.0, yn = 0.0;
+            for (int q = 0; q < Q1D; ++q)
+            {
+               yv += B(q,d)*u[s][q] + G(q,d)*ut[s][q];
+               yn += B(q,d)*un[s][q];
+            }
+            y(d,s,f) += yv;
+            dydn(d,s,f) += yn;
+         }
+      }
+   });
+}
+
+// PA DGDiffusion Apply 3D kernel for Gauss-Lobatto/Bernstein, see
+// PADGDiffusionApply2D.
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADGDiffusionApply3D(const int NF,
+                          const Array<double> &b,
+                          const Array<double> &g,
+                          const Vector &_op,
+                          const double a_jf,
+                          const double a_fj,
+                          const Vector &_x,
+                          const Vector &_dxdn,
+                          Vector &_y,
+                          Vector &_dydn,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   // Number of sides stored in the face E-vectors
+   const int NS = _x.Size()/(D1D*D1D*NF);
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 7, NF);
+   auto x = Reshape(_x.Read(), D1D, D1D, NS, NF);
+   auto dxdn = Reshape(_dxdn.Read(), D1D, D1D, NS, NF);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, NS, NF);
+   auto dydn = Reshape(_dydn.ReadWrite(), D1D, D1D, NS, NF);
+
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // values, tangential and normal derivatives at the quadrature points
+      double u[2][max_Q1D][max_Q1D];
+      double ut1[2][max_Q1D][max_Q1D];
+      double ut2[2][max_Q1D][max_Q1D];
+      double un[2][max_Q1D][max_Q1D];
+      for (int s = 0; s < 2; ++s)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               u[s][qy][qx] = ut1[s][qy][qx] = ut2[s][qy][qx] = 0.0;
+               un[s][qy][qx] = 0.0;
+            }
+         }
+         if (s >= NS) { continue; }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double Bu[max_Q1D], Gu[max_Q1D], Bn[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Bu[qx] = Gu[qx] = Bn[qx] = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Bu[qx] += B(qx,dx)*x(dx,dy,s,f);
+                  Gu[qx] += G(qx,dx)*x(dx,dy,s,f);
+                  Bn[qx] += B(qx,dx)*dxdn(dx,dy,s,f);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double by = B(qy,dy), gy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u[s][qy][qx] += by*Bu[qx];
+                  ut1[s][qy][qx] += by*Gu[qx];
+                  ut2[s][qy][qx] += gy*Bu[qx];
+                  un[s][qy][qx] += by*Bn[qx];
+               }
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double flux = 0.0;
+            for (int s = 0; s < 2; ++s)
+            {
+               flux += op(qx,qy,3*s,f)*un[s][qy][qx] +
+                       op(qx,qy,3*s+1,f)*ut1[s][qy][qx] +
+                       op(qx,qy,3*s+2,f)*ut2[s][qy][qx];
+            }
+            const double jump = u[0][qy][qx] - u[1][qy][qx];
+            const double rv = a_jf*flux + op(qx,qy,6,f)*jump;
+            const double rf = a_fj*jump;
+            for (int s = 0; s < 2; ++s)
+            {
+               u[s][qy][qx] = s ? -rv : rv;
+               un[s][qy][qx] = rf*op(qx,qy,3*s,f);
+               ut1[s][qy][qx] = rf*op(qx,qy,3*s+1,f);
+               ut2[s][qy][qx] = rf*op(qx,qy,3*s+2,f);
+            }
+         }
+      }
+      for (int s = 0; s < NS; ++s)
+      {
+         double Bv[max_D1D][max_Q1D], Gv[max_D1D][max_Q1D];
+         double Bn[max_D1D][max_Q1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Bv[dy][qx] = Gv[dy][qx] = Bn[dy][qx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double by = B(qy,dy), gy = G(qy,dy);
+                  Bv[dy][qx] += by*u[s][qy][qx] + gy*ut2[s][qy][qx];
+                  Gv[dy][qx] += by*ut1[s][qy][qx];
+                  Bn[dy][qx] += by*un[s][qy][qx];
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double yv = 0.0, yn = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  yv += B(qx,dx)*Bv[dy][qx] + G(qx,dx)*Gv[dy][qx];
+                  yn += B(qx,dx)*Bn[dy][qx];
+               }
+               y(dx,dy,s,f) += yv;
+               dydn(dx,dy,s,f) += yn;
+            }
+         }
+      }
+   });
+}
+
+static void PADGDiffusionApply(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NF,
+                               const Array<double> &B,
+                               const Array<double> &G,
+                               const Vector &op,
+                               const double a_jf,
+                               const double a_fj,
+                               const Vector &x,
+                               const Vector &dxdn,
+                               Vector &y,
+                               Vector &dydn)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return PADGDiffusionApply2D<2,2>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         case 0x33:
+            return PADGDiffusionApply2D<3,3>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         case 0x44:
+            return PADGDiffusionApply2D<4,4>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         case 0x55:
+            return PADGDiffusionApply2D<5,5>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         default:
+            return PADGDiffusionApply2D(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn,
+                                        D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return PADGDiffusionApply3D<2,2>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         case 0x33:
+            return PADGDiffusionApply3D<3,3>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         case 0x44:
+            return PADGDiffusionApply3D<4,4>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         case 0x55:
+            return PADGDiffusionApply3D<5,5>(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn);
+         default:
+            return PADGDiffusionApply3D(NF,B,G,op,a_jf,a_fj,x,dxdn,y,dydn,
+                                        D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DGDiffusionIntegrator::AddMultPAFaceNormalDerivatives(
+   const Vector &x, const Vector &dxdn, Vector &y, Vector &dydn) const
+{
+   if (nf == 0) { return; }
+   PADGDiffusionApply(dim, dofs1D, quad1D, nf, maps->B, maps->G, pa_data,
+                      -1.0, sigma, x, dxdn, y, dydn);
+}
+
+void DGDiffusionIntegrator::AddMultTransposePAFaceNormalDerivatives(
+   const Vector &x, const Vector &dxdn, Vector &y, Vector &dydn) const
+{
+   if (nf == 0) { return; }
+   PADGDiffusionApply(dim, dofs1D, quad1D, nf, maps->B, maps->G, pa_data,
+                      sigma, -1.0, x, dxdn, y, dydn);
+}
+
+} // namespace mfem
@@ -355,6 +355,8 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    fespace = &fes;
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
+   simplex = !UsesTensorBasis(fes);
+   if (simplex) { return AssemblePASimplex(fes); }
    const FiniteElement &el = *fes.GetFE(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
    if (DeviceCanUseCeed())
@@ -916,7 +918,11 @@ static void PADiffusionAssembleDiagonal(const int dim,
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
-   if (DeviceCanUseCeed())
+   if (simplex)
+   {
+      AssembleDiagonalPASimplex(diag);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAssembleDiagonal(ceedDataPtr, diag);
    }
@@ -1040,6 +1046,7 @@ static void PADiffusionApply2D(const int NE,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
+                               const ElementGather &gather,
                                const int d1d = 0,
                                const int q1d = 0)
 {
@@ -1054,8 +1061,9 @@ static void PADiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, gather.Size(NE),
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -1081,7 +1089,8 @@ static void PADiffusionApply2D(const int NE,
          }
          for (int dx = 0; dx < D1D; ++dx)
          {
-            const double s = X(dx,dy,e);
+            const double s = gather.Fused() ? gather.Gather(X, e, dx + D1D*dy) :
+                             X(dx,dy,e);
             for (int qx = 0; qx < Q1D; ++qx)
             {
                gradX[qx][0] += s * B(qx,dx);
@@ -1144,7 +1153,9 @@ static void PADiffusionApply2D(const int NE,
             const double wDy = Gt(dy,qy);
             for (int dx = 0; dx < D1D; ++dx)
             {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               const double val = ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               if (gather.Fused()) { gather.Scatter(Y, e, dx + D1D*dy, val); }
+               else { Y(dx,dy,e) += val; }
             }
          }
       }
@@ -1160,6 +1171,7 @@ static void SmemPADiffusionApply2D(const int NE,
                                    const Vector &d_,
                                    const Vector &x_,
                                    Vector &y_,
+                                   const ElementGather &gather,
                                    const int d1d = 0,
                                    const int q1d = 0)
 {
@@ -1175,8 +1187,9 @@ static void SmemPADiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_FORALL_2D(i, gather.Size(NE), Q1D, Q1D, NBZ,
    {
+      const int e = gather.Element(i);
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1200,7 +1213,8 @@ static void SmemPADiffusionApply2D(const int NE,
       {
          MFEM_FOREACH_THREAD(dx,x,D1D)
          {
-            X[dy][dx] = x(dx,dy,e);
+            X[dy][dx] = gather.Fused() ? gather.Gather(x, e, dx + D1D*dy) :
+                        x(dx,dy,e);
          }
       }
       if (tidz == 0)
@@ -1303,7 +1317,9 @@ static void SmemPADiffusionApply2D(const int NE,
                u += DQ0[qy][dx] * Bt[dy][qy];
                v += DQ1[qy][dx] * Gt[dy][qy];
             }
-            Y(dx,dy,e) += (u + v);
+            const double val = (u + v);
+            if (gather.Fused()) { gather.Scatter(Y, e, dx + D1D*dy, val); }
+            else { Y(dx,dy,e) += val; }
          }
       }
    });
@@ -1320,6 +1336,7 @@ static void PADiffusionApply3D(const int NE,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
+                               const ElementGather &gather,
                                int d1d = 0, int q1d = 0)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
@@ -1333,8 +1350,9 @@ static void PADiffusionApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, gather.Size(NE),
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -1374,7 +1392,9 @@ static void PADiffusionApply3D(const int NE,
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double s = X(dx,dy,dz,e);
+               const double s = gather.Fused() ?
+                                gather.Gather(X, e, dx + D1D*(dy + D1D*dz)) :
+                                X(dx,dy,dz,e);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   gradX[qx][0] += s * B(qx,dx);
@@ -1491,10 +1511,15 @@ static void PADiffusionApply3D(const int NE,
             {
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  Y(dx,dy,dz,e) +=
+                  const double val =
                      ((gradXY[dy][dx][0] * wz) +
                       (gradXY[dy][dx][1] * wz) +
                       (gradXY[dy][dx][2] * wDz));
+                  if (gather.Fused())
+                  {
+                     gather.Scatter(Y, e, dx + D1D*(dy + D1D*dz), val);
+                  }
+                  else { Y(dx,dy,dz,e) += val; }
                }
             }
          }
@@ -1537,6 +1562,7 @@ static void SmemPADiffusionApply3D(const int NE,
                                    const Vector &d_,
                                    const Vector &x_,
                                    Vector &y_,
+                                   const ElementGather &gather,
                                    const int d1d = 0,
                                    const int q1d = 0)
 {
@@ -1551,8 +1577,9 @@ static void SmemPADiffusionApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, symmetric ? 6 : 9, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   MFEM_FORALL_3D(i, gather.Size(NE), Q1D, Q1D, 1,
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
@@ -1587,7 +1614,9 @@ static void SmemPADiffusionApply3D(const int NE,
             MFEM_UNROLL(MD1)
             for (int dz = 0; dz < D1D; ++dz)
             {
-               X[dz][dy][dx] = x(dx,dy,dz,e);
+               X[dz][dy][dx] = gather.Fused() ?
+                               gather.Gather(x, e, dx + D1D*(dy + D1D*dz)) :
+                               x(dx,dy,dz,e);
             }
          }
          MFEM_FOREACH_THREAD(qx,x,Q1D)
@@ -1816,7 +1845,353 @@ static void SmemPADiffusionApply3D(const int NE,
             MFEM_UNROLL(MD1)
             for (int dz = 0; dz < D1D; ++dz)
             {
-               y(dx,dy,dz,e) += (u[dz] + v[dz] + w[dz]);
+               const double val = (u[dz] + v[dz] + w[dz]);
+               if (gather.Fused())
+               {
+                  gather.Scatter(y, e, dx + D1D*(dy + D1D*dz), val);
+               }
+               else { y(dx,dy,dz,e) += val; }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyBatched2D(const int NE,
+                                      const int NV,
+                                      const bool symmetric,
+                                      const Array<double> &b_,
+                                      const Array<double> &g_,
+                                      const Array<double> &bt_,
+                                      const Array<double> &gt_,
+                                      const Vector &d_,
+                                      const Vector &x_,
+                                      Vector &y_,
+                                      const int d1d = 0,
+                                      const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // read the quadrature data of the element once for all vectors
+      const int ND = symmetric ? 3 : 4;
+      double Dq[max_Q1D*max_Q1D][4];
+      for (int q = 0; q < Q1D*Q1D; ++q)
+      {
+         for (int c = 0; c < ND; ++c)
+         {
+            Dq[q][c] = D(q,c,e);
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         double grad[max_Q1D][max_Q1D][2];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][0] = 0.0;
+               grad[qy][qx][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,e,v);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+         // Calculate Dxy, xDy in plane
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + qy * Q1D;
+
+               const double O11 = Dq[q][0];
+               const double O21 = Dq[q][1];
+               const double O12 = symmetric ? O21 : Dq[q][2];
+               const double O22 = symmetric ? Dq[q][2] : Dq[q][3];
+
+               const double gradX = grad[qy][qx][0];
+               const double gradY = grad[qy][qx][1];
+
+               grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+               grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0;
+               gradX[dx][1] = 0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][0];
+               const double gY = grad[qy][qx][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,e,v) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyBatched3D(const int NE,
+                                      const int NV,
+                                      const bool symmetric,
+                                      const Array<double> &b,
+                                      const Array<double> &g,
+                                      const Array<double> &bt,
+                                      const Array<double> &gt,
+                                      const Vector &d_,
+                                      const Vector &x_,
+                                      Vector &y_,
+                                      int d1d = 0, int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // read the quadrature data of the element once for all vectors
+      const int ND = symmetric ? 6 : 9;
+      double Dq[max_Q1D*max_Q1D*max_Q1D][9];
+      for (int q = 0; q < Q1D*Q1D*Q1D; ++q)
+      {
+         for (int c = 0; c < ND; ++c)
+         {
+            Dq[q][c] = D(q,c,e);
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         double grad[max_Q1D][max_Q1D][max_Q1D][3];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] = 0.0;
+                  grad[qz][qy][qx][1] = 0.0;
+                  grad[qz][qy][qx][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx,dy,dz,e,v);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+         // Calculate Dxyz, xDyz, xyDz in plane
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const int q = qx + (qy + qz * Q1D) * Q1D;
+                  const double O11 = Dq[q][0];
+                  const double O12 = Dq[q][1];
+                  const double O13 = Dq[q][2];
+                  const double O21 = symmetric ? O12 : Dq[q][3];
+                  const double O22 = symmetric ? Dq[q][3] : Dq[q][4];
+                  const double O23 = symmetric ? Dq[q][4] : Dq[q][5];
+                  const double O31 = symmetric ? O13 : Dq[q][6];
+                  const double O32 = symmetric ? O23 : Dq[q][7];
+                  const double O33 = symmetric ? Dq[q][5] : Dq[q][8];
+                  const double gradX = grad[qz][qy][qx][0];
+                  const double gradY = grad[qz][qy][qx][1];
+                  const double gradZ = grad[qz][qy][qx][2];
+                  grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+                  grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
+                  grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0;
+                  gradXY[dy][dx][1] = 0;
+                  gradXY[dy][dx][2] = 0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0;
+                  gradX[dx][1] = 0;
+                  gradX[dx][2] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][0];
+                  const double gY = grad[qz][qy][qx][1];
+                  const double gZ = grad[qz][qy][qx][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,e,v) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
             }
          }
       }
@@ -1834,10 +2209,11 @@ static void PADiffusionApply(const int dim,
                              const Array<double> &Gt,
                              const Vector &D,
                              const Vector &X,
-                             Vector &Y)
+                             Vector &Y,
+                             const ElementGather &EG = ElementGather())
 {
 #ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   if (DeviceCanUseOcca() && !EG.Fused())
    {
       if (dim == 2)
       {
@@ -1858,15 +2234,16 @@ static void PADiffusionApply(const int dim,
    {
       switch (ID)
       {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,symm,B,G,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,symm,B,G,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,symm,B,G,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,symm,B,G,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,symm,B,G,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,symm,B,G,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,symm,B,G,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,symm,B,G,D,X,Y,EG);
+         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,symm,B,G,D,X,Y,EG);
+         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,symm,B,G,D,X,Y,EG);
+         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,symm,B,G,D,X,Y,EG);
+         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,symm,B,G,D,X,Y,EG);
+         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,symm,B,G,D,X,Y,EG);
+         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,symm,B,G,D,X,Y,EG);
+         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,symm,B,G,D,X,Y,EG);
+         default:
+            return PADiffusionApply2D(NE,symm,B,G,Bt,Gt,D,X,Y,EG,D1D,Q1D);
       }
    }
 
@@ -1874,16 +2251,17 @@ static void PADiffusionApply(const int dim,
    {
       switch (ID)
       {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,symm,B,G,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,symm,B,G,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,symm,B,G,D,X,Y);
-         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,symm,B,G,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,symm,B,G,D,X,Y);
-         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,symm,B,G,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,symm,B,G,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,symm,B,G,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,symm,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,symm,B,G,D,X,Y,EG);
+         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,symm,B,G,D,X,Y,EG);
+         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,symm,B,G,D,X,Y,EG);
+         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,symm,B,G,D,X,Y,EG);
+         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,symm,B,G,D,X,Y,EG);
+         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,symm,B,G,D,X,Y,EG);
+         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,symm,B,G,D,X,Y,EG);
+         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,symm,B,G,D,X,Y,EG);
+         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,symm,B,G,D,X,Y,EG);
+         default:
+            return PADiffusionApply3D(NE,symm,B,G,Bt,Gt,D,X,Y,EG,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1892,7 +2270,11 @@ static void PADiffusionApply(const int dim,
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   if (DeviceCanUseCeed())
+   if (simplex)
+   {
+      AddMultPASimplex(x, y);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAddMult(ceedDataPtr, x, y);
    }
@@ -1904,4 +2286,605 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void DiffusionIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                         const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(!simplex, "fused action is not supported on simplices");
+   for (int g = 0; g < R.GetNumElementGroups(); g++)
+   {
+      PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
+                       maps->B, maps->G, maps->Bt, maps->Gt,
+                       pa_data, x, y, R.GetElementGather(g));
+   }
+}
+
+// Returns false if there is no batched kernel for the given sizes
+static bool PADiffusionApplyBatched(const int dim,
+                                    const int D1D,
+                                    const int Q1D,
+                                    const int NE,
+                                    const int NV,
+                                    const bool symm,
+                                    const Array<double> &B,
+                                    const Array<double> &G,
+                                    const Array<double> &Bt,
+                                    const Array<double> &Gt,
+                                    const Vector &D,
+                                    const Vector &X,
+                                    Vector &Y)
+{
+   const int ID = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (ID)
+      {
+         case 0x22:
+            PADiffusionApplyBatched2D<2,2>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x33:
+            PADiffusionApplyBatched2D<3,3>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x44:
+            PADiffusionApplyBatched2D<4,4>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x55:
+            PADiffusionApplyBatched2D<5,5>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x66:
+            PADiffusionApplyBatched2D<6,6>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x77:
+            PADiffusionApplyBatched2D<7,7>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x88:
+            PADiffusionApplyBatched2D<8,8>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x99:
+            PADiffusionApplyBatched2D<9,9>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         default:
+            PADiffusionApplyBatched2D(NE,NV,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+      }
+      return true;
+   }
+   if (dim == 3)
+   {
+      // The generic 3D kernel would need too much local storage for the
+      // quadrature data, so only the specialized kernels are used.
+      switch (ID)
+      {
+         case 0x23:
+            PADiffusionApplyBatched3D<2,3>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x34:
+            PADiffusionApplyBatched3D<3,4>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x45:
+            PADiffusionApplyBatched3D<4,5>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x46:
+            PADiffusionApplyBatched3D<4,6>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x56:
+            PADiffusionApplyBatched3D<5,6>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x58:
+            PADiffusionApplyBatched3D<5,8>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x67:
+            PADiffusionApplyBatched3D<6,7>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x78:
+            PADiffusionApplyBatched3D<7,8>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         case 0x89:
+            PADiffusionApplyBatched3D<8,9>(NE,NV,symm,B,G,Bt,Gt,D,X,Y);
+            break;
+         default: return false;
+      }
+      return true;
+   }
+   return false;
+}
+
+void DiffusionIntegrator::AddMultBatchedPA(const int nvec, const Vector &x,
+                                           Vector &y) const
+{
+   if (DeviceCanUseCeed() || simplex ||
+       !PADiffusionApplyBatched(dim, dofs1D, quad1D, ne, nvec, symmetric,
+                                maps->B, maps->G, maps->Bt, maps->Gt,
+                                pa_data, x, y))
+   {
+      BilinearFormIntegrator::AddMultBatchedPA(nvec, x, y);
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyComplex2D(const int NE,
+                                      const bool symm_r,
+                                      const bool symm_i,
+                                      const Array<double> &b_,
+                                      const Array<double> &g_,
+                                      const Array<double> &bt_,
+                                      const Array<double> &gt_,
+                                      const Vector &dr_,
+                                      const Vector &di_,
+                                      const Vector &x_,
+                                      Vector &y_,
+                                      const int d1d = 0,
+                                      const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto Dr = Reshape(dr_.Read(), Q1D*Q1D, symm_r ? 3 : 4, NE);
+   auto Di = Reshape(di_.Read(), Q1D*Q1D, symm_i ? 3 : 4, NE);
+   auto X = Reshape(x_.Read(), 2, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), 2, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // grad[qy][qx][d][c]: component d of the gradient, real (c = 0) and
+      // imaginary (c = 1) parts
+      double grad[max_Q1D][max_Q1D][2][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               grad[qy][qx][0][c] = 0.0;
+               grad[qy][qx][1][c] = 0.0;
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[max_Q1D][2][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               gradX[qx][0][c] = 0.0;
+               gradX[qx][1][c] = 0.0;
+            }
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               const double s = X(c,dx,dy,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0][c] += s * B(qx,dx);
+                  gradX[qx][1][c] += s * G(qx,dx);
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  grad[qy][qx][0][c] += gradX[qx][1][c] * wy;
+                  grad[qy][qx][1][c] += gradX[qx][0][c] * wDy;
+               }
+            }
+         }
+      }
+      // complex product with the quadrature data, (D_r + i D_i) grad(u)
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double O[2][2][2]; // O[c][i][j]
+            O[0][0][0] = Dr(q,0,e);
+            O[0][1][0] = Dr(q,1,e);
+            O[0][0][1] = symm_r ? Dr(q,1,e) : Dr(q,2,e);
+            O[0][1][1] = symm_r ? Dr(q,2,e) : Dr(q,3,e);
+            O[1][0][0] = Di(q,0,e);
+            O[1][1][0] = Di(q,1,e);
+            O[1][0][1] = symm_i ? Di(q,1,e) : Di(q,2,e);
+            O[1][1][1] = symm_i ? Di(q,2,e) : Di(q,3,e);
+            double g[2][2];
+            for (int i = 0; i < 2; ++i)
+            {
+               g[i][0] = grad[qy][qx][i][0];
+               g[i][1] = grad[qy][qx][i][1];
+            }
+            for (int i = 0; i < 2; ++i)
+            {
+               double re = 0.0, im = 0.0;
+               for (int j = 0; j < 2; ++j)
+               {
+                  re += O[0][i][j] * g[j][0] - O[1][i][j] * g[j][1];
+                  im += O[1][i][j] * g[j][0] + O[0][i][j] * g[j][1];
+               }
+               grad[qy][qx][i][0] = re;
+               grad[qy][qx][i][1] = im;
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[max_D1D][2][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               gradX[dx][0][c] = 0.0;
+               gradX[dx][1][c] = 0.0;
+            }
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int c = 0; c < 2; ++c)
+            {
+               const double gX = grad[qy][qx][0][c];
+               const double gY = grad[qy][qx][1][c];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0][c] += gX * Gt(dx,qx);
+                  gradX[dx][1][c] += gY * Bt(dx,qx);
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  Y(c,dx,dy,e) += gradX[dx][0][c] * wy + gradX[dx][1][c] * wDy;
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PADiffusionApplyComplex3D(const int NE,
+                                      const bool symm_r,
+                                      const bool symm_i,
+                                      const Array<double> &b_,
+                                      const Array<double> &g_,
+                                      const Array<double> &bt_,
+                                      const Array<double> &gt_,
+                                      const Vector &dr_,
+                                      const Vector &di_,
+                                      const Vector &x_,
+                                      Vector &y_,
+                                      const int d1d = 0,
+                                      const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto Dr = Reshape(dr_.Read(), Q1D*Q1D*Q1D, symm_r ? 6 : 9, NE);
+   auto Di = Reshape(di_.Read(), Q1D*Q1D*Q1D, symm_i ? 6 : 9, NE);
+   auto X = Reshape(x_.Read(), 2, D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), 2, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // grad[qz][qy][qx][d][c]: component d of the gradient, real (c = 0) and
+      // imaginary (c = 1) parts
+      double grad[max_Q1D][max_Q1D][max_Q1D][3][2];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int d = 0; d < 3; ++d)
+               {
+                  grad[qz][qy][qx][d][0] = 0.0;
+                  grad[qz][qy][qx][d][1] = 0.0;
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double gradXY[max_Q1D][max_Q1D][3][2];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int d = 0; d < 3; ++d)
+               {
+                  gradXY[qy][qx][d][0] = 0.0;
+                  gradXY[qy][qx][d][1] = 0.0;
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  gradX[qx][0][c] = 0.0;
+                  gradX[qx][1][c] = 0.0;
+               }
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  const double s = X(c,dx,dy,dz,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0][c] += s * B(qx,dx);
+                     gradX[qx][1][c] += s * G(qx,dx);
+                  }
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int c = 0; c < 2; ++c)
+                  {
+                     const double wx  = gradX[qx][0][c];
+                     const double wDx = gradX[qx][1][c];
+                     gradXY[qy][qx][0][c] += wDx * wy;
+                     gradXY[qy][qx][1][c] += wx  * wDy;
+                     gradXY[qy][qx][2][c] += wx  * wy;
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = B(qz,dz);
+            const double wDz = G(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int c = 0; c < 2; ++c)
+                  {
+                     grad[qz][qy][qx][0][c] += gradXY[qy][qx][0][c] * wz;
+                     grad[qz][qy][qx][1][c] += gradXY[qy][qx][1][c] * wz;
+                     grad[qz][qy][qx][2][c] += gradXY[qy][qx][2][c] * wDz;
+                  }
+               }
+            }
+         }
+      }
+      // complex product with the quadrature data, (D_r + i D_i) grad(u)
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double O[2][3][3]; // O[c][i][j]
+               for (int c = 0; c < 2; ++c)
+               {
+                  const bool symm = c ? symm_i : symm_r;
+                  const auto &D = c ? Di : Dr;
+                  O[c][0][0] = D(q,0,e);
+                  O[c][0][1] = D(q,1,e);
+                  O[c][0][2] = D(q,2,e);
+                  O[c][1][0] = symm ? D(q,1,e) : D(q,3,e);
+                  O[c][1][1] = symm ? D(q,3,e) : D(q,4,e);
+                  O[c][1][2] = symm ? D(q,4,e) : D(q,5,e);
+                  O[c][2][0] = symm ? D(q,2,e) : D(q,6,e);
+                  O[c][2][1] = symm ? D(q,4,e) : D(q,7,e);
+                  O[c][2][2] = symm ? D(q,5,e) : D(q,8,e);
+               }
+               double g[3][2];
+               for (int i = 0; i < 3; ++i)
+               {
+                  g[i][0] = grad[qz][qy][qx][i][0];
+                  g[i][1] = grad[qz][qy][qx][i][1];
+               }
+               for (int i = 0; i < 3; ++i)
+               {
+                  double re = 0.0, im = 0.0;
+                  for (int j = 0; j < 3; ++j)
+                  {
+                     re += O[0][i][j] * g[j][0] - O[1][i][j] * g[j][1];
+                     im += O[1][i][j] * g[j][0] + O[0][i][j] * g[j][1];
+                  }
+                  grad[qz][qy][qx][i][0] = re;
+                  grad[qz][qy][qx][i][1] = im;
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double gradXY[max_D1D][max_D1D][3][2];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int d = 0; d < 3; ++d)
+               {
+                  gradXY[dy][dx][d][0] = 0.0;
+                  gradXY[dy][dx][d][1] = 0.0;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][3][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int d = 0; d < 3; ++d)
+               {
+                  gradX[dx][d][0] = 0.0;
+                  gradX[dx][d][1] = 0.0;
+               }
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int c = 0; c < 2; ++c)
+               {
+                  const double gX = grad[qz][qy][qx][0][c];
+                  const double gY = grad[qz][qy][qx][1][c];
+                  const double gZ = grad[qz][qy][qx][2][c];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0][c] += gX * wDx;
+                     gradX[dx][1][c] += gY * wx;
+                     gradX[dx][2][c] += gZ * wx;
+                  }
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  for (int c = 0; c < 2; ++c)
+                  {
+                     gradXY[dy][dx][0][c] += gradX[dx][0][c] * wy;
+                     gradXY[dy][dx][1][c] += gradX[dx][1][c] * wDy;
+                     gradXY[dy][dx][2][c] += gradX[dx][2][c] * wy;
+                  }
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  for (int c = 0; c < 2; ++c)
+                  {
+                     Y(c,dx,dy,dz,e) +=
+                        ((gradXY[dy][dx][0][c] * wz) +
+                         (gradXY[dy][dx][1][c] * wz) +
+                         (gradXY[dy][dx][2][c] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Returns false if there is no fused complex kernel for the given dimension
+static bool PADiffusionApplyComplex(const int dim,
+                                    const int D1D,
+                                    const int Q1D,
+                                    const int NE,
+                                    const bool symm_r,
+                                    const bool symm_i,
+                                    const Array<double> &B,
+                                    const Array<double> &G,
+                                    const Array<double> &Bt,
+                                    const Array<double> &Gt,
+                                    const Vector &Dr,
+                                    const Vector &Di,
+                                    const Vector &X,
+                                    Vector &Y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22:
+            PADiffusionApplyComplex2D<2,2>(NE,symm_r,symm_i,B,G,Bt,Gt,
+                                           Dr,Di,X,Y);
+            break;
+         case 0x33:
+            PADiffusionApplyComplex2D<3,3>(NE,symm_r,symm_i,B,G,Bt,Gt,
+                                           Dr,Di,X,Y);
+            break;
+         case 0x44:
+            PADiffusionApplyComplex2D<4,4>(NE,symm_r,symm_i,B,G,Bt,Gt,
+                                           Dr,Di,X,Y);
+            break;
+         default:
+            PADiffusionApplyComplex2D(NE,symm_r,symm_i,B,G,Bt,Gt,Dr,Di,X,Y,
+                                      D1D,Q1D);
+            break;
+      }
+      return true;
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23:
+            PADiffusionApplyComplex3D<2,3>(NE,symm_r,symm_i,B,G,Bt,Gt,
+                                           Dr,Di,X,Y);
+            break;
+         case 0x34:
+            PADiffusionApplyComplex3D<3,4>(NE,symm_r,symm_i,B,G,Bt,Gt,
+                                           Dr,Di,X,Y);
+            break;
+         case 0x45:
+            PADiffusionApplyComplex3D<4,5>(NE,symm_r,symm_i,B,G,Bt,Gt,
+                                           Dr,Di,X,Y);
+            break;
+         default:
+            PADiffusionApplyComplex3D(NE,symm_r,symm_i,B,G,Bt,Gt,Dr,Di,X,Y,
+                                      D1D,Q1D);
+            break;
+      }
+      return true;
+   }
+   return false;
+}
+
+void DiffusionIntegrator::AddMultComplexPA(const BilinearFormIntegrator &imag,
+                                           const Vector &x, Vector &y) const
+{
+   const DiffusionIntegrator *di =
+      dynamic_cast<const DiffusionIntegrator*>(&imag);
+   const bool fused = !DeviceCanUseCeed() && !simplex && di &&
+                      di->maps == maps && di->ne == ne &&
+                      di->quad1D == quad1D;
+   if (!fused ||
+       !PADiffusionApplyComplex(dim, dofs1D, quad1D, ne, symmetric,
+                                di->symmetric, maps->B, maps->G, maps->Bt,
+                                maps->Gt, pa_data, di->pa_data, x, y))
+   {
+      BilinearFormIntegrator::AddMultComplexPA(imag, x, y);
+   }
+}
+
 } // namespace mfem
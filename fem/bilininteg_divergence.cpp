@@ -25,11 +25,13 @@ static void PADivergenceSetup2D(const int Q1D,
                                 const int NE,
                                 const Array<double> &w,
                                 const Vector &j,
-                                const double COEFF,
+                                const Vector &c,
                                 Vector &op)
 {
    const int NQ = Q1D*Q1D;
    auto W = w.Read();
+   const bool const_c = c.Size() == 1;
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
    auto y = Reshape(op.Write(), NQ, 2, 2, NE);
 
@@ -37,6 +39,7 @@ static void PADivergenceSetup2D(const int Q1D,
    {
       for (int q = 0; q < NQ; ++q)
       {
+         const double COEFF = const_c ? C(0,0) : C(q,e);
          const double J11 = J(q,0,0,e);
          const double J12 = J(q,0,1,e);
          const double J21 = J(q,1,0,e);
@@ -55,17 +58,20 @@ static void PADivergenceSetup3D(const int Q1D,
                                 const int NE,
                                 const Array<double> &w,
                                 const Vector &j,
-                                const double COEFF,
+                                const Vector &c,
                                 Vector &op)
 {
    const int NQ = Q1D*Q1D*Q1D;
    auto W = w.Read();
+   const bool const_c = c.Size() == 1;
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
    auto y = Reshape(op.Write(), NQ, 3, 3, NE);
    MFEM_FORALL(e, NE,
    {
       for (int q = 0; q < NQ; ++q)
       {
+         const double COEFF = const_c ? C(0,0) : C(q,e);
          const double J11 = J(q,0,0,e);
          const double J21 = J(q,1,0,e);
          const double J31 = J(q,2,0,e);
@@ -107,7 +113,7 @@ static void PADivergenceSetup(const int dim,
                               const int NE,
                               const Array<double> &W,
                               const Vector &J,
-                              const double COEFF,
+                              const Vector &COEFF,
                               Vector &op)
 {
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PADivergenceSetup"); }
@@ -121,8 +127,8 @@ static void PADivergenceSetup(const int dim,
    }
 }
 
-void VectorDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
-                                            const FiniteElementSpace &test_fes)
+void VectorDivergenceIntegrator::SetupPA(const FiniteElementSpace &trial_fes,
+                                         const FiniteElementSpace &test_fes)
 {
    // Assumes tensor-product elements ordered by nodes
    MFEM_ASSERT(trial_fes.GetOrdering() == Ordering::byNODES,
@@ -131,11 +137,8 @@ void VectorDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    const FiniteElement &trial_fe = *trial_fes.GetFE(0);
    const FiniteElement &test_fe = *test_fes.GetFE(0);
    ElementTransformation *trans = mesh->GetElementTransformation(0);
-   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(trial_fe, test_fe,
-                                                            *trans);
-   const int dims = trial_fe.GetDim();
-   const int dimsToStore = dims * dims;
-   const int nq = ir->GetNPoints();
+   ir = IntRule ? IntRule : &GetRule(trial_fe, test_fe, *trans);
+   nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = trial_fes.GetNE();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
@@ -146,16 +149,50 @@ void VectorDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    test_dofs1D = test_maps->ndof;
    MFEM_ASSERT(quad1D == test_maps->nqpt,
                "PA requires test and trial space to have same number of quadrature points!");
-   pa_data.SetSize(nq * dimsToStore * ne, Device::GetMemoryType());
-   double coeff = 1.0;
-   if (Q)
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
    {
-      ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
-      MFEM_VERIFY(cQ != NULL, "only ConstantCoefficient is supported!");
-      coeff = cQ->constant;
+      coeff.SetSize(nq * ne);
+      auto C = Reshape(coeff.HostWrite(), nq, ne);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation &T = *trial_fes.GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            C(q,e) = Q->Eval(T, ir->IntPoint(q));
+         }
+      }
    }
+}
+
+void VectorDivergenceIntegrator::ComputeQuadratureData(Vector &op) const
+{
+   op.SetSize(nq * dim * dim * ne, Device::GetMemoryType());
    PADivergenceSetup(dim, trial_dofs1D, test_dofs1D, quad1D,
-                     ne, ir->GetWeights(), geom->J, coeff, pa_data);
+                     ne, ir->GetWeights(), geom->J, coeff, op);
+}
+
+void VectorDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
+                                            const FiniteElementSpace &test_fes)
+{
+   SetupPA(trial_fes, test_fes);
+   ComputeQuadratureData(pa_data);
+   coeff.Destroy();
+}
+
+void VectorDivergenceIntegrator::AssembleMF(const FiniteElementSpace &trial_fes,
+                                            const FiniteElementSpace &test_fes)
+{
+   SetupPA(trial_fes, test_fes);
 }
 
 // PA Divergence Apply 2D kernel
@@ -1038,12 +1075,24 @@ static void PADivergenceApply(const int dim,
                               Vector &y,
                               bool transpose=false)
 {
+   // In transpose mode, B and G are the transposed trial basis and gradient
+   // and Bt is the (non-transposed) test basis.
    if (dim == 2)
    {
+      if (transpose)
+      {
+         return PADivergenceApplyTranspose2D(NE,B,G,Bt,op,x,y,
+                                             TR_D1D,TE_D1D,Q1D);
+      }
       return PADivergenceApply2D(NE,B,G,Bt,op,x,y,TR_D1D,TE_D1D,Q1D);
    }
    if (dim == 3)
    {
+      if (transpose)
+      {
+         return PADivergenceApplyTranspose3D(NE,B,G,Bt,op,x,y,
+                                             TR_D1D,TE_D1D,Q1D);
+      }
       return PADivergenceApply3D(NE,B,G,Bt,op,x,y,TR_D1D,TE_D1D,Q1D);
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1066,4 +1115,23 @@ void VectorDivergenceIntegrator::AddMultTransposePA(const Vector &x,
                      true);
 }
 
+void VectorDivergenceIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   PADivergenceApply(dim, trial_dofs1D, test_dofs1D, quad1D, ne,
+                     trial_maps->B, trial_maps->G, test_maps->Bt, op, x, y,
+                     false);
+}
+
+void VectorDivergenceIntegrator::AddMultTransposeMF(const Vector &x,
+                                                    Vector &y) const
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   PADivergenceApply(dim, trial_dofs1D, test_dofs1D, quad1D, ne,
+                     trial_maps->Bt, trial_maps->Gt, test_maps->B, op, x, y,
+                     true);
+}
+
 } // namespace mfem
@@ -0,0 +1,283 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+// Add the contribution of a quadrature point to the dim x dim block of the
+// element matrix coupling the scalar basis functions with physical gradients
+// gi and gj. The block entry (ci,cj) is
+//    lambda gi_ci gj_cj + mu (delta_{ci,cj} gi.gj + gi_cj gj_ci).
+template<int DIM> MFEM_HOST_DEVICE inline
+void EAElasticityAddBlock(const double L, const double M,
+                          const double (&gi)[DIM], const double (&gj)[DIM],
+                          double (&val)[DIM][DIM])
+{
+   double gij = 0.0;
+   for (int k = 0; k < DIM; ++k) { gij += gi[k] * gj[k]; }
+   for (int ci = 0; ci < DIM; ++ci)
+   {
+      for (int cj = 0; cj < DIM; ++cj)
+      {
+         val[ci][cj] += L * gi[ci] * gj[cj] +
+                        M * (gi[cj] * gj[ci] + ((ci == cj) ? gij : 0.0));
+      }
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAElasticityAssemble2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &padata,
+                                   Vector &eadata,
+                                   const bool add,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, 2 + DIM*DIM, NE);
+   auto A = Reshape(eadata.ReadWrite(), D1D, D1D, DIM, D1D, D1D, DIM, NE);
+   MFEM_FORALL_3D(e, NE, D1D, D1D, 1,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      double r_G[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(i1,x,D1D)
+      {
+         MFEM_FOREACH_THREAD(i2,y,D1D)
+         {
+            for (int j1 = 0; j1 < D1D; ++j1)
+            {
+               for (int j2 = 0; j2 < D1D; ++j2)
+               {
+                  double val[DIM][DIM] = {{0.0, 0.0}, {0.0, 0.0}};
+                  for (int k1 = 0; k1 < Q1D; ++k1)
+                  {
+                     for (int k2 = 0; k2 < Q1D; ++k2)
+                     {
+                        // reference gradients
+                        const double ri[DIM] = { r_G[k1][i1] * r_B[k2][i2],
+                                                 r_B[k1][i1] * r_G[k2][i2]
+                                               };
+                        const double rj[DIM] = { r_G[k1][j1] * r_B[k2][j2],
+                                                 r_B[k1][j1] * r_G[k2][j2]
+                                               };
+                        // physical gradients
+                        double gi[DIM], gj[DIM];
+                        for (int k = 0; k < DIM; ++k)
+                        {
+                           gi[k] = 0.0;
+                           gj[k] = 0.0;
+                           for (int r = 0; r < DIM; ++r)
+                           {
+                              const double iJ = D(k1,k2,2+r+DIM*k,e);
+                              gi[k] += ri[r] * iJ;
+                              gj[k] += rj[r] * iJ;
+                           }
+                        }
+                        EAElasticityAddBlock<DIM>(D(k1,k2,0,e), D(k1,k2,1,e),
+                                                  gi, gj, val);
+                     }
+                  }
+                  for (int ci = 0; ci < DIM; ++ci)
+                  {
+                     for (int cj = 0; cj < DIM; ++cj)
+                     {
+                        if (add)
+                        {
+                           A(i1, i2, ci, j1, j2, cj, e) += val[ci][cj];
+                        }
+                        else
+                        {
+                           A(i1, i2, ci, j1, j2, cj, e) = val[ci][cj];
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void EAElasticityAssemble3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &padata,
+                                   Vector &eadata,
+                                   const bool add,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), Q1D, Q1D, Q1D, 2 + DIM*DIM, NE);
+   const int ND = D1D*D1D*D1D;
+   auto A = Reshape(eadata.ReadWrite(), ND, DIM, ND, DIM, NE);
+   MFEM_FORALL_3D(e, NE, D1D, D1D, D1D,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double r_B[MQ1][MD1];
+      double r_G[MQ1][MD1];
+      for (int d = 0; d < D1D; d++)
+      {
+         for (int q = 0; q < Q1D; q++)
+         {
+            r_B[q][d] = B(q,d);
+            r_G[q][d] = G(q,d);
+         }
+      }
+      MFEM_SYNC_THREAD;
+      MFEM_FOREACH_THREAD(i1,x,D1D)
+      {
+         MFEM_FOREACH_THREAD(i2,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(i3,z,D1D)
+            {
+               for (int j1 = 0; j1 < D1D; ++j1)
+               {
+                  for (int j2 = 0; j2 < D1D; ++j2)
+                  {
+                     for (int j3 = 0; j3 < D1D; ++j3)
+                     {
+                        double val[DIM][DIM] = {{0.0, 0.0, 0.0},
+                           {0.0, 0.0, 0.0},
+                           {0.0, 0.0, 0.0}
+                        };
+                        for (int k1 = 0; k1 < Q1D; ++k1)
+                        {
+                           for (int k2 = 0; k2 < Q1D; ++k2)
+                           {
+                              for (int k3 = 0; k3 < Q1D; ++k3)
+                              {
+                                 // reference gradients
+                                 const double ri[DIM] =
+                                 {
+                                    r_G[k1][i1] * r_B[k2][i2] * r_B[k3][i3],
+                                    r_B[k1][i1] * r_G[k2][i2] * r_B[k3][i3],
+                                    r_B[k1][i1] * r_B[k2][i2] * r_G[k3][i3]
+                                 };
+                                 const double rj[DIM] =
+                                 {
+                                    r_G[k1][j1] * r_B[k2][j2] * r_B[k3][j3],
+                                    r_B[k1][j1] * r_G[k2][j2] * r_B[k3][j3],
+                                    r_B[k1][j1] * r_B[k2][j2] * r_G[k3][j3]
+                                 };
+                                 // physical gradients
+                                 double gi[DIM], gj[DIM];
+                                 for (int k = 0; k < DIM; ++k)
+                                 {
+                                    gi[k] = 0.0;
+                                    gj[k] = 0.0;
+                                    for (int r = 0; r < DIM; ++r)
+                                    {
+                                       const double iJ =
+                                          D(k1,k2,k3,2+r+DIM*k,e);
+                                       gi[k] += ri[r] * iJ;
+                                       gj[k] += rj[r] * iJ;
+                                    }
+                                 }
+                                 EAElasticityAddBlock<DIM>(D(k1,k2,k3,0,e),
+                                                           D(k1,k2,k3,1,e),
+                                                           gi, gj, val);
+                              }
+                           }
+                        }
+                        const int i = i1 + D1D*(i2 + D1D*i3);
+                        const int j = j1 + D1D*(j2 + D1D*j3);
+                        for (int ci = 0; ci < DIM; ++ci)
+                        {
+                           for (int cj = 0; cj < DIM; ++cj)
+                           {
+                              if (add)
+                              {
+                                 A(i, ci, j, cj, e) += val[ci][cj];
+                              }
+                              else
+                              {
+                                 A(i, ci, j, cj, e) = val[ci][cj];
+                              }
+                           }
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void ElasticityIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                      Vector &ea_data,
+                                      const bool add)
+{
+   AssemblePA(fes);
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   const Vector &D = pa_data;
+   if (dim == 2)
+   {
+      switch ((dofs1D << 4 ) | quad1D)
+      {
+         case 0x22: return EAElasticityAssemble2D<2,2>(ne,B,G,D,ea_data,add);
+         case 0x33: return EAElasticityAssemble2D<3,3>(ne,B,G,D,ea_data,add);
+         case 0x44: return EAElasticityAssemble2D<4,4>(ne,B,G,D,ea_data,add);
+         default:   return EAElasticityAssemble2D(ne,B,G,D,ea_data,add,
+                                                  dofs1D,quad1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((dofs1D << 4 ) | quad1D)
+      {
+         case 0x23: return EAElasticityAssemble3D<2,3>(ne,B,G,D,ea_data,add);
+         case 0x34: return EAElasticityAssemble3D<3,4>(ne,B,G,D,ea_data,add);
+         default:   return EAElasticityAssemble3D(ne,B,G,D,ea_data,add,
+                                                  dofs1D,quad1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+}
@@ -0,0 +1,777 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Elasticity Integrator
+
+// The PA data at each quadrature point consists of lambda w det(J),
+// mu w det(J) and the entries of J^{-1} in column-major order, i.e. 2+dim*dim
+// values per point.
+
+// PA Elasticity Assemble 2D kernel
+static void PAElasticitySetup2D(const int NQ,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &c,
+                                Vector &op)
+{
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 2, 2, NE);
+   auto C = Reshape(c.Read(), NQ, 2, NE);
+   auto y = Reshape(op.Write(), NQ, 6, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double detJ = (J11*J22)-(J21*J12);
+         const double w_detJ = W[q] * detJ;
+         y(q,0,e) = w_detJ * C(q,0,e); // lambda
+         y(q,1,e) = w_detJ * C(q,1,e); // mu
+         y(q,2,e) =  J22 / detJ; // 1,1
+         y(q,3,e) = -J21 / detJ; // 2,1
+         y(q,4,e) = -J12 / detJ; // 1,2
+         y(q,5,e) =  J11 / detJ; // 2,2
+      }
+   });
+}
+
+// PA Elasticity Assemble 3D kernel
+static void PAElasticitySetup3D(const int NQ,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &c,
+                                Vector &op)
+{
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, 3, 3, NE);
+   auto C = Reshape(c.Read(), NQ, 2, NE);
+   auto y = Reshape(op.Write(), NQ, 11, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J31 = J(q,2,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double J32 = J(q,2,1,e);
+         const double J13 = J(q,0,2,e);
+         const double J23 = J(q,1,2,e);
+         const double J33 = J(q,2,2,e);
+         const double detJ = J11 * (J22 * J33 - J32 * J23) -
+         /* */               J21 * (J12 * J33 - J32 * J13) +
+         /* */               J31 * (J12 * J23 - J22 * J13);
+         const double w_detJ = W[q] * detJ;
+         // adj(J)
+         const double A11 = (J22 * J33) - (J23 * J32);
+         const double A12 = (J32 * J13) - (J12 * J33);
+         const double A13 = (J12 * J23) - (J22 * J13);
+         const double A21 = (J31 * J23) - (J21 * J33);
+         const double A22 = (J11 * J33) - (J13 * J31);
+         const double A23 = (J21 * J13) - (J11 * J23);
+         const double A31 = (J21 * J32) - (J31 * J22);
+         const double A32 = (J31 * J12) - (J11 * J32);
+         const double A33 = (J11 * J22) - (J12 * J21);
+         y(q,0,e) = w_detJ * C(q,0,e); // lambda
+         y(q,1,e) = w_detJ * C(q,1,e); // mu
+         // J^{-1} = adj(J) / det(J)
+         y(q,2,e) = A11 / detJ;
+         y(q,3,e) = A21 / detJ;
+         y(q,4,e) = A31 / detJ;
+         y(q,5,e) = A12 / detJ;
+         y(q,6,e) = A22 / detJ;
+         y(q,7,e) = A32 / detJ;
+         y(q,8,e) = A13 / detJ;
+         y(q,9,e) = A23 / detJ;
+         y(q,10,e) = A33 / detJ;
+      }
+   });
+}
+
+void ElasticityIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   MFEM_VERIFY(dim == 2 || dim == 3, "Dimension not supported.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "The vector dimension must be equal to the mesh dimension.");
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation &T0 = *mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             2 * T0.OrderGrad(&el));
+   const int nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+
+   // Evaluate lambda and mu at the quadrature points
+   Vector coeff(2 * nq * ne);
+   auto C = Reshape(coeff.HostWrite(), nq, 2, ne);
+   for (int e = 0; e < ne; ++e)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      for (int q = 0; q < nq; ++q)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(q);
+         T.SetIntPoint(&ip);
+         const double M = mu->Eval(T, ip);
+         C(q,0,e) = lambda ? lambda->Eval(T, ip) : q_lambda * M;
+         C(q,1,e) = lambda ? M : q_mu * M;
+      }
+   }
+
+   pa_data.SetSize((2 + dim*dim) * nq * ne, Device::GetDeviceMemoryType());
+   const Array<double> &w = ir->GetWeights();
+   if (dim == 2)
+   {
+      PAElasticitySetup2D(nq, ne, w, geom->J, coeff, pa_data);
+   }
+   else
+   {
+      PAElasticitySetup3D(nq, ne, w, geom->J, coeff, pa_data);
+   }
+}
+
+// Replace the reference gradient G of the displacement at a quadrature point,
+// G_cr = d u_c / d xi_r, with the reference stress w det(J) sigma J^{-T}.
+template<int DIM> MFEM_HOST_DEVICE inline
+void PAElasticityStress(const double L, const double M,
+                        const double (&iJ)[DIM][DIM], double (&G)[DIM][DIM])
+{
+   double du[DIM][DIM];
+   double div = 0.0;
+   for (int c = 0; c < DIM; ++c)
+   {
+      for (int k = 0; k < DIM; ++k)
+      {
+         double s = 0.0;
+         for (int r = 0; r < DIM; ++r) { s += G[c][r] * iJ[r][k]; }
+         du[c][k] = s;
+      }
+      div += du[c][c];
+   }
+   for (int c = 0; c < DIM; ++c)
+   {
+      for (int r = 0; r < DIM; ++r)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; ++k)
+         {
+            const double sigma = M * (du[c][k] + du[k][c]) +
+                                 ((c == k) ? L * div : 0.0);
+            s += sigma * iJ[r][k];
+         }
+         G[c][r] = s;
+      }
+   }
+}
+
+// PA Elasticity Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply2D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // Reference gradients of all the components
+      double grad[max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][c][0] = 0.0;
+               grad[qy][qx][c][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][c][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][c][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+      }
+      // Stress at the quadrature points
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double iJ[DIM][DIM];
+            for (int r = 0; r < DIM; ++r)
+            {
+               for (int k = 0; k < DIM; ++k)
+               {
+                  iJ[r][k] = D(q,2+r+DIM*k,e);
+               }
+            }
+            PAElasticityStress<DIM>(D(q,0,e), D(q,1,e), iJ, grad[qy][qx]);
+         }
+      }
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][c][0];
+               const double gY = grad[qy][qx][c][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply3D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // Reference gradients of all the components
+      double grad[max_Q1D][max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][c][0] = 0.0;
+                  grad[qz][qy][qx][c][1] = 0.0;
+                  grad[qz][qy][qx][c][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][c][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][c][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][c][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+      }
+      // Stress at the quadrature points
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double iJ[DIM][DIM];
+               for (int r = 0; r < DIM; ++r)
+               {
+                  for (int k = 0; k < DIM; ++k)
+                  {
+                     iJ[r][k] = D(q,2+r+DIM*k,e);
+                  }
+               }
+               PAElasticityStress<DIM>(D(q,0,e), D(q,1,e), iJ,
+                                       grad[qz][qy][qx]);
+            }
+         }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0.0;
+                  gradXY[dy][dx][1] = 0.0;
+                  gradXY[dy][dx][2] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0.0;
+                  gradX[dx][1] = 0.0;
+                  gradX[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][c][0];
+                  const double gY = grad[qz][qy][qx][c][1];
+                  const double gZ = grad[qz][qy][qx][c][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y(dx,dy,dz,c,e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply kernel
+void ElasticityIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   const int D1D = dofs1D;
+   const int Q1D = quad1D;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   const Array<double> &Bt = maps->Bt;
+   const Array<double> &Gt = maps->Gt;
+   const Vector &D = pa_data;
+
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityApply2D<2,2>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x33: return PAElasticityApply2D<3,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x44: return PAElasticityApply2D<4,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x55: return PAElasticityApply2D<5,5>(ne,B,G,Bt,Gt,D,x,y);
+         default:
+            return PAElasticityApply2D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAElasticityApply3D<2,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x34: return PAElasticityApply3D<3,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x45: return PAElasticityApply3D<4,5>(ne,B,G,Bt,Gt,D,x,y);
+         default:
+            return PAElasticityApply3D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// The diagonal of the elasticity operator for the component c is the diagonal
+// of a scalar diffusion operator with the (symmetric) reference matrix
+//    w det(J) J^{-1} ((lambda + mu) e_c e_c^T + mu I) J^{-T}.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double O[MQ1][MQ1];
+      double QD[MQ1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const int q = qx + qy * Q1D;
+                     const double L = D(q,0,e);
+                     const double M = D(q,1,e);
+                     double o = (L + M) * D(q,2+i+DIM*c,e) * D(q,2+j+DIM*c,e);
+                     for (int k = 0; k < DIM; ++k)
+                     {
+                        o += M * D(q,2+i+DIM*k,e) * D(q,2+j+DIM*k,e);
+                     }
+                     O[qy][qx] = o;
+                  }
+               }
+               // first tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     QD[qx][dy] = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        const double By = B(qy,dy);
+                        const double Gy = G(qy,dy);
+                        const double L = i==1 ? Gy : By;
+                        const double R = j==1 ? Gy : By;
+                        QD[qx][dy] += L * O[qy][qx] * R;
+                     }
+                  }
+               }
+               // second tensor contraction, along x direction
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double temp = 0.0;
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        const double Bx = B(qx,dx);
+                        const double Gx = G(qx,dx);
+                        const double L = i==0 ? Gx : Bx;
+                        const double R = j==0 ? Gx : Bx;
+                        temp += L * QD[qx][dy] * R;
+                     }
+                     Y(dx,dy,c,e) += temp;
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D*Q1D, 2 + DIM*DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double O[MQ1][MQ1][MQ1];
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        const int q = qx + (qy + qz * Q1D) * Q1D;
+                        const double L = D(q,0,e);
+                        const double M = D(q,1,e);
+                        double o = (L + M) * D(q,2+i+DIM*c,e) *
+                                   D(q,2+j+DIM*c,e);
+                        for (int k = 0; k < DIM; ++k)
+                        {
+                           o += M * D(q,2+i+DIM*k,e) * D(q,2+j+DIM*k,e);
+                        }
+                        O[qz][qy][qx] = o;
+                     }
+                  }
+               }
+               // first tensor contraction, along z direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        QQD[qx][qy][dz] = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const double Bz = B(qz,dz);
+                           const double Gz = G(qz,dz);
+                           const double L = i==2 ? Gz : Bz;
+                           const double R = j==2 ? Gz : Bz;
+                           QQD[qx][qy][dz] += L * O[qz][qy][qx] * R;
+                        }
+                     }
+                  }
+               }
+               // second tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        QDD[qx][dy][dz] = 0.0;
+                        for (int qy = 0; qy < Q1D; ++qy)
+                        {
+                           const double By = B(qy,dy);
+                           const double Gy = G(qy,dy);
+                           const double L = i==1 ? Gy : By;
+                           const double R = j==1 ? Gy : By;
+                           QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
+                        }
+                     }
+                  }
+               }
+               // third tensor contraction, along x direction
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        double temp = 0.0;
+                        for (int qx = 0; qx < Q1D; ++qx)
+                        {
+                           const double Bx = B(qx,dx);
+                           const double Gx = G(qx,dx);
+                           const double L = i==0 ? Gx : Bx;
+                           const double R = j==0 ? Gx : Bx;
+                           temp += L * QDD[qx][dy][dz] * R;
+                        }
+                        Y(dx,dy,dz,c,e) += temp;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void ElasticityIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (dim == 2)
+   {
+      return PAElasticityDiagonal2D(ne, maps->B, maps->G, pa_data, diag,
+                                    dofs1D, quad1D);
+   }
+   else if (dim == 3)
+   {
+      return PAElasticityDiagonal3D(ne, maps->B, maps->G, pa_data, diag,
+                                    dofs1D, quad1D);
+   }
+   MFEM_ABORT("Dimension not implemented.");
+}
+
+} // namespace mfem
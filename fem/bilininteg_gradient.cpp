@@ -74,11 +74,13 @@ static void PAGradientSetup2D(const int Q1D,
                               const int NE,
                               const Array<double> &w,
                               const Vector &j,
-                              const double COEFF,
+                              const Vector &c,
                               Vector &op)
 {
    const int NQ = Q1D*Q1D;
    auto W = w.Read();
+   const bool const_c = c.Size() == 1;
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
    auto y = Reshape(op.Write(), NQ, 2, 2, NE);
 
@@ -86,6 +88,7 @@ static void PAGradientSetup2D(const int Q1D,
    {
       for (int q = 0; q < NQ; ++q)
       {
+         const double COEFF = const_c ? C(0,0) : C(q,e);
          const double J11 = J(q,0,0,e);
          const double J12 = J(q,0,1,e);
          const double J21 = J(q,1,0,e);
@@ -104,17 +107,20 @@ static void PAGradientSetup3D(const int Q1D,
                               const int NE,
                               const Array<double> &w,
                               const Vector &j,
-                              const double COEFF,
+                              const Vector &c,
                               Vector &op)
 {
    const int NQ = Q1D*Q1D*Q1D;
    auto W = w.Read();
+   const bool const_c = c.Size() == 1;
+   auto C = const_c ? Reshape(c.Read(), 1, 1) : Reshape(c.Read(), NQ, NE);
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
    auto y = Reshape(op.Write(), NQ, 3, 3, NE);
    MFEM_FORALL(e, NE,
    {
       for (int q = 0; q < NQ; ++q)
       {
+         const double COEFF = const_c ? C(0,0) : C(q,e);
          const double J11 = J(q,0,0,e);
          const double J21 = J(q,1,0,e);
          const double J31 = J(q,2,0,e);
@@ -156,7 +162,7 @@ static void PAGradientSetup(const int dim,
                             const int NE,
                             const Array<double> &W,
                             const Vector &J,
-                            const double COEFF,
+                            const Vector &COEFF,
                             Vector &op)
 {
    if (dim == 1) { MFEM_ABORT("dim==1 not supported in PAGradientSetup"); }
@@ -170,8 +176,8 @@ static void PAGradientSetup(const int dim,
    }
 }
 
-void GradientIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
-                                    const FiniteElementSpace &test_fes)
+void GradientIntegrator::SetupPA(const FiniteElementSpace &trial_fes,
+                                 const FiniteElementSpace &test_fes)
 {
    // Assumes tensor-product elements ordered by nodes
    MFEM_ASSERT(trial_fes.GetOrdering() == Ordering::byNODES,
@@ -180,11 +186,8 @@ void GradientIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    const FiniteElement &trial_fe = *trial_fes.GetFE(0);
    const FiniteElement &test_fe = *test_fes.GetFE(0);
    ElementTransformation *trans = mesh->GetElementTransformation(0);
-   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(trial_fe, test_fe,
-                                                            *trans);
-   const int dims = trial_fe.GetDim();
-   const int dimsToStore = dims * dims;
-   const int nq = ir->GetNPoints();
+   ir = IntRule ? IntRule : &GetRule(trial_fe, test_fe, *trans);
+   nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = trial_fes.GetNE();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
@@ -195,16 +198,50 @@ void GradientIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    test_dofs1D = test_maps->ndof;
    MFEM_ASSERT(quad1D == test_maps->nqpt,
                "PA requires test and trial space to have same number of quadrature points!");
-   pa_data.SetSize(nq * dimsToStore * ne, Device::GetMemoryType());
-   double coeff = 1.0;
-   if (Q)
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
    {
-      ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
-      MFEM_VERIFY(cQ != NULL, "only ConstantCoefficient is supported!");
-      coeff = cQ->constant;
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
    }
+   else
+   {
+      coeff.SetSize(nq * ne);
+      auto C = Reshape(coeff.HostWrite(), nq, ne);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation &T = *trial_fes.GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            C(q,e) = Q->Eval(T, ir->IntPoint(q));
+         }
+      }
+   }
+}
+
+void GradientIntegrator::ComputeQuadratureData(Vector &op) const
+{
+   op.SetSize(nq * dim * dim * ne, Device::GetMemoryType());
    PAGradientSetup(dim, trial_dofs1D, test_dofs1D, quad1D,
-                   ne, ir->GetWeights(), geom->J, coeff, pa_data);
+                   ne, ir->GetWeights(), geom->J, coeff, op);
+}
+
+void GradientIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
+                                    const FiniteElementSpace &test_fes)
+{
+   SetupPA(trial_fes, test_fes);
+   ComputeQuadratureData(pa_data);
+   coeff.Destroy();
+}
+
+void GradientIntegrator::AssembleMF(const FiniteElementSpace &trial_fes,
+                                    const FiniteElementSpace &test_fes)
+{
+   SetupPA(trial_fes, test_fes);
 }
 
 // PA Gradient Apply 2D kernel
@@ -333,8 +370,103 @@ static void PAGradientApplyTranspose2D(const int NE,
                                        const int te_d1d = 0,
                                        const int q1d = 0)
 {
-   // TODO
-   MFEM_ASSERT(false, "GradientPAApplyTranspose 3D not implemented.");
+   const int TR_D1D = T_TR_D1D ? T_TR_D1D : tr_d1d;
+   const int TE_D1D = T_TE_D1D ? T_TE_D1D : te_d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(TR_D1D <= MAX_D1D, "");
+   MFEM_VERIFY(TE_D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto Bt = Reshape(bt.Read(), TR_D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), TR_D1D, Q1D);
+   auto B = Reshape(b.Read(), Q1D, TE_D1D);
+   auto op = Reshape(_op.Read(), Q1D*Q1D, 2,2, NE);
+   auto x = Reshape(_x.Read(), TE_D1D, TE_D1D, 2, NE);
+   auto y = Reshape(_y.ReadWrite(), TR_D1D, TR_D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int TR_D1D = T_TR_D1D ? T_TR_D1D : tr_d1d;
+      const int TE_D1D = T_TE_D1D ? T_TE_D1D : te_d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = 2;
+      // the following variables are evaluated at compile time
+      constexpr int max_TR_D1D = T_TR_D1D ? T_TR_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double val[max_Q1D][max_Q1D][VDIM];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            val[qy][qx][0] = 0.0;
+            val[qy][qx][1] = 0.0;
+         }
+      }
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int dy = 0; dy < TE_D1D; ++dy)
+         {
+            double valX[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               valX[qx] = 0.0;
+            }
+            for (int dx = 0; dx < TE_D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  valX[qx] += s * B(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  val[qy][qx][c] += valX[qx] * wy;
+               }
+            }
+         }
+      }
+      // We've now calculated the vector field u at the quadrature points
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            const double u0 = val[qy][qx][0];
+            const double u1 = val[qy][qx][1];
+
+            val[qy][qx][0] = op(q,0,0,e)*u0 + op(q,0,1,e)*u1;
+            val[qy][qx][1] = op(q,1,0,e)*u0 + op(q,1,1,e)*u1;
+         }
+      }
+      // We've now calculated op * u
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[max_TR_D1D][VDIM];
+         for (int dx = 0; dx < TR_D1D; ++dx)
+         {
+            gradX[dx][0] = 0.0;
+            gradX[dx][1] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[dx][0] += Gt(dx,qx)*val[qy][qx][0];
+               gradX[dx][1] += Bt(dx,qx)*val[qy][qx][1];
+            }
+         }
+         for (int dy = 0; dy < TR_D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < TR_D1D; ++dx)
+            {
+               y(dx,dy,e) += gradX[dx][0]*wy + gradX[dx][1]*wDy;
+            }
+         }
+      }
+      // We've now calculated y = grad^T (op * u)
+   });
 }
 
 // PA Gradient Apply 3D kernel
@@ -516,7 +648,7 @@ static void PAGradientApply3D(const int NE,
    });
 }
 
-// PA Gradient Apply 3D kernel
+// PA Gradient Apply 3D kernel transpose
 template<const int T_TR_D1D = 0, const int T_TE_D1D = 0, const int T_Q1D = 0>
 static void PAGradientApplyTranspose3D(const int NE,
                                        const Array<double> &bt,
@@ -529,7 +661,168 @@ static void PAGradientApplyTranspose3D(const int NE,
                                        int te_d1d = 0,
                                        int q1d = 0)
 {
-   MFEM_ASSERT(false, "Gradient PA Apply Transpose 3D not implemented.");
+   const int TR_D1D = T_TR_D1D ? T_TR_D1D : tr_d1d;
+   const int TE_D1D = T_TE_D1D ? T_TE_D1D : te_d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(TR_D1D <= MAX_D1D, "");
+   MFEM_VERIFY(TE_D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto Bt = Reshape(bt.Read(), TR_D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), TR_D1D, Q1D);
+   auto B = Reshape(b.Read(), Q1D, TE_D1D);
+   auto op = Reshape(_op.Read(), Q1D*Q1D*Q1D, 3,3, NE);
+   auto x = Reshape(_x.Read(), TE_D1D, TE_D1D, TE_D1D, 3, NE);
+   auto y = Reshape(_y.ReadWrite(), TR_D1D, TR_D1D, TR_D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int TR_D1D = T_TR_D1D ? T_TR_D1D : tr_d1d;
+      const int TE_D1D = T_TE_D1D ? T_TE_D1D : te_d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = 3;
+      // the following variables are evaluated at compile time
+      constexpr int max_TR_D1D = T_TR_D1D ? T_TR_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double val[max_Q1D][max_Q1D][max_Q1D][VDIM];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               val[qz][qy][qx][0] = 0.0;
+               val[qz][qy][qx][1] = 0.0;
+               val[qz][qy][qx][2] = 0.0;
+            }
+         }
+      }
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int dz = 0; dz < TE_D1D; ++dz)
+         {
+            double valXY[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  valXY[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < TE_D1D; ++dy)
+            {
+               double valX[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  valX[qx] = 0.0;
+               }
+               for (int dx = 0; dx < TE_D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     valX[qx] += s * B(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     valXY[qy][qx] += valX[qx] * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     val[qz][qy][qx][c] += valXY[qy][qx] * wz;
+                  }
+               }
+            }
+         }
+      }
+      // We've now calculated the vector field u at the quadrature points
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const double u0 = val[qz][qy][qx][0];
+               const double u1 = val[qz][qy][qx][1];
+               const double u2 = val[qz][qy][qx][2];
+
+               val[qz][qy][qx][0] =
+                  op(q,0,0,e)*u0 + op(q,0,1,e)*u1 + op(q,0,2,e)*u2;
+               val[qz][qy][qx][1] =
+                  op(q,1,0,e)*u0 + op(q,1,1,e)*u1 + op(q,1,2,e)*u2;
+               val[qz][qy][qx][2] =
+                  op(q,2,0,e)*u0 + op(q,2,1,e)*u1 + op(q,2,2,e)*u2;
+            }
+         }
+      }
+      // We've now calculated op * u
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double gradXY[max_TR_D1D][max_TR_D1D][VDIM];
+         for (int dy = 0; dy < TR_D1D; ++dy)
+         {
+            for (int dx = 0; dx < TR_D1D; ++dx)
+            {
+               gradXY[dy][dx][0] = 0.0;
+               gradXY[dy][dx][1] = 0.0;
+               gradXY[dy][dx][2] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_TR_D1D][VDIM];
+            for (int dx = 0; dx < TR_D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+               gradX[dx][2] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[dx][0] += Gt(dx,qx)*val[qz][qy][qx][0];
+                  gradX[dx][1] += Bt(dx,qx)*val[qz][qy][qx][1];
+                  gradX[dx][2] += Bt(dx,qx)*val[qz][qy][qx][2];
+               }
+            }
+            for (int dy = 0; dy < TR_D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < TR_D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] += gradX[dx][0]*wy;
+                  gradXY[dy][dx][1] += gradX[dx][1]*wDy;
+                  gradXY[dy][dx][2] += gradX[dx][2]*wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < TR_D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < TR_D1D; ++dy)
+            {
+               for (int dx = 0; dx < TR_D1D; ++dx)
+               {
+                  y(dx,dy,dz,e) += gradXY[dy][dx][0]*wz +
+                                   gradXY[dy][dx][1]*wz +
+                                   gradXY[dy][dx][2]*wDz;
+               }
+            }
+         }
+      }
+      // We've now calculated y = grad^T (op * u)
+   });
 }
 
 // Shared memory PA Gradient Apply 3D kernel
@@ -793,13 +1086,24 @@ static void PAGradientApply(const int dim,
                             Vector &y,
                             bool transpose=false)
 {
-
+   // In transpose mode, B and G are the transposed trial basis and gradient
+   // and Bt is the (non-transposed) test basis.
    if (dim == 2)
    {
+      if (transpose)
+      {
+         return PAGradientApplyTranspose2D(NE,B,G,Bt,op,x,y,
+                                           TR_D1D,TE_D1D,Q1D);
+      }
       return PAGradientApply2D(NE,B,G,Bt,op,x,y,TR_D1D,TE_D1D,Q1D);
    }
    if (dim == 3)
    {
+      if (transpose)
+      {
+         return PAGradientApplyTranspose3D(NE,B,G,Bt,op,x,y,
+                                           TR_D1D,TE_D1D,Q1D);
+      }
       return PAGradientApply3D(NE,B,G,Bt,op,x,y,TR_D1D,TE_D1D,Q1D);
    }
    MFEM_ABORT("Unknown kernel.");
@@ -816,7 +1120,27 @@ void GradientIntegrator::AddMultPA(const Vector &x, Vector &y) const
 // PA Gradient Apply kernel
 void GradientIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
 {
-   MFEM_ABORT("PA Gradient AddMultTransposePA not implemented.");
+   PAGradientApply(dim, trial_dofs1D, test_dofs1D, quad1D, ne,
+                   trial_maps->Bt, trial_maps->Gt, test_maps->B, pa_data, x, y,
+                   true);
+}
+
+void GradientIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   PAGradientApply(dim, trial_dofs1D, test_dofs1D, quad1D, ne,
+                   trial_maps->B, trial_maps->G, test_maps->Bt, op, x, y,
+                   false);
+}
+
+void GradientIntegrator::AddMultTransposeMF(const Vector &x, Vector &y) const
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   PAGradientApply(dim, trial_dofs1D, test_dofs1D, quad1D, ne,
+                   trial_maps->Bt, trial_maps->Gt, test_maps->B, op, x, y,
+                   true);
 }
 
 } // namespace mfem
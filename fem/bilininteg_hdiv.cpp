@@ -1108,7 +1108,7 @@ void DivDivIntegrator::AssembleDiagonalPA(Vector& diag)
 static void PADivL2Setup2D(const int Q1D,
                            const int NE,
                            const Array<double> &w,
-                           Vector &_coeff,
+                           const Vector &_coeff,
                            Vector &op)
 {
    const int NQ = Q1D*Q1D;
@@ -1127,7 +1127,7 @@ static void PADivL2Setup2D(const int Q1D,
 static void PADivL2Setup3D(const int Q1D,
                            const int NE,
                            const Array<double> &w,
-                           Vector &_coeff,
+                           const Vector &_coeff,
                            Vector &op)
 {
    const int NQ = Q1D*Q1D*Q1D;
@@ -1145,8 +1145,8 @@ static void PADivL2Setup3D(const int Q1D,
 }
 
 void
-VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
-                                         const FiniteElementSpace &test_fes)
+VectorFEDivergenceIntegrator::SetupPA(const FiniteElementSpace &trial_fes,
+                                      const FiniteElementSpace &test_fes)
 {
    // Assumes tensor-product elements, with a vector test space and
    // scalar trial space.
@@ -1162,18 +1162,19 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
       dynamic_cast<const NodalTensorFiniteElement*>(test_fel);
    MFEM_VERIFY(test_el != NULL, "Only NodalTensorFiniteElement is supported!");
 
-   const IntegrationRule *ir = IntRule ? IntRule : &MassIntegrator::GetRule(
-                                  *trial_el, *trial_el,
-                                  *mesh->GetElementTransformation(0));
+   ir = IntRule ? IntRule : &MassIntegrator::GetRule(
+           *trial_el, *trial_el, *mesh->GetElementTransformation(0));
 
    const int dims = trial_el->GetDim();
    MFEM_VERIFY(dims == 2 || dims == 3, "");
 
-   const int nq = ir->GetNPoints();
+   nq = ir->GetNPoints();
    dim = mesh->Dimension();
    MFEM_VERIFY(dim == 2 || dim == 3, "");
 
    MFEM_VERIFY(trial_el->GetOrder() == test_el->GetOrder() + 1, "");
+   MFEM_VERIFY(trial_el->GetDerivType() == mfem::FiniteElement::DIV,
+               "Unknown kernel.");
 
    ne = trial_fes.GetNE();
    mapsC = &trial_el->GetDofToQuad(*ir, DofToQuad::TENSOR);
@@ -1194,9 +1195,7 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
       MFEM_VERIFY(nq == quad1D * quad1D * quad1D, "");
    }
 
-   pa_data.SetSize(nq * ne, Device::GetMemoryType());
-
-   Vector coeff(ne * nq);
+   coeff.SetSize(ne * nq);
    coeff = 1.0;
    if (Q)
    {
@@ -1209,21 +1208,37 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
          }
       }
    }
+}
 
-   if (trial_el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
-   {
-      PADivL2Setup3D(quad1D, ne, ir->GetWeights(), coeff, pa_data);
-   }
-   else if (trial_el->GetDerivType() == mfem::FiniteElement::DIV && dim == 2)
+void VectorFEDivergenceIntegrator::ComputeQuadratureData(Vector &op) const
+{
+   op.SetSize(nq * ne, Device::GetMemoryType());
+   if (dim == 3)
    {
-      PADivL2Setup2D(quad1D, ne, ir->GetWeights(), coeff, pa_data);
+      PADivL2Setup3D(quad1D, ne, ir->GetWeights(), coeff, op);
    }
    else
    {
-      MFEM_ABORT("Unknown kernel.");
+      PADivL2Setup2D(quad1D, ne, ir->GetWeights(), coeff, op);
    }
 }
 
+void
+VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
+                                         const FiniteElementSpace &test_fes)
+{
+   SetupPA(trial_fes, test_fes);
+   ComputeQuadratureData(pa_data);
+   coeff.Destroy();
+}
+
+void
+VectorFEDivergenceIntegrator::AssembleMF(const FiniteElementSpace &trial_fes,
+                                         const FiniteElementSpace &test_fes)
+{
+   SetupPA(trial_fes, test_fes);
+}
+
 // Apply to x corresponding to DOF's in H(div) (trial), whose divergence is
 // integrated against L_2 test functions corresponding to y.
 static void PAHdivL2Apply3D(const int D1D,
@@ -2024,4 +2039,123 @@ void VectorFEDivergenceIntegrator::AssembleDiagonalPA_ADAt(const Vector &D,
    }
 }
 
+void VectorFEDivergenceIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   if (dim == 3)
+      PAHdivL2Apply3D(dofs1D, quad1D, L2dofs1D, ne, mapsO->B, mapsC->G,
+                      L2mapsO->Bt, op, x, y);
+   else
+      PAHdivL2Apply2D(dofs1D, quad1D, L2dofs1D, ne, mapsO->B, mapsC->G,
+                      L2mapsO->Bt, op, x, y);
+}
+
+void VectorFEDivergenceIntegrator::AddMultTransposeMF(const Vector &x,
+                                                      Vector &y) const
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   if (dim == 3)
+      PAHdivL2ApplyTranspose3D(dofs1D, quad1D, L2dofs1D, ne, L2mapsO->B,
+                               mapsC->Gt, mapsO->Bt, op, x, y);
+   else
+      PAHdivL2ApplyTranspose2D(dofs1D, quad1D, L2dofs1D, ne, L2mapsO->B,
+                               mapsC->Gt, mapsO->Bt, op, x, y);
+}
+
+void VectorFEDivergenceIntegrator::AssembleDiagonalMF_ADAt(const Vector &D,
+                                                           Vector &diag)
+{
+   Vector op;
+   ComputeQuadratureData(op);
+   if (dim == 3)
+      PAHdivL2AssembleDiagonal_ADAt_3D(dofs1D, quad1D, L2dofs1D, ne, L2mapsO->B,
+                                       mapsC->Gt, mapsO->Bt, op, D, diag);
+   else
+      PAHdivL2AssembleDiagonal_ADAt_2D(dofs1D, quad1D, L2dofs1D, ne, L2mapsO->B,
+                                       mapsC->Gt, mapsO->Bt, op, D, diag);
+}
+
+MixedScalarDivergenceIntegrator::~MixedScalarDivergenceIntegrator()
+{
+   delete pa_integ;
+}
+
+void MixedScalarDivergenceIntegrator::NewPAIntegrator(
+   const FiniteElementSpace &trial_fes,
+   const FiniteElementSpace &test_fes)
+{
+   // The form (Q div u, v) coincides with the one computed by
+   // VectorFEDivergenceIntegrator when v is an L2 function of VALUE type.
+   const FiniteElement &trial_fe = *trial_fes.GetFE(0);
+   const FiniteElement &test_fe = *test_fes.GetFE(0);
+   MFEM_VERIFY(test_fe.GetMapType() == FiniteElement::VALUE,
+               "Only VALUE map type is supported for the test space!");
+   const IntegrationRule *ir = IntRule;
+   if (ir == NULL)
+   {
+      // Same default rule as AssembleElementMatrix2()
+      ElementTransformation &T = *trial_fes.GetElementTransformation(0);
+      ir = &IntRules.Get(trial_fe.GetGeomType(),
+                         GetIntegrationOrder(trial_fe, test_fe, T));
+   }
+   delete pa_integ;
+   pa_integ = Q ? new VectorFEDivergenceIntegrator(*Q) :
+              new VectorFEDivergenceIntegrator();
+   pa_integ->SetIntRule(ir);
+}
+
+void MixedScalarDivergenceIntegrator::AssemblePA(
+   const FiniteElementSpace &trial_fes,
+   const FiniteElementSpace &test_fes)
+{
+   NewPAIntegrator(trial_fes, test_fes);
+   pa_integ->AssemblePA(trial_fes, test_fes);
+}
+
+void MixedScalarDivergenceIntegrator::AddMultPA(const Vector &x,
+                                                Vector &y) const
+{
+   pa_integ->AddMultPA(x, y);
+}
+
+void MixedScalarDivergenceIntegrator::AddMultTransposePA(const Vector &x,
+                                                         Vector &y) const
+{
+   pa_integ->AddMultTransposePA(x, y);
+}
+
+void MixedScalarDivergenceIntegrator::AssembleDiagonalPA_ADAt(const Vector &D,
+                                                              Vector &diag)
+{
+   pa_integ->AssembleDiagonalPA_ADAt(D, diag);
+}
+
+void MixedScalarDivergenceIntegrator::AssembleMF(
+   const FiniteElementSpace &trial_fes,
+   const FiniteElementSpace &test_fes)
+{
+   NewPAIntegrator(trial_fes, test_fes);
+   pa_integ->AssembleMF(trial_fes, test_fes);
+}
+
+void MixedScalarDivergenceIntegrator::AddMultMF(const Vector &x,
+                                                Vector &y) const
+{
+   pa_integ->AddMultMF(x, y);
+}
+
+void MixedScalarDivergenceIntegrator::AddMultTransposeMF(const Vector &x,
+                                                         Vector &y) const
+{
+   pa_integ->AddMultTransposeMF(x, y);
+}
+
+void MixedScalarDivergenceIntegrator::AssembleDiagonalMF_ADAt(const Vector &D,
+                                                              Vector &diag)
+{
+   pa_integ->AssembleDiagonalMF_ADAt(D, diag);
+}
+
 } // namespace mfem
@@ -228,6 +228,7 @@ void MassIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                 const bool add)
 {
    AssemblePA(fes);
+   MFEM_VERIFY(!simplex, "Element assembly is not supported on simplices");
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
    if (dim == 1)
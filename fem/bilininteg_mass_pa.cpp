@@ -29,6 +29,8 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    fespace = &fes;
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
+   simplex = !UsesTensorBasis(fes);
+   if (simplex) { return AssemblePASimplex(fes); }
    const FiniteElement &el = *fes.GetFE(0);
    ElementTransformation *T = mesh->GetElementTransformation(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
@@ -459,7 +461,11 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
-   if (DeviceCanUseCeed())
+   if (simplex)
+   {
+      AssembleDiagonalPASimplex(diag);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAssembleDiagonal(ceedDataPtr, diag);
    }
@@ -569,6 +575,7 @@ static void PAMassApply2D(const int NE,
                           const Vector &d_,
                           const Vector &x_,
                           Vector &y_,
+                          const ElementGather &gather,
                           const int d1d = 0,
                           const int q1d = 0)
 {
@@ -581,8 +588,9 @@ static void PAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, gather.Size(NE),
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -605,7 +613,8 @@ static void PAMassApply2D(const int NE,
          }
          for (int dx = 0; dx < D1D; ++dx)
          {
-            const double s = X(dx,dy,e);
+            const double s = gather.Fused() ? gather.Gather(X, e, dx + D1D*dy) :
+                             X(dx,dy,e);
             for (int qx = 0; qx < Q1D; ++qx)
             {
                sol_x[qx] += B(qx,dx)* s;
@@ -647,7 +656,9 @@ static void PAMassApply2D(const int NE,
             const double q2d = Bt(dy,qy);
             for (int dx = 0; dx < D1D; ++dx)
             {
-               Y(dx,dy,e) += q2d * sol_x[dx];
+               const double val = q2d * sol_x[dx];
+               if (gather.Fused()) { gather.Scatter(Y, e, dx + D1D*dy, val); }
+               else { Y(dx,dy,e) += val; }
             }
          }
       }
@@ -661,6 +672,7 @@ static void SmemPAMassApply2D(const int NE,
                               const Vector &d_,
                               const Vector &x_,
                               Vector &y_,
+                              const ElementGather &gather,
                               const int d1d = 0,
                               const int q1d = 0)
 {
@@ -676,8 +688,9 @@ static void SmemPAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_FORALL_2D(i, gather.Size(NE), Q1D, Q1D, NBZ,
    {
+      const int e = gather.Element(i);
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -698,7 +711,8 @@ static void SmemPAMassApply2D(const int NE,
       {
          MFEM_FOREACH_THREAD(dx,x,D1D)
          {
-            X[dy][dx] = x(dx,dy,e);
+            X[dy][dx] = gather.Fused() ? gather.Gather(x, e, dx + D1D*dy) :
+                        x(dx,dy,e);
          }
       }
       if (tidz == 0)
@@ -771,7 +785,8 @@ static void SmemPAMassApply2D(const int NE,
             {
                dd += (QD[qy][dx] * Bt[dy][qy]);
             }
-            Y(dx, dy, e) += dd;
+            if (gather.Fused()) { gather.Scatter(Y, e, dx + D1D*dy, dd); }
+            else { Y(dx,dy,e) += dd; }
          }
       }
    });
@@ -784,6 +799,7 @@ static void PAMassApply3D(const int NE,
                           const Vector &d_,
                           const Vector &x_,
                           Vector &y_,
+                          const ElementGather &gather,
                           const int d1d = 0,
                           const int q1d = 0)
 {
@@ -796,8 +812,9 @@ static void PAMassApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, gather.Size(NE),
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -832,7 +849,9 @@ static void PAMassApply3D(const int NE,
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double s = X(dx,dy,dz,e);
+               const double s = gather.Fused() ?
+                                gather.Gather(X, e, dx + D1D*(dy + D1D*dz)) :
+                                X(dx,dy,dz,e);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   sol_x[qx] += B(qx,dx) * s;
@@ -910,7 +929,12 @@ static void PAMassApply3D(const int NE,
             {
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
+                  const double val = wz * sol_xy[dy][dx];
+                  if (gather.Fused())
+                  {
+                     gather.Scatter(Y, e, dx + D1D*(dy + D1D*dz), val);
+                  }
+                  else { Y(dx,dy,dz,e) += val; }
                }
             }
          }
@@ -925,6 +949,7 @@ static void SmemPAMassApply3D(const int NE,
                               const Vector &d_,
                               const Vector &x_,
                               Vector &y_,
+                              const ElementGather &gather,
                               const int d1d = 0,
                               const int q1d = 0)
 {
@@ -939,8 +964,9 @@ static void SmemPAMassApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   MFEM_FORALL_3D(i, gather.Size(NE), Q1D, Q1D, 1,
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
@@ -964,7 +990,9 @@ static void SmemPAMassApply3D(const int NE,
             MFEM_UNROLL(MD1)
             for (int dz = 0; dz < D1D; ++dz)
             {
-               X[dz][dy][dx] = x(dx,dy,dz,e);
+               X[dz][dy][dx] = gather.Fused() ?
+                               gather.Gather(x, e, dx + D1D*(dy + D1D*dz)) :
+                               x(dx,dy,dz,e);
             }
          }
          MFEM_FOREACH_THREAD(dx,x,Q1D)
@@ -1138,7 +1166,274 @@ static void SmemPAMassApply3D(const int NE,
             MFEM_UNROLL(MD1)
             for (int dz = 0; dz < D1D; ++dz)
             {
-               y(dx,dy,dz,e) += u[dz];
+               const double val = u[dz];
+               if (gather.Fused())
+               {
+                  gather.Scatter(y, e, dx + D1D*(dy + D1D*dz), val);
+               }
+               else { y(dx,dy,dz,e) += val; }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAMassApplyBatched2D(const int NE,
+                                 const int NV,
+                                 const Array<double> &b_,
+                                 const Array<double> &bt_,
+                                 const Vector &d_,
+                                 const Vector &x_,
+                                 Vector &y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // read the quadrature data of the element once for all vectors
+      double Dq[max_Q1D][max_Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            Dq[qy][qx] = D(qx,qy,e);
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         double sol_xy[max_Q1D][max_Q1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               sol_x[qy] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,e,v);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += B(qx,dx)* s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double d2q = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] += d2q * sol_x[qx];
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] *= Dq[qy][qx];
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = sol_xy[qy][qx];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double q2d = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,e,v) += q2d * sol_x[dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAMassApplyBatched3D(const int NE,
+                                 const int NV,
+                                 const Array<double> &b_,
+                                 const Array<double> &bt_,
+                                 const Vector &d_,
+                                 const Vector &x_,
+                                 Vector &y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE, NV);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // read the quadrature data of the element once for all vectors
+      double Dq[max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Dq[qz][qy][qx] = D(qx,qy,qz,e);
+            }
+         }
+      }
+      for (int v = 0; v < NV; ++v)
+      {
+         double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double sol_xy[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double sol_x[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] = 0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx,dy,dz,e,v);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_x[qx] += B(qx,dx) * s;
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xy[qy][qx] += wy * sol_x[qx];
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] *= Dq[qz][qy][qx];
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double sol_xy[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] = 0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double sol_x[max_D1D];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double s = sol_xyz[qz][qy][qx];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_x[dx] += Bt(dx,qx) * s;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = Bt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx] += wy * sol_x[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = Bt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,e,v) += wz * sol_xy[dy][dx];
+                  }
+               }
             }
          }
       }
@@ -1153,10 +1448,11 @@ static void PAMassApply(const int dim,
                         const Array<double> &Bt,
                         const Vector &D,
                         const Vector &X,
-                        Vector &Y)
+                        Vector &Y,
+                        const ElementGather &EG = ElementGather())
 {
 #ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   if (DeviceCanUseOcca() && !EG.Fused())
    {
       if (dim == 2)
       {
@@ -1174,40 +1470,40 @@ static void PAMassApply(const int dim,
    {
       switch (id)
       {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y,EG);
+         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,B,Bt,D,X,Y,EG);
+         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y,EG);
+         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,B,Bt,D,X,Y,EG);
+         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,B,Bt,D,X,Y,EG);
+         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y,EG);
+         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,B,Bt,D,X,Y,EG);
+         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y,EG);
+         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,B,Bt,D,X,Y,EG);
+         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y,EG);
+         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y,EG);
+         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y,EG);
+         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y,EG);
+         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,EG,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch (id)
       {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply3D<2,4>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply3D<3,6>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x46: return SmemPAMassApply3D<4,6>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply3D<4,8>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply3D<5,8>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y,EG);
+         case 0x24: return SmemPAMassApply3D<2,4>(NE,B,Bt,D,X,Y,EG);
+         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y,EG);
+         case 0x36: return SmemPAMassApply3D<3,6>(NE,B,Bt,D,X,Y,EG);
+         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y,EG);
+         case 0x46: return SmemPAMassApply3D<4,6>(NE,B,Bt,D,X,Y,EG);
+         case 0x48: return SmemPAMassApply3D<4,8>(NE,B,Bt,D,X,Y,EG);
+         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y,EG);
+         case 0x58: return SmemPAMassApply3D<5,8>(NE,B,Bt,D,X,Y,EG);
+         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y,EG);
+         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y,EG);
+         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y,EG);
+         case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y,EG);
+         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,EG,D1D,Q1D);
       }
    }
    mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
@@ -1216,7 +1512,11 @@ static void PAMassApply(const int dim,
 
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   if (DeviceCanUseCeed())
+   if (simplex)
+   {
+      AddMultPASimplex(x, y);
+   }
+   else if (DeviceCanUseCeed())
    {
       CeedAddMult(ceedDataPtr, x, y);
    }
@@ -1226,4 +1526,408 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void MassIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                    const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(!simplex, "fused action is not supported on simplices");
+   for (int g = 0; g < R.GetNumElementGroups(); g++)
+   {
+      PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y,
+                  R.GetElementGather(g));
+   }
+}
+
+static void PAMassApplyBatched(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NE,
+                               const int NV,
+                               const Array<double> &B,
+                               const Array<double> &Bt,
+                               const Vector &D,
+                               const Vector &X,
+                               Vector &Y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return PAMassApplyBatched2D<2,2>(NE,NV,B,Bt,D,X,Y);
+         case 0x24: return PAMassApplyBatched2D<2,4>(NE,NV,B,Bt,D,X,Y);
+         case 0x33: return PAMassApplyBatched2D<3,3>(NE,NV,B,Bt,D,X,Y);
+         case 0x34: return PAMassApplyBatched2D<3,4>(NE,NV,B,Bt,D,X,Y);
+         case 0x36: return PAMassApplyBatched2D<3,6>(NE,NV,B,Bt,D,X,Y);
+         case 0x44: return PAMassApplyBatched2D<4,4>(NE,NV,B,Bt,D,X,Y);
+         case 0x48: return PAMassApplyBatched2D<4,8>(NE,NV,B,Bt,D,X,Y);
+         case 0x55: return PAMassApplyBatched2D<5,5>(NE,NV,B,Bt,D,X,Y);
+         case 0x58: return PAMassApplyBatched2D<5,8>(NE,NV,B,Bt,D,X,Y);
+         case 0x66: return PAMassApplyBatched2D<6,6>(NE,NV,B,Bt,D,X,Y);
+         case 0x77: return PAMassApplyBatched2D<7,7>(NE,NV,B,Bt,D,X,Y);
+         case 0x88: return PAMassApplyBatched2D<8,8>(NE,NV,B,Bt,D,X,Y);
+         case 0x99: return PAMassApplyBatched2D<9,9>(NE,NV,B,Bt,D,X,Y);
+         default:   return PAMassApplyBatched2D(NE,NV,B,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23: return PAMassApplyBatched3D<2,3>(NE,NV,B,Bt,D,X,Y);
+         case 0x24: return PAMassApplyBatched3D<2,4>(NE,NV,B,Bt,D,X,Y);
+         case 0x34: return PAMassApplyBatched3D<3,4>(NE,NV,B,Bt,D,X,Y);
+         case 0x36: return PAMassApplyBatched3D<3,6>(NE,NV,B,Bt,D,X,Y);
+         case 0x45: return PAMassApplyBatched3D<4,5>(NE,NV,B,Bt,D,X,Y);
+         case 0x46: return PAMassApplyBatched3D<4,6>(NE,NV,B,Bt,D,X,Y);
+         case 0x48: return PAMassApplyBatched3D<4,8>(NE,NV,B,Bt,D,X,Y);
+         case 0x56: return PAMassApplyBatched3D<5,6>(NE,NV,B,Bt,D,X,Y);
+         case 0x58: return PAMassApplyBatched3D<5,8>(NE,NV,B,Bt,D,X,Y);
+         case 0x67: return PAMassApplyBatched3D<6,7>(NE,NV,B,Bt,D,X,Y);
+         case 0x78: return PAMassApplyBatched3D<7,8>(NE,NV,B,Bt,D,X,Y);
+         case 0x89: return PAMassApplyBatched3D<8,9>(NE,NV,B,Bt,D,X,Y);
+         case 0x9A: return PAMassApplyBatched3D<9,10>(NE,NV,B,Bt,D,X,Y);
+         default:   return PAMassApplyBatched3D(NE,NV,B,Bt,D,X,Y,D1D,Q1D);
+      }
+   }
+   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void MassIntegrator::AddMultBatchedPA(const int nvec, const Vector &x,
+                                      Vector &y) const
+{
+   if (DeviceCanUseCeed() || simplex)
+   {
+      BilinearFormIntegrator::AddMultBatchedPA(nvec, x, y);
+   }
+   else
+   {
+      PAMassApplyBatched(dim, dofs1D, quad1D, ne, nvec, maps->B, maps->Bt,
+                         pa_data, x, y);
+   }
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAMassApplyComplex2D(const int NE,
+                                 const Array<double> &b_,
+                                 const Array<double> &bt_,
+                                 const Vector &dr_,
+                                 const Vector &di_,
+                                 const Vector &x_,
+                                 Vector &y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Dr = Reshape(dr_.Read(), Q1D, Q1D, NE);
+   auto Di = Reshape(di_.Read(), Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), 2, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), 2, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double sol_xy[max_Q1D][max_Q1D][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            sol_xy[qy][qx][0] = 0.0;
+            sol_xy[qy][qx][1] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double sol_x[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            sol_x[qx][0] = 0.0;
+            sol_x[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s_r = X(0,dx,dy,e);
+            const double s_i = X(1,dx,dy,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx][0] += B(qx,dx) * s_r;
+               sol_x[qx][1] += B(qx,dx) * s_i;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double d2q = B(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx][0] += d2q * sol_x[qx][0];
+               sol_xy[qy][qx][1] += d2q * sol_x[qx][1];
+            }
+         }
+      }
+      // complex product with the quadrature data, (D_r + i D_i) (u_r + i u_i)
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double d_r = Dr(qx,qy,e), d_i = Di(qx,qy,e);
+            const double u_r = sol_xy[qy][qx][0], u_i = sol_xy[qy][qx][1];
+            sol_xy[qy][qx][0] = d_r * u_r - d_i * u_i;
+            sol_xy[qy][qx][1] = d_i * u_r + d_r * u_i;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double sol_x[max_D1D][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            sol_x[dx][0] = 0.0;
+            sol_x[dx][1] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double s_r = sol_xy[qy][qx][0];
+            const double s_i = sol_xy[qy][qx][1];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx][0] += Bt(dx,qx) * s_r;
+               sol_x[dx][1] += Bt(dx,qx) * s_i;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double q2d = Bt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(0,dx,dy,e) += q2d * sol_x[dx][0];
+               Y(1,dx,dy,e) += q2d * sol_x[dx][1];
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAMassApplyComplex3D(const int NE,
+                                 const Array<double> &b_,
+                                 const Array<double> &bt_,
+                                 const Vector &dr_,
+                                 const Vector &di_,
+                                 const Vector &x_,
+                                 Vector &y_,
+                                 const int d1d = 0,
+                                 const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Dr = Reshape(dr_.Read(), Q1D, Q1D, Q1D, NE);
+   auto Di = Reshape(di_.Read(), Q1D, Q1D, Q1D, NE);
+   auto X = Reshape(x_.Read(), 2, D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), 2, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double sol_xyz[max_Q1D][max_Q1D][max_Q1D][2];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xyz[qz][qy][qx][0] = 0.0;
+               sol_xyz[qz][qy][qx][1] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double sol_xy[max_Q1D][max_Q1D][2];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx][0] = 0.0;
+               sol_xy[qy][qx][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx][0] = 0.0;
+               sol_x[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s_r = X(0,dx,dy,dz,e);
+               const double s_i = X(1,dx,dy,dz,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx][0] += B(qx,dx) * s_r;
+                  sol_x[qx][1] += B(qx,dx) * s_i;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx][0] += wy * sol_x[qx][0];
+                  sol_xy[qy][qx][1] += wy * sol_x[qx][1];
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz = B(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx][0] += wz * sol_xy[qy][qx][0];
+                  sol_xyz[qz][qy][qx][1] += wz * sol_xy[qy][qx][1];
+               }
+            }
+         }
+      }
+      // complex product with the quadrature data, (D_r + i D_i) (u_r + i u_i)
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double d_r = Dr(qx,qy,qz,e), d_i = Di(qx,qy,qz,e);
+               const double u_r = sol_xyz[qz][qy][qx][0];
+               const double u_i = sol_xyz[qz][qy][qx][1];
+               sol_xyz[qz][qy][qx][0] = d_r * u_r - d_i * u_i;
+               sol_xyz[qz][qy][qx][1] = d_i * u_r + d_r * u_i;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double sol_xy[max_D1D][max_D1D][2];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_xy[dy][dx][0] = 0.0;
+               sol_xy[dy][dx][1] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx][0] = 0.0;
+               sol_x[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s_r = sol_xyz[qz][qy][qx][0];
+               const double s_i = sol_xyz[qz][qy][qx][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx][0] += Bt(dx,qx) * s_r;
+                  sol_x[dx][1] += Bt(dx,qx) * s_i;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx][0] += wy * sol_x[dx][0];
+                  sol_xy[dy][dx][1] += wy * sol_x[dx][1];
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz = Bt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(0,dx,dy,dz,e) += wz * sol_xy[dy][dx][0];
+                  Y(1,dx,dy,dz,e) += wz * sol_xy[dy][dx][1];
+               }
+            }
+         }
+      }
+   });
+}
+
+// Returns false if there is no fused complex kernel for the given dimension
+static bool PAMassApplyComplex(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NE,
+                               const Array<double> &B,
+                               const Array<double> &Bt,
+                               const Vector &Dr,
+                               const Vector &Di,
+                               const Vector &X,
+                               Vector &Y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: PAMassApplyComplex2D<2,2>(NE,B,Bt,Dr,Di,X,Y); break;
+         case 0x33: PAMassApplyComplex2D<3,3>(NE,B,Bt,Dr,Di,X,Y); break;
+         case 0x44: PAMassApplyComplex2D<4,4>(NE,B,Bt,Dr,Di,X,Y); break;
+         case 0x55: PAMassApplyComplex2D<5,5>(NE,B,Bt,Dr,Di,X,Y); break;
+         default: PAMassApplyComplex2D(NE,B,Bt,Dr,Di,X,Y,D1D,Q1D); break;
+      }
+      return true;
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23: PAMassApplyComplex3D<2,3>(NE,B,Bt,Dr,Di,X,Y); break;
+         case 0x34: PAMassApplyComplex3D<3,4>(NE,B,Bt,Dr,Di,X,Y); break;
+         case 0x45: PAMassApplyComplex3D<4,5>(NE,B,Bt,Dr,Di,X,Y); break;
+         case 0x56: PAMassApplyComplex3D<5,6>(NE,B,Bt,Dr,Di,X,Y); break;
+         default: PAMassApplyComplex3D(NE,B,Bt,Dr,Di,X,Y,D1D,Q1D); break;
+      }
+      return true;
+   }
+   return false;
+}
+
+void MassIntegrator::AddMultComplexPA(const BilinearFormIntegrator &imag,
+                                      const Vector &x, Vector &y) const
+{
+   const MassIntegrator *mi = dynamic_cast<const MassIntegrator*>(&imag);
+   const bool fused = !DeviceCanUseCeed() && !simplex && mi &&
+                      mi->maps == maps && mi->ne == ne &&
+                      mi->quad1D == quad1D;
+   if (!fused || !PAMassApplyComplex(dim, dofs1D, quad1D, ne, maps->B,
+                                     maps->Bt, pa_data, mi->pa_data, x, y))
+   {
+      BilinearFormIntegrator::AddMultComplexPA(imag, x, y);
+   }
+}
+
 } // namespace mfem
@@ -0,0 +1,1094 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Mass and Diffusion Integrators on simplices
+//
+// The generic kernels use the full (non-tensor) DofToQuad maps with the native
+// E-vector ordering. For the positive (Bernstein) H1 elements on triangles and
+// tetrahedra, the actions are sum-factorized in the collapsed coordinates:
+//
+//    2D: x = a (1-b),         y = b,
+//    3D: x = a (1-b) (1-c),   y = b (1-c),   z = c,
+//
+// in which the Bernstein polynomials factor into products of 1D Bernstein
+// polynomials of decreasing degree, e.g. in 2D:
+//
+//    B_ij(x,y) = B^{p-j}_i(a) B^p_j(b).
+// The quadrature is the tensor Gauss-Legendre rule in (a,b,c), see
+// IntegrationRules::GetCollapsed(), and the derivatives of a degree p
+// expansion are degree p-1 expansions whose coefficients are differences of
+// the original ones.
+
+/// Largest number of 1D dofs/points handled by the Bernstein kernels
+static constexpr int MAX_SIMPLEX_1D = 8;
+
+/// Return the lexicographic to native dof map of the Bernstein elements
+static const Array<int> *GetBernsteinDofMap(const FiniteElement &el)
+{
+   if (const H1Pos_TriangleElement *tri =
+          dynamic_cast<const H1Pos_TriangleElement*>(&el))
+   {
+      return &tri->GetDofMap();
+   }
+   if (const H1Pos_TetrahedronElement *tet =
+          dynamic_cast<const H1Pos_TetrahedronElement*>(&el))
+   {
+      return &tet->GetDofMap();
+   }
+   return NULL;
+}
+
+/** Tabulate the 1D Bernstein polynomials of all degrees m <= p at the points of
+    the 1D rule with Q1D points: B(q,i,m) = binom(m,i) t_q^i (1-t_q)^{m-i}. */
+static void GetBernsteinBasis(const int p, const int Q1D, Vector &bernstein)
+{
+   const IntegrationRule &ir1D = IntRules.Get(Geometry::SEGMENT, 2*Q1D - 1);
+   const int D1D = p + 1;
+   bernstein.SetSize(Q1D*D1D*D1D);
+   auto B = Reshape(bernstein.HostWrite(), Q1D, D1D, D1D);
+   Vector u(D1D);
+   for (int q = 0; q < Q1D; q++)
+   {
+      const double t = ir1D.IntPoint(q).x;
+      for (int m = 0; m <= p; m++)
+      {
+         Poly_1D::CalcBinomTerms(m, t, 1.0 - t, u.GetData());
+         for (int i = 0; i < D1D; i++) { B(q,i,m) = (i <= m) ? u(i) : 0.0; }
+      }
+   }
+}
+
+/// Evaluate the scalar coefficient @a Q at the points of @a ir
+static void GetScalarCoefficient(Coefficient *Q, const FiniteElementSpace &fes,
+                                 const IntegrationRule &ir, Vector &coeff)
+{
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else if (QuadratureFunctionCoefficient* cQ =
+               dynamic_cast<QuadratureFunctionCoefficient*>(Q))
+   {
+      const QuadratureFunction &qFun = cQ->GetQuadFunction();
+      MFEM_VERIFY(qFun.Size() == NQ*NE,
+                  "Incompatible QuadratureFunction dimension \n");
+      MFEM_VERIFY(&ir == &qFun.GetSpace()->GetElementIntRule(0),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+      qFun.Read();
+      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun),0);
+   }
+   else
+   {
+      coeff.SetSize(NQ*NE);
+      auto C = Reshape(coeff.HostWrite(), NQ, NE);
+      for (int e = 0; e < NE; ++e)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < NQ; ++q)
+         {
+            C(q,e) = Q->Eval(T, ir.IntPoint(q));
+         }
+      }
+   }
+}
+
+// PA Mass Assemble kernel: D = W c det(J)
+static void PAMassSetupSimplex(const int dim, const int NQ, const int NE,
+                               const Array<double> &w, const Vector &j,
+                               const Vector &c, Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   const auto W = w.Read();
+   const auto J = Reshape(j.Read(), NQ, dim, dim, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto D = Reshape(d.Write(), NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double detJ;
+      if (dim == 2)
+      {
+         detJ = J(q,0,0,e)*J(q,1,1,e) - J(q,1,0,e)*J(q,0,1,e);
+      }
+      else
+      {
+         detJ = J(q,0,0,e)*(J(q,1,1,e)*J(q,2,2,e) - J(q,2,1,e)*J(q,1,2,e)) -
+                J(q,1,0,e)*(J(q,0,1,e)*J(q,2,2,e) - J(q,2,1,e)*J(q,0,2,e)) +
+                J(q,2,0,e)*(J(q,0,1,e)*J(q,1,2,e) - J(q,1,1,e)*J(q,0,2,e));
+      }
+      const double coeff = const_c ? C(0,0) : C(q,e);
+      D(q,e) = W[q] * coeff * detJ;
+   });
+}
+
+// PA Diffusion Assemble kernel: D = W c/det(J) adj(J) adj(J)^T, stored in the
+// symmetric format O11, O12, (O13), O22, (O23), O33
+static void PADiffusionSetupSimplex(const int dim, const int NQ, const int NE,
+                                    const Array<double> &w, const Vector &j,
+                                    const Vector &c, Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   const int S = (dim*(dim + 1))/2;
+   const auto W = w.Read();
+   const auto J = Reshape(j.Read(), NQ, dim, dim, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto D = Reshape(d.Write(), NQ, S, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      const double coeff = const_c ? C(0,0) : C(q,e);
+      if (dim == 2)
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double c_detJ = W[q] * coeff / ((J11*J22)-(J21*J12));
+         D(q,0,e) =  c_detJ * (J12*J12 + J22*J22); // 1,1
+         D(q,1,e) = -c_detJ * (J12*J11 + J22*J21); // 1,2
+         D(q,2,e) =  c_detJ * (J11*J11 + J21*J21); // 2,2
+      }
+      else
+      {
+         const double J11 = J(q,0,0,e);
+         const double J21 = J(q,1,0,e);
+         const double J31 = J(q,2,0,e);
+         const double J12 = J(q,0,1,e);
+         const double J22 = J(q,1,1,e);
+         const double J32 = J(q,2,1,e);
+         const double J13 = J(q,0,2,e);
+         const double J23 = J(q,1,2,e);
+         const double J33 = J(q,2,2,e);
+         // adj(J)
+         const double A11 = (J22*J33)-(J23*J32);
+         const double A12 = (J32*J13)-(J12*J33);
+         const double A13 = (J12*J23)-(J22*J13);
+         const double A21 = (J31*J23)-(J21*J33);
+         const double A22 = (J11*J33)-(J13*J31);
+         const double A23 = (J21*J13)-(J11*J23);
+         const double A31 = (J21*J32)-(J31*J22);
+         const double A32 = (J31*J12)-(J11*J32);
+         const double A33 = (J11*J22)-(J12*J21);
+         const double detJ = J11*A11 + J21*A12 + J31*A13;
+         const double c_detJ = W[q] * coeff / detJ;
+         D(q,0,e) = c_detJ * (A11*A11 + A12*A12 + A13*A13); // 1,1
+         D(q,1,e) = c_detJ * (A11*A21 + A12*A22 + A13*A23); // 2,1
+         D(q,2,e) = c_detJ * (A11*A31 + A12*A32 + A13*A33); // 3,1
+         D(q,3,e) = c_detJ * (A21*A21 + A22*A22 + A23*A23); // 2,2
+         D(q,4,e) = c_detJ * (A21*A31 + A22*A32 + A23*A33); // 3,2
+         D(q,5,e) = c_detJ * (A31*A31 + A32*A32 + A33*A33); // 3,3
+      }
+   });
+}
+
+// PA Mass Apply kernel with the full (non-tensor) maps
+static void PAMassApplySimplex(const int NE, const int ND, const int NQ,
+                               const Array<double> &b, const Array<double> &bt,
+                               const Vector &d, const Vector &x, Vector &y)
+{
+   Vector xq(NQ*NE, Device::GetDeviceMemoryType());
+   const auto B = Reshape(b.Read(), NQ, ND);
+   const auto Bt = Reshape(bt.Read(), ND, NQ);
+   const auto D = Reshape(d.Read(), NQ, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto XQ = Reshape(xq.Write(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double u = 0.0;
+      for (int dof = 0; dof < ND; dof++) { u += B(q,dof) * X(dof,e); }
+      XQ(q,e) = D(q,e) * u;
+   });
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int dof = i % ND;
+      const int e = i / ND;
+      double v = 0.0;
+      for (int q = 0; q < NQ; q++) { v += Bt(dof,q) * XQ(q,e); }
+      Y(dof,e) += v;
+   });
+}
+
+// PA Diffusion Apply kernel with the full (non-tensor) maps
+template<int DIM>
+static void PADiffusionApplySimplex(const int NE, const int ND, const int NQ,
+                                    const Array<double> &g,
+                                    const Array<double> &gt,
+                                    const Vector &d, const Vector &x, Vector &y)
+{
+   constexpr int S = (DIM*(DIM + 1))/2;
+   Vector gq(NQ*DIM*NE, Device::GetDeviceMemoryType());
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto Gt = Reshape(gt.Read(), ND, NQ, DIM);
+   const auto D = Reshape(d.Read(), NQ, S, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto GQ = Reshape(gq.Write(), NQ, DIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double grad[DIM];
+      for (int k = 0; k < DIM; k++)
+      {
+         grad[k] = 0.0;
+         for (int dof = 0; dof < ND; dof++)
+         {
+            grad[k] += G(q,k,dof) * X(dof,e);
+         }
+      }
+      for (int k = 0; k < DIM; k++)
+      {
+         double u = 0.0;
+         for (int l = 0; l < DIM; l++)
+         {
+            // index of (k,l) in the symmetric storage
+            const int kl = (k <= l) ? (k*(2*DIM - k - 1))/2 + l :
+                           (l*(2*DIM - l - 1))/2 + k;
+            u += D(q,kl,e) * grad[l];
+         }
+         GQ(q,k,e) = u;
+      }
+   });
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int dof = i % ND;
+      const int e = i / ND;
+      double v = 0.0;
+      for (int k = 0; k < DIM; k++)
+      {
+         for (int q = 0; q < NQ; q++) { v += Gt(dof,q,k) * GQ(q,k,e); }
+      }
+      Y(dof,e) += v;
+   });
+}
+
+// PA Mass Diagonal kernel with the full (non-tensor) maps
+static void PAMassDiagonalSimplex(const int NE, const int ND, const int NQ,
+                                  const Array<double> &b, const Vector &d,
+                                  Vector &y)
+{
+   const auto B = Reshape(b.Read(), NQ, ND);
+   const auto D = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int dof = i % ND;
+      const int e = i / ND;
+      double v = 0.0;
+      for (int q = 0; q < NQ; q++) { v += B(q,dof) * B(q,dof) * D(q,e); }
+      Y(dof,e) += v;
+   });
+}
+
+// PA Diffusion Diagonal kernel with the full (non-tensor) maps
+template<int DIM>
+static void PADiffusionDiagonalSimplex(const int NE, const int ND, const int NQ,
+                                       const Array<double> &g, const Vector &d,
+                                       Vector &y)
+{
+   constexpr int S = (DIM*(DIM + 1))/2;
+   const auto G = Reshape(g.Read(), NQ, DIM, ND);
+   const auto D = Reshape(d.Read(), NQ, S, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(i, ND*NE,
+   {
+      const int dof = i % ND;
+      const int e = i / ND;
+      double v = 0.0;
+      for (int q = 0; q < NQ; q++)
+      {
+         for (int k = 0, kl = 0; k < DIM; k++)
+         {
+            v += G(q,k,dof) * G(q,k,dof) * D(q,kl++,e);
+            for (int l = k + 1; l < DIM; l++)
+            {
+               v += 2.0 * G(q,k,dof) * G(q,l,dof) * D(q,kl++,e);
+            }
+         }
+      }
+      Y(dof,e) += v;
+   });
+}
+
+// Bernstein PA Mass Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void BernsteinMassApply2D(const int NE, const Array<int> &map,
+                                 const Vector &b, const Vector &d,
+                                 const Vector &x, Vector &y,
+                                 const int d1d = 0, const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_SIMPLEX_1D, "");
+   MFEM_VERIFY(Q1D <= MAX_SIMPLEX_1D, "");
+   const int ND = map.Size();
+   const auto M = map.Read();
+   const auto B = Reshape(b.Read(), Q1D, D1D, D1D);
+   const auto D = Reshape(d.Read(), Q1D, Q1D, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_SIMPLEX_1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_SIMPLEX_1D;
+      const int p = D1D - 1;
+      double c[max_D1D][max_D1D];
+      for (int j = 0, o = 0; j <= p; j++)
+      {
+         for (int i = 0; i <= p - j; i++) { c[j][i] = X(M[o++],e); }
+      }
+      // sum over i: B^{p-j}_i(a)
+      double t[max_D1D][max_Q1D];
+      for (int j = 0; j <= p; j++)
+      {
+         for (int qa = 0; qa < Q1D; qa++)
+         {
+            double s = 0.0;
+            for (int i = 0; i <= p - j; i++) { s += B(qa,i,p-j) * c[j][i]; }
+            t[j][qa] = s;
+         }
+      }
+      // sum over j: B^p_j(b), and apply the quadrature data
+      double u[max_Q1D][max_Q1D];
+      for (int qb = 0; qb < Q1D; qb++)
+      {
+         for (int qa = 0; qa < Q1D; qa++)
+         {
+            double s = 0.0;
+            for (int j = 0; j <= p; j++) { s += B(qb,j,p) * t[j][qa]; }
+            u[qb][qa] = D(qa,qb,e) * s;
+         }
+      }
+      // transposed sums in reverse order
+      for (int j = 0; j <= p; j++)
+      {
+         for (int qa = 0; qa < Q1D; qa++)
+         {
+            double s = 0.0;
+            for (int qb = 0; qb < Q1D; qb++) { s += B(qb,j,p) * u[qb][qa]; }
+            t[j][qa] = s;
+         }
+      }
+      for (int j = 0, o = 0; j <= p; j++)
+      {
+         for (int i = 0; i <= p - j; i++)
+         {
+            double s = 0.0;
+            for (int qa = 0; qa < Q1D; qa++) { s += B(qa,i,p-j) * t[j][qa]; }
+            Y(M[o++],e) += s;
+         }
+      }
+   });
+}
+
+// Bernstein PA Mass Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void BernsteinMassApply3D(const int NE, const Array<int> &map,
+                                 const Vector &b, const Vector &d,
+                                 const Vector &x, Vector &y,
+                                 const int d1d = 0, const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_SIMPLEX_1D, "");
+   MFEM_VERIFY(Q1D <= MAX_SIMPLEX_1D, "");
+   const int ND = map.Size();
+   const auto M = map.Read();
+   const auto B = Reshape(b.Read(), Q1D, D1D, D1D);
+   const auto D = Reshape(d.Read(), Q1D, Q1D, Q1D, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_SIMPLEX_1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_SIMPLEX_1D;
+      const int p = D1D - 1;
+      double c[max_D1D][max_D1D][max_D1D];
+      for (int k = 0, o = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int i = 0; i <= p - k - j; i++) { c[k][j][i] = X(M[o++],e); }
+         }
+      }
+      // sum over i: B^{p-k-j}_i(a)
+      double t1[max_D1D][max_D1D][max_Q1D];
+      for (int k = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int i = 0; i <= p - k - j; i++)
+               {
+                  s += B(qa,i,p-k-j) * c[k][j][i];
+               }
+               t1[k][j][qa] = s;
+            }
+         }
+      }
+      // sum over j: B^{p-k}_j(b)
+      double t2[max_D1D][max_Q1D][max_Q1D];
+      for (int k = 0; k <= p; k++)
+      {
+         for (int qb = 0; qb < Q1D; qb++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int j = 0; j <= p - k; j++)
+               {
+                  s += B(qb,j,p-k) * t1[k][j][qa];
+               }
+               t2[k][qb][qa] = s;
+            }
+         }
+      }
+      // sum over k: B^p_k(c), and apply the quadrature data
+      double u[max_Q1D][max_Q1D][max_Q1D];
+      for (int qc = 0; qc < Q1D; qc++)
+      {
+         for (int qb = 0; qb < Q1D; qb++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int k = 0; k <= p; k++) { s += B(qc,k,p) * t2[k][qb][qa]; }
+               u[qc][qb][qa] = D(qa,qb,qc,e) * s;
+            }
+         }
+      }
+      // transposed sums in reverse order
+      for (int k = 0; k <= p; k++)
+      {
+         for (int qb = 0; qb < Q1D; qb++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int qc = 0; qc < Q1D; qc++)
+               {
+                  s += B(qc,k,p) * u[qc][qb][qa];
+               }
+               t2[k][qb][qa] = s;
+            }
+         }
+      }
+      for (int k = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int qb = 0; qb < Q1D; qb++)
+               {
+                  s += B(qb,j,p-k) * t2[k][qb][qa];
+               }
+               t1[k][j][qa] = s;
+            }
+         }
+      }
+      for (int k = 0, o = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int i = 0; i <= p - k - j; i++)
+            {
+               double s = 0.0;
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  s += B(qa,i,p-k-j) * t1[k][j][qa];
+               }
+               Y(M[o++],e) += s;
+            }
+         }
+      }
+   });
+}
+
+// Bernstein PA Diffusion Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void BernsteinDiffusionApply2D(const int NE, const Array<int> &map,
+                                      const Vector &b, const Vector &d,
+                                      const Vector &x, Vector &y,
+                                      const int d1d = 0, const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_SIMPLEX_1D, "");
+   MFEM_VERIFY(Q1D <= MAX_SIMPLEX_1D, "");
+   const int ND = map.Size();
+   const auto M = map.Read();
+   const auto B = Reshape(b.Read(), Q1D, D1D, D1D);
+   const auto D = Reshape(d.Read(), Q1D, Q1D, 3, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_SIMPLEX_1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_SIMPLEX_1D;
+      const int p = D1D - 1;
+      const int n = p - 1; // degree of the derivatives
+      double c[max_D1D][max_D1D];
+      for (int j = 0, o = 0; j <= p; j++)
+      {
+         for (int i = 0; i <= p - j; i++) { c[j][i] = X(M[o++],e); }
+      }
+      // coefficients of the reference derivatives
+      double g[2][max_D1D][max_D1D];
+      for (int j = 0; j <= n; j++)
+      {
+         for (int i = 0; i <= n - j; i++)
+         {
+            g[0][j][i] = p * (c[j][i+1] - c[j][i]);
+            g[1][j][i] = p * (c[j+1][i] - c[j][i]);
+         }
+      }
+      double t[2][max_D1D][max_Q1D];
+      double u[2][max_Q1D][max_Q1D];
+      for (int dd = 0; dd < 2; dd++)
+      {
+         for (int j = 0; j <= n; j++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int i = 0; i <= n - j; i++)
+               {
+                  s += B(qa,i,n-j) * g[dd][j][i];
+               }
+               t[dd][j][qa] = s;
+            }
+         }
+         for (int qb = 0; qb < Q1D; qb++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int j = 0; j <= n; j++) { s += B(qb,j,n) * t[dd][j][qa]; }
+               u[dd][qb][qa] = s;
+            }
+         }
+      }
+      for (int qb = 0; qb < Q1D; qb++)
+      {
+         for (int qa = 0; qa < Q1D; qa++)
+         {
+            const double O11 = D(qa,qb,0,e);
+            const double O12 = D(qa,qb,1,e);
+            const double O22 = D(qa,qb,2,e);
+            const double gX = u[0][qb][qa];
+            const double gY = u[1][qb][qa];
+            u[0][qb][qa] = (O11 * gX) + (O12 * gY);
+            u[1][qb][qa] = (O12 * gX) + (O22 * gY);
+         }
+      }
+      // transposed sums in reverse order
+      for (int dd = 0; dd < 2; dd++)
+      {
+         for (int j = 0; j <= n; j++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               double s = 0.0;
+               for (int qb = 0; qb < Q1D; qb++)
+               {
+                  s += B(qb,j,n) * u[dd][qb][qa];
+               }
+               t[dd][j][qa] = s;
+            }
+         }
+         for (int j = 0; j <= n; j++)
+         {
+            for (int i = 0; i <= n - j; i++)
+            {
+               double s = 0.0;
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  s += B(qa,i,n-j) * t[dd][j][qa];
+               }
+               g[dd][j][i] = p * s;
+            }
+         }
+      }
+      // transpose of the differences
+      for (int j = 0; j <= p; j++)
+      {
+         for (int i = 0; i <= p - j; i++) { c[j][i] = 0.0; }
+      }
+      for (int j = 0; j <= n; j++)
+      {
+         for (int i = 0; i <= n - j; i++)
+         {
+            c[j][i+1] += g[0][j][i];
+            c[j+1][i] += g[1][j][i];
+            c[j][i] -= g[0][j][i] + g[1][j][i];
+         }
+      }
+      for (int j = 0, o = 0; j <= p; j++)
+      {
+         for (int i = 0; i <= p - j; i++) { Y(M[o++],e) += c[j][i]; }
+      }
+   });
+}
+
+// Bernstein PA Diffusion Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void BernsteinDiffusionApply3D(const int NE, const Array<int> &map,
+                                      const Vector &b, const Vector &d,
+                                      const Vector &x, Vector &y,
+                                      const int d1d = 0, const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_SIMPLEX_1D, "");
+   MFEM_VERIFY(Q1D <= MAX_SIMPLEX_1D, "");
+   const int ND = map.Size();
+   const auto M = map.Read();
+   const auto B = Reshape(b.Read(), Q1D, D1D, D1D);
+   const auto D = Reshape(d.Read(), Q1D, Q1D, Q1D, 6, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_SIMPLEX_1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_SIMPLEX_1D;
+      const int p = D1D - 1;
+      const int n = p - 1; // degree of the derivatives
+      double c[max_D1D][max_D1D][max_D1D];
+      for (int k = 0, o = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int i = 0; i <= p - k - j; i++) { c[k][j][i] = X(M[o++],e); }
+         }
+      }
+      // coefficients of the reference derivatives
+      double g[3][max_D1D][max_D1D][max_D1D];
+      for (int k = 0; k <= n; k++)
+      {
+         for (int j = 0; j <= n - k; j++)
+         {
+            for (int i = 0; i <= n - k - j; i++)
+            {
+               g[0][k][j][i] = p * (c[k][j][i+1] - c[k][j][i]);
+               g[1][k][j][i] = p * (c[k][j+1][i] - c[k][j][i]);
+               g[2][k][j][i] = p * (c[k+1][j][i] - c[k][j][i]);
+            }
+         }
+      }
+      double t1[max_D1D][max_D1D][max_Q1D];
+      double t2[max_D1D][max_Q1D][max_Q1D];
+      double u[3][max_Q1D][max_Q1D][max_Q1D];
+      for (int dd = 0; dd < 3; dd++)
+      {
+         for (int k = 0; k <= n; k++)
+         {
+            for (int j = 0; j <= n - k; j++)
+            {
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  double s = 0.0;
+                  for (int i = 0; i <= n - k - j; i++)
+                  {
+                     s += B(qa,i,n-k-j) * g[dd][k][j][i];
+                  }
+                  t1[k][j][qa] = s;
+               }
+            }
+         }
+         for (int k = 0; k <= n; k++)
+         {
+            for (int qb = 0; qb < Q1D; qb++)
+            {
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  double s = 0.0;
+                  for (int j = 0; j <= n - k; j++)
+                  {
+                     s += B(qb,j,n-k) * t1[k][j][qa];
+                  }
+                  t2[k][qb][qa] = s;
+               }
+            }
+         }
+         for (int qc = 0; qc < Q1D; qc++)
+         {
+            for (int qb = 0; qb < Q1D; qb++)
+            {
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  double s = 0.0;
+                  for (int k = 0; k <= n; k++)
+                  {
+                     s += B(qc,k,n) * t2[k][qb][qa];
+                  }
+                  u[dd][qc][qb][qa] = s;
+               }
+            }
+         }
+      }
+      for (int qc = 0; qc < Q1D; qc++)
+      {
+         for (int qb = 0; qb < Q1D; qb++)
+         {
+            for (int qa = 0; qa < Q1D; qa++)
+            {
+               const double O11 = D(qa,qb,qc,0,e);
+               const double O12 = D(qa,qb,qc,1,e);
+               const double O13 = D(qa,qb,qc,2,e);
+               const double O22 = D(qa,qb,qc,3,e);
+               const double O23 = D(qa,qb,qc,4,e);
+               const double O33 = D(qa,qb,qc,5,e);
+               const double gX = u[0][qc][qb][qa];
+               const double gY = u[1][qc][qb][qa];
+               const double gZ = u[2][qc][qb][qa];
+               u[0][qc][qb][qa] = (O11 * gX) + (O12 * gY) + (O13 * gZ);
+               u[1][qc][qb][qa] = (O12 * gX) + (O22 * gY) + (O23 * gZ);
+               u[2][qc][qb][qa] = (O13 * gX) + (O23 * gY) + (O33 * gZ);
+            }
+         }
+      }
+      // transposed sums in reverse order
+      for (int dd = 0; dd < 3; dd++)
+      {
+         for (int k = 0; k <= n; k++)
+         {
+            for (int qb = 0; qb < Q1D; qb++)
+            {
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  double s = 0.0;
+                  for (int qc = 0; qc < Q1D; qc++)
+                  {
+                     s += B(qc,k,n) * u[dd][qc][qb][qa];
+                  }
+                  t2[k][qb][qa] = s;
+               }
+            }
+         }
+         for (int k = 0; k <= n; k++)
+         {
+            for (int j = 0; j <= n - k; j++)
+            {
+               for (int qa = 0; qa < Q1D; qa++)
+               {
+                  double s = 0.0;
+                  for (int qb = 0; qb < Q1D; qb++)
+                  {
+                     s += B(qb,j,n-k) * t2[k][qb][qa];
+                  }
+                  t1[k][j][qa] = s;
+               }
+            }
+         }
+         for (int k = 0; k <= n; k++)
+         {
+            for (int j = 0; j <= n - k; j++)
+            {
+               for (int i = 0; i <= n - k - j; i++)
+               {
+                  double s = 0.0;
+                  for (int qa = 0; qa < Q1D; qa++)
+                  {
+                     s += B(qa,i,n-k-j) * t1[k][j][qa];
+                  }
+                  g[dd][k][j][i] = p * s;
+               }
+            }
+         }
+      }
+      // transpose of the differences
+      for (int k = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int i = 0; i <= p - k - j; i++) { c[k][j][i] = 0.0; }
+         }
+      }
+      for (int k = 0; k <= n; k++)
+      {
+         for (int j = 0; j <= n - k; j++)
+         {
+            for (int i = 0; i <= n - k - j; i++)
+            {
+               c[k][j][i+1] += g[0][k][j][i];
+               c[k][j+1][i] += g[1][k][j][i];
+               c[k+1][j][i] += g[2][k][j][i];
+               c[k][j][i] -= g[0][k][j][i] + g[1][k][j][i] + g[2][k][j][i];
+            }
+         }
+      }
+      for (int k = 0, o = 0; k <= p; k++)
+      {
+         for (int j = 0; j <= p - k; j++)
+         {
+            for (int i = 0; i <= p - k - j; i++) { Y(M[o++],e) += c[k][j][i]; }
+         }
+      }
+   });
+}
+
+static void BernsteinMassApply(const int dim, const int D1D, const int Q1D,
+                               const int NE, const Array<int> &map,
+                               const Vector &b, const Vector &d,
+                               const Vector &x, Vector &y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return BernsteinMassApply2D<2,2>(NE,map,b,d,x,y);
+         case 0x33: return BernsteinMassApply2D<3,3>(NE,map,b,d,x,y);
+         case 0x44: return BernsteinMassApply2D<4,4>(NE,map,b,d,x,y);
+         case 0x55: return BernsteinMassApply2D<5,5>(NE,map,b,d,x,y);
+         case 0x66: return BernsteinMassApply2D<6,6>(NE,map,b,d,x,y);
+         case 0x77: return BernsteinMassApply2D<7,7>(NE,map,b,d,x,y);
+         default: return BernsteinMassApply2D(NE,map,b,d,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23: return BernsteinMassApply3D<2,3>(NE,map,b,d,x,y);
+         case 0x34: return BernsteinMassApply3D<3,4>(NE,map,b,d,x,y);
+         case 0x45: return BernsteinMassApply3D<4,5>(NE,map,b,d,x,y);
+         case 0x56: return BernsteinMassApply3D<5,6>(NE,map,b,d,x,y);
+         case 0x67: return BernsteinMassApply3D<6,7>(NE,map,b,d,x,y);
+         case 0x78: return BernsteinMassApply3D<7,8>(NE,map,b,d,x,y);
+         default: return BernsteinMassApply3D(NE,map,b,d,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+static void BernsteinDiffusionApply(const int dim, const int D1D,
+                                    const int Q1D, const int NE,
+                                    const Array<int> &map, const Vector &b,
+                                    const Vector &d, const Vector &x, Vector &y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x21: return BernsteinDiffusionApply2D<2,1>(NE,map,b,d,x,y);
+         case 0x32: return BernsteinDiffusionApply2D<3,2>(NE,map,b,d,x,y);
+         case 0x43: return BernsteinDiffusionApply2D<4,3>(NE,map,b,d,x,y);
+         case 0x54: return BernsteinDiffusionApply2D<5,4>(NE,map,b,d,x,y);
+         case 0x65: return BernsteinDiffusionApply2D<6,5>(NE,map,b,d,x,y);
+         case 0x76: return BernsteinDiffusionApply2D<7,6>(NE,map,b,d,x,y);
+         default: return BernsteinDiffusionApply2D(NE,map,b,d,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x22: return BernsteinDiffusionApply3D<2,2>(NE,map,b,d,x,y);
+         case 0x33: return BernsteinDiffusionApply3D<3,3>(NE,map,b,d,x,y);
+         case 0x44: return BernsteinDiffusionApply3D<4,4>(NE,map,b,d,x,y);
+         case 0x55: return BernsteinDiffusionApply3D<5,5>(NE,map,b,d,x,y);
+         case 0x66: return BernsteinDiffusionApply3D<6,6>(NE,map,b,d,x,y);
+         case 0x77: return BernsteinDiffusionApply3D<7,7>(NE,map,b,d,x,y);
+         default: return BernsteinDiffusionApply3D(NE,map,b,d,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+/** Select the quadrature rule of the simplex PA: the collapsed rule with Q1D
+    points per direction for the Bernstein elements (when no rule was set by the
+    user), or @a ir otherwise. Returns true if the Bernstein kernels are
+    used. */
+static bool GetSimplexRule(const FiniteElement &el, const IntegrationRule *ir,
+                           const int Q1D, const IntegrationRule *&rule)
+{
+   const bool bernstein = !ir && GetBernsteinDofMap(el) &&
+                          el.GetOrder() + 1 <= MAX_SIMPLEX_1D &&
+                          Q1D <= MAX_SIMPLEX_1D;
+   rule = bernstein ? &IntRules.GetCollapsed(el.GetGeomType(), Q1D) : ir;
+   return bernstein;
+}
+
+void MassIntegrator::AssemblePASimplex(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation &T = *mesh->GetElementTransformation(0);
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Not supported yet... stay tuned!");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim,
+               "Not supported yet... stay tuned!");
+   MFEM_VERIFY(mesh->GetNumGeometries(dim) == 1, "Mixed meshes are not"
+               " supported by the partial assembly");
+
+   const IntegrationRule *ir = IntRule;
+   const int order = 2*el.GetOrder() + T.OrderW();
+   if (GetSimplexRule(el, IntRule, (order + dim + 1)/2, ir))
+   {
+      dofs1D = el.GetOrder() + 1;
+      quad1D = (order + dim + 1)/2;
+      GetBernsteinBasis(el.GetOrder(), quad1D, bernstein);
+   }
+   else
+   {
+      if (!ir) { ir = &GetRule(el, el, T); }
+      bernstein.Destroy();
+   }
+   nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::FULL);
+   if (bernstein.Size() == 0)
+   {
+      dofs1D = maps->ndof;
+      quad1D = maps->nqpt;
+   }
+   Vector coeff;
+   GetScalarCoefficient(Q, fes, *ir, coeff);
+   pa_data.SetSize(nq*ne, Device::GetDeviceMemoryType());
+   PAMassSetupSimplex(dim, nq, ne, ir->GetWeights(), geom->J, coeff, pa_data);
+}
+
+void MassIntegrator::AddMultPASimplex(const Vector &x, Vector &y) const
+{
+   if (bernstein.Size() > 0)
+   {
+      const Array<int> &map = *GetBernsteinDofMap(*fespace->GetFE(0));
+      BernsteinMassApply(dim, dofs1D, quad1D, ne, map, bernstein, pa_data,
+                         x, y);
+   }
+   else
+   {
+      PAMassApplySimplex(ne, maps->ndof, maps->nqpt, maps->B, maps->Bt,
+                         pa_data, x, y);
+   }
+}
+
+void MassIntegrator::AssembleDiagonalPASimplex(Vector &diag) const
+{
+   PAMassDiagonalSimplex(ne, maps->ndof, maps->nqpt, maps->B, pa_data, diag);
+}
+
+void DiffusionIntegrator::AssemblePASimplex(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Not supported yet... stay tuned!");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim,
+               "Not supported yet... stay tuned!");
+   MFEM_VERIFY(mesh->GetNumGeometries(dim) == 1, "Mixed meshes are not"
+               " supported by the partial assembly");
+   MFEM_VERIFY(!VQ && !MQ && !SMQ, "Only scalar coefficients are supported"
+               " by the partial assembly on simplices");
+
+   const IntegrationRule *ir = IntRule;
+   const int order = 2*el.GetOrder() - 2;
+   if (GetSimplexRule(el, IntRule, (order + dim + 1)/2, ir))
+   {
+      dofs1D = el.GetOrder() + 1;
+      quad1D = (order + dim + 1)/2;
+      GetBernsteinBasis(el.GetOrder(), quad1D, bernstein);
+   }
+   else
+   {
+      if (!ir) { ir = &GetRule(el, el); }
+      bernstein.Destroy();
+   }
+   const int nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::FULL);
+   if (bernstein.Size() == 0)
+   {
+      dofs1D = maps->ndof;
+      quad1D = maps->nqpt;
+   }
+   Vector coeff;
+   GetScalarCoefficient(Q, fes, *ir, coeff);
+   const int symmDims = (dim*(dim + 1))/2;
+   pa_data.SetSize(symmDims*nq*ne, Device::GetDeviceMemoryType());
+   PADiffusionSetupSimplex(dim, nq, ne, ir->GetWeights(), geom->J, coeff,
+                           pa_data);
+}
+
+void DiffusionIntegrator::AddMultPASimplex(const Vector &x, Vector &y) const
+{
+   if (bernstein.Size() > 0)
+   {
+      const Array<int> &map = *GetBernsteinDofMap(*fespace->GetFE(0));
+      BernsteinDiffusionApply(dim, dofs1D, quad1D, ne, map, bernstein,
+                              pa_data, x, y);
+   }
+   else if (dim == 2)
+   {
+      PADiffusionApplySimplex<2>(ne, maps->ndof, maps->nqpt, maps->G,
+                                 maps->Gt, pa_data, x, y);
+   }
+   else
+   {
+      PADiffusionApplySimplex<3>(ne, maps->ndof, maps->nqpt, maps->G,
+                                 maps->Gt, pa_data, x, y);
+   }
+}
+
+void DiffusionIntegrator::AssembleDiagonalPASimplex(Vector &diag) const
+{
+   if (dim == 2)
+   {
+      PADiffusionDiagonalSimplex<2>(ne, maps->ndof, maps->nqpt, maps->G,
+                                    pa_data, diag);
+   }
+   else
+   {
+      PADiffusionDiagonalSimplex<3>(ne, maps->ndof, maps->nqpt, maps->G,
+                                    pa_data, diag);
+   }
+}
+
+} // namespace mfem
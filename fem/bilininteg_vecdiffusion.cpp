@@ -205,6 +205,7 @@ void PAVectorDiffusionApply2D(const int NE,
                               const Vector &d_,
                               const Vector &x_,
                               Vector &y_,
+                              const ElementGather &gather,
                               const int d1d = 0,
                               const int q1d = 0,
                               const int vdim = 0)
@@ -221,8 +222,9 @@ void PAVectorDiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, VDIM, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, VDIM, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, gather.Size(NE),
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       const int VDIM = T_VDIM ? T_VDIM : vdim;
@@ -250,7 +252,9 @@ void PAVectorDiffusionApply2D(const int NE,
             }
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const double s = x(dx,dy,c,e);
+               const double s = gather.Fused() ?
+                                gather.Gather(x, e, dx + D1D*dy, c) :
+                                x(dx,dy,c,e);
                for (int qx = 0; qx < Q1D; ++qx)
                {
                   gradX[qx][0] += s * B(qx,dx);
@@ -309,7 +313,13 @@ void PAVectorDiffusionApply2D(const int NE,
                const double wDy = Gt(dy,qy);
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+                  const double val =
+                     (gradX[dx][0] * wy) + (gradX[dx][1] * wDy);
+                  if (gather.Fused())
+                  {
+                     gather.Scatter(y, e, dx + D1D*dy, val, c);
+                  }
+                  else { y(dx,dy,c,e) += val; }
                }
             }
          }
@@ -328,6 +338,7 @@ void PAVectorDiffusionApply3D(const int NE,
                               const Vector &_op,
                               const Vector &_x,
                               Vector &_y,
+                              const ElementGather &gather,
                               int d1d = 0, int q1d = 0)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
@@ -342,8 +353,9 @@ void PAVectorDiffusionApply3D(const int NE,
    auto op = Reshape(_op.Read(), Q1D*Q1D*Q1D, 6, NE);
    auto x = Reshape(_x.Read(), D1D, D1D, D1D, VDIM, NE);
    auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i, gather.Size(NE),
    {
+      const int e = gather.Element(i);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -385,7 +397,9 @@ void PAVectorDiffusionApply3D(const int NE,
                }
                for (int dx = 0; dx < D1D; ++dx)
                {
-                  const double s = x(dx,dy,dz,c,e);
+                  const int d = dx + D1D*(dy + D1D*dz);
+                  const double s = gather.Fused() ? gather.Gather(x, e, d, c) :
+                                   x(dx,dy,dz,c,e);
                   for (int qx = 0; qx < Q1D; ++qx)
                   {
                      gradX[qx][0] += s * B(qx,dx);
@@ -499,10 +513,15 @@ void PAVectorDiffusionApply3D(const int NE,
                {
                   for (int dx = 0; dx < D1D; ++dx)
                   {
-                     y(dx,dy,dz,c,e) +=
+                     const double val =
                         ((gradXY[dy][dx][0] * wz) +
                          (gradXY[dy][dx][1] * wz) +
                          (gradXY[dy][dx][2] * wDz));
+                     if (gather.Fused())
+                     {
+                        gather.Scatter(y, e, dx + D1D*(dy + D1D*dz), val, c);
+                     }
+                     else { y(dx,dy,dz,c,e) += val; }
                   }
                }
             }
@@ -511,6 +530,45 @@ void PAVectorDiffusionApply3D(const int NE,
    });
 }
 
+static void PAVectorDiffusionApply(const int dim,
+                                   const int sdim,
+                                   const int D1D,
+                                   const int Q1D,
+                                   const int NE,
+                                   const Array<double> &B,
+                                   const Array<double> &G,
+                                   const Array<double> &Bt,
+                                   const Array<double> &Gt,
+                                   const Vector &D,
+                                   const Vector &x,
+                                   Vector &y,
+                                   const ElementGather &EG = ElementGather())
+{
+   if (dim == 2 && sdim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return PAVectorDiffusionApply2D<2,2,3>(NE,B,G,Bt,Gt,D,x,y,EG);
+         case 0x33:
+            return PAVectorDiffusionApply2D<3,3,3>(NE,B,G,Bt,Gt,D,x,y,EG);
+         case 0x44:
+            return PAVectorDiffusionApply2D<4,4,3>(NE,B,G,Bt,Gt,D,x,y,EG);
+         case 0x55:
+            return PAVectorDiffusionApply2D<5,5,3>(NE,B,G,Bt,Gt,D,x,y,EG);
+         default:
+            return PAVectorDiffusionApply2D(NE,B,G,Bt,Gt,D,x,y,EG,D1D,Q1D,sdim);
+      }
+   }
+   if (dim == 2 && sdim == 2)
+   { return PAVectorDiffusionApply2D(NE,B,G,Bt,Gt,D,x,y,EG,D1D,Q1D,sdim); }
+
+   if (dim == 3 && sdim == 3)
+   { return PAVectorDiffusionApply3D(NE,B,G,Bt,Gt,D,x,y,EG,D1D,Q1D); }
+
+   MFEM_ABORT("Unknown kernel.");
+}
+
 // PA Diffusion Apply kernel
 void VectorDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
@@ -520,33 +578,21 @@ void VectorDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
    else
    {
-      const int D1D = dofs1D;
-      const int Q1D = quad1D;
-      const Array<double> &B = maps->B;
-      const Array<double> &G = maps->G;
-      const Array<double> &Bt = maps->Bt;
-      const Array<double> &Gt = maps->Gt;
-      const Vector &D = pa_data;
-
-      if (dim == 2 && sdim == 3)
-      {
-         switch ((dofs1D << 4 ) | quad1D)
-         {
-            case 0x22: return PAVectorDiffusionApply2D<2,2,3>(ne,B,G,Bt,Gt,D,x,y);
-            case 0x33: return PAVectorDiffusionApply2D<3,3,3>(ne,B,G,Bt,Gt,D,x,y);
-            case 0x44: return PAVectorDiffusionApply2D<4,4,3>(ne,B,G,Bt,Gt,D,x,y);
-            case 0x55: return PAVectorDiffusionApply2D<5,5,3>(ne,B,G,Bt,Gt,D,x,y);
-            default:
-               return PAVectorDiffusionApply2D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D,sdim);
-         }
-      }
-      if (dim == 2 && sdim == 2)
-      { return PAVectorDiffusionApply2D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D,sdim); }
-
-      if (dim == 3 && sdim == 3)
-      { return PAVectorDiffusionApply3D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D); }
+      PAVectorDiffusionApply(dim, sdim, dofs1D, quad1D, ne,
+                             maps->B, maps->G, maps->Bt, maps->Gt,
+                             pa_data, x, y);
+   }
+}
 
-      MFEM_ABORT("Unknown kernel.");
+void VectorDiffusionIntegrator::AddMultPAFused(const ElementRestriction &R,
+                                               const Vector &x,
+                                               Vector &y) const
+{
+   for (int g = 0; g < R.GetNumElementGroups(); g++)
+   {
+      PAVectorDiffusionApply(dim, sdim, dofs1D, quad1D, ne,
+                             maps->B, maps->G, maps->Bt, maps->Gt,
+                             pa_data, x, y, R.GetElementGather(g));
    }
 }
 
@@ -270,6 +270,152 @@ ComplexLinearForm::operator()(const ComplexGridFunction &gf) const
 }
 
 
+ComplexPAOperator::ComplexPAOperator(BilinearForm &a_r_, BilinearForm &a_i_,
+                                     const Array<int> &ess_tdofs,
+                                     Matrix::DiagonalPolicy policy,
+                                     ComplexOperator::Convention convention)
+   : Operator(2*a_r_.FESpace()->GetTrueVSize()),
+     a_r(a_r_), a_i(a_i_),
+     diag_one(policy == Matrix::DIAG_ONE), conv(convention)
+{
+   MFEM_VERIFY(Supports(a_r, a_i, policy),
+               "the fused partial assembly is not supported for these forms");
+   FiniteElementSpace *fes = a_r.FESpace();
+   const ElementDofOrdering ordering = UsesTensorBasis(*fes) ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   elem_restrict = dynamic_cast<const ElementRestriction*>(
+                      fes->GetElementRestriction(ordering));
+   P = fes->GetProlongationMatrix();
+   ess_tdof_list = ess_tdofs;
+
+   const MemoryType mt = Device::GetDeviceMemoryType();
+   z.SetSize(width, mt);
+   xe.SetSize(2*elem_restrict->Height(), mt);
+   ye.SetSize(2*elem_restrict->Height(), mt);
+   ye.UseDevice(true);
+   if (P)
+   {
+      xl.SetSize(2*fes->GetVSize(), mt);
+      yl.SetSize(2*fes->GetVSize(), mt);
+   }
+}
+
+bool ComplexPAOperator::Supports(BilinearForm &a_r, BilinearForm &a_i,
+                                 Matrix::DiagonalPolicy policy)
+{
+   if (a_r.GetAssemblyLevel() != AssemblyLevel::PARTIAL ||
+       a_i.GetAssemblyLevel() != AssemblyLevel::PARTIAL ||
+       a_r.FESpace() != a_i.FESpace() || DeviceCanUseCeed())
+   {
+      return false;
+   }
+   if (policy != Matrix::DIAG_ONE && policy != Matrix::DIAG_ZERO)
+   {
+      return false;
+   }
+   for (BilinearForm *a : { &a_r, &a_i })
+   {
+      if (a->GetBBFI()->Size() > 0 || a->GetFBFI()->Size() > 0 ||
+          a->GetBFBFI()->Size() > 0)
+      {
+         return false;
+      }
+   }
+   if (a_r.GetDBFI()->Size() == 0 ||
+       a_r.GetDBFI()->Size() != a_i.GetDBFI()->Size())
+   {
+      return false;
+   }
+   FiniteElementSpace *fes = a_r.FESpace();
+   const ElementDofOrdering ordering = UsesTensorBasis(*fes) ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   return dynamic_cast<const ElementRestriction*>(
+             fes->GetElementRestriction(ordering)) != NULL;
+}
+
+void ComplexPAOperator::Mult(const Vector &x, Vector &y) const
+{
+   const int tvsize = width/2;
+   const int csz = ess_tdof_list.Size();
+   auto idx = ess_tdof_list.Read();
+
+   // Eliminate the essential dofs of the input
+   z = x;
+   auto d_z = z.ReadWrite();
+   MFEM_FORALL(i, csz,
+   {
+      d_z[idx[i]] = 0.0;
+      d_z[tvsize + idx[i]] = 0.0;
+   });
+
+   Vector u_r, u_i, v_r, v_i;
+   if (P)
+   {
+      const int vsize = xl.Size()/2;
+      z.Read();
+      u_r.MakeRef(z, 0, tvsize);
+      u_i.MakeRef(z, tvsize, tvsize);
+      xl.Write();
+      v_r.MakeRef(xl, 0, vsize);
+      v_i.MakeRef(xl, vsize, vsize);
+      P->Mult(u_r, v_r);
+      P->Mult(u_i, v_i);
+      v_r.SyncAliasMemory(xl);
+      v_i.SyncAliasMemory(xl);
+      elem_restrict->MultComplex(xl, xe);
+   }
+   else
+   {
+      elem_restrict->MultComplex(z, xe);
+   }
+
+   ye = 0.0;
+   Array<BilinearFormIntegrator*> &integ_r = *a_r.GetDBFI();
+   Array<BilinearFormIntegrator*> &integ_i = *a_i.GetDBFI();
+   for (int i = 0; i < integ_r.Size(); i++)
+   {
+      integ_r[i]->AddMultComplexPA(*integ_i[i], xe, ye);
+   }
+
+   if (P)
+   {
+      const int vsize = yl.Size()/2;
+      elem_restrict->MultTransposeComplex(ye, yl);
+      yl.Read();
+      u_r.MakeRef(yl, 0, vsize);
+      u_i.MakeRef(yl, vsize, vsize);
+      y.Write();
+      v_r.MakeRef(y, 0, tvsize);
+      v_i.MakeRef(y, tvsize, tvsize);
+      P->MultTranspose(u_r, v_r);
+      P->MultTranspose(u_i, v_i);
+      v_r.SyncAliasMemory(y);
+      v_i.SyncAliasMemory(y);
+   }
+   else
+   {
+      elem_restrict->MultTransposeComplex(ye, y);
+   }
+
+   // Essential rows: identity (DIAG_ONE) or zero (DIAG_ZERO) in the real part
+   // of the operator, zero in the imaginary part
+   const bool one = diag_one;
+   auto d_x = x.Read();
+   auto d_y = y.ReadWrite();
+   MFEM_FORALL(i, csz,
+   {
+      const int j = idx[i];
+      d_y[j] = one ? d_x[j] : 0.0;
+      d_y[tvsize + j] = one ? d_x[tvsize + j] : 0.0;
+   });
+   if (conv == ComplexOperator::BLOCK_SYMMETRIC)
+   {
+      MFEM_FORALL(i, tvsize, d_y[tvsize + i] = -d_y[tvsize + i];);
+   }
+}
+
 bool SesquilinearForm::RealInteg()
 {
    int nint = blfr->GetFBFI()->Size() + blfr->GetDBFI()->Size() +
@@ -284,6 +430,19 @@ bool SesquilinearForm::ImagInteg()
    return (nint != 0);
 }
 
+bool SesquilinearForm::FormFusedPAOperator(const Array<int> &ess_tdof_list,
+                                           OperatorHandle &A)
+{
+   if (!fused_pa || !RealInteg() || !ImagInteg() ||
+       !ComplexPAOperator::Supports(*blfr, *blfi, diag_policy))
+   {
+      return false;
+   }
+   A.Reset(new ComplexPAOperator(*blfr, *blfi, ess_tdof_list, diag_policy,
+                                 conv));
+   return true;
+}
+
 SesquilinearForm::SesquilinearForm(FiniteElementSpace *f,
                                    ComplexOperator::Convention convention)
    : conv(convention),
@@ -509,6 +668,7 @@ SesquilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list,
 
    // A = A_r + i A_i
    A.Clear();
+   if (FormFusedPAOperator(ess_tdof_list, A)) { return; }
    if ( A_r.Type() == Operator::MFEM_SPARSEMAT ||
         A_i.Type() == Operator::MFEM_SPARSEMAT )
    {
@@ -570,6 +730,7 @@ SesquilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
 
    // A = A_r + i A_i
    A.Clear();
+   if (FormFusedPAOperator(ess_tdof_list, A)) { return; }
    if ( A_r.Type() == Operator::MFEM_SPARSEMAT ||
         A_i.Type() == Operator::MFEM_SPARSEMAT )
    {
@@ -183,6 +183,46 @@ public:
 };
 
 
+/** @brief Fused partial assembly action of the system operator of a
+    SesquilinearForm, see SesquilinearForm::EnableFusedPA().
+
+    The complex input vector is restricted to an E-vector with interleaved real
+    and imaginary parts, and each pair of real and imaginary domain integrators
+    is applied in a single pass over the E-vector and the quadrature data, see
+    BilinearFormIntegrator::AddMultComplexPA(). The result is the same as the
+    one of the ComplexOperator built from the constrained real and imaginary
+    operators, including the treatment of the essential true dofs and the
+    ComplexOperator::Convention. */
+class ComplexPAOperator : public Operator
+{
+protected:
+   BilinearForm &a_r, &a_i;
+   const ElementRestriction *elem_restrict; // Not owned
+   const Operator *P; // Not owned
+   Array<int> ess_tdof_list;
+   bool diag_one;
+   ComplexOperator::Convention conv;
+   mutable Vector z, xl, yl, xe, ye;
+
+public:
+   /** Construct the operator for the partially assembled forms @a a_r and
+       @a a_i, see Supports(), with essential true dofs @a ess_tdofs. */
+   ComplexPAOperator(BilinearForm &a_r, BilinearForm &a_i,
+                     const Array<int> &ess_tdofs,
+                     Matrix::DiagonalPolicy policy,
+                     ComplexOperator::Convention convention);
+
+   /** @brief Return true if the fused action is supported for the forms
+       @a a_r and @a a_i: both are partially assembled on the same space,
+       with the same number of domain integrators and no other integrators,
+       and @a policy is DIAG_ONE or DIAG_ZERO. */
+   static bool Supports(BilinearForm &a_r, BilinearForm &a_i,
+                        Matrix::DiagonalPolicy policy);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+
 /** Class for sesquilinear form
 
     A sesquilinear form is a generalization of a bilinear form to complex-valued
@@ -211,11 +251,19 @@ private:
    BilinearForm *blfr;
    BilinearForm *blfi;
 
+   /// Use the fused partial assembly operator, see EnableFusedPA().
+   bool fused_pa = false;
+
    /* These methods check if the real/imag parts of the sesquilinear form are
       not empty */
    bool RealInteg();
    bool ImagInteg();
 
+   /* Set @a A to the fused partial assembly operator if it is enabled and
+      supported, returns false otherwise. */
+   bool FormFusedPAOperator(const Array<int> &ess_tdof_list,
+                            OperatorHandle &A);
+
 public:
    SesquilinearForm(FiniteElementSpace *fes,
                     ComplexOperator::Convention
@@ -251,6 +299,17 @@ public:
       blfi->SetAssemblyLevel(assembly_level);
    }
 
+   /** @brief Use fused partial assembly kernels for the system operator
+       returned by FormSystemMatrix() and FormLinearSystem() (default: false).
+       */
+   /** With AssemblyLevel::PARTIAL, the system operator is then a
+       ComplexPAOperator that applies the real and imaginary integrators in a
+       single pass over interleaved complex E-vectors, instead of a
+       ComplexOperator applying the real and imaginary parts separately. This
+       requires pairs of real and imaginary domain integrators; otherwise the
+       ComplexOperator is used. */
+   void EnableFusedPA(bool fused = true) { fused_pa = fused; }
+
    BilinearForm & real() { return *blfr; }
    BilinearForm & imag() { return *blfi; }
    const BilinearForm & real() const { return *blfr; }
@@ -32,6 +32,7 @@ FiniteElement::FiniteElement(int D, Geometry::Type G, int Do, int O, int F)
    deriv_range_type = SCALAR;
    deriv_map_type = VALUE;
    for (int i = 0; i < Geometry::MaxDim; i++) { orders[i] = -1; }
+   for (int i = 0; i < MaxFastDofToQuad; i++) { dof2quad_fast[i] = NULL; }
 #ifndef MFEM_THREAD_SAFE
    vshape.SetSize(dof, dim);
 #endif
@@ -389,6 +390,66 @@ FiniteElement::~FiniteElement()
    }
 }
 
+const DofToQuad *FiniteElement::FindDofToQuad(
+   const Array<DofToQuad*> &d2q_array,
+   const std::atomic<const DofToQuad*> *d2q_fast,
+   const IntegrationRule &ir, DofToQuad::Mode mode)
+{
+   for (int i = 0; i < MaxFastDofToQuad; i++)
+   {
+      const DofToQuad *d2q = d2q_fast[i].load(std::memory_order_acquire);
+      if (d2q == NULL) { return NULL; }
+      if (d2q->IntRule == &ir && d2q->mode == mode) { return d2q; }
+   }
+   const DofToQuad *found = NULL;
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp critical (DofToQuad)
+#endif
+   {
+      for (int i = MaxFastDofToQuad; i < d2q_array.Size(); i++)
+      {
+         const DofToQuad *d2q = d2q_array[i];
+         if (d2q->IntRule == &ir && d2q->mode == mode) { found = d2q; break; }
+      }
+   }
+   return found;
+}
+
+const DofToQuad &FiniteElement::AddDofToQuad(
+   Array<DofToQuad*> &d2q_array, std::atomic<const DofToQuad*> *d2q_fast,
+   DofToQuad *d2q)
+{
+   const DofToQuad *found = NULL;
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp critical (DofToQuad)
+#endif
+   {
+      for (int i = 0; i < d2q_array.Size(); i++)
+      {
+         const DofToQuad *other = d2q_array[i];
+         if (other->IntRule == d2q->IntRule && other->mode == d2q->mode)
+         {
+            found = other;
+            break;
+         }
+      }
+      if (!found)
+      {
+         const int i = d2q_array.Append(d2q) - 1;
+         if (i < MaxFastDofToQuad)
+         {
+            d2q_fast[i].store(d2q, std::memory_order_release);
+         }
+      }
+   }
+   if (found)
+   {
+      delete d2q;
+      return *found;
+   }
+   return *d2q;
+}
+
 
 void ScalarFiniteElement::NodalLocalInterpolation (
    ElementTransformation &Trans, DenseMatrix &I,
@@ -507,11 +568,9 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
 {
    MFEM_VERIFY(mode == DofToQuad::FULL, "invalid mode requested");
 
-   for (int i = 0; i < dof2quad_array.Size(); i++)
-   {
-      const DofToQuad &d2q = *dof2quad_array[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found =
+      FindDofToQuad(dof2quad_array, dof2quad_fast, ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const int nqpt = ir.GetNPoints();
@@ -545,8 +604,7 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
          }
       }
    }
-   dof2quad_array.Append(d2q);
-   return *d2q;
+   return AddDofToQuad(dof2quad_array, dof2quad_fast, d2q);
 }
 
 // protected method
@@ -556,11 +614,9 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
-   for (int i = 0; i < dof2quad_array.Size(); i++)
-   {
-      const DofToQuad &d2q = *dof2quad_array[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   const DofToQuad *found =
+      FindDofToQuad(dof2quad_array, dof2quad_fast, ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const Poly_1D::Basis &basis_1d = tb.GetBasis1D();
@@ -587,8 +643,7 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
          d2q->G[i+nqpt*j] = d2q->Gt[j+ndof*i] = grad(j);
       }
    }
-   dof2quad_array.Append(d2q);
-   return *d2q;
+   return AddDofToQuad(dof2quad_array, dof2quad_fast, d2q);
 }
 
 
@@ -2046,7 +2101,7 @@ void H1Ser_QuadrilateralElement::CalcShape(const IntegrationPoint &ip,
       shape(4 + 4*(p-1) - i - 1) = (nodalY(i+1)) * (1. - x); // west edge  0->3
    }
 
-   BiLinear2DFiniteElement bilinear = BiLinear2DFiniteElement();
+   BiLinear2DFiniteElement bilinear;
    Vector bilinearsAtIP(4);
    bilinear.CalcShape(ip, bilinearsAtIP);
 
@@ -2132,7 +2187,7 @@ void H1Ser_QuadrilateralElement::CalcDShape(const IntegrationPoint &ip,
       dshape(4 + 4*(p-1) - i - 1,1) =  DnodalY(i+1) * (1.-x);
    }
 
-   BiLinear2DFiniteElement bilinear = BiLinear2DFiniteElement();
+   BiLinear2DFiniteElement bilinear;
    DenseMatrix DbilinearsAtIP(4);
    bilinear.CalcDShape(ip, DbilinearsAtIP);
 
@@ -7742,7 +7797,10 @@ VectorTensorFiniteElement::VectorTensorFiniteElement(const int dims,
                          p, M, FunctionSpace::Qk),
      TensorBasisElement(dims, p, VerifyNodal(cbtype), dmtype),
      cbasis1d(poly1d.GetBasis(p, VerifyClosed(cbtype))),
-     obasis1d(poly1d.GetBasis(p - 1, VerifyOpen(obtype))) { }
+     obasis1d(poly1d.GetBasis(p - 1, VerifyOpen(obtype)))
+{
+   for (int i = 0; i < MaxFastDofToQuad; i++) { dof2quad_fast_open[i] = NULL; }
+}
 
 H1_SegmentElement::H1_SegmentElement(const int p, const int btype)
    : NodalTensorFiniteElement(1, p, VerifyClosed(btype), H1_DOF_MAP)
@@ -11778,13 +11836,12 @@ const DofToQuad &VectorTensorFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
-   for (int i = 0;
-        i < (closed ? dof2quad_array.Size() : dof2quad_array_open.Size());
-        i++)
-   {
-      const DofToQuad &d2q = closed ? *dof2quad_array[i] : *dof2quad_array_open[i];
-      if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
-   }
+   Array<DofToQuad*> &d2q_array =
+      closed ? dof2quad_array : dof2quad_array_open;
+   std::atomic<const DofToQuad*> *d2q_fast =
+      closed ? dof2quad_fast : dof2quad_fast_open;
+   const DofToQuad *found = FindDofToQuad(d2q_array, d2q_fast, ir, mode);
+   if (found) { return *found; }
 
    DofToQuad *d2q = new DofToQuad;
    const int ndof = closed ? order + 1 : order;
@@ -11820,16 +11877,7 @@ const DofToQuad &VectorTensorFiniteElement::GetTensorDofToQuad(
       }
    }
 
-   if (closed)
-   {
-      dof2quad_array.Append(d2q);
-   }
-   else
-   {
-      dof2quad_array_open.Append(d2q);
-   }
-
-   return *d2q;
+   return AddDofToQuad(d2q_array, d2q_fast, d2q);
 }
 
 VectorTensorFiniteElement::~VectorTensorFiniteElement()
@@ -19,6 +19,7 @@
 #include "geom.hpp"
 
 #include <map>
+#include <atomic>
 
 namespace mfem
 {
@@ -252,6 +253,31 @@ protected:
        or different DofToQuad::Mode are used. */
    mutable Array<DofToQuad*> dof2quad_array;
 
+   /// Number of DofToQuad objects that can be found without locking.
+   static const int MaxFastDofToQuad = 8;
+   /// The first MaxFastDofToQuad entries of #dof2quad_array.
+   /** Entries are set once, after the DofToQuad object is fully initialized,
+       and can be read while another thread adds new DofToQuad objects. */
+   mutable std::atomic<const DofToQuad*> dof2quad_fast[MaxFastDofToQuad];
+
+   /** @brief Return the DofToQuad object for @a ir and @a mode stored in the
+       cache @a d2q_array, @a d2q_fast, or NULL if there is none. */
+   /** The search is lock-free for the first MaxFastDofToQuad entries. */
+   static const DofToQuad *FindDofToQuad(
+      const Array<DofToQuad*> &d2q_array,
+      const std::atomic<const DofToQuad*> *d2q_fast,
+      const IntegrationRule &ir, DofToQuad::Mode mode);
+
+   /** @brief Add the new DofToQuad object @a d2q to the cache @a d2q_array,
+       @a d2q_fast and return it. */
+   /** If another thread added an object with the same rule and mode since the
+       last FindDofToQuad() call, @a d2q is deleted and that object is
+       returned instead. This method is thread-safe when MFEM is built with
+       MFEM_USE_LEGACY_OPENMP. */
+   static const DofToQuad &AddDofToQuad(
+      Array<DofToQuad*> &d2q_array, std::atomic<const DofToQuad*> *d2q_fast,
+      DofToQuad *d2q);
+
 public:
    /// Enumeration for range_type and deriv_range_type
    enum RangeType { SCALAR, VECTOR };
@@ -2104,6 +2130,7 @@ class VectorTensorFiniteElement : public VectorFiniteElement,
 {
 private:
    mutable Array<DofToQuad*> dof2quad_array_open;
+   mutable std::atomic<const DofToQuad*> dof2quad_fast_open[MaxFastDofToQuad];
 
 protected:
    Poly_1D::Basis &cbasis1d, &obasis1d;
@@ -2333,6 +2360,10 @@ public:
    virtual void CalcShape(const IntegrationPoint &ip, Vector &shape) const;
    virtual void CalcDShape(const IntegrationPoint &ip,
                            DenseMatrix &dshape) const;
+
+   /** @brief Get the map from the lexicographic ordering of the Bernstein
+       basis functions, as in CalcShape(p,...), to the native dof ordering. */
+   const Array<int> &GetDofMap() const { return dof_map; }
 };
 
 
@@ -2362,6 +2393,10 @@ public:
    virtual void CalcShape(const IntegrationPoint &ip, Vector &shape) const;
    virtual void CalcDShape(const IntegrationPoint &ip,
                            DenseMatrix &dshape) const;
+
+   /** @brief Get the map from the lexicographic ordering of the Bernstein
+       basis functions, as in CalcShape(p,...), to the native dof ordering. */
+   const Array<int> &GetDofMap() const { return dof_map; }
 };
 
 
@@ -91,6 +91,10 @@ FiniteElementSpace::FiniteElementSpace(const FiniteElementSpace &orig,
       }
    }
    Constructor(mesh, NURBSext, fec, orig.vdim, orig.ordering);
+   if (orig.dof_perm.Size() && mesh == orig.mesh && ndofs == orig.ndofs)
+   {
+      ReorderDofs(orig.dof_perm);
+   }
 }
 
 int FiniteElementSpace::GetOrder(int i) const
@@ -309,6 +313,84 @@ void FiniteElementSpace::ReorderElementToDofTable()
    }
 }
 
+void FiniteElementSpace::ReorderDofs(const Array<int> &ordering)
+{
+   MFEM_VERIFY(!NURBSext, "NURBS spaces are not supported");
+   MFEM_VERIFY(Conforming(), "nonconforming spaces are not supported");
+#ifdef MFEM_USE_MPI
+   MFEM_VERIFY(!dynamic_cast<ParMesh*>(mesh),
+               "parallel spaces are not supported");
+#endif
+   MFEM_VERIFY(ordering.Size() == ndofs, "invalid ordering size");
+
+   // Compose the new ordering with the current one
+   Array<int> new_perm(ndofs), marker(ndofs);
+   marker = 0;
+   for (int i = 0; i < ndofs; i++)
+   {
+      const int dof = ordering[dof_perm.Size() ? dof_perm[i] : i];
+      MFEM_VERIFY(0 <= dof && dof < ndofs && !marker[dof],
+                  "the ordering is not a permutation");
+      marker[dof] = 1;
+      new_perm[i] = dof;
+   }
+   mfem::Swap(dof_perm, new_perm);
+
+   // Rebuild the dof tables and clear everything that depends on them
+   delete elem_dof;
+   delete bdrElem_dof;
+   delete face_dof;
+   elem_dof = bdrElem_dof = face_dof = NULL;
+   L2E_nat.Clear();
+   L2E_lex.Clear();
+   for (auto &x : L2F)
+   {
+      delete x.second;
+   }
+   L2F.clear();
+   dof_elem_array.DeleteAll();
+   dof_ldof_array.DeleteAll();
+   RemoveCeedBasisAndRestriction(this);
+
+   BuildElementToDofTable();
+}
+
+Table *FiniteElementSpace::GetDofToDofTable() const
+{
+   // Copy of elem_dof with the signs removed
+   BuildElementToDofTable();
+   Table elem_udof(*elem_dof);
+   int *J = elem_udof.GetJ();
+   for (int k = 0; k < elem_udof.Size_of_connections(); k++)
+   {
+      J[k] = DecodeDof(J[k]);
+   }
+
+   Table udof_elem, *dof_dof = new Table;
+   Transpose(elem_udof, udof_elem, ndofs);
+   mfem::Mult(udof_elem, elem_udof, *dof_dof);
+   return dof_dof;
+}
+
+void FiniteElementSpace::GetRCMDofOrdering(Array<int> &ordering) const
+{
+   Table *dof_dof = GetDofToDofTable();
+   SparseMatrix graph(dof_dof->GetI(), dof_dof->GetJ(), NULL, ndofs, ndofs,
+                      false, false, false);
+   graph.GetRCMOrdering(ordering);
+   delete dof_dof;
+}
+
+void FiniteElementSpace::GetNestedDissectionDofOrdering(Array<int> &ordering,
+                                                        int leaf_size) const
+{
+   Table *dof_dof = GetDofToDofTable();
+   SparseMatrix graph(dof_dof->GetI(), dof_dof->GetJ(), NULL, ndofs, ndofs,
+                      false, false, false);
+   graph.GetNestedDissectionOrdering(ordering, leaf_size);
+   delete dof_dof;
+}
+
 void FiniteElementSpace::BuildDofToArrays()
 {
    if (dof_elem_array.Size()) { return; }
@@ -1635,6 +1717,7 @@ void FiniteElementSpace::Construct()
    elem_dof = NULL;
    bdrElem_dof = NULL;
    face_dof = NULL;
+   dof_perm.DeleteAll();
 
    ndofs = 0;
    nedofs = nfdofs = nbdofs = 0;
@@ -1792,6 +1875,7 @@ void FiniteElementSpace::GetElementDofs(int i, Array<int> &dofs) const
             dofs[ne+j] = k + j;
          }
       }
+      ApplyDofOrdering(dofs);
    }
 }
 
@@ -1892,6 +1976,7 @@ void FiniteElementSpace::GetBdrElementDofs(int i, Array<int> &dofs) const
             }
          }
       }
+      ApplyDofOrdering(dofs);
    }
 }
 
@@ -1960,6 +2045,7 @@ void FiniteElementSpace::GetFaceDofs(int i, Array<int> &dofs) const
             dofs[ne+k] = j;
          }
       }
+      ApplyDofOrdering(dofs);
    }
 }
 
@@ -1990,6 +2076,7 @@ void FiniteElementSpace::GetEdgeDofs(int i, Array<int> &dofs) const
    {
       dofs[nv+j] = k;
    }
+   ApplyDofOrdering(dofs);
 }
 
 void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
@@ -2002,6 +2089,7 @@ void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
    {
       dofs[j] = i*nv+j;
    }
+   ApplyDofOrdering(dofs);
 }
 
 void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
@@ -2015,6 +2103,7 @@ void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k + j;
    }
+   ApplyDofOrdering(dofs);
 }
 
 void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
@@ -2027,6 +2116,7 @@ void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k;
    }
+   ApplyDofOrdering(dofs);
 }
 
 void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
@@ -2042,6 +2132,7 @@ void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
          dofs[j] = k;
       }
    }
+   ApplyDofOrdering(dofs);
 }
 
 const FiniteElement *FiniteElementSpace::GetBE (int i) const
@@ -117,6 +117,9 @@ protected:
 
    Array<int> dof_elem_array, dof_ldof_array;
 
+   /// New indices of the scalar dofs set by ReorderDofs(), empty if not used.
+   Array<int> dof_perm;
+
    NURBSExtension *NURBSext;
    int own_ext;
 
@@ -169,6 +172,21 @@ protected:
        boundary. */
    void BuildNURBSFaceToDofTable() const;
 
+   /** @brief Apply the renumbering of ReorderDofs(), if any, to the (signed)
+       dofs computed from the mesh entities. */
+   inline void ApplyDofOrdering(Array<int> &dofs) const
+   {
+      if (dof_perm.Size() == 0) { return; }
+      for (int i = 0; i < dofs.Size(); i++)
+      {
+         const int d = dofs[i];
+         dofs[i] = (d >= 0) ? dof_perm[d] : -1 - dof_perm[-1-d];
+      }
+   }
+
+   /// Return the connectivity of the scalar dofs through the mesh elements.
+   Table *GetDofToDofTable() const;
+
    /// Helpers to remove encoded sign from a DOF
    static inline int DecodeDof(int dof)
    {
@@ -538,6 +556,31 @@ public:
        is preserved. */
    void ReorderElementToDofTable();
 
+   /** @brief Renumber the scalar dofs: dof i gets the new index
+       @a ordering[i], where @a ordering is a permutation of 0,...,ndofs-1.
+
+       The renumbering is applied consistently to all dof queries: element,
+       boundary element, face, edge and vertex dofs. The signs of signed dofs
+       are preserved. Use with a bandwidth-reducing ordering, see
+       GetRCMDofOrdering(), to improve the locality of the assembled matrices
+       and of the dof-indexed vectors.
+
+       This method can be used only with conforming, non-NURBS, serial spaces
+       and must be called before any objects (e.g. GridFunction%s, bilinear and
+       linear forms) are built on the space. The renumbering is discarded by
+       Update(). */
+   void ReorderDofs(const Array<int> &ordering);
+
+   /** @brief Compute the reverse Cuthill-McKee ordering of the scalar dofs for
+       ReorderDofs(), see SparseMatrix::GetRCMOrdering(). Dofs are connected if
+       they belong to a common element. */
+   void GetRCMDofOrdering(Array<int> &ordering) const;
+
+   /** @brief Compute a nested dissection ordering of the scalar dofs for
+       ReorderDofs(), see SparseMatrix::GetNestedDissectionOrdering(). */
+   void GetNestedDissectionDofOrdering(Array<int> &ordering,
+                                       int leaf_size = 64) const;
+
    /** @brief Return a reference to the internal Table that stores the lists of
        scalar dofs, for each mesh element, as returned by GetElementDofs(). */
    const Table &GetElementToDofTable() const { return *elem_dof; }
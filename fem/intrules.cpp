@@ -881,6 +881,22 @@ IntegrationRules RefinedIntRules(1, Quadrature1D::GaussLegendre);
 IntegrationRules::IntegrationRules(int Ref, int _type):
    quad_type(_type)
 {
+   static_assert(NumGeom == Geometry::NumGeom, "invalid NumGeom");
+   for (int g = 0; g < NumGeom; g++)
+   {
+      for (int o = 0; o < MaxFastOrder; o++) { fast_rules[g][o] = NULL; }
+   }
+   for (int t = 0; t < 2; t++)
+   {
+      for (int n = 0; n < MaxFastOrder; n++)
+      {
+         fast_collapsed_rules[t][n] = NULL;
+      }
+   }
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_init_nest_lock(&lock);
+#endif
+
    refined = Ref;
 
    if (refined < 0) { own_rules = 0; return; }
@@ -914,11 +930,27 @@ IntegrationRules::IntegrationRules(int Ref, int _type):
 
 const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
 {
+   if (GeomType == Geometry::POINT || Order < 0)
+   {
+      Order = 0;
+   }
+
+   if (GeomType >= 0 && GeomType < NumGeom && Order < MaxFastOrder)
+   {
+      const IntegrationRule *ir =
+         fast_rules[GeomType][Order].load(std::memory_order_acquire);
+      if (ir) { return *ir; }
+   }
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_set_nest_lock(&lock);
+#endif
+
    Array<IntegrationRule *> *ir_array;
 
    switch (GeomType)
    {
-      case Geometry::POINT:       ir_array = &PointIntRules; Order = 0; break;
+      case Geometry::POINT:       ir_array = &PointIntRules; break;
       case Geometry::SEGMENT:     ir_array = &SegmentIntRules; break;
       case Geometry::TRIANGLE:    ir_array = &TriangleIntRules; break;
       case Geometry::SQUARE:      ir_array = &SquareIntRules; break;
@@ -930,32 +962,92 @@ const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
          ir_array = NULL;
    }
 
-   if (Order < 0)
+   if (!HaveIntRule(*ir_array, Order))
    {
-      Order = 0;
+      IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
+      int RealOrder = Order;
+      while (RealOrder+1 < ir_array->Size() &&
+      /*  */ (*ir_array)[RealOrder+1] == ir)
+      {
+         RealOrder++;
+      }
+      ir->SetOrder(RealOrder);
    }
 
-   if (!HaveIntRule(*ir_array, Order))
+   IntegrationRule *ir = (*ir_array)[Order];
+   // The weights array is computed on demand: create it before the rule can
+   // be shared between threads.
+   ir->GetWeights();
+   if (Order < MaxFastOrder)
    {
+      fast_rules[GeomType][Order].store(ir, std::memory_order_release);
+   }
+
 #ifdef MFEM_USE_LEGACY_OPENMP
-      #pragma omp critical
+   omp_unset_nest_lock(&lock);
 #endif
+
+   return *ir;
+}
+
+const IntegrationRule &IntegrationRules::GetCollapsed(int GeomType, int n)
+{
+   MFEM_VERIFY(GeomType == Geometry::TRIANGLE ||
+               GeomType == Geometry::TETRAHEDRON,
+               "IntegrationRules::GetCollapsed(...) : invalid geometry type!");
+   MFEM_VERIFY(n > 0 && n < MaxFastOrder,
+               "IntegrationRules::GetCollapsed(...) : invalid n = " << n);
+   const int tet = (GeomType == Geometry::TETRAHEDRON);
+   const IntegrationRule *fast_ir =
+      fast_collapsed_rules[tet][n].load(std::memory_order_acquire);
+   if (fast_ir) { return *fast_ir; }
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_set_nest_lock(&lock);
+#endif
+
+   Array<IntegrationRule *> &ir_array =
+      tet ? CollapsedTetrahedronIntRules : CollapsedTriangleIntRules;
+   AllocIntRule(ir_array, n);
+   if (!ir_array[n])
+   {
+      const IntegrationRule &ir1D = Get(Geometry::SEGMENT, 2*n - 1);
+      MFEM_VERIFY(ir1D.GetNPoints() == n,
+                  "IntegrationRules::GetCollapsed(...) : invalid 1D rule!");
+      const int nz = tet ? n : 1;
+      IntegrationRule *ir = new IntegrationRule(n*n*nz);
+      for (int qc = 0; qc < nz; qc++)
       {
-         if (!HaveIntRule(*ir_array, Order))
+         const double c = tet ? ir1D.IntPoint(qc).x : 0.0;
+         const double wc =
+            tet ? ir1D.IntPoint(qc).weight*(1.0 - c)*(1.0 - c) : 1.0;
+         for (int qb = 0; qb < n; qb++)
          {
-            IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
-            int RealOrder = Order;
-            while (RealOrder+1 < ir_array->Size() &&
-            /*  */ (*ir_array)[RealOrder+1] == ir)
+            const double b = ir1D.IntPoint(qb).x;
+            const double wb = ir1D.IntPoint(qb).weight*(1.0 - b);
+            for (int qa = 0; qa < n; qa++)
             {
-               RealOrder++;
+               const double a = ir1D.IntPoint(qa).x;
+               IntegrationPoint &ip = ir->IntPoint(qa + n*(qb + n*qc));
+               ip.x = a*(1.0 - b)*(1.0 - c);
+               ip.y = b*(1.0 - c);
+               ip.z = c;
+               ip.weight = ir1D.IntPoint(qa).weight*wb*wc;
             }
-            ir->SetOrder(RealOrder);
          }
       }
+      ir->SetOrder(tet ? 2*n - 3 : 2*n - 2);
+      ir->GetWeights();
+      ir_array[n] = ir;
    }
+   fast_collapsed_rules[tet][n].store(ir_array[n], std::memory_order_release);
+   const IntegrationRule &ir = *ir_array[n];
 
-   return *(*ir_array)[Order];
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_unset_nest_lock(&lock);
+#endif
+
+   return ir;
 }
 
 void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
@@ -976,6 +1068,10 @@ void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
          ir_array = NULL;
    }
 
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_set_nest_lock(&lock);
+#endif
+
    if (HaveIntRule(*ir_array, Order))
    {
       MFEM_ABORT("Overwriting set rules is not supported!");
@@ -984,6 +1080,10 @@ void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
    AllocIntRule(*ir_array, Order);
 
    (*ir_array)[Order] = &IntRule;
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_unset_nest_lock(&lock);
+#endif
 }
 
 void IntegrationRules::DeleteIntRuleArray(Array<IntegrationRule *> &ir_array)
@@ -1005,6 +1105,14 @@ void IntegrationRules::DeleteIntRuleArray(Array<IntegrationRule *> &ir_array)
 
 IntegrationRules::~IntegrationRules()
 {
+#ifdef MFEM_USE_LEGACY_OPENMP
+   omp_destroy_nest_lock(&lock);
+#endif
+
+   // The collapsed rules are always generated by this object
+   DeleteIntRuleArray(CollapsedTriangleIntRules);
+   DeleteIntRuleArray(CollapsedTetrahedronIntRules);
+
    if (!own_rules) { return; }
 
    DeleteIntRuleArray(PointIntRules);
@@ -1524,7 +1632,8 @@ IntegrationRule *IntegrationRules::SquareIntegrationRule(int Order)
    // Order is one of {RealOrder-1,RealOrder}
    if (!HaveIntRule(SegmentIntRules, RealOrder))
    {
-      SegmentIntegrationRule(RealOrder);
+      // Also sets the order of the segment rule
+      Get(Geometry::SEGMENT, RealOrder);
    }
    AllocIntRule(SquareIntRules, RealOrder); // RealOrder >= Order
    SquareIntRules[RealOrder-1] =
@@ -1676,7 +1785,8 @@ IntegrationRule *IntegrationRules::CubeIntegrationRule(int Order)
    int RealOrder = GetSegmentRealOrder(Order);
    if (!HaveIntRule(SegmentIntRules, RealOrder))
    {
-      SegmentIntegrationRule(RealOrder);
+      // Also sets the order of the segment rule
+      Get(Geometry::SEGMENT, RealOrder);
    }
    AllocIntRule(CubeIntRules, RealOrder);
    CubeIntRules[RealOrder-1] =
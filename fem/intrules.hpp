@@ -15,6 +15,11 @@
 #include "../config/config.hpp"
 #include "../general/array.hpp"
 
+#include <atomic>
+#ifdef MFEM_USE_LEGACY_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -327,6 +332,29 @@ private:
    Array<IntegrationRule *> PrismIntRules;
    Array<IntegrationRule *> CubeIntRules;
 
+   /// Number of geometry types, see Geometry::Type.
+   static const int NumGeom = 7;
+   /// Rules of order less than MaxFastOrder are entered in #fast_rules.
+   static const int MaxFastOrder = 64;
+   /** @brief Rules returned by Get(), indexed by geometry type and order, that
+       can be read without locking.
+
+       The arrays above may be reallocated when new rules are generated, so in
+       threaded builds they are only accessed while holding #lock. An entry of
+       this table is set once, after the rule has been fully initialized. */
+   std::atomic<const IntegrationRule *> fast_rules[NumGeom][MaxFastOrder];
+   /// Collapsed rules, see GetCollapsed(), indexed by the number of 1D points.
+   Array<IntegrationRule *> CollapsedTriangleIntRules;
+   Array<IntegrationRule *> CollapsedTetrahedronIntRules;
+   /** @brief Lock-free lookup table of the collapsed rules on triangles (0) and
+       tetrahedra (1), set like #fast_rules. */
+   std::atomic<const IntegrationRule *> fast_collapsed_rules[2][MaxFastOrder];
+#ifdef MFEM_USE_LEGACY_OPENMP
+   /// Serializes the generation of rules; nestable since the generation of
+   /// some rules calls Get() for other geometries.
+   omp_nest_lock_t lock;
+#endif
+
    void AllocIntRule(Array<IntegrationRule *> &ir_array, int Order)
    {
       if (ir_array.Size() <= Order)
@@ -364,8 +392,23 @@ public:
                              int type = Quadrature1D::GaussLegendre);
 
    /// Returns an integration rule for given GeomType and Order.
+   /** Rules are generated the first time they are requested. This method may
+       be called concurrently from multiple threads when MFEM is built with
+       MFEM_USE_LEGACY_OPENMP; the lookup of an existing rule does not lock. */
    const IntegrationRule &Get(int GeomType, int Order);
 
+   /** @brief Returns the collapsed tensor-product rule on the reference
+       triangle or tetrahedron with the @a n points of the segment rule of
+       order 2n-1 in each of the collapsed coordinates (a,b) or (a,b,c):
+
+           triangle:     x = a (1-b),         y = b,
+           tetrahedron:  x = a (1-b) (1-c),   y = b (1-c),   z = c.
+
+       The points are ordered with a running fastest. The rule is exact for
+       polynomials of degree 2n-2 on triangles and 2n-3 on tetrahedra. Like
+       Get(), this method may be called concurrently from multiple threads. */
+   const IntegrationRule &GetCollapsed(int GeomType, int n);
+
    void Set(int GeomType, int Order, IntegrationRule &IntRule);
 
    void SetOwnRules(int o) { own_rules = o; }
@@ -24,6 +24,9 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   fast_assembly = lf->fast_assembly;
+   ext = NULL;
+   device_domain_check = device_bdr_check = -1;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -31,6 +34,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
    dlfi_delta = lf->dlfi_delta;
 
    blfi = lf->blfi;
+   blfi_marker = lf->blfi_marker;
 
    flfi = lf->flfi;
    flfi_marker = lf->flfi_marker;
@@ -76,8 +80,71 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+bool LinearForm::SupportsDevice() const
+{
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      if (!dlfi[k]->SupportsDevice()) { return false; }
+   }
+   for (int k = 0; k < blfi.Size(); k++)
+   {
+      if (!blfi[k]->SupportsDevice()) { return false; }
+   }
+   if (flfi.Size() > 0) { return false; }
+
+   const Mesh &mesh = *fes->GetMesh();
+   if (device_domain_check < 0)
+   {
+      // Conforming mesh of tensor-product elements
+      device_domain_check = !mesh.NURBSext && mesh.Conforming();
+      for (int e = 0; device_domain_check && e < mesh.GetNE(); e++)
+      {
+         const Geometry::Type geom = mesh.GetElementBaseGeometry(e);
+         device_domain_check = (geom == Geometry::SEGMENT ||
+                                geom == Geometry::SQUARE ||
+                                geom == Geometry::CUBE);
+      }
+      if (device_domain_check && mesh.GetNE() > 0 &&
+          !dynamic_cast<const TensorBasisElement*>(fes->GetFE(0)))
+      {
+         device_domain_check = 0;
+      }
+   }
+   if (!device_domain_check) { return false; }
+
+   if (blfi.Size() > 0 && device_bdr_check < 0)
+   {
+      // The boundary face restriction requires a H1 space with Gauss-Lobatto
+      // or positive basis
+      const H1_FECollection *h1_fec =
+         dynamic_cast<const H1_FECollection*>(fes->FEColl());
+      const int btype = h1_fec ? h1_fec->GetBasisType() : BasisType::Invalid;
+      device_bdr_check = (mesh.Dimension() > 1 &&
+                          (btype == BasisType::GaussLobatto ||
+                           btype == BasisType::Positive));
+      // All the boundary elements must lie on boundary faces
+      for (int be = 0; device_bdr_check && be < mesh.GetNBE(); be++)
+      {
+         int e1, e2, inf1, inf2;
+         const int f = mesh.GetBdrElementEdgeIndex(be);
+         mesh.GetFaceElements(f, &e1, &e2);
+         mesh.GetFaceInfos(f, &inf1, &inf2);
+         device_bdr_check = (e2 < 0 && inf2 < 0);
+      }
+   }
+   return (blfi.Size() == 0 || device_bdr_check);
+}
+
 void LinearForm::Assemble()
 {
+   if (fast_assembly && SupportsDevice())
+   {
+      if (!ext) { ext = new LinearFormExtension(this); }
+      ext->Assemble();
+      AssembleDelta();
+      return;
+   }
+
    Array<int> vdofs;
    ElementTransformation *eltrans;
    Vector elemvect;
@@ -202,6 +269,7 @@ void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
    NewMemoryAndSize(Memory<double>(v.GetMemory(), v_offset, f->GetVSize()),
                     f->GetVSize(), false);
    ResetDeltaLocations();
+   UpdateExtension();
 }
 
 void LinearForm::MakeRef(FiniteElementSpace *f, Vector &v, int v_offset)
@@ -210,6 +278,7 @@ void LinearForm::MakeRef(FiniteElementSpace *f, Vector &v, int v_offset)
    fes = f;
    v.UseDevice(true);
    this->Vector::MakeRef(v, v_offset, fes->GetVSize());
+   UpdateExtension();
 }
 
 void LinearForm::AssembleDelta()
@@ -267,6 +336,7 @@ LinearForm & LinearForm::operator=(const Vector &v)
 
 LinearForm::~LinearForm()
 {
+   delete ext;
    if (!extern_lfs)
    {
       int k;
@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "lininteg.hpp"
 #include "gridfunc.hpp"
+#include "linearform_ext.hpp"
 
 namespace mfem
 {
@@ -56,6 +57,24 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// Use the device assembly of the integrators when possible.
+   bool fast_assembly;
+
+   /// Extension for the device assembly, see UseFastAssembly().
+   LinearFormExtension *ext;
+
+   /** @brief Cached results of the mesh and space checks of SupportsDevice()
+       for the domain and the boundary integrators: 1 or 0, or -1 if unknown. */
+   mutable int device_domain_check, device_bdr_check;
+
+   /** @brief Update the extension, if any, and reset the cached checks of
+       SupportsDevice() after the FE space has changed. */
+   void UpdateExtension()
+   {
+      device_domain_check = device_bdr_check = -1;
+      if (ext) { ext->Update(); }
+   }
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -64,7 +83,8 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; UseDevice(true); }
+   { fes = f; extern_lfs = 0; fast_assembly = false; ext = NULL;
+     device_domain_check = device_bdr_check = -1; UseDevice(true); }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +99,9 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; UseDevice(true); }
+   LinearForm()
+   { fes = NULL; extern_lfs = 0; fast_assembly = false; ext = NULL;
+     device_domain_check = device_bdr_check = -1; UseDevice(true); }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -87,7 +109,8 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; extern_lfs = 0; }
+   { fes = f; extern_lfs = 0; fast_assembly = false; ext = NULL;
+     device_domain_check = device_bdr_check = -1; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -144,6 +167,11 @@ public:
    /// Access all integrators added with AddBoundaryIntegrator().
    Array<LinearFormIntegrator*> *GetBLFI() { return &blfi; }
 
+   /** @brief Access all boundary markers added with AddBoundaryIntegrator().
+       If no marker was specified when the integrator was added, the
+       corresponding pointer (to Array<int>) will be NULL. */
+   Array<Array<int>*> *GetBLFI_Marker() { return &blfi_marker; }
+
    /// Access all integrators added with AddBdrFaceIntegrator().
    Array<LinearFormIntegrator*> *GetFLFI() { return &flfi; }
 
@@ -152,6 +180,22 @@ public:
        corresponding pointer (to Array<int>) will be NULL. */
    Array<Array<int>*> *GetFLFI_Marker() { return &flfi_marker; }
 
+   /** @brief Select the assembly algorithm: the device-compatible one (true),
+       or the legacy host-only one (false, the default). */
+   /** The device assembly is used by Assemble() only when SupportsDevice()
+       returns true, otherwise the legacy algorithm is used. */
+   void UseFastAssembly(bool use_fa) { fast_assembly = use_fa; }
+
+   /** @brief Return true if all the integrators, the mesh and the FE space
+       support the device assembly. */
+   /** It requires domain and boundary integrators with
+       LinearFormIntegrator::SupportsDevice(), no boundary face integrators, a
+       conforming mesh of tensor-product elements, and, with boundary
+       integrators, an H1 space on a mesh whose boundary elements all lie on
+       the boundary faces. The checks of the mesh and the space are cached
+       until the next Update(). */
+   bool SupportsDevice() const;
+
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
    void Assemble();
 
@@ -163,11 +207,15 @@ public:
        updated, e.g. after its associated Mesh object has been refined.
 
        @note This method does not perform assembly. */
-   void Update() { SetSize(fes->GetVSize()); ResetDeltaLocations(); }
+   void Update()
+   { SetSize(fes->GetVSize()); ResetDeltaLocations(); UpdateExtension(); }
 
    /// Associate a new FE space, @a *f, with this object and Update() it. */
    void Update(FiniteElementSpace *f)
-   { fes = f; SetSize(f->GetVSize()); ResetDeltaLocations(); }
+   {
+      fes = f; SetSize(f->GetVSize()); ResetDeltaLocations();
+      UpdateExtension();
+   }
 
    /** @brief Associate a new FE space, @a *f, with this object and use the data
        of @a v, offset by @a v_offset, to initialize this object's Vector::data.
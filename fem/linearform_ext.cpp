@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class LinearFormExtension
+
+#include "fem.hpp"
+
+namespace mfem
+{
+
+LinearFormExtension::LinearFormExtension(LinearForm *lf)
+   : lf(lf), elem_restrict_lex(NULL), bdr_restrict_lex(NULL)
+{
+   Update();
+}
+
+void LinearFormExtension::Update()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const Mesh &mesh = *fes.GetMesh();
+   const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+
+   elem_restrict_lex = fes.GetElementRestriction(ordering);
+   b.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   b.UseDevice(true);
+   markers.SetSize(mesh.GetNE());
+   markers = 1;
+
+   bdr_restrict_lex = NULL;
+   if (lf->GetBLFI()->Size() > 0)
+   {
+      bdr_restrict_lex = fes.GetFaceRestriction(ordering, FaceType::Boundary,
+                                                L2FaceValues::SingleValued);
+      bdr_b.SetSize(bdr_restrict_lex->Height(), Device::GetMemoryType());
+      bdr_b.UseDevice(true);
+      bdr_markers.SetSize(mesh.GetNBE());
+   }
+}
+
+void LinearFormExtension::Assemble()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   const Mesh &mesh = *fes.GetMesh();
+   Array<LinearFormIntegrator*> &domain_integs = *lf->GetDLFI();
+   Array<LinearFormIntegrator*> &bdr_integs = *lf->GetBLFI();
+   Array<Array<int>*> &bdr_integs_marker = *lf->GetBLFI_Marker();
+
+   b = 0.0;
+   for (int k = 0; k < domain_integs.Size(); ++k)
+   {
+      domain_integs[k]->AssembleDevice(fes, markers, b);
+   }
+   // Sets all the entries of the LinearForm
+   elem_restrict_lex->MultTranspose(b, *lf);
+
+   if (bdr_integs.Size() == 0) { return; }
+   // The boundary integrators may have been added after the construction
+   if (!bdr_restrict_lex) { Update(); }
+   bdr_b = 0.0;
+   for (int k = 0; k < bdr_integs.Size(); ++k)
+   {
+      const Array<int> *attr_marker = bdr_integs_marker[k];
+      MFEM_ASSERT(!attr_marker ||
+                  attr_marker->Size() == mesh.bdr_attributes.Max(),
+                  "invalid boundary marker for boundary integrator #"
+                  << k << ", counting from zero");
+      int *h_markers = bdr_markers.HostWrite();
+      for (int be = 0; be < mesh.GetNBE(); ++be)
+      {
+         const int attr = mesh.GetBdrAttribute(be);
+         h_markers[be] = attr_marker ? (*attr_marker)[attr-1] : 1;
+      }
+      bdr_integs[k]->AssembleDevice(fes, bdr_markers, bdr_b);
+   }
+   // The face restrictions add their contributions to the LinearForm
+   bdr_restrict_lex->MultTranspose(bdr_b, *lf);
+}
+
+} // namespace mfem
@@ -0,0 +1,51 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LINEARFORM_EXT
+#define MFEM_LINEARFORM_EXT
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+class LinearForm;
+
+/// Class extending the LinearForm class to support assembly on device
+/** The domain and boundary integrators add their element contributions to
+    E-vectors with LinearFormIntegrator::AssembleDevice(), which are then
+    gathered into the LinearForm with the transpose of the lexicographic element
+    and boundary face restrictions. */
+class LinearFormExtension
+{
+protected:
+   LinearForm *lf; ///< Not owned
+   const Operator *elem_restrict_lex; ///< Not owned
+   const Operator *bdr_restrict_lex; ///< Not owned
+   /// Element and boundary element markers used by the integrators.
+   Array<int> markers, bdr_markers;
+   /// Element and boundary face E-vectors.
+   Vector b, bdr_b;
+
+public:
+   LinearFormExtension(LinearForm *lf);
+
+   /// Assemble the domain and boundary integrators of the LinearForm.
+   void Assemble();
+
+   /// Update the extension after the FiniteElementSpace has changed.
+   void Update();
+};
+
+} // namespace mfem
+
+#endif // MFEM_LINEARFORM_EXT
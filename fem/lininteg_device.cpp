@@ -0,0 +1,450 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "fem.hpp"
+
+namespace mfem
+{
+
+// Device assembly of linear forms: the data at the quadrature points, d, is
+// contracted with the transposed tensor basis B^T, y(i,c,e) += B(q,i) d(q,c,e).
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void LFEvalAssemble1D(const int vdim,
+                             const int NE,
+                             const Array<double> &b,
+                             const Vector &d,
+                             Vector &y,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D, vdim, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               u += B(qx,dx) * D(qx,c,e);
+            }
+            Y(dx,c,e) += u;
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void LFEvalAssemble2D(const int vdim,
+                             const int NE,
+                             const Array<double> &b,
+                             const Vector &d,
+                             Vector &y,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D, Q1D, vdim, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double QD[max_Q1D][max_D1D];
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += B(qx,dx) * D(qx,qy,c,e);
+               }
+               QD[qy][dx] = u;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += B(qy,dy) * QD[qy][dx];
+               }
+               Y(dx,dy,c,e) += u;
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void LFEvalAssemble3D(const int vdim,
+                             const int NE,
+                             const Array<double> &b,
+                             const Vector &d,
+                             Vector &y,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D, Q1D, Q1D, vdim, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double QQD[max_Q1D][max_Q1D][max_D1D];
+      double QDD[max_Q1D][max_D1D][max_D1D];
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += B(qx,dx) * D(qx,qy,qz,c,e);
+                  }
+                  QQD[qz][qy][dx] = u;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += B(qy,dy) * QQD[qz][qy][dx];
+                  }
+                  QDD[qz][dy][dx] = u;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += B(qz,dz) * QDD[qz][dy][dx];
+                  }
+                  Y(dx,dy,dz,c,e) += u;
+               }
+            }
+         }
+      }
+   });
+}
+
+static void LFEvalAssemble(const int dim,
+                           const int D1D,
+                           const int Q1D,
+                           const int vdim,
+                           const int NE,
+                           const Array<double> &B,
+                           const Vector &D,
+                           Vector &Y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 1)
+   {
+      return LFEvalAssemble1D(vdim,NE,B,D,Y,D1D,Q1D);
+   }
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return LFEvalAssemble2D<2,2>(vdim,NE,B,D,Y);
+         case 0x33: return LFEvalAssemble2D<3,3>(vdim,NE,B,D,Y);
+         case 0x44: return LFEvalAssemble2D<4,4>(vdim,NE,B,D,Y);
+         case 0x55: return LFEvalAssemble2D<5,5>(vdim,NE,B,D,Y);
+         default:   return LFEvalAssemble2D(vdim,NE,B,D,Y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x22: return LFEvalAssemble3D<2,2>(vdim,NE,B,D,Y);
+         case 0x33: return LFEvalAssemble3D<3,3>(vdim,NE,B,D,Y);
+         case 0x44: return LFEvalAssemble3D<4,4>(vdim,NE,B,D,Y);
+         case 0x55: return LFEvalAssemble3D<5,5>(vdim,NE,B,D,Y);
+         default:   return LFEvalAssemble3D(vdim,NE,B,D,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// Assemble the E-vector b of a domain integrator with the coefficient values f.
+// The vector f has vdim components, given either once for all the quadrature
+// points (size vdim), or at each quadrature point (layout NQ x vdim x NE).
+static void LFDomainAssemble(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const Array<int> &markers,
+                             const int vdim,
+                             const Vector &f,
+                             Vector &b)
+{
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   const int dim = el.GetDim();
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+   const DofToQuad &maps = el.GetDofToQuad(ir, DofToQuad::TENSOR);
+
+   Vector d(NQ*vdim*NE, Device::GetDeviceMemoryType());
+   const bool const_f = (f.Size() == vdim);
+   auto M = markers.Read();
+   auto W = ir.GetWeights().Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NE);
+   auto F = const_f ? Reshape(f.Read(), 1, vdim, 1) :
+            Reshape(f.Read(), NQ, vdim, NE);
+   auto D = Reshape(d.Write(), NQ, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const double m = M[e] ? 1.0 : 0.0;
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double fq = const_f ? F(0,c,0) : F(q,c,e);
+            D(q,c,e) = m * W[q] * detJ(q,e) * fq;
+         }
+      }
+   });
+   LFEvalAssemble(dim, maps.ndof, maps.nqpt, vdim, NE, maps.B, d, b);
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        const Array<int> &markers,
+                                        Vector &b)
+{
+   MFEM_VERIFY(fes.GetVDim() == 1, "Only scalar spaces are supported!");
+   const int NE = fes.GetNE();
+   if (NE == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(),
+                                            oa * el.GetOrder() + ob);
+   const int NQ = ir.GetNPoints();
+
+   Vector coeff;
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else if (QuadratureFunctionCoefficient *cQ =
+               dynamic_cast<QuadratureFunctionCoefficient*>(&Q))
+   {
+      const QuadratureFunction &qFun = cQ->GetQuadFunction();
+      MFEM_VERIFY(qFun.Size() == NQ * NE,
+                  "Incompatible QuadratureFunction dimension \n");
+      MFEM_VERIFY(&ir == &qFun.GetSpace()->GetElementIntRule(0),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+      qFun.Read();
+      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun), 0);
+   }
+   else
+   {
+      coeff.SetSize(NQ * NE);
+      auto C = Reshape(coeff.HostWrite(), NQ, NE);
+      for (int e = 0; e < NE; ++e)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < NQ; ++q)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            C(q,e) = Q.Eval(T, ip);
+         }
+      }
+   }
+   LFDomainAssemble(fes, ir, markers, 1, coeff, b);
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              const Array<int> &markers,
+                                              Vector &b)
+{
+   const int vdim = Q.GetVDim();
+   MFEM_VERIFY(fes.GetVDim() == vdim, "Incompatible coefficient dimension!");
+   const int NE = fes.GetNE();
+   if (NE == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(),
+                                            2 * el.GetOrder());
+   const int NQ = ir.GetNPoints();
+
+   Vector coeff;
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      coeff = cQ->GetVec();
+   }
+   else
+   {
+      coeff.SetSize(NQ * vdim * NE);
+      auto C = Reshape(coeff.HostWrite(), NQ, vdim, NE);
+      for (int e = 0; e < NE; ++e)
+      {
+         ElementTransformation &T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < NQ; ++q)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            Q.Eval(Qvec, T, ip);
+            for (int c = 0; c < vdim; ++c)
+            {
+               C(q,c,e) = Qvec(c);
+            }
+         }
+      }
+   }
+   LFDomainAssemble(fes, ir, markers, vdim, coeff, b);
+}
+
+// Return the index of the point of the tensor product face quadrature rule ir,
+// in the lexicographic order of the face restriction, corresponding to the
+// point eip of the reference element. The local face is face_id.
+static int GetLexFaceQuadIndex(const int dim, const int face_id,
+                               const IntegrationRule &ir, const int Q1D,
+                               const IntegrationPoint &eip)
+{
+   // Tangential coordinates of the face, in the order of GetFaceDofs()
+   double t[2] = { 0.0, 0.0 };
+   if (dim == 2)
+   {
+      t[0] = (face_id == 0 || face_id == 2) ? eip.x : eip.y;
+   }
+   else
+   {
+      t[0] = (face_id == 2 || face_id == 4) ? eip.y : eip.x;
+      t[1] = (face_id == 0 || face_id == 5) ? eip.y : eip.z;
+   }
+   int idx[2] = { 0, 0 };
+   for (int k = 0; k < dim - 1; ++k)
+   {
+      // The first Q1D points of ir form the 1D quadrature rule
+      double dist = std::abs(t[k] - ir.IntPoint(0).x);
+      for (int q = 1; q < Q1D; ++q)
+      {
+         const double dist_q = std::abs(t[k] - ir.IntPoint(q).x);
+         if (dist_q < dist) { dist = dist_q; idx[k] = q; }
+      }
+   }
+   return idx[0] + Q1D * idx[1];
+}
+
+void BoundaryLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers,
+                                          Vector &b)
+{
+   MFEM_VERIFY(fes.GetVDim() == 1, "Only scalar spaces are supported!");
+   Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Unsupported dimension!");
+   const int NF = fes.GetNFbyType(FaceType::Boundary);
+   if (NF == 0) { return; }
+   const FiniteElement &el = *fes.GetFaceElement(0);
+   const IntegrationRule &ir = IntRule ? *IntRule :
+                               IntRules.Get(el.GetGeomType(),
+                                            oa * el.GetOrder() + ob);
+   const DofToQuad &maps = el.GetDofToQuad(ir, DofToQuad::TENSOR);
+   const int Q1D = maps.nqpt;
+   const int NQ = ir.GetNPoints();
+
+   // The coefficient and the geometric factors are evaluated on the host with
+   // the face transformations of the boundary elements, in the ordering of the
+   // lexicographic boundary face restriction.
+   Array<int> face_to_be(mesh->GetNumFaces());
+   face_to_be = -1;
+   for (int be = 0; be < mesh->GetNBE(); ++be)
+   {
+      face_to_be[mesh->GetBdrElementEdgeIndex(be)] = be;
+   }
+   Vector d(NQ*NF);
+   d.UseDevice(true);
+   auto D = Reshape(d.HostWrite(), NQ, NF);
+   const int *h_markers = markers.HostRead();
+   int f_ind = 0;
+   for (int f = 0; f < mesh->GetNumFaces(); ++f)
+   {
+      int e1, e2, inf1, inf2;
+      mesh->GetFaceElements(f, &e1, &e2);
+      mesh->GetFaceInfos(f, &inf1, &inf2);
+      // Same selection of the faces as in H1FaceRestriction
+      if (e2 >= 0 || inf2 >= 0) { continue; }
+      const int be = face_to_be[f];
+      if (be < 0 || h_markers[be] == 0)
+      {
+         for (int q = 0; q < NQ; ++q) { D(q,f_ind) = 0.0; }
+         f_ind++;
+         continue;
+      }
+      FaceElementTransformations &Tr = *mesh->GetBdrFaceTransformations(be);
+      const int face_id = inf1 / 64;
+      for (int k = 0; k < NQ; ++k)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(k);
+         Tr.SetAllIntPoints(&ip);
+         const IntegrationPoint &eip = Tr.GetElement1IntPoint();
+         const int q = GetLexFaceQuadIndex(dim, face_id, ir, Q1D, eip);
+         D(q,f_ind) = ip.weight * Tr.Weight() * Q.Eval(Tr, ip);
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind == NF, "Unexpected number of faces.");
+   LFEvalAssemble(dim - 1, maps.ndof, Q1D, 1, NF, maps.B, d, b);
+}
+
+} // namespace mfem
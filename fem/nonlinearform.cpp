@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -138,6 +139,14 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
    if (ext)
    {
       ext->Mult(px, py);
+      if (Serial())
+      {
+         if (cP) { cP->MultTranspose(py, y); }
+         const int N = ess_tdof_list.Size();
+         const auto tdof = ess_tdof_list.Read();
+         auto Y = y.ReadWrite();
+         MFEM_FORALL(i, N, Y[tdof[i]] = 0.0; );
+      }
       return;
    }
 
@@ -264,7 +273,13 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
    if (ext)
    {
-      MFEM_ABORT("Not yet implemented!");
+      // Matrix-free gradient: P^t G P with eliminated essential true dofs
+      hGrad.Clear();
+      Operator &grad = ext->GetGradient(Prolongate(x));
+      Operator *Gop = &grad;
+      if (P) { Gop = new RAPOperator(*P, grad, *P); }
+      hGrad.Reset(new ConstrainedOperator(Gop, ess_tdof_list, P != NULL));
+      return *hGrad.Ptr();
    }
 
    const int skip_zeros = 0;
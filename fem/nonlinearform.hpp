@@ -46,6 +46,9 @@ protected:
 
    mutable SparseMatrix *Grad, *cGrad; // owned
 
+   /// Matrix-free gradient operator, used with an extension (e.g. PA)
+   mutable OperatorHandle hGrad;
+
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
 
@@ -154,6 +157,10 @@ public:
 
        In general, @a x may have non-homogeneous essential boundary values.
 
+       With partial assembly, the returned Operator is matrix-free; it requires
+       the domain integrators to implement AssembleGradPA() and
+       AddMultGradPA().
+
        The state @a x must be a true-dof vector. */
    virtual Operator &GetGradient(const Vector &x) const;
 
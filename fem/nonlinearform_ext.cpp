@@ -24,7 +24,7 @@ NonlinearFormExtension::NonlinearFormExtension(NonlinearForm *form)
 }
 
 PANonlinearFormExtension::PANonlinearFormExtension(NonlinearForm *form):
-   NonlinearFormExtension(form), fes(*form->FESpace())
+   NonlinearFormExtension(form), fes(*form->FESpace()), Grad(NULL)
 {
    const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
    elem_restrict_lex = fes.GetElementRestriction(ordering);
@@ -71,4 +71,56 @@ void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
+{
+   if (Grad == NULL) { Grad = new Gradient(*this); }
+   Grad->Assemble(x);
+   return *Grad;
+}
+
+PANonlinearFormExtension::Gradient::Gradient(const PANonlinearFormExtension &e)
+   : Operator(e.fes.GetVSize()), ext(e)
+{ }
+
+void PANonlinearFormExtension::Gradient::Assemble(const Vector &x)
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   const int iSz = integrators.Size();
+   const Vector *xe = &x;
+   if (ext.elem_restrict_lex)
+   {
+      ext.elem_restrict_lex->Mult(x, ext.localX);
+      xe = &ext.localX;
+   }
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AssembleGradPA(*xe, ext.fes);
+   }
+}
+
+void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   const int iSz = integrators.Size();
+   if (ext.elem_restrict_lex)
+   {
+      ext.elem_restrict_lex->Mult(x, ext.localX);
+      ext.localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(ext.localX, ext.localY);
+      }
+      ext.elem_restrict_lex->MultTranspose(ext.localY, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(x, y);
+      }
+   }
+}
+
 }
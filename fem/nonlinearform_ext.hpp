@@ -26,6 +26,9 @@ protected:
 public:
    NonlinearFormExtension(NonlinearForm *form);
    virtual void AssemblePA() = 0;
+   /** @brief Return the local gradient operator at the L-vector @a x. The
+       returned operator is owned by the extension. */
+   virtual Operator &GetGradient(const Vector &x) const = 0;
 };
 
 /// Data and methods for partially-assembled nonlinear forms
@@ -35,10 +38,26 @@ protected:
    const FiniteElementSpace &fes; // Not owned
    mutable Vector localX, localY;
    const Operator *elem_restrict_lex; // Not owned
+
+   /// Matrix-free action of the gradient of the partially assembled form
+   class Gradient : public Operator
+   {
+   protected:
+      const PANonlinearFormExtension &ext;
+   public:
+      Gradient(const PANonlinearFormExtension &e);
+      /// Assemble the gradient data of the integrators at the L-vector @a x.
+      void Assemble(const Vector &x);
+      virtual void Mult(const Vector &x, Vector &y) const;
+   };
+   mutable Gradient *Grad;
+
 public:
    PANonlinearFormExtension(NonlinearForm*);
    void AssemblePA();
    void Mult(const Vector &x, Vector &y) const;
+   Operator &GetGradient(const Vector &x) const;
+   ~PANonlinearFormExtension() { delete Grad; }
 };
 }
 #endif // NONLINEARFORM_EXT_HPP
@@ -88,6 +88,21 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Prepare the partially assembled gradient at the state @a x.
+   /** The state @a x is an E-vector. The data needed for the action of the
+       gradient is stored internally so that it can be used later in the method
+       AddMultGradPA().
+
+       This method can be called only after the method AssemblePA() has been
+       called. */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   /// Method for the partially assembled action of the gradient.
+   /** Perform the action of the gradient of the integrator, at the state given
+       to AssembleGradPA(), on the input @a x and add the result to the output
+       @a y. Both @a x and @a y are E-vectors. */
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -226,6 +241,11 @@ public:
 
    virtual void AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
                           const double weight, DenseMatrix &A) const;
+
+   /** @brief Evaluate the shear modulus @a mu_, the bulk modulus @a K_ and the
+       reference volumetric scaling @a g_ at the current point of the
+       transformation given to SetTransformation(). */
+   void EvalParameters(double &mu_, double &K_, double &g_) const;
 };
 
 
@@ -253,9 +273,19 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension, supported for the NeoHookeanModel
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, nq;
+   Vector pa_data;   // w det(Jtr), mu, K, g and Jrt at the quadrature points
+   Vector grad_data; // deformation gradient Jpt at the quadrature points
+
+   static const IntegrationRule &GetRule(const FiniteElement &el);
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m)
+      : model(m), maps(NULL), geom(NULL) { }
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -272,6 +302,12 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   using NonlinearFormIntegrator::AssemblePA;
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
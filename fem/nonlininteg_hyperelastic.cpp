@@ -0,0 +1,734 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include "nonlininteg.hpp"
+#include "fespace.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Hyperelastic Integrator
+//
+// The E-vectors hold the coordinates of the deformed configuration. The PA data
+// at each quadrature point consists of w det(Jtr), the parameters mu, K and g
+// of the NeoHookeanModel and the entries of Jrt = Jtr^{-1} in column-major
+// order, i.e. 4+dim*dim values per point. The deformation gradient Jpt is
+// computed from the reference gradient, Jpr, of the coordinates as Jpr Jrt.
+
+// 1st Piola-Kirchhoff stress P of the NeoHookeanModel, see
+// NeoHookeanModel::EvalP(). All matrices are stored in column-major order.
+template<int DIM> MFEM_HOST_DEVICE inline
+void NeoHookeanEvalP(const double mu, const double K, const double g,
+                     const double *J, double *P)
+{
+   double Jinv[DIM*DIM];
+   const double dJ = kernels::Det<DIM>(J);
+   kernels::CalcInverse<DIM>(J, Jinv);
+   double JJ = 0.0;
+   for (int i = 0; i < DIM*DIM; i++) { JJ += J[i]*J[i]; }
+   const double a = mu*pow(dJ, -2.0/DIM);
+   const double b = K*(dJ/g - 1.0)/g - a*JJ/(DIM*dJ);
+   // P = a J + b adj(J)^t, where adj(J)^t = det(J) J^{-t}
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         P[i+DIM*j] = a*J[i+DIM*j] + b*dJ*Jinv[j+DIM*i];
+      }
+   }
+}
+
+// Action of the derivative of the 1st Piola-Kirchhoff stress of the
+// NeoHookeanModel at J on the direction dJ, see NeoHookeanModel::AssembleH().
+template<int DIM> MFEM_HOST_DEVICE inline
+void NeoHookeanEvaldP(const double mu, const double K, const double g,
+                      const double *J, const double *dJ, double *dP)
+{
+   double Jinv[DIM*DIM];
+   const double detJ = kernels::Det<DIM>(J);
+   kernels::CalcInverse<DIM>(J, Jinv);
+   double JJ = 0.0, J_dJ = 0.0, JinvT_dJ = 0.0;
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         JJ += J[i+DIM*j]*J[i+DIM*j];
+         J_dJ += J[i+DIM*j]*dJ[i+DIM*j];
+         JinvT_dJ += Jinv[j+DIM*i]*dJ[i+DIM*j];
+      }
+   }
+   const double sJ = detJ/g;
+   const double a  = mu*pow(detJ, -2.0/DIM);
+   const double bc = a*JJ/DIM;
+   const double b  = bc - K*sJ*(sJ - 1.0);
+   const double c  = 2.0*bc/DIM + K*sJ*(2.0*sJ - 1.0);
+   const double a2 = -2.0*a/DIM;
+   // dP = a dJ + a2 ((J^{-t}:dJ) J + (J:dJ) J^{-t})
+   //      + b J^{-t} dJ^t J^{-t} + c (J^{-t}:dJ) J^{-t}
+   for (int i = 0; i < DIM; i++)
+   {
+      for (int j = 0; j < DIM; j++)
+      {
+         const double JinvT_ij = Jinv[j+DIM*i];
+         double s = 0.0;
+         for (int k = 0; k < DIM; k++)
+         {
+            for (int l = 0; l < DIM; l++)
+            {
+               s += Jinv[k+DIM*i]*dJ[l+DIM*k]*Jinv[j+DIM*l];
+            }
+         }
+         dP[i+DIM*j] = a*dJ[i+DIM*j] +
+                       a2*(JinvT_dJ*J[i+DIM*j] + J_dJ*JinvT_ij) +
+                       b*s + c*JinvT_dJ*JinvT_ij;
+      }
+   }
+}
+
+// Replace the reference gradient Gr (d x_c / d xi_r) of the input at a
+// quadrature point with w det(Jtr) P Jrt^t, where P is the stress for the
+// residual (GRAD = false) or its derivative at the deformation gradient Jpt
+// (GRAD = true).
+template<int DIM, bool GRAD> MFEM_HOST_DEVICE inline
+void PAHyperelasticQFunction(const double w, const double mu, const double K,
+                             const double g, const double *Jrt,
+                             const double *Jpt, double (&Gr)[DIM][DIM])
+{
+   double F[DIM*DIM], P[DIM*DIM];
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int k = 0; k < DIM; k++)
+      {
+         double s = 0.0;
+         for (int r = 0; r < DIM; r++) { s += Gr[c][r]*Jrt[r+DIM*k]; }
+         F[c+DIM*k] = s;
+      }
+   }
+   if (GRAD) { NeoHookeanEvaldP<DIM>(mu, K, g, Jpt, F, P); }
+   else { NeoHookeanEvalP<DIM>(mu, K, g, F, P); }
+   for (int c = 0; c < DIM; c++)
+   {
+      for (int r = 0; r < DIM; r++)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; k++) { s += P[c+DIM*k]*Jrt[r+DIM*k]; }
+         Gr[c][r] = w*s;
+      }
+   }
+}
+
+// Reference gradients, grad[qy][qx][c][r] = d x_c / d xi_r, of the E-vector x
+// of the element e at the quadrature points.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAHyperelasticGrad2D(const int e, const int D1D, const int Q1D,
+                          const DeviceTensor<2,const double> &B,
+                          const DeviceTensor<2,const double> &G,
+                          const DeviceTensor<4,const double> &x,
+                          double (&grad)[MQ1][MQ1][2][2])
+{
+   for (int c = 0; c < 2; ++c)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][c][0] = 0.0;
+            grad[qy][qx][c][1] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[MQ1][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = x(dx,dy,c,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][c][0] += gradX[qx][1] * wy;
+               grad[qy][qx][c][1] += gradX[qx][0] * wDy;
+            }
+         }
+      }
+   }
+}
+
+// Add the transposed action of PAHyperelasticGrad2D() on grad to y.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAHyperelasticGradT2D(const int e, const int D1D, const int Q1D,
+                           const DeviceTensor<2,const double> &Bt,
+                           const DeviceTensor<2,const double> &Gt,
+                           const double (&grad)[MQ1][MQ1][2][2],
+                           const DeviceTensor<4,double> &y)
+{
+   for (int c = 0; c < 2; ++c)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[MD1][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0.0;
+            gradX[dx][1] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double gX = grad[qy][qx][c][0];
+            const double gY = grad[qy][qx][c][1];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = Bt(dx,qx);
+               const double wDx = Gt(dx,qx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+            }
+         }
+      }
+   }
+}
+
+// Reference gradients, grad[qz][qy][qx][c][r] = d x_c / d xi_r, of the
+// E-vector x of the element e at the quadrature points.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAHyperelasticGrad3D(const int e, const int D1D, const int Q1D,
+                          const DeviceTensor<2,const double> &B,
+                          const DeviceTensor<2,const double> &G,
+                          const DeviceTensor<5,const double> &x,
+                          double (&grad)[MQ1][MQ1][MQ1][3][3])
+{
+   for (int c = 0; c < 3; ++c)
+   {
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][c][0] = 0.0;
+               grad[qz][qy][qx][c][1] = 0.0;
+               grad[qz][qy][qx][c][2] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double gradXY[MQ1][MQ1][3];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradXY[qy][qx][0] = 0.0;
+               gradXY[qy][qx][1] = 0.0;
+               gradXY[qy][qx][2] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[MQ1][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,dz,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double wx  = gradX[qx][0];
+                  const double wDx = gradX[qx][1];
+                  gradXY[qy][qx][0] += wDx * wy;
+                  gradXY[qy][qx][1] += wx  * wDy;
+                  gradXY[qy][qx][2] += wx  * wy;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = B(qz,dz);
+            const double wDz = G(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][c][0] += gradXY[qy][qx][0] * wz;
+                  grad[qz][qy][qx][c][1] += gradXY[qy][qx][1] * wz;
+                  grad[qz][qy][qx][c][2] += gradXY[qy][qx][2] * wDz;
+               }
+            }
+         }
+      }
+   }
+}
+
+// Add the transposed action of PAHyperelasticGrad3D() on grad to y.
+template<int MD1, int MQ1> MFEM_HOST_DEVICE inline
+void PAHyperelasticGradT3D(const int e, const int D1D, const int Q1D,
+                           const DeviceTensor<2,const double> &Bt,
+                           const DeviceTensor<2,const double> &Gt,
+                           const double (&grad)[MQ1][MQ1][MQ1][3][3],
+                           const DeviceTensor<5,double> &y)
+{
+   for (int c = 0; c < 3; ++c)
+   {
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double gradXY[MD1][MD1][3];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] = 0.0;
+               gradXY[dy][dx][1] = 0.0;
+               gradXY[dy][dx][2] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[MD1][3];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+               gradX[dx][2] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qz][qy][qx][c][0];
+               const double gY = grad[qz][qy][qx][c][1];
+               const double gZ = grad[qz][qy][qx][c][2];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+                  gradX[dx][2] += gZ * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,dz,c,e) +=
+                     ((gradXY[dy][dx][0] * wz) +
+                      (gradXY[dy][dx][1] * wz) +
+                      (gradXY[dy][dx][2] * wDz));
+               }
+            }
+         }
+      }
+   }
+}
+
+// PA Hyperelastic Apply 2D kernel: residual (GRAD = false) or gradient action
+// (GRAD = true)
+template<bool GRAD, int T_D1D = 0, int T_Q1D = 0> static
+void PAHyperelasticApply2D(const int NE,
+                           const Array<double> &b,
+                           const Array<double> &g,
+                           const Array<double> &bt,
+                           const Array<double> &gt,
+                           const Vector &d_,
+                           const Vector &j_,
+                           const Vector &x_,
+                           Vector &y_,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NQ = Q1D*Q1D;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), NQ, 4 + DIM*DIM, NE);
+   auto J = Reshape(GRAD ? j_.Read() : NULL, NQ, DIM*DIM, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double grad[max_Q1D][max_Q1D][DIM][DIM];
+      PAHyperelasticGrad2D<max_D1D,max_Q1D>(e, D1D, Q1D, B, G, x, grad);
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double Jrt[DIM*DIM], Jpt[DIM*DIM];
+            for (int i = 0; i < DIM*DIM; i++)
+            {
+               Jrt[i] = D(q,4+i,e);
+               Jpt[i] = GRAD ? J(q,i,e) : 0.0;
+            }
+            PAHyperelasticQFunction<DIM,GRAD>(D(q,0,e), D(q,1,e), D(q,2,e),
+                                              D(q,3,e), Jrt, Jpt,
+                                              grad[qy][qx]);
+         }
+      }
+      PAHyperelasticGradT2D<max_D1D,max_Q1D>(e, D1D, Q1D, Bt, Gt, grad, y);
+   });
+}
+
+// PA Hyperelastic Apply 3D kernel: residual (GRAD = false) or gradient action
+// (GRAD = true)
+template<bool GRAD, int T_D1D = 0, int T_Q1D = 0> static
+void PAHyperelasticApply3D(const int NE,
+                           const Array<double> &b,
+                           const Array<double> &g,
+                           const Array<double> &bt,
+                           const Array<double> &gt,
+                           const Vector &d_,
+                           const Vector &j_,
+                           const Vector &x_,
+                           Vector &y_,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NQ = Q1D*Q1D*Q1D;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), NQ, 4 + DIM*DIM, NE);
+   auto J = Reshape(GRAD ? j_.Read() : NULL, NQ, DIM*DIM, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      double grad[max_Q1D][max_Q1D][max_Q1D][DIM][DIM];
+      PAHyperelasticGrad3D<max_D1D,max_Q1D>(e, D1D, Q1D, B, G, x, grad);
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double Jrt[DIM*DIM], Jpt[DIM*DIM];
+               for (int i = 0; i < DIM*DIM; i++)
+               {
+                  Jrt[i] = D(q,4+i,e);
+                  Jpt[i] = GRAD ? J(q,i,e) : 0.0;
+               }
+               PAHyperelasticQFunction<DIM,GRAD>(D(q,0,e), D(q,1,e),
+                                                 D(q,2,e), D(q,3,e), Jrt, Jpt,
+                                                 grad[qz][qy][qx]);
+            }
+         }
+      }
+      PAHyperelasticGradT3D<max_D1D,max_Q1D>(e, D1D, Q1D, Bt, Gt, grad, y);
+   });
+}
+
+template<bool GRAD>
+static void PAHyperelasticApply(const int dim,
+                                const int NE,
+                                const DofToQuad &maps,
+                                const Vector &D,
+                                const Vector &J,
+                                const Vector &x,
+                                Vector &y)
+{
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   const Array<double> &B = maps.B;
+   const Array<double> &G = maps.G;
+   const Array<double> &Bt = maps.Bt;
+   const Array<double> &Gt = maps.Gt;
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23:
+            return PAHyperelasticApply2D<GRAD,2,3>(NE,B,G,Bt,Gt,D,J,x,y);
+         case 0x34:
+            return PAHyperelasticApply2D<GRAD,3,4>(NE,B,G,Bt,Gt,D,J,x,y);
+         case 0x45:
+            return PAHyperelasticApply2D<GRAD,4,5>(NE,B,G,Bt,Gt,D,J,x,y);
+         default:
+            return PAHyperelasticApply2D<GRAD>(NE,B,G,Bt,Gt,D,J,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23:
+            return PAHyperelasticApply3D<GRAD,2,3>(NE,B,G,Bt,Gt,D,J,x,y);
+         case 0x34:
+            return PAHyperelasticApply3D<GRAD,3,4>(NE,B,G,Bt,Gt,D,J,x,y);
+         case 0x45:
+            return PAHyperelasticApply3D<GRAD,4,5>(NE,B,G,Bt,Gt,D,J,x,y);
+         default:
+            return PAHyperelasticApply3D<GRAD>(NE,B,G,Bt,Gt,D,J,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Hyperelastic Assemble kernel
+template<int DIM>
+static void PAHyperelasticSetup(const int NQ,
+                                const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &c,
+                                Vector &op)
+{
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   auto C = Reshape(c.Read(), NQ, 3, NE);
+   auto y = Reshape(op.Write(), NQ, 4 + DIM*DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double Jtr[DIM*DIM], Jrt[DIM*DIM];
+         for (int i = 0; i < DIM; i++)
+         {
+            for (int k = 0; k < DIM; k++)
+            {
+               Jtr[i+DIM*k] = J(q,i,k,e);
+            }
+         }
+         kernels::CalcInverse<DIM>(Jtr, Jrt);
+         y(q,0,e) = W[q] * kernels::Det<DIM>(Jtr);
+         y(q,1,e) = C(q,0,e); // mu
+         y(q,2,e) = C(q,1,e); // K
+         y(q,3,e) = C(q,2,e); // g
+         for (int i = 0; i < DIM*DIM; i++) { y(q,4+i,e) = Jrt[i]; }
+      }
+   });
+}
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const NeoHookeanModel *nh = dynamic_cast<const NeoHookeanModel*>(model);
+   MFEM_VERIFY(nh, "PA is supported only for the NeoHookeanModel!");
+   MFEM_VERIFY(dim == 2 || dim == 3, "Dimension not supported.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim && fes.GetVDim() == dim,
+               "The vector dimension must be equal to the mesh dimension.");
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el);
+   nq = ir->GetNPoints();
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+
+   // Evaluate the model parameters at the quadrature points
+   Vector coeff(3 * nq * ne);
+   auto C = Reshape(coeff.HostWrite(), nq, 3, ne);
+   for (int e = 0; e < ne; ++e)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(e);
+      model->SetTransformation(T);
+      for (int q = 0; q < nq; ++q)
+      {
+         T.SetIntPoint(&ir->IntPoint(q));
+         nh->EvalParameters(C(q,0,e), C(q,1,e), C(q,2,e));
+      }
+   }
+
+   pa_data.SetSize((4 + dim*dim) * nq * ne, Device::GetDeviceMemoryType());
+   const Array<double> &w = ir->GetWeights();
+   if (dim == 2)
+   {
+      PAHyperelasticSetup<2>(nq, ne, w, geom->J, coeff, pa_data);
+   }
+   else
+   {
+      PAHyperelasticSetup<3>(nq, ne, w, geom->J, coeff, pa_data);
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   PAHyperelasticApply<false>(dim, ne, *maps, pa_data, grad_data, x, y);
+}
+
+// Deformation gradients Jpt = Jpr Jrt of the E-vector x at the quadrature
+// points
+template<int DIM, int T_D1D = 0, int T_Q1D = 0> static
+void PAHyperelasticSetupGrad(const int NE,
+                             const Array<double> &b,
+                             const Array<double> &g,
+                             const Vector &d_,
+                             const Vector &x_,
+                             Vector &j_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int NQ = DIM == 2 ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d_.Read(), NQ, 4 + DIM*DIM, NE);
+   auto J = Reshape(j_.Write(), NQ, DIM*DIM, NE);
+   auto x2 = Reshape(x_.Read(), D1D, D1D, 2, NE);
+   auto x3 = Reshape(x_.Read(), D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MQ2 = DIM == 2 ? max_Q1D : 1;
+      constexpr int MQ3 = DIM == 3 ? max_Q1D : 1;
+      double grad2[MQ2][MQ2][2][2];
+      double grad3[MQ3][MQ3][MQ3][3][3];
+      if (DIM == 2)
+      {
+         PAHyperelasticGrad2D<max_D1D,MQ2>(e, D1D, Q1D, B, G, x2, grad2);
+      }
+      else
+      {
+         PAHyperelasticGrad3D<max_D1D,MQ3>(e, D1D, Q1D, B, G, x3, grad3);
+      }
+      for (int q = 0; q < NQ; ++q)
+      {
+         const int qx = q % Q1D;
+         const int qy = (q / Q1D) % Q1D;
+         const int qz = q / (Q1D*Q1D);
+         for (int c = 0; c < DIM; c++)
+         {
+            for (int k = 0; k < DIM; k++)
+            {
+               double s = 0.0;
+               for (int r = 0; r < DIM; r++)
+               {
+                  const double Gr = (DIM == 2) ? grad2[qy][qx][c][r] :
+                                    grad3[qz][qy][qx][c][r];
+                  s += Gr * D(q,4+r+DIM*k,e);
+               }
+               J(q,c+DIM*k,e) = s;
+            }
+         }
+      }
+   });
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(fes.GetNE() == ne, "AssemblePA() must be called first!");
+   if (ne == 0) { return; }
+   const int D1D = maps->ndof;
+   const int Q1D = maps->nqpt;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   grad_data.SetSize(dim * dim * nq * ne, Device::GetDeviceMemoryType());
+   Vector &J = grad_data;
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAHyperelasticSetupGrad<2,2,3>(ne,B,G,pa_data,x,J);
+         case 0x34: return PAHyperelasticSetupGrad<2,3,4>(ne,B,G,pa_data,x,J);
+         default:
+            return PAHyperelasticSetupGrad<2>(ne,B,G,pa_data,x,J,D1D,Q1D);
+      }
+   }
+   switch ((D1D << 4 ) | Q1D)
+   {
+      case 0x23: return PAHyperelasticSetupGrad<3,2,3>(ne,B,G,pa_data,x,J);
+      case 0x34: return PAHyperelasticSetupGrad<3,3,4>(ne,B,G,pa_data,x,J);
+      default:
+         return PAHyperelasticSetupGrad<3>(ne,B,G,pa_data,x,J,D1D,Q1D);
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &x,
+                                              Vector &y) const
+{
+   if (ne == 0) { return; }
+   PAHyperelasticApply<true>(dim, ne, *maps, pa_data, grad_data, x, y);
+}
+
+} // namespace mfem
@@ -24,7 +24,7 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    qspace = NULL;
    IntRule = &ir;
    q_layout = QVectorLayout::byNODES;
-   use_tensor_products = true; // not implemented yet (not used)
+   use_tensor_products = true;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -39,7 +39,7 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    qspace = &qs;
    IntRule = NULL;
    q_layout = QVectorLayout::byNODES;
-   use_tensor_products = true; // not implemented yet (not used)
+   use_tensor_products = true;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -232,23 +232,118 @@ void QuadratureInterpolator::Eval3D(
    });
 }
 
-void QuadratureInterpolator::Mult(
-   const Vector &e_vec, unsigned eval_flags,
-   Vector &q_val, Vector &q_der, Vector &q_det) const
+bool QuadratureInterpolator::UseTensorProducts(QVectorLayout layout) const
+{
+   const FiniteElement *fe = fespace->GetFE(0);
+   const int dim = fe->GetDim();
+   if (!dynamic_cast<const TensorBasisElement*>(fe) || dim == 1)
+   {
+      return false;
+   }
+   if (layout == QVectorLayout::byVDIM) { return true; }
+   if (!use_tensor_products) { return false; }
+   // The determinants of the tensor path require vdim == dim
+   const int vdim = fespace->GetVDim();
+   if (vdim != 1 && vdim != dim) { return false; }
+   // Limits of the generic tensor kernels in D2QValues and D2QGrad
+   const IntegrationRule &ir =
+      IntRule ? *IntRule : qspace->GetElementIntRule(0);
+   const DofToQuad &d2q = fe->GetDofToQuad(ir, DofToQuad::TENSOR);
+   const int max_d1d = (dim == 2) ? MAX_D1D : 8;
+   const int max_q1d = (dim == 2) ? MAX_Q1D : 8;
+   return d2q.ndof <= max_d1d && d2q.nqpt <= max_q1d;
+}
+
+static void D2QValues(const FiniteElementSpace &fes,
+                      const DofToQuad *maps,
+                      const Vector &e_vec,
+                      Vector &q_val,
+                      const bool by_vdim,
+                      const ElementGather &EG);
+
+static void D2QGrad(const FiniteElementSpace &fes,
+                    const DofToQuad *maps,
+                    const Vector &e_vec,
+                    Vector &q_der,
+                    const bool by_vdim,
+                    const ElementGather &EG);
+
+// Determinants of the Jacobians given by the derivatives q_der of a vector
+// field with VDIM = DIM, with the Q-vectors in the layout given by 'by_vdim'.
+template<int DIM>
+static void D2QDet(const int NQ,
+                   const int NE,
+                   const bool by_vdim,
+                   const Vector &q_der,
+                   Vector &q_det)
 {
-   if (q_layout == QVectorLayout::byVDIM)
+   auto J_n = Reshape(q_der.Read(), NQ, DIM, DIM, NE);
+   auto J_v = Reshape(q_der.Read(), DIM, DIM, NQ, NE);
+   auto det = Reshape(q_det.Write(), NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
    {
-      if (eval_flags & VALUES) { Values(e_vec, q_val); }
-      if (eval_flags & DERIVATIVES) { Derivatives(e_vec, q_der); }
-      if (eval_flags & DETERMINANTS)
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jloc[DIM*DIM];
+      for (int col = 0; col < DIM; col++)
       {
-         MFEM_ABORT("evaluation of determinants with 'byVDIM' output layout"
-                    " is not implemented yet!");
+         for (int row = 0; row < DIM; row++)
+         {
+            Jloc[row+DIM*col] = by_vdim ? J_v(row,col,q,e) : J_n(q,row,col,e);
+         }
       }
-      return;
+      det(q,e) = kernels::Det<DIM>(Jloc);
+   });
+}
+
+// Tensor product evaluations of Mult() and MultFused(): the element dofs are
+// read from the lexicographic E-vector x, or gathered from the L-vector x when
+// EG is fused.
+static void D2QTensor(const FiniteElementSpace &fes,
+                      const IntegrationRule &ir,
+                      const Vector &x,
+                      const ElementGather &EG,
+                      const bool by_vdim,
+                      const unsigned eval_flags,
+                      Vector &q_val,
+                      Vector &q_der,
+                      Vector &q_det)
+{
+   const int ne = fes.GetNE();
+   const int vdim = fes.GetVDim();
+   const int dim = fes.GetMesh()->Dimension();
+   const DofToQuad &d2q = fes.GetFE(0)->GetDofToQuad(ir, DofToQuad::TENSOR);
+   if (eval_flags & QuadratureInterpolator::VALUES)
+   {
+      D2QValues(fes, &d2q, x, q_val, by_vdim, EG);
+   }
+   if (eval_flags & QuadratureInterpolator::DERIVATIVES)
+   {
+      D2QGrad(fes, &d2q, x, q_der, by_vdim, EG);
+   }
+   if (eval_flags & QuadratureInterpolator::DETERMINANTS)
+   {
+      MFEM_VERIFY(vdim == dim, "the determinants require vdim == dim");
+      const int nq = ir.GetNPoints();
+      Vector der;
+      if (eval_flags & QuadratureInterpolator::DERIVATIVES)
+      {
+         der.MakeRef(q_der, 0, q_der.Size());
+      }
+      else
+      {
+         der.SetSize(nq*vdim*dim*ne, Device::GetDeviceMemoryType());
+         D2QGrad(fes, &d2q, x, der, by_vdim, EG);
+      }
+      if (dim == 2) { D2QDet<2>(nq, ne, by_vdim, der, q_det); }
+      else { D2QDet<3>(nq, ne, by_vdim, der, q_det); }
    }
+}
 
-   // q_layout == QVectorLayout::byNODES
+void QuadratureInterpolator::Mult(
+   const Vector &e_vec, unsigned eval_flags,
+   Vector &q_val, Vector &q_der, Vector &q_det) const
+{
    const int ne = fespace->GetNE();
    if (ne == 0) { return; }
    const int vdim = fespace->GetVDim();
@@ -256,6 +351,16 @@ void QuadratureInterpolator::Mult(
    const FiniteElement *fe = fespace->GetFE(0);
    const IntegrationRule *ir =
       IntRule ? IntRule : &qspace->GetElementIntRule(0);
+
+   if (UseTensorProducts(q_layout))
+   {
+      const bool by_vdim = (q_layout == QVectorLayout::byVDIM);
+      D2QTensor(*fespace, *ir, e_vec, ElementGather(), by_vdim, eval_flags,
+                q_val, q_der, q_det);
+      return;
+   }
+   MFEM_VERIFY(q_layout == QVectorLayout::byNODES,
+               "the 'byVDIM' output layout requires tensor-product elements!");
    const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
    const int nd = maps.ndof;
    const int nq = maps.nqpt;
@@ -413,19 +518,28 @@ void QuadratureInterpolator::Mult(
    }
 }
 
-void QuadratureInterpolator::MultTranspose(
-   unsigned eval_flags, const Vector &q_val, const Vector &q_der,
-   Vector &e_vec) const
+
+void QuadratureInterpolator::MultFused(
+   const ElementRestriction &R, const Vector &l_vec, unsigned eval_flags,
+   Vector &q_val, Vector &q_der, Vector &q_det) const
 {
-   MFEM_ABORT("this method is not implemented yet");
+   if (fespace->GetNE() == 0) { return; }
+   MFEM_VERIFY(UseTensorProducts(q_layout),
+               "the fused evaluation requires the tensor product evaluations");
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+   const bool by_vdim = (q_layout == QVectorLayout::byVDIM);
+   D2QTensor(*fespace, *ir, l_vec, R.GetElementGather(), by_vdim, eval_flags,
+             q_val, q_der, q_det);
 }
 
-
 template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void D2QValues2D(const int NE,
                         const Array<double> &b_,
                         const Vector &x_,
                         Vector &y_,
+                        const bool by_vdim,
+                        const ElementGather &gather,
                         const int vdim = 1,
                         const int d1d = 0,
                         const int q1d = 0)
@@ -438,6 +552,7 @@ static void D2QValues2D(const int NE,
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto x = Reshape(x_.Read(), D1D, D1D, VDIM, NE);
    auto y = Reshape(y_.Write(), VDIM, Q1D, Q1D, NE);
+   auto y_n = Reshape(y_.Write(), Q1D, Q1D, VDIM, NE);
 
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
@@ -474,7 +589,9 @@ static void D2QValues2D(const int NE,
          {
             MFEM_FOREACH_THREAD(dx,x,D1D)
             {
-               DD[dy][dx] = x(dx,dy,c,e);
+               DD[dy][dx] = gather.Fused() ?
+                            gather.Gather(x, e, dx + D1D*dy, c) :
+                            x(dx,dy,c,e);
             }
          }
          MFEM_SYNC_THREAD;
@@ -500,7 +617,8 @@ static void D2QValues2D(const int NE,
                {
                   qq += DQ[dy][qx] * B[qy][dy];
                }
-               y(c,qx,qy,e) = qq;
+               if (by_vdim) { y(c,qx,qy,e) = qq; }
+               else { y_n(qx,qy,c,e) = qq; }
             }
          }
          MFEM_SYNC_THREAD;
@@ -514,6 +632,8 @@ static void D2QValues3D(const int NE,
                         const Array<double> &b_,
                         const Vector &x_,
                         Vector &y_,
+                        const bool by_vdim,
+                        const ElementGather &gather,
                         const int vdim = 1,
                         const int d1d = 0,
                         const int q1d = 0)
@@ -525,6 +645,7 @@ static void D2QValues3D(const int NE,
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, VDIM, NE);
    auto y = Reshape(y_.Write(), VDIM, Q1D, Q1D, Q1D, NE);
+   auto y_n = Reshape(y_.Write(), Q1D, Q1D, Q1D, VDIM, NE);
 
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
@@ -562,7 +683,9 @@ static void D2QValues3D(const int NE,
             {
                MFEM_FOREACH_THREAD(dx,x,D1D)
                {
-                  X[dz][dy][dx] = x(dx,dy,dz,c,e);
+                  const int d = dx + D1D*(dy + D1D*dz);
+                  X[dz][dy][dx] = gather.Fused() ? gather.Gather(x, e, d, c) :
+                                  x(dx,dy,dz,c,e);
                }
             }
          }
@@ -610,7 +733,8 @@ static void D2QValues3D(const int NE,
                   {
                      u += DQQ[dz][qy][qx] * B[qz][dz];
                   }
-                  y(c,qx,qy,qz,e) = u;
+                  if (by_vdim) { y(c,qx,qy,qz,e) = u; }
+                  else { y_n(qx,qy,qz,c,e) = u; }
                }
             }
          }
@@ -621,8 +745,10 @@ static void D2QValues3D(const int NE,
 
 static void D2QValues(const FiniteElementSpace &fes,
                       const DofToQuad *maps,
-                      const Vector &e_vec,
-                      Vector &q_val)
+                      const Vector &X,
+                      Vector &Y,
+                      const bool by_vdim,
+                      const ElementGather &EG)
 {
    const int dim = fes.GetMesh()->Dimension();
    const int vdim = fes.GetVDim();
@@ -630,24 +756,25 @@ static void D2QValues(const FiniteElementSpace &fes,
    const int D1D = maps->ndof;
    const int Q1D = maps->nqpt;
    const int id = (vdim<<8) | (D1D<<4) | Q1D;
+   const Array<double> &B = maps->B;
 
    if (dim == 2)
    {
       switch (id)
       {
-         case 0x124: return D2QValues2D<1,2,4,8>(NE, maps->B, e_vec, q_val);
-         case 0x136: return D2QValues2D<1,3,6,4>(NE, maps->B, e_vec, q_val);
-         case 0x148: return D2QValues2D<1,4,8,2>(NE, maps->B, e_vec, q_val);
-         case 0x224: return D2QValues2D<2,2,4,8>(NE, maps->B, e_vec, q_val);
-         case 0x236: return D2QValues2D<2,3,6,4>(NE, maps->B, e_vec, q_val);
-         case 0x248: return D2QValues2D<2,4,8,2>(NE, maps->B, e_vec, q_val);
+         case 0x124: return D2QValues2D<1,2,4,8>(NE, B, X, Y, by_vdim, EG);
+         case 0x136: return D2QValues2D<1,3,6,4>(NE, B, X, Y, by_vdim, EG);
+         case 0x148: return D2QValues2D<1,4,8,2>(NE, B, X, Y, by_vdim, EG);
+         case 0x224: return D2QValues2D<2,2,4,8>(NE, B, X, Y, by_vdim, EG);
+         case 0x236: return D2QValues2D<2,3,6,4>(NE, B, X, Y, by_vdim, EG);
+         case 0x248: return D2QValues2D<2,4,8,2>(NE, B, X, Y, by_vdim, EG);
          default:
          {
             MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
                         << MAX_Q1D << " 1D points are not supported!");
-            D2QValues2D(NE, maps->B, e_vec, q_val, vdim, D1D, Q1D);
+            D2QValues2D(NE, B, X, Y, by_vdim, EG, vdim, D1D, Q1D);
             return;
          }
       }
@@ -656,12 +783,12 @@ static void D2QValues(const FiniteElementSpace &fes,
    {
       switch (id)
       {
-         case 0x124: return D2QValues3D<1,2,4>(NE, maps->B, e_vec, q_val);
-         case 0x136: return D2QValues3D<1,3,6>(NE, maps->B, e_vec, q_val);
-         case 0x148: return D2QValues3D<1,4,8>(NE, maps->B, e_vec, q_val);
-         case 0x324: return D2QValues3D<3,2,4>(NE, maps->B, e_vec, q_val);
-         case 0x336: return D2QValues3D<3,3,6>(NE, maps->B, e_vec, q_val);
-         case 0x348: return D2QValues3D<3,4,8>(NE, maps->B, e_vec, q_val);
+         case 0x124: return D2QValues3D<1,2,4>(NE, B, X, Y, by_vdim, EG);
+         case 0x136: return D2QValues3D<1,3,6>(NE, B, X, Y, by_vdim, EG);
+         case 0x148: return D2QValues3D<1,4,8>(NE, B, X, Y, by_vdim, EG);
+         case 0x324: return D2QValues3D<3,2,4>(NE, B, X, Y, by_vdim, EG);
+         case 0x336: return D2QValues3D<3,3,6>(NE, B, X, Y, by_vdim, EG);
+         case 0x348: return D2QValues3D<3,4,8>(NE, B, X, Y, by_vdim, EG);
          default:
          {
             constexpr int MD = 8;
@@ -670,7 +797,8 @@ static void D2QValues(const FiniteElementSpace &fes,
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than " << MQ
                         << " 1D points are not supported!");
-            D2QValues3D<0,0,0,MD,MQ>(NE, maps->B, e_vec, q_val, vdim, D1D, Q1D);
+            D2QValues3D<0,0,0,MD,MQ>(NE, B, X, Y, by_vdim, EG,
+                                     vdim, D1D, Q1D);
             return;
          }
       }
@@ -681,19 +809,8 @@ static void D2QValues(const FiniteElementSpace &fes,
 
 void QuadratureInterpolator::Values(const Vector &e_vec, Vector &q_val) const
 {
-   if (q_layout == QVectorLayout::byNODES)
-   {
-      Vector empty;
-      Mult(e_vec, VALUES, q_val, empty, empty);
-      return;
-   }
-
-   // q_layout == QVectorLayout::byVDIM
-   if (fespace->GetNE() == 0) { return; }
-   const IntegrationRule &ir = *IntRule;
-   const DofToQuad::Mode mode = DofToQuad::TENSOR;
-   const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
-   D2QValues(*fespace, &d2q, e_vec, q_val);
+   Vector empty;
+   Mult(e_vec, VALUES, q_val, empty, empty);
 }
 
 template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
@@ -702,6 +819,8 @@ static void D2QGrad2D(const int NE,
                       const double *g_,
                       const double *x_,
                       double *y_,
+                      const bool by_vdim,
+                      const ElementGather &gather,
                       const int vdim = 1,
                       const int d1d = 0,
                       const int q1d = 0)
@@ -715,6 +834,7 @@ static void D2QGrad2D(const int NE,
    auto g = Reshape(g_, Q1D, D1D);
    auto x = Reshape(x_, D1D, D1D, VDIM, NE);
    auto y = Reshape(y_, VDIM, 2, Q1D, Q1D, NE);
+   auto y_n = Reshape(y_, Q1D, Q1D, VDIM, 2, NE);
 
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
@@ -754,7 +874,9 @@ static void D2QGrad2D(const int NE,
          {
             MFEM_FOREACH_THREAD(dy,y,D1D)
             {
-               X[dx][dy] = x(dx,dy,c,e);
+               X[dx][dy] = gather.Fused() ?
+                           gather.Gather(x, e, dx + D1D*dy, c) :
+                           x(dx,dy,c,e);
             }
          }
          MFEM_SYNC_THREAD;
@@ -786,8 +908,16 @@ static void D2QGrad2D(const int NE,
                   u += DQ1[dy][qx] * B[qy][dy];
                   v += DQ0[dy][qx] * G[qy][dy];
                }
-               y(c,0,qx,qy,e) = u;
-               y(c,1,qx,qy,e) = v;
+               if (by_vdim)
+               {
+                  y(c,0,qx,qy,e) = u;
+                  y(c,1,qx,qy,e) = v;
+               }
+               else
+               {
+                  y_n(qx,qy,c,0,e) = u;
+                  y_n(qx,qy,c,1,e) = v;
+               }
             }
          }
          MFEM_SYNC_THREAD;
@@ -802,6 +932,8 @@ static  void D2QGrad3D(const int NE,
                        const double *g_,
                        const double *x_,
                        double *y_,
+                       const bool by_vdim,
+                       const ElementGather &gather,
                        const int vdim = 1,
                        const int d1d = 0,
                        const int q1d = 0)
@@ -814,6 +946,7 @@ static  void D2QGrad3D(const int NE,
    auto g = Reshape(g_, Q1D, D1D);
    auto x = Reshape(x_, D1D, D1D, D1D, VDIM, NE);
    auto y = Reshape(y_, VDIM, 3, Q1D, Q1D, Q1D, NE);
+   auto y_n = Reshape(y_, Q1D, Q1D, Q1D, VDIM, 3, NE);
 
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
@@ -856,7 +989,9 @@ static  void D2QGrad3D(const int NE,
             {
                MFEM_FOREACH_THREAD(dz,z,D1D)
                {
-                  X[dx][dy][dz] = x(dx,dy,dz,c,e);
+                  const int d = dx + D1D*(dy + D1D*dz);
+                  X[dx][dy][dz] = gather.Fused() ? gather.Gather(x, e, d, c) :
+                                  x(dx,dy,dz,c,e);
                }
             }
          }
@@ -919,9 +1054,18 @@ static  void D2QGrad3D(const int NE,
                      v += DQQ1[dz][qy][qx] * B[qz][dz];
                      w += DQQ2[dz][qy][qx] * G[qz][dz];
                   }
-                  y(c,0,qx,qy,qz,e) = u;
-                  y(c,1,qx,qy,qz,e) = v;
-                  y(c,2,qx,qy,qz,e) = w;
+                  if (by_vdim)
+                  {
+                     y(c,0,qx,qy,qz,e) = u;
+                     y(c,1,qx,qy,qz,e) = v;
+                     y(c,2,qx,qy,qz,e) = w;
+                  }
+                  else
+                  {
+                     y_n(qx,qy,qz,c,0,e) = u;
+                     y_n(qx,qy,qz,c,1,e) = v;
+                     y_n(qx,qy,qz,c,2,e) = w;
+                  }
                }
             }
          }
@@ -933,7 +1077,9 @@ static  void D2QGrad3D(const int NE,
 static void D2QGrad(const FiniteElementSpace &fes,
                     const DofToQuad *maps,
                     const Vector &e_vec,
-                    Vector &q_der)
+                    Vector &q_der,
+                    const bool by_vdim,
+                    const ElementGather &EG)
 {
    const int dim = fes.GetMesh()->Dimension();
    const int vdim = fes.GetVDim();
@@ -949,19 +1095,19 @@ static void D2QGrad(const FiniteElementSpace &fes,
    {
       switch (id)
       {
-         case 0x134: return D2QGrad2D<1,3,4,8>(NE, B, G, X, Y);
-         case 0x146: return D2QGrad2D<1,4,6,4>(NE, B, G, X, Y);
-         case 0x158: return D2QGrad2D<1,5,8,2>(NE, B, G, X, Y);
-         case 0x234: return D2QGrad2D<2,3,4,8>(NE, B, G, X, Y);
-         case 0x246: return D2QGrad2D<2,4,6,4>(NE, B, G, X, Y);
-         case 0x258: return D2QGrad2D<2,5,8,2>(NE, B, G, X, Y);
+         case 0x134: return D2QGrad2D<1,3,4,8>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x146: return D2QGrad2D<1,4,6,4>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x158: return D2QGrad2D<1,5,8,2>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x234: return D2QGrad2D<2,3,4,8>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x246: return D2QGrad2D<2,4,6,4>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x258: return D2QGrad2D<2,5,8,2>(NE, B, G, X, Y, by_vdim, EG);
          default:
          {
             MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
                         << MAX_Q1D << " 1D points are not supported!");
-            D2QGrad2D(NE, B, G, X, Y, vdim, D1D, Q1D);
+            D2QGrad2D(NE, B, G, X, Y, by_vdim, EG, vdim, D1D, Q1D);
             return;
          }
       }
@@ -970,12 +1116,12 @@ static void D2QGrad(const FiniteElementSpace &fes,
    {
       switch (id)
       {
-         case 0x134: return D2QGrad3D<1,3,4>(NE, B, G, X, Y);
-         case 0x146: return D2QGrad3D<1,4,6>(NE, B, G, X, Y);
-         case 0x158: return D2QGrad3D<1,5,8>(NE, B, G, X, Y);
-         case 0x334: return D2QGrad3D<3,3,4>(NE, B, G, X, Y);
-         case 0x346: return D2QGrad3D<3,4,6>(NE, B, G, X, Y);
-         case 0x358: return D2QGrad3D<3,5,8>(NE, B, G, X, Y);
+         case 0x134: return D2QGrad3D<1,3,4>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x146: return D2QGrad3D<1,4,6>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x158: return D2QGrad3D<1,5,8>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x334: return D2QGrad3D<3,3,4>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x346: return D2QGrad3D<3,4,6>(NE, B, G, X, Y, by_vdim, EG);
+         case 0x358: return D2QGrad3D<3,5,8>(NE, B, G, X, Y, by_vdim, EG);
          default:
          {
             constexpr int MD = 8;
@@ -984,7 +1130,8 @@ static void D2QGrad(const FiniteElementSpace &fes,
                         << " are not supported!");
             MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than " << MQ
                         << " 1D points are not supported!");
-            D2QGrad3D<0,0,0,MD,MQ>(NE, B, G, X, Y, vdim, D1D, Q1D);
+            D2QGrad3D<0,0,0,MD,MQ>(NE, B, G, X, Y, by_vdim, EG,
+                                   vdim, D1D, Q1D);
             return;
          }
       }
@@ -1317,19 +1464,8 @@ static void D2QPhysGrad(const FiniteElementSpace &fes,
 void QuadratureInterpolator::Derivatives(const Vector &e_vec,
                                          Vector &q_der) const
 {
-   if (q_layout == QVectorLayout::byNODES)
-   {
-      Vector empty;
-      Mult(e_vec, DERIVATIVES, empty, q_der, empty);
-      return;
-   }
-
-   // q_layout == QVectorLayout::byVDIM
-   if (fespace->GetNE() == 0) { return; }
-   const IntegrationRule &ir = *IntRule;
-   const DofToQuad::Mode mode = DofToQuad::TENSOR;
-   const DofToQuad &d2q = fespace->GetFE(0)->GetDofToQuad(ir, mode);
-   D2QGrad(*fespace, &d2q, e_vec, q_der);
+   Vector empty;
+   Mult(e_vec, DERIVATIVES, empty, q_der, empty);
 }
 
 void QuadratureInterpolator::PhysDerivatives(const Vector &e_vec,
@@ -1354,4 +1490,541 @@ void QuadratureInterpolator::PhysDerivatives(const Vector &e_vec,
    D2QPhysGrad(*fespace, geom, &d2q, e_vec, q_der);
 }
 
+// Transpose of Eval2D/Eval3D: e_vec = B^T q_val + G^T q_der, with the
+// Q-vectors in the layout given by 'by_vdim'.
+template<int T_DIM, int T_VDIM = 0>
+static void EvalTranspose(const int NE,
+                          const int vdim,
+                          const bool by_vdim,
+                          const DofToQuad &maps,
+                          const bool use_val,
+                          const bool use_der,
+                          const Vector &q_val,
+                          const Vector &q_der,
+                          Vector &e_vec)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+   auto B = Reshape(maps.B.Read(), NQ, ND);
+   auto G = Reshape(maps.G.Read(), NQ, T_DIM, ND);
+   const double *v = use_val ? q_val.Read() : NULL;
+   const double *d = use_der ? q_der.Read() : NULL;
+   auto val_n = Reshape(v, NQ, VDIM, NE);
+   auto val_v = Reshape(v, VDIM, NQ, NE);
+   auto der_n = Reshape(d, NQ, VDIM, T_DIM, NE);
+   auto der_v = Reshape(d, VDIM, T_DIM, NQ, NE);
+   auto E = Reshape(e_vec.Write(), ND, VDIM, NE);
+   MFEM_FORALL_2D(e, NE, ND, 1, 1,
+   {
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      MFEM_FOREACH_THREAD(dof, x, ND)
+      {
+         for (int c = 0; c < VDIM; c++)
+         {
+            double ed = 0.0;
+            for (int q = 0; q < NQ; ++q)
+            {
+               if (use_val)
+               {
+                  const double vq = by_vdim ? val_v(c,q,e) : val_n(q,c,e);
+                  ed += B(q,dof) * vq;
+               }
+               if (use_der)
+               {
+                  for (int k = 0; k < T_DIM; k++)
+                  {
+                     const double dq = by_vdim ? der_v(c,k,q,e) :
+                                       der_n(q,c,k,e);
+                     ed += G(q,k,dof) * dq;
+                  }
+               }
+            }
+            E(dof,c,e) = ed;
+         }
+      }
+   });
+}
+
+// Tensor-product transpose of D2QValues2D and D2QGrad2D.
+template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+static void Q2DTranspose2D(const int NE,
+                           const double *b_,
+                           const double *g_,
+                           const double *v_,
+                           const double *d_,
+                           double *y_,
+                           const bool by_vdim,
+                           const bool use_val,
+                           const bool use_der,
+                           const int vdim = 1,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+
+   auto b = Reshape(b_, Q1D, D1D);
+   auto g = Reshape(g_, Q1D, D1D);
+   auto val_n = Reshape(v_, Q1D, Q1D, VDIM, NE);
+   auto val_v = Reshape(v_, VDIM, Q1D, Q1D, NE);
+   auto der_n = Reshape(d_, Q1D, Q1D, VDIM, 2, NE);
+   auto der_v = Reshape(d_, VDIM, 2, Q1D, Q1D, NE);
+   auto y = Reshape(y_, D1D, D1D, VDIM, NE);
+
+   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int NBZ = T_NBZ ? T_NBZ : 1;
+      const int tidz = MFEM_THREAD_ID(z);
+      MFEM_SHARED double B[MQ1][MD1];
+      MFEM_SHARED double G[MQ1][MD1];
+
+      MFEM_SHARED double QQ[3][NBZ][MQ1][MQ1];
+      double (*QQ0)[MQ1] = (double (*)[MQ1])(QQ[0] + tidz);
+      double (*QQ1)[MQ1] = (double (*)[MQ1])(QQ[1] + tidz);
+      double (*QQ2)[MQ1] = (double (*)[MQ1])(QQ[2] + tidz);
+
+      MFEM_SHARED double QD[2][NBZ][MQ1][MD1];
+      double (*QD0)[MD1] = (double (*)[MD1])(QD[0] + tidz);
+      double (*QD1)[MD1] = (double (*)[MD1])(QD[1] + tidz);
+
+      if (tidz == 0)
+      {
+         MFEM_FOREACH_THREAD(d,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(q,x,Q1D)
+            {
+               B[q][d] = b(q,d);
+               G[q][d] = g(q,d);
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+
+      for (int c = 0; c < VDIM; ++c)
+      {
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qx,x,Q1D)
+            {
+               QQ0[qy][qx] = !use_val ? 0.0 :
+                             by_vdim ? val_v(c,qx,qy,e) : val_n(qx,qy,c,e);
+               QQ1[qy][qx] = !use_der ? 0.0 :
+                             by_vdim ? der_v(c,0,qx,qy,e) : der_n(qx,qy,c,0,e);
+               QQ2[qy][qx] = !use_der ? 0.0 :
+                             by_vdim ? der_v(c,1,qx,qy,e) : der_n(qx,qy,c,1,e);
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qy,y,Q1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               double u = 0.0;
+               double v = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += B[qx][dx] * QQ0[qy][qx] + G[qx][dx] * QQ1[qy][qx];
+                  v += B[qx][dx] * QQ2[qy][qx];
+               }
+               QD0[qy][dx] = u;
+               QD1[qy][dx] = v;
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dy,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(dx,x,D1D)
+            {
+               double u = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += B[qy][dy] * QD0[qy][dx] + G[qy][dy] * QD1[qy][dx];
+               }
+               y(dx,dy,c,e) = u;
+            }
+         }
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
+// Tensor-product transpose of D2QValues3D and D2QGrad3D.
+template<int T_VDIM = 0, int T_D1D = 0, int T_Q1D = 0,
+         int MAX_D = 0, int MAX_Q = 0>
+static void Q2DTranspose3D(const int NE,
+                           const double *b_,
+                           const double *g_,
+                           const double *v_,
+                           const double *d_,
+                           double *y_,
+                           const bool by_vdim,
+                           const bool use_val,
+                           const bool use_der,
+                           const int vdim = 1,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int VDIM = T_VDIM ? T_VDIM : vdim;
+
+   auto b = Reshape(b_, Q1D, D1D);
+   auto g = Reshape(g_, Q1D, D1D);
+   auto val_n = Reshape(v_, Q1D, Q1D, Q1D, VDIM, NE);
+   auto val_v = Reshape(v_, VDIM, Q1D, Q1D, Q1D, NE);
+   auto der_n = Reshape(d_, Q1D, Q1D, Q1D, VDIM, 3, NE);
+   auto der_v = Reshape(d_, VDIM, 3, Q1D, Q1D, Q1D, NE);
+   auto y = Reshape(y_, D1D, D1D, D1D, VDIM, NE);
+
+   MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      const int VDIM = T_VDIM ? T_VDIM : vdim;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D;
+      const int tidz = MFEM_THREAD_ID(z);
+      MFEM_SHARED double B[MQ1][MD1];
+      MFEM_SHARED double G[MQ1][MD1];
+
+      MFEM_SHARED double QQQ[4][MQ1][MQ1][MQ1];
+      MFEM_SHARED double QQD[3][MQ1][MQ1][MD1];
+      MFEM_SHARED double QDD[2][MQ1][MD1][MD1];
+
+      if (tidz == 0)
+      {
+         MFEM_FOREACH_THREAD(d,y,D1D)
+         {
+            MFEM_FOREACH_THREAD(q,x,Q1D)
+            {
+               B[q][d] = b(q,d);
+               G[q][d] = g(q,d);
+            }
+         }
+      }
+      MFEM_SYNC_THREAD;
+
+      for (int c = 0; c < VDIM; ++c)
+      {
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(qx,x,Q1D)
+               {
+                  QQQ[0][qz][qy][qx] = !use_val ? 0.0 : by_vdim ?
+                                       val_v(c,qx,qy,qz,e) :
+                                       val_n(qx,qy,qz,c,e);
+                  for (int k = 0; k < 3; k++)
+                  {
+                     QQQ[k+1][qz][qy][qx] = !use_der ? 0.0 : by_vdim ?
+                                            der_v(c,k,qx,qy,qz,e) :
+                                            der_n(qx,qy,qz,c,k,e);
+                  }
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(qy,y,Q1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double bx = B[qx][dx];
+                     u += bx * QQQ[0][qz][qy][qx] +
+                          G[qx][dx] * QQQ[1][qz][qy][qx];
+                     v += bx * QQQ[2][qz][qy][qx];
+                     w += bx * QQQ[3][qz][qy][qx];
+                  }
+                  QQD[0][qz][qy][dx] = u;
+                  QQD[1][qz][qy][dx] = v;
+                  QQD[2][qz][qy][dx] = w;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(qz,z,Q1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double by = B[qy][dy];
+                     u += by * QQD[0][qz][qy][dx] +
+                          G[qy][dy] * QQD[1][qz][qy][dx];
+                     v += by * QQD[2][qz][qy][dx];
+                  }
+                  QDD[0][qz][dy][dx] = u;
+                  QDD[1][qz][dy][dx] = v;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+         MFEM_FOREACH_THREAD(dz,z,D1D)
+         {
+            MFEM_FOREACH_THREAD(dy,y,D1D)
+            {
+               MFEM_FOREACH_THREAD(dx,x,D1D)
+               {
+                  double u = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += B[qz][dz] * QDD[0][qz][dy][dx] +
+                          G[qz][dz] * QDD[1][qz][dy][dx];
+                  }
+                  y(dx,dy,dz,c,e) = u;
+               }
+            }
+         }
+         MFEM_SYNC_THREAD;
+      }
+   });
+}
+
+static void Q2DTranspose(const FiniteElementSpace &fes,
+                         const DofToQuad *maps,
+                         const bool by_vdim,
+                         const bool use_val,
+                         const bool use_der,
+                         const Vector &q_val,
+                         const Vector &q_der,
+                         Vector &e_vec)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   const int vdim = fes.GetVDim();
+   const int NE = fes.GetNE();
+   const int D1D = maps->ndof;
+   const int Q1D = maps->nqpt;
+   const int id = (vdim<<8) | (D1D<<4) | Q1D;
+   const double *B = maps->B.Read();
+   const double *G = maps->G.Read();
+   const double *V = use_val ? q_val.Read() : NULL;
+   const double *D = use_der ? q_der.Read() : NULL;
+   double *Y = e_vec.Write();
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x124: return Q2DTranspose2D<1,2,4,8>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x134: return Q2DTranspose2D<1,3,4,8>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x136: return Q2DTranspose2D<1,3,6,4>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x146: return Q2DTranspose2D<1,4,6,4>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x148: return Q2DTranspose2D<1,4,8,2>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x158: return Q2DTranspose2D<1,5,8,2>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x224: return Q2DTranspose2D<2,2,4,8>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x234: return Q2DTranspose2D<2,3,4,8>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x236: return Q2DTranspose2D<2,3,6,4>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x246: return Q2DTranspose2D<2,4,6,4>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x248: return Q2DTranspose2D<2,4,8,2>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         case 0x258: return Q2DTranspose2D<2,5,8,2>(NE, B, G, V, D, Y, by_vdim,
+                                                       use_val, use_der);
+         default:
+         {
+            MFEM_VERIFY(D1D <= MAX_D1D, "Orders higher than " << MAX_D1D-1
+                        << " are not supported!");
+            MFEM_VERIFY(Q1D <= MAX_Q1D, "Quadrature rules with more than "
+                        << MAX_Q1D << " 1D points are not supported!");
+            Q2DTranspose2D(NE, B, G, V, D, Y, by_vdim, use_val, use_der,
+                           vdim, D1D, Q1D);
+            return;
+         }
+      }
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x124: return Q2DTranspose3D<1,2,4>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x134: return Q2DTranspose3D<1,3,4>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x136: return Q2DTranspose3D<1,3,6>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x146: return Q2DTranspose3D<1,4,6>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x148: return Q2DTranspose3D<1,4,8>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x158: return Q2DTranspose3D<1,5,8>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x324: return Q2DTranspose3D<3,2,4>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x334: return Q2DTranspose3D<3,3,4>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x336: return Q2DTranspose3D<3,3,6>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x346: return Q2DTranspose3D<3,4,6>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x348: return Q2DTranspose3D<3,4,8>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         case 0x358: return Q2DTranspose3D<3,5,8>(NE, B, G, V, D, Y, by_vdim,
+                                                     use_val, use_der);
+         default:
+         {
+            constexpr int MD = 8;
+            constexpr int MQ = 8;
+            MFEM_VERIFY(D1D <= MD, "Orders higher than " << MD-1
+                        << " are not supported!");
+            MFEM_VERIFY(Q1D <= MQ, "Quadrature rules with more than " << MQ
+                        << " 1D points are not supported!");
+            Q2DTranspose3D<0,0,0,MD,MQ>(NE, B, G, V, D, Y, by_vdim, use_val,
+                                        use_der, vdim, D1D, Q1D);
+            return;
+         }
+      }
+   }
+   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
+   MFEM_ABORT("Unknown kernel");
+}
+
+// Map the derivatives in physical space q_der to reference derivatives r_der,
+// with the transpose of the (inverse Jacobian) map used by D2QPhysGrad.
+template<int DIM>
+static void PhysToRefDerivativesTranspose(const int NQ,
+                                          const int NE,
+                                          const int VDIM,
+                                          const bool by_vdim,
+                                          const Vector &J_,
+                                          const Vector &q_der,
+                                          Vector &r_der)
+{
+   auto J = Reshape(J_.Read(), NQ, DIM, DIM, NE);
+   auto p_n = Reshape(q_der.Read(), NQ, VDIM, DIM, NE);
+   auto p_v = Reshape(q_der.Read(), VDIM, DIM, NQ, NE);
+   auto r_n = Reshape(r_der.Write(), NQ, VDIM, DIM, NE);
+   auto r_v = Reshape(r_der.Write(), VDIM, DIM, NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jloc[DIM*DIM], Jinv[DIM*DIM];
+      for (int col = 0; col < DIM; col++)
+      {
+         for (int row = 0; row < DIM; row++)
+         {
+            Jloc[row+DIM*col] = J(q,row,col,e);
+         }
+      }
+      kernels::CalcInverse<DIM>(Jloc, Jinv);
+      for (int c = 0; c < VDIM; c++)
+      {
+         double p[DIM];
+         for (int k = 0; k < DIM; k++)
+         {
+            p[k] = by_vdim ? p_v(c,k,q,e) : p_n(q,c,k,e);
+         }
+         for (int j = 0; j < DIM; j++)
+         {
+            double r = 0.0;
+            for (int k = 0; k < DIM; k++) { r += Jinv[j+DIM*k] * p[k]; }
+            if (by_vdim) { r_v(c,j,q,e) = r; }
+            else { r_n(q,c,j,e) = r; }
+         }
+      }
+   });
+}
+
+void QuadratureInterpolator::MultTranspose(
+   unsigned eval_flags, const Vector &q_val, const Vector &q_der,
+   Vector &e_vec) const
+{
+   MFEM_VERIFY(!(eval_flags & DETERMINANTS),
+               "the transpose of the determinants is not supported!");
+   MFEM_VERIFY(!((eval_flags & DERIVATIVES) &&
+                 (eval_flags & PHYSICAL_DERIVATIVES)),
+               "DERIVATIVES and PHYSICAL_DERIVATIVES are exclusive!");
+   const int ne = fespace->GetNE();
+   if (ne == 0) { return; }
+   const int vdim = fespace->GetVDim();
+   const int dim = fespace->GetMesh()->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "only 2D and 3D are supported!");
+   const FiniteElement *fe = fespace->GetFE(0);
+   const IntegrationRule &ir =
+      IntRule ? *IntRule : qspace->GetElementIntRule(0);
+   const bool by_vdim = (q_layout == QVectorLayout::byVDIM);
+   const bool use_val = (eval_flags & VALUES);
+   const bool use_der = (eval_flags & (DERIVATIVES | PHYSICAL_DERIVATIVES));
+
+   const Vector *der = &q_der;
+   Vector ref_der;
+   if (eval_flags & PHYSICAL_DERIVATIVES)
+   {
+      Mesh *mesh = fespace->GetMesh();
+      const GeometricFactors *geom =
+         mesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
+      const int nq = ir.GetNPoints();
+      ref_der.SetSize(nq*vdim*dim*ne, Device::GetDeviceMemoryType());
+      if (dim == 2)
+      {
+         PhysToRefDerivativesTranspose<2>(nq, ne, vdim, by_vdim, geom->J,
+                                          q_der, ref_der);
+      }
+      else
+      {
+         PhysToRefDerivativesTranspose<3>(nq, ne, vdim, by_vdim, geom->J,
+                                          q_der, ref_der);
+      }
+      der = &ref_der;
+   }
+
+   // Same choice of the evaluation path as in Mult(), Values(), etc.
+   if (UseTensorProducts(q_layout))
+   {
+      const DofToQuad &d2q = fe->GetDofToQuad(ir, DofToQuad::TENSOR);
+      Q2DTranspose(*fespace, &d2q, by_vdim, use_val, use_der, q_val, *der,
+                   e_vec);
+      return;
+   }
+   const DofToQuad &maps = fe->GetDofToQuad(ir, DofToQuad::FULL);
+   if (dim == 2)
+   {
+      switch (vdim)
+      {
+         case 1: return EvalTranspose<2,1>(ne, vdim, by_vdim, maps, use_val,
+                                              use_der, q_val, *der, e_vec);
+         case 2: return EvalTranspose<2,2>(ne, vdim, by_vdim, maps, use_val,
+                                              use_der, q_val, *der, e_vec);
+         default: return EvalTranspose<2>(ne, vdim, by_vdim, maps, use_val,
+                                             use_der, q_val, *der, e_vec);
+      }
+   }
+   switch (vdim)
+   {
+      case 1: return EvalTranspose<3,1>(ne, vdim, by_vdim, maps, use_val,
+                                           use_der, q_val, *der, e_vec);
+      case 3: return EvalTranspose<3,3>(ne, vdim, by_vdim, maps, use_val,
+                                           use_der, q_val, *der, e_vec);
+      default: return EvalTranspose<3>(ne, vdim, by_vdim, maps, use_val,
+                                          use_der, q_val, *der, e_vec);
+   }
+}
+
 } // namespace mfem
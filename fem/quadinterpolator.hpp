@@ -61,7 +61,10 @@ public:
       /** @brief Assuming the derivative at quadrature points form a matrix,
           this flag can be used to compute and store their determinants. This
           flag can only be used in Mult(). */
-      DETERMINANTS = 1 << 2
+      DETERMINANTS = 1 << 2,
+      /** @brief Use the derivatives in physical space at quadrature points.
+          This flag can only be used in MultTranspose(). */
+      PHYSICAL_DERIVATIVES = 1 << 3
    };
 
    QuadratureInterpolator(const FiniteElementSpace &fes,
@@ -72,11 +75,22 @@ public:
 
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
-   /** Currently, tensor product evaluations are not implemented and this method
-       has no effect. */
+   /** By default, the tensor product (sum factorization) evaluations are used
+       for tensor-product elements in both output layouts. They require the
+       E-vector to use the lexicographic dof ordering, see
+       ElementDofOrdering::LEXICOGRAPHIC. When they are disabled, the byNODES
+       layout uses the full (non-tensor) evaluations with the native dof
+       ordering; the byVDIM layout always uses the tensor product evaluations.
+       The full evaluations are also used when the numbers of 1D dofs or
+       points exceed the limits of the tensor kernels. */
    void DisableTensorProducts(bool disable = true) const
    { use_tensor_products = !disable; }
 
+   /** @brief Return true if the tensor product evaluations are used with the
+       output layout @a layout, i.e. if the E-vector must use the
+       lexicographic dof ordering, see DisableTensorProducts(). */
+   bool UseTensorProducts(QVectorLayout layout) const;
+
    /** @brief Query the current output Q-vector layout. The default value is
        QVectorLayout::byNODES. */
    QVectorLayout GetOutputLayout() const { return q_layout; }
@@ -94,10 +108,20 @@ public:
        When the DETERMINANTS flags is set, it is assumed that the derivatives
        form a matrix at each quadrature point (i.e. the associated
        FiniteElementSpace is a vector space) and their determinants are computed
-       and stored in @a q_det. */
+       and stored in @a q_det. The dof ordering of @a e_vec depends on the use
+       of tensor product evaluations, see DisableTensorProducts(). */
    void Mult(const Vector &e_vec, unsigned eval_flags,
              Vector &q_val, Vector &q_der, Vector &q_det) const;
 
+   /** @brief Perform Mult() on the L-vector @a l_vec, gathering the element
+       dofs in the kernels instead of using an E-vector. */
+   /** The ElementRestriction @a R of the FiniteElementSpace must use the
+       lexicographic dof ordering, and the tensor product evaluations must be
+       used, see UseTensorProducts(). */
+   void MultFused(const ElementRestriction &R, const Vector &l_vec,
+                  unsigned eval_flags, Vector &q_val, Vector &q_der,
+                  Vector &q_det) const;
+
    /// Interpolate the values of the E-vector @a e_vec at quadrature points.
    void Values(const Vector &e_vec, Vector &q_val) const;
 
@@ -109,7 +133,15 @@ public:
        @a e_vec at quadrature points. */
    void PhysDerivatives(const Vector &e_vec, Vector &q_der) const;
 
-   /// Perform the transpose operation of Mult(). (TODO)
+   /// Perform the transpose operation of Mult().
+   /** The E-vector @a e_vec is set to the sum of the transposed interpolation
+       of the values @a q_val, when the VALUES flag is set, and of the
+       derivatives @a q_der, when the flag DERIVATIVES (reference derivatives)
+       or PHYSICAL_DERIVATIVES (derivatives in physical space) is set. The
+       Q-vectors use the current output layout, and @a e_vec has the same dof
+       ordering as the input of Mult() with this layout: lexicographic when the
+       tensor product evaluations are used, see DisableTensorProducts(), native
+       otherwise. */
    void MultTranspose(unsigned eval_flags, const Vector &q_val,
                       const Vector &q_der, Vector &e_vec) const;
 
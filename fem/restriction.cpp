@@ -28,7 +28,9 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
      nedofs(ne*dof),
      offsets(ndofs+1),
      indices(ne*dof),
-     gatherMap(ne*dof)
+     gatherMap(ne*dof),
+     colored_groups(false),
+     force_colored(false)
 {
    // Assuming all finite elements are the same.
    height = vdim*ne*dof;
@@ -195,6 +197,61 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultComplex(const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd, 2);
+   auto d_y = Reshape(y.Write(), 2, nd, vd, ne);
+   auto d_gatherMap = gatherMap.Read();
+   MFEM_FORALL(i, dof*ne,
+   {
+      const int gid = d_gatherMap[i];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double re = d_x(t?c:j, t?j:c, 0);
+         const double im = d_x(t?c:j, t?j:c, 1);
+         d_y(0, i % nd, c, i / nd) = plus ? re : -re;
+         d_y(1, i % nd, c, i / nd) = plus ? im : -im;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeComplex(const Vector& x, Vector& y) const
+{
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), 2, nd, vd, ne);
+   auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd, 2);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double re = 0.0, im = 0.0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const bool plus = d_indices[j] >= 0;
+            const int idx_j = plus ? d_indices[j] : -1 - d_indices[j];
+            const double s = plus ? 1.0 : -1.0;
+            re += s * d_x(0, idx_j % nd, c, idx_j / nd);
+            im += s * d_x(1, idx_j % nd, c, idx_j / nd);
+         }
+         d_y(t?c:i, t?i:c, 0) = re;
+         d_y(t?c:i, t?i:c, 1) = im;
+      }
+   });
+}
+
 void ElementRestriction::BooleanMask(Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -273,43 +330,34 @@ static MFEM_HOST_DEVICE int GetMinElt(const int *my_elts, const int nbElts,
    return min;
 }
 
-/** Returns the index where a non-zero entry should be added and increment the
-    number of non-zeros for the row i_L. */
-static MFEM_HOST_DEVICE int GetAndIncrementNnzIndex(const int i_L, int* I)
-{
-   int ind = AtomicAdd(I[i_L],1);
-   return ind;
-}
-
 int ElementRestriction::FillI(SparseMatrix &mat) const
 {
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
    const int vd = vdim;
+   const bool t = byvdim;
    const int elt_dofs = dof;
-   auto I = mat.ReadWriteI();
+   auto I = mat.WriteI();
    auto d_offsets = offsets.Read();
    auto d_indices = indices.Read();
    auto d_gatherMap = gatherMap.Read();
-   MFEM_FORALL(i_L, vd*all_dofs+1,
+   // Each row is processed by a single thread, going through the elements
+   // containing its dof with the transposed map given by offsets and indices.
+   MFEM_FORALL(i_L, all_dofs,
    {
-      I[i_L] = 0;
-   });
-   MFEM_FORALL(e, ne,
-   {
-      for (int i = 0; i < elt_dofs; i++)
+      int i_elts[Max];
+      const int i_offset = d_offsets[i_L];
+      const int i_nextOffset = d_offsets[i_L+1];
+      const int i_nbElts = i_nextOffset - i_offset;
+      for (int e_i = 0; e_i < i_nbElts; ++e_i)
       {
-         int i_elts[Max];
-         const int i_E = e*elt_dofs + i;
-         const int i_L = d_gatherMap[i_E];
-         const int i_offset = d_offsets[i_L];
-         const int i_nextOffset = d_offsets[i_L+1];
-         const int i_nbElts = i_nextOffset - i_offset;
-         for (int e_i = 0; e_i < i_nbElts; ++e_i)
-         {
-            const int i_E = d_indices[i_offset+e_i];
-            i_elts[e_i] = i_E/elt_dofs;
-         }
+         const int i_E = d_indices[i_offset+e_i];
+         i_elts[e_i] = i_E/elt_dofs;
+      }
+      int nnz = 0;
+      for (int e_i = 0; e_i < i_nbElts; ++e_i)
+      {
+         const int e = i_elts[e_i];
          for (int j = 0; j < elt_dofs; j++)
          {
             const int j_E = e*elt_dofs + j;
@@ -319,7 +367,7 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
             const int j_nbElts = j_nextOffset - j_offset;
             if (i_nbElts == 1 || j_nbElts == 1) // no assembly required
             {
-               GetAndIncrementNnzIndex(i_L, I);
+               nnz++;
             }
             else // assembly required
             {
@@ -333,25 +381,19 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
                int min_e = GetMinElt<Max>(i_elts, i_nbElts, j_elts, j_nbElts);
                if (e == min_e) // add the nnz only once
                {
-                  GetAndIncrementNnzIndex(i_L, I);
+                  nnz++;
                }
             }
          }
       }
+      for (int ci = 0; ci < vd; ci++)
+      {
+         const int i_V = t ? vd*i_L+ci : i_L+ci*all_dofs;
+         I[i_V] = vd*nnz;
+      }
    });
-   // We need to sum the entries of I, we do it on CPU as it is very sequential.
-   auto h_I = mat.HostReadWriteI();
-   const int nTdofs = vd*all_dofs;
-   int sum = 0;
-   for (int i = 0; i < nTdofs; i++)
-   {
-      const int nnz = h_I[i];
-      h_I[i] = sum;
-      sum+=nnz;
-   }
-   h_I[nTdofs] = sum;
    // We return the number of nnz
-   return h_I[nTdofs];
+   return ExclusiveScan(vd*all_dofs, I);
 }
 
 void ElementRestriction::FillJAndData(const Vector &ea_data,
@@ -360,31 +402,35 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
    const int vd = vdim;
+   const bool t = byvdim;
    const int elt_dofs = dof;
-   auto I = mat.ReadWriteI();
+   auto I = mat.ReadI();
    auto J = mat.WriteJ();
    auto Data = mat.WriteData();
    auto d_offsets = offsets.Read();
    auto d_indices = indices.Read();
    auto d_gatherMap = gatherMap.Read();
-   auto mat_ea = Reshape(ea_data.Read(), elt_dofs, elt_dofs, ne);
-   MFEM_FORALL(e, ne,
+   auto mat_ea = Reshape(ea_data.Read(), elt_dofs, vd, elt_dofs, vd, ne);
+   // The entries of each row are written by a single thread in the order used
+   // by FillI(), so the result does not depend on the backend.
+   MFEM_FORALL(i_L, all_dofs,
    {
-      for (int i = 0; i < elt_dofs; i++)
+      int i_elts[Max];
+      int i_B[Max];
+      const int i_offset = d_offsets[i_L];
+      const int i_nextOffset = d_offsets[i_L+1];
+      const int i_nbElts = i_nextOffset - i_offset;
+      for (int e_i = 0; e_i < i_nbElts; ++e_i)
       {
-         int i_elts[Max];
-         int i_B[Max];
-         const int i_E = e*elt_dofs + i;
-         const int i_L = d_gatherMap[i_E];
-         const int i_offset = d_offsets[i_L];
-         const int i_nextOffset = d_offsets[i_L+1];
-         const int i_nbElts = i_nextOffset - i_offset;
-         for (int e_i = 0; e_i < i_nbElts; ++e_i)
-         {
-            const int i_E = d_indices[i_offset+e_i];
-            i_elts[e_i] = i_E/elt_dofs;
-            i_B[e_i]    = i_E%elt_dofs;
-         }
+         const int i_E = d_indices[i_offset+e_i];
+         i_elts[e_i] = i_E/elt_dofs;
+         i_B[e_i]    = i_E%elt_dofs;
+      }
+      int nnz = 0;
+      for (int e_i = 0; e_i < i_nbElts; ++e_i)
+      {
+         const int e = i_elts[e_i];
+         const int i = i_B[e_i];
          for (int j = 0; j < elt_dofs; j++)
          {
             const int j_E = e*elt_dofs + j;
@@ -394,9 +440,17 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
             const int j_nbElts = j_nextOffset - j_offset;
             if (i_nbElts == 1 || j_nbElts == 1) // no assembly required
             {
-               const int nnz = GetAndIncrementNnzIndex(i_L, I);
-               J[nnz] = j_L;
-               Data[nnz] = mat_ea(j,i,e);
+               for (int ci = 0; ci < vd; ci++)
+               {
+                  const int i_V = t ? vd*i_L+ci : i_L+ci*all_dofs;
+                  for (int cj = 0; cj < vd; cj++)
+                  {
+                     const int k = I[i_V] + vd*nnz + cj;
+                     J[k] = t ? vd*j_L+cj : j_L+cj*all_dofs;
+                     Data[k] = mat_ea(j,cj,i,ci,e);
+                  }
+               }
+               nnz++;
             }
             else // assembly required
             {
@@ -412,38 +466,122 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
                int min_e = GetMinElt<Max>(i_elts, i_nbElts, j_elts, j_nbElts);
                if (e == min_e) // add the nnz only once
                {
-                  double val = 0.0;
-                  for (int i = 0; i < i_nbElts; i++)
+                  for (int ci = 0; ci < vd; ci++)
                   {
-                     const int e_i = i_elts[i];
-                     const int i_Bloc = i_B[i];
-                     for (int j = 0; j < j_nbElts; j++)
+                     const int i_V = t ? vd*i_L+ci : i_L+ci*all_dofs;
+                     for (int cj = 0; cj < vd; cj++)
                      {
-                        const int e_j = j_elts[j];
-                        const int j_Bloc = j_B[j];
-                        if (e_i == e_j)
+                        double val = 0.0;
+                        for (int i = 0; i < i_nbElts; i++)
                         {
-                           val += mat_ea(j_Bloc, i_Bloc, e_i);
+                           const int e_i = i_elts[i];
+                           const int i_Bloc = i_B[i];
+                           for (int j = 0; j < j_nbElts; j++)
+                           {
+                              const int e_j = j_elts[j];
+                              const int j_Bloc = j_B[j];
+                              if (e_i == e_j)
+                              {
+                                 val += mat_ea(j_Bloc, cj, i_Bloc, ci, e_i);
+                              }
+                           }
                         }
+                        const int k = I[i_V] + vd*nnz + cj;
+                        J[k] = t ? vd*j_L+cj : j_L+cj*all_dofs;
+                        Data[k] = val;
                      }
                   }
-                  const int nnz = GetAndIncrementNnzIndex(i_L, I);
-                  J[nnz] = j_L;
-                  Data[nnz] = val;
+                  nnz++;
                }
             }
          }
       }
    });
-   // We need to shift again the entries of I, we do it on CPU as it is very
-   // sequential.
-   auto h_I = mat.HostReadWriteI();
-   const int size = vd*all_dofs;
-   for (int i = 0; i < size; i++)
+}
+
+void ElementRestriction::BuildElementGroups(bool colored) const
+{
+   colored_groups = colored;
+   group_elements.SetSize(ne);
+   if (!colored)
    {
-      h_I[size-i] = h_I[size-(i+1)];
+      group_offsets.SetSize(2);
+      group_offsets[0] = 0;
+      group_offsets[1] = ne;
+      for (int e = 0; e < ne; e++) { group_elements[e] = e; }
+      return;
    }
-   h_I[0] = 0;
+   // Greedy coloring of the elements such that the elements of each color
+   // share no dofs. The elements sharing a dof are given by the local dofs
+   // stored in 'indices'.
+   const int *h_offsets = offsets.HostRead();
+   const int *h_indices = indices.HostRead();
+   const int *h_gatherMap = gatherMap.HostRead();
+   Array<int> color(ne), used;
+   color = -1;
+   int num_colors = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      for (int d = 0; d < dof; d++)
+      {
+         const int sgid = h_gatherMap[d + dof*e];
+         const int gid = (sgid >= 0) ? sgid : -1-sgid;
+         for (int k = h_offsets[gid]; k < h_offsets[gid+1]; k++)
+         {
+            const int lid = h_indices[k];
+            const int nc = color[((lid >= 0) ? lid : -1-lid)/dof];
+            if (nc >= 0) { used[nc] = e; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && used[c] == e) { c++; }
+      if (c == num_colors) { used.Append(-1); num_colors++; }
+      color[e] = c;
+   }
+   group_offsets.SetSize(num_colors + 1);
+   group_offsets = 0;
+   for (int e = 0; e < ne; e++) { group_offsets[color[e]+1]++; }
+   group_offsets.PartialSum();
+   for (int c = 0; c < num_colors; c++) { used[c] = group_offsets[c]; }
+   for (int e = 0; e < ne; e++) { group_elements[used[color[e]]++] = e; }
+}
+
+int ElementRestriction::GetNumElementGroups() const
+{
+   // The elements are processed concurrently with these backends
+   const bool colored =
+      force_colored || Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK);
+   if (group_offsets.Size() == 0 || colored != colored_groups)
+   {
+      BuildElementGroups(colored);
+   }
+   return group_offsets.Size() - 1;
+}
+
+ElementGather ElementRestriction::GetElementGather(int g) const
+{
+   MFEM_ASSERT(0 <= g && g < GetNumElementGroups(), "invalid group " << g);
+   ElementGather gather;
+   gather.ne = group_offsets[g+1] - group_offsets[g];
+   gather.elems = group_elements.Read() + group_offsets[g];
+   gather.map = gatherMap.Read();
+   gather.dof = dof;
+   gather.ndofs = ndofs;
+   gather.vdim = vdim;
+   gather.byvdim = byvdim;
+   return gather;
+}
+
+ElementGather ElementRestriction::GetElementGather() const
+{
+   ElementGather gather;
+   gather.ne = ne;
+   gather.map = gatherMap.Read();
+   gather.dof = dof;
+   gather.ndofs = ndofs;
+   gather.vdim = vdim;
+   gather.byvdim = byvdim;
+   return gather;
 }
 
 L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
@@ -1300,15 +1438,12 @@ void L2FaceRestriction::FillI(SparseMatrix &mat,
                               SparseMatrix &face_mat) const
 {
    const int face_dofs = dof;
-   auto d_indices1 = scatter_indices1.Read();
-   auto d_indices2 = scatter_indices2.Read();
+   auto d_offsets = offsets.Read();
    auto I = mat.ReadWriteI();
-   MFEM_FORALL(fdof, nf*face_dofs,
+   // Each face dof couples with the face dofs of the other side of the face
+   MFEM_FORALL(i, ndofs,
    {
-      const int iE1 = d_indices1[fdof];
-      const int iE2 = d_indices2[fdof];
-      AddNnz(iE1,I,face_dofs);
-      AddNnz(iE2,I,face_dofs);
+      I[i] += face_dofs*(d_offsets[i+1] - d_offsets[i]);
    });
 }
 
@@ -1317,29 +1452,37 @@ void L2FaceRestriction::FillJAndData(const Vector &ea_data,
                                      SparseMatrix &face_mat) const
 {
    const int face_dofs = dof;
+   const int nface_dofs = nfdofs;
    auto d_indices1 = scatter_indices1.Read();
    auto d_indices2 = scatter_indices2.Read();
+   auto d_offsets = offsets.Read();
+   auto d_gather = gather_indices.Read();
    auto I = mat.ReadWriteI();
    auto mat_fea = Reshape(ea_data.Read(), face_dofs, face_dofs, 2, nf);
    auto J = mat.WriteJ();
    auto Data = mat.WriteData();
-   MFEM_FORALL(fdof, nf*face_dofs,
-   {
-      const int f  = fdof/face_dofs;
-      const int iF = fdof%face_dofs;
-      const int iE1 = d_indices1[f*face_dofs+iF];
-      const int iE2 = d_indices2[f*face_dofs+iF];
-      const int offset1 = AddNnz(iE1,I,face_dofs);
-      const int offset2 = AddNnz(iE2,I,face_dofs);
-      for (int jF = 0; jF < face_dofs; jF++)
+   // Each row is filled by a single thread, going through the faces of its
+   // dof in the order given by the transposed map gather_indices, so the
+   // result does not depend on the backend.
+   MFEM_FORALL(i, ndofs,
+   {
+      int offset = I[i];
+      for (int k = d_offsets[i]; k < d_offsets[i+1]; k++)
       {
-         const int jE1 = d_indices1[f*face_dofs+jF];
-         const int jE2 = d_indices2[f*face_dofs+jF];
-         J[offset2+jF] = jE1;
-         J[offset1+jF] = jE2;
-         Data[offset2+jF] = mat_fea(jF,iF,0,f);
-         Data[offset1+jF] = mat_fea(jF,iF,1,f);
+         const int lid = d_gather[k];
+         const bool e2 = lid >= nface_dofs;
+         const int fdof = e2 ? lid - nface_dofs : lid;
+         const int f  = fdof/face_dofs;
+         const int iF = fdof%face_dofs;
+         for (int jF = 0; jF < face_dofs; jF++)
+         {
+            J[offset+jF] = e2 ? d_indices1[f*face_dofs+jF] :
+                           d_indices2[f*face_dofs+jF];
+            Data[offset+jF] = mat_fea(jF,iF,e2?0:1,f);
+         }
+         offset += face_dofs;
       }
+      I[i] = offset;
    });
 }
 
@@ -1403,6 +1546,180 @@ void L2FaceRestriction::AddFaceMatricesToElementMatrices(Vector &fea_data,
    }
 }
 
+L2NormalDerivativeFaceRestriction::L2NormalDerivativeFaceRestriction(
+   const FiniteElementSpace &fes, const FaceType type, const L2FaceValues m)
+   : fes(fes),
+     nf(fes.GetNFbyType(type)),
+     ne(fes.GetNE()),
+     dim(fes.GetMesh()->Dimension()),
+     dof1d(fes.GetFE(0)->GetOrder()+1),
+     dof(dim == 2 ? dof1d : dof1d*dof1d),
+     elemDofs(fes.GetFE(0)->GetDof()),
+     m(m)
+{
+   const TensorBasisElement *tfe =
+      dynamic_cast<const TensorBasisElement*>(fes.GetFE(0));
+   MFEM_VERIFY(tfe != NULL &&
+               (tfe->GetBasisType()==BasisType::GaussLobatto ||
+                tfe->GetBasisType()==BasisType::Positive),
+               "Only Gauss-Lobatto and Bernstein basis are supported in "
+               "L2NormalDerivativeFaceRestriction.");
+   MFEM_VERIFY(dim == 2 || dim == 3, "Unsupported dimension.");
+   MFEM_VERIFY(fes.GetVDim() == 1, "Only scalar spaces are supported.");
+   MFEM_VERIFY(fes.GetMesh()->Conforming(),
+               "Non-conforming meshes not yet supported with partial "
+               "assembly.");
+   const int ns = (m==L2FaceValues::DoubleValued) ? 2 : 1;
+   height = ns*nf*dof;
+   width = fes.GetVSize();
+
+   const int nfe = 2*dim; // number of faces of an element
+   const Table &e2dTable = fes.GetElementToDofTable();
+   elem_map.SetSize(ne*elemDofs);
+   for (int i = 0; i < ne*elemDofs; i++)
+   {
+      elem_map[i] = e2dTable.GetJ()[i];
+   }
+
+   // Derivatives of the 1D basis functions at both ends of the segment
+   bd.SetSize(2*dof1d);
+   Vector u(dof1d), d(dof1d);
+   for (int k = 0; k < 2; k++)
+   {
+      tfe->GetBasis1D().Eval(k, u, d);
+      for (int i = 0; i < dof1d; i++) { bd[i + dof1d*k] = d(i); }
+   }
+
+   // Stride of the normal coordinate and side of the reference element of
+   // each local face, with the local face dofs, see GetFaceDofs()
+   const int axis2D[] = {1, 0, 1, 0}, end2D[] = {0, 1, 1, 0};
+   const int axis3D[] = {2, 1, 0, 1, 0, 2}, end3D[] = {0, 0, 1, 1, 0, 1};
+   Array<int> face_stride(nfe), face_end(nfe), face_map(dof*nfe);
+   face_proj.SetSize(elemDofs*nfe);
+   face_line.SetSize(elemDofs*nfe);
+   Array<int> faceMap(dof);
+   for (int lf = 0; lf < nfe; lf++)
+   {
+      const int axis = (dim == 2) ? axis2D[lf] : axis3D[lf];
+      const int end = (dim == 2) ? end2D[lf] : end3D[lf];
+      const int stride = (axis == 0) ? 1 : (axis == 1) ? dof1d : dof1d*dof1d;
+      face_stride[lf] = stride;
+      face_end[lf] = end;
+      GetFaceDofs(dim, lf, dof1d, faceMap);
+      for (int p = 0; p < dof; p++)
+      {
+         face_map[p + dof*lf] = faceMap[p];
+         // All the dofs on the normal line through faceMap[p]
+         for (int l = 0; l < dof1d; l++)
+         {
+            const int j = faceMap[p] + (l - end*(dof1d-1))*stride;
+            face_proj[j + elemDofs*lf] = p;
+            face_line[j + elemDofs*lf] = l + dof1d*end;
+         }
+      }
+   }
+
+   // E-vector indices of the dofs of the local faces, and the normal lines of
+   // the E-vector entries
+   elem_faces.SetSize(dof*nfe*ne);
+   elem_faces = -1;
+   face_gather.SetSize(3*height);
+   face_gather = -1;
+   auto set_entry = [&](const int idx, const int e, const int lf, const int p)
+   {
+      const int lpd = p + dof*lf;
+      elem_faces[lpd + dof*nfe*e] = idx;
+      face_gather[3*idx] = elemDofs*e + face_map[lpd] -
+                           face_end[lf]*(dof1d-1)*face_stride[lf];
+      face_gather[3*idx+1] = face_stride[lf];
+      face_gather[3*idx+2] = face_end[lf];
+   };
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2, inf1, inf2;
+      fes.GetMesh()->GetFaceElements(f, &e1, &e2);
+      fes.GetMesh()->GetFaceInfos(f, &inf1, &inf2);
+      if ((type==FaceType::Interior && (e2>=0 || (e2<0 && inf2>=0))) ||
+          (type==FaceType::Boundary && e2<0 && inf2<0) )
+      {
+         const int face_id1 = inf1 / 64;
+         for (int d = 0; d < dof; ++d)
+         {
+            set_entry(d + dof*ns*f_ind, e1, face_id1, d);
+         }
+         if (m==L2FaceValues::DoubleValued && e2>=0)
+         {
+            const int face_id2 = inf2 / 64;
+            const int orientation = inf2 % 64;
+            for (int d = 0; d < dof; ++d)
+            {
+               const int pd = PermuteFaceL2(dim, face_id1, face_id2,
+                                            orientation, dof1d, d);
+               set_entry(d + dof*(1 + 2*f_ind), e2, face_id2, pd);
+            }
+         }
+         f_ind++;
+      }
+   }
+   MFEM_VERIFY(f_ind==nf, "Unexpected number of faces.");
+}
+
+void L2NormalDerivativeFaceRestriction::Mult(const Vector &x, Vector &y) const
+{
+   const int d1d = dof1d;
+   auto d_elem_map = elem_map.Read();
+   auto d_gather = Reshape(face_gather.Read(), 3, height);
+   auto d_bd = Reshape(bd.Read(), d1d, 2);
+   auto d_x = x.Read();
+   auto d_y = y.Write();
+   MFEM_FORALL(i, height,
+   {
+      const int j0 = d_gather(0,i);
+      const int stride = d_gather(1,i);
+      const int end = d_gather(2,i);
+      double dudn = 0.0;
+      // The side 2 of the boundary faces has no element
+      if (j0 >= 0)
+      {
+         for (int l = 0; l < d1d; ++l)
+         {
+            dudn += d_bd(l,end) * d_x[d_elem_map[j0 + l*stride]];
+         }
+      }
+      d_y[i] = dudn;
+   });
+}
+
+void L2NormalDerivativeFaceRestriction::MultTranspose(const Vector &x,
+                                                      Vector &y) const
+{
+   const int nd = dof, nfe = 2*dim, ed = elemDofs;
+   auto d_elem_map = elem_map.Read();
+   auto d_face_proj = Reshape(face_proj.Read(), ed, nfe);
+   auto d_face_line = Reshape(face_line.Read(), ed, nfe);
+   auto d_elem_faces = Reshape(elem_faces.Read(), nd, nfe, ne);
+   auto d_bd = bd.Read();
+   auto d_x = x.Read();
+   auto d_y = y.ReadWrite();
+   // Each L2 dof belongs to a single element, so there are no write conflicts
+   MFEM_FORALL(i, ed*ne,
+   {
+      const int j = i % ed;
+      const int e = i / ed;
+      double val = 0.0;
+      for (int lf = 0; lf < nfe; ++lf)
+      {
+         const int idx = d_elem_faces(d_face_proj(j,lf),lf,e);
+         if (idx >= 0)
+         {
+            val += d_bd[d_face_line(j,lf)] * d_x[idx];
+         }
+      }
+      d_y[d_elem_map[i]] += val;
+   });
+}
+
 int ToLexOrdering(const int dim, const int face_id, const int size1d,
                   const int index)
 {
@@ -1420,4 +1737,49 @@ int ToLexOrdering(const int dim, const int face_id, const int size1d,
    }
 }
 
+int ExclusiveScan(const int n, int *I)
+{
+   if (n == 0)
+   {
+      MFEM_FORALL(i, 1, { I[0] = 0; });
+      return 0;
+   }
+   // The entries are summed sequentially within blocks, and the blocks are
+   // processed in parallel.
+   const int bsize = 256;
+   const int nb = (n + bsize - 1)/bsize;
+   Array<int> block_sums(nb);
+   auto d_sums = block_sums.Write();
+   MFEM_FORALL(b, nb,
+   {
+      const int end = (b+1)*bsize < n ? (b+1)*bsize : n;
+      int sum = 0;
+      for (int i = b*bsize; i < end; i++) { sum += I[i]; }
+      d_sums[b] = sum;
+   });
+   // The scan of the block sums is done on the host, there are few blocks.
+   auto h_sums = block_sums.HostReadWrite();
+   int total = 0;
+   for (int b = 0; b < nb; b++)
+   {
+      const int sum = h_sums[b];
+      h_sums[b] = total;
+      total += sum;
+   }
+   auto d_block_offsets = block_sums.Read();
+   MFEM_FORALL(b, nb,
+   {
+      const int end = (b+1)*bsize < n ? (b+1)*bsize : n;
+      int sum = d_block_offsets[b];
+      for (int i = b*bsize; i < end; i++)
+      {
+         const int nnz = I[i];
+         I[i] = sum;
+         sum += nnz;
+      }
+      if (end == n) { I[n] = sum; }
+   });
+   return total;
+}
+
 } // namespace mfem
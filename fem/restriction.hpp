@@ -13,6 +13,7 @@
 #define MFEM_RESTRICTION
 
 #include "../linalg/operator.hpp"
+#include "../linalg/dtensor.hpp"
 #include "../mesh/mesh.hpp"
 
 namespace mfem
@@ -25,6 +26,60 @@ enum class ElementDofOrdering;
     e1 and e2 (DoubleValued). */
 enum class L2FaceValues : bool {SingleValued, DoubleValued};
 
+/** @brief Data used by the partial assembly kernels to access the element
+    dofs directly in L-vectors, see ElementRestriction::GetElementGather(). */
+/** The elements of an element group share no dofs, so their contributions
+    can be added to an L-vector concurrently, without atomic operations. With a
+    default constructed ElementGather, the kernels use E-vectors instead. */
+class ElementGather
+{
+public:
+   int ne;            ///< Number of elements
+   const int *elems;  ///< Element indices (device pointer), or all if NULL
+   const int *map;    ///< Signed gather map (device pointer)
+   int dof;           ///< Number of dofs per element
+   int ndofs;         ///< Number of scalar dofs of the L-vector
+   int vdim;          ///< Vector dimension of the L-vector
+   bool byvdim;       ///< Ordering::byVDIM ordering of the L-vector
+
+   ElementGather()
+      : ne(0), elems(nullptr), map(nullptr), dof(0), ndofs(0), vdim(1),
+        byvdim(false) { }
+
+   /// Return true if the kernels use L-vectors.
+   MFEM_HOST_DEVICE inline bool Fused() const { return map != nullptr; }
+
+   /** @brief Return the number of elements processed by the kernels, @a NE
+       when they use E-vectors. */
+   inline int Size(const int NE) const { return map ? ne : NE; }
+
+   /// Return the element processed by the @a i-th kernel iteration.
+   MFEM_HOST_DEVICE inline int Element(const int i) const
+   { return elems ? elems[i] : i; }
+
+   /** @brief Return the value of the L-vector @a x for the component @a c of
+       the local dof @a i of element @a e. */
+   template <typename T> MFEM_HOST_DEVICE inline
+   double Gather(const T &x, const int e, const int i, const int c = 0) const
+   {
+      const int gid = map[i + dof*e];
+      const int j = (gid >= 0) ? gid : -1-gid;
+      const double v = x[byvdim ? c + vdim*j : j + ndofs*c];
+      return (gid >= 0) ? v : -v;
+   }
+
+   /** @brief Add @a v to the L-vector @a y for the component @a c of the local
+       dof @a i of element @a e. */
+   template <typename T> MFEM_HOST_DEVICE inline
+   void Scatter(const T &y, const int e, const int i, const double v,
+                const int c = 0) const
+   {
+      const int gid = map[i + dof*e];
+      const int j = (gid >= 0) ? gid : -1-gid;
+      y[byvdim ? c + vdim*j : j + ndofs*c] += (gid >= 0) ? v : -v;
+   }
+};
+
 /// Operator that converts FiniteElementSpace L-vectors to E-vectors.
 /** Objects of this type are typically created and owned by FiniteElementSpace
     objects, see FiniteElementSpace::GetElementRestriction(). */
@@ -46,6 +101,13 @@ protected:
    Array<int> offsets;
    Array<int> indices;
    Array<int> gatherMap;
+   // Groups of elements sharing no dofs, see GetElementGather()
+   mutable Array<int> group_offsets;
+   mutable Array<int> group_elements;
+   mutable bool colored_groups;
+   bool force_colored;
+
+   void BuildElementGroups(bool colored) const;
 
 public:
    ElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
@@ -57,6 +119,16 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /** @brief Compute Mult for a complex L-vector @a x, storing its real part
+       followed by its imaginary part, e.g. a ComplexGridFunction. */
+   /** The real and imaginary parts of the complex E-vector @a y, of size
+       2*Height(), are interleaved: y(2*i) and y(2*i+1) are the real and
+       imaginary parts of the i-th E-vector entry. */
+   void MultComplex(const Vector &x, Vector &y) const;
+   /// Compute MultTranspose for an interleaved complex E-vector, see
+   /// MultComplex().
+   void MultTransposeComplex(const Vector &x, Vector &y) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -66,6 +138,8 @@ public:
    void BooleanMask(Vector& y) const;
 
    /// Fill a Sparse Matrix with Element Matrices.
+   /** For vector spaces, the element matrices couple all the vector
+       components, i.e. they are of size (dof*vdim) x (dof*vdim). */
    void FillSparseMatrix(const Vector &mat_ea, SparseMatrix &mat) const;
 
    /** Fill the I array of SparseMatrix corresponding to the sparsity pattern
@@ -74,6 +148,30 @@ public:
    /** Fill the J and Data arrays of SparseMatrix corresponding to the sparsity
        pattern given by this ElementRestriction, and the values of ea_data. */
    void FillJAndData(const Vector &ea_data, SparseMatrix &mat) const;
+
+   /** @brief Return the number of element groups used by the fused
+       restriction, see GetElementGather(). */
+   /** When the elements are processed concurrently (device and OpenMP
+       backends), the groups are given by a greedy coloring of the elements
+       such that the elements of each group share no dofs. Otherwise, all the
+       elements belong to a single group, unless the coloring is forced with
+       ForceColoredElementGroups(). */
+   int GetNumElementGroups() const;
+
+   /** @brief Use the colored element groups with all the backends if @a force
+       is true, e.g. to test the coloring on the host (default: false). */
+   void ForceColoredElementGroups(bool force = true) { force_colored = force; }
+
+   /** @brief Return the ElementGather of the element group @a g, used by the
+       partial assembly kernels to gather the element dofs from L-vectors and
+       to scatter their contributions back, without E-vectors. */
+   /** The groups must be processed one after the other. */
+   ElementGather GetElementGather(int g) const;
+
+   /** @brief Return an ElementGather of all the elements, in order, used by
+       the kernels that only gather the element dofs from L-vectors, e.g.
+       QuadratureInterpolator::MultFused(). */
+   ElementGather GetElementGather() const;
 };
 
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
@@ -168,6 +266,41 @@ public:
                                          Vector &ea_data) const;
 };
 
+/// Operator computing the normal derivatives at the face degrees of freedom.
+/** For each face of the given type and each side of the face, Mult() computes
+    the derivative of the element function in the direction of the reference
+    coordinate normal to the face, at the face degrees of freedom. The result
+    uses the ordering and the layout of the L2FaceRestriction E-vectors.
+    MultTranspose() adds the transposed action to the L-vector. Only scalar L2
+    spaces on conforming quadrilateral and hexahedral meshes are supported. */
+class L2NormalDerivativeFaceRestriction : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   const int nf;
+   const int ne;
+   const int dim;
+   const int dof1d;
+   const int dof;
+   const int elemDofs;
+   const L2FaceValues m;
+   Array<int> elem_map;    ///< Element to dof map of the space
+   Array<int> face_gather; ///< First element dof, stride and end of the normal
+                           ///< line of each E-vector entry
+   Array<int> face_proj;   ///< Face dof index of the projection of element dofs
+   Array<int> face_line;   ///< Index in #bd of the element dofs, for each face
+   Array<int> elem_faces;  ///< E-vector index of the local face dofs, or -1
+   Array<double> bd;       ///< Derivatives of the 1D basis at 0 and 1
+
+public:
+   L2NormalDerivativeFaceRestriction(const FiniteElementSpace&,
+                                     const FaceType,
+                                     const L2FaceValues m =
+                                        L2FaceValues::DoubleValued);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+};
+
 // Return the face degrees of freedom returned in Lexicographic order.
 void GetFaceDofs(const int dim, const int face_id,
                  const int dof1d, Array<int> &faceMap);
@@ -181,6 +314,14 @@ int PermuteFaceL2(const int dim, const int face_id1,
                   const int face_id2, const int orientation,
                   const int size1d, const int index);
 
+/** @brief Replace the first @a n entries of the device array @a I by their
+    exclusive prefix sums, set I[n] to their total and return it.
+
+    This is used to convert the row sizes of a SparseMatrix into its row
+    offsets. The sums are computed by blocks in parallel, on the host or on the
+    device, with the same result on all backends. */
+int ExclusiveScan(const int n, int *I);
+
 }
 
 #endif //MFEM_RESTRICTION
@@ -1071,6 +1071,145 @@ void dsyev_Eigensystem(DenseMatrix &a, Vector &ev, DenseMatrix *evect)
 #endif
 }
 
+// Cyclic Jacobi method for the symmetric eigenvalue problem, used when MFEM is
+// compiled without LAPACK. Only the upper triangular part of 'a' is used. The
+// eigenvalues are returned in ascending order, as in dsyev_Eigensystem().
+static void JacobiEigensystem(const DenseMatrix &a, Vector &ev,
+                              DenseMatrix *evect)
+{
+   const int n = a.Width();
+   DenseMatrix A(n), V(n);
+   for (int j = 0; j < n; j++)
+   {
+      for (int i = 0; i <= j; i++)
+      {
+         A(i,j) = A(j,i) = a(i,j);
+      }
+   }
+   V = 0.0;
+   for (int i = 0; i < n; i++) { V(i,i) = 1.0; }
+
+   const double eps = std::numeric_limits<double>::epsilon();
+   const double norm2 = A.FNorm2();
+   for (int sweep = 0; sweep < 50; sweep++)
+   {
+      double off = 0.0;
+      for (int j = 1; j < n; j++)
+      {
+         for (int i = 0; i < j; i++) { off += A(i,j)*A(i,j); }
+      }
+      if (off <= eps*eps*norm2) { break; }
+
+      for (int p = 0; p < n-1; p++)
+      {
+         for (int q = p+1; q < n; q++)
+         {
+            if (A(p,q) == 0.0) { continue; }
+            const double theta = (A(q,q) - A(p,p))/(2.0*A(p,q));
+            const double t = copysign(1.0, theta)/
+                             (fabs(theta) + sqrt(theta*theta + 1.0));
+            const double c = 1.0/sqrt(t*t + 1.0), s = t*c;
+            for (int k = 0; k < n; k++)
+            {
+               const double akp = A(k,p), akq = A(k,q);
+               A(k,p) = c*akp - s*akq;
+               A(k,q) = s*akp + c*akq;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double apk = A(p,k), aqk = A(q,k);
+               A(p,k) = c*apk - s*aqk;
+               A(q,k) = s*apk + c*aqk;
+               const double vkp = V(k,p), vkq = V(k,q);
+               V(k,p) = c*vkp - s*vkq;
+               V(k,q) = s*vkp + c*vkq;
+            }
+         }
+      }
+   }
+
+   // Sort the eigenvalues (and eigenvectors) in ascending order
+   Array<int> perm(n);
+   for (int i = 0; i < n; i++) { perm[i] = i; }
+   std::sort(perm.begin(), perm.end(),
+             [&A](int i, int j) { return A(i,i) < A(j,j); });
+   ev.SetSize(n);
+   for (int i = 0; i < n; i++) { ev(i) = A(perm[i],perm[i]); }
+   if (evect)
+   {
+      evect->SetSize(n);
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = 0; i < n; i++) { (*evect)(i,j) = V(i,perm[j]); }
+      }
+   }
+}
+
+// Generalized symmetric-definite eigenvalue problem A x = ev B x, used when MFEM
+// is compiled without LAPACK. The problem is reduced to standard form using the
+// Cholesky factorization B = L L^t and the eigenvectors are normalized such
+// that X^t B X = I, as in dsygv_Eigensystem().
+static void JacobiEigensystem(const DenseMatrix &a, const DenseMatrix &b,
+                              Vector &ev, DenseMatrix *evect)
+{
+   const int n = a.Width();
+   DenseMatrix L(n);
+   L = 0.0;
+   for (int j = 0; j < n; j++)
+   {
+      double d = b(j,j);
+      for (int k = 0; k < j; k++) { d -= L(j,k)*L(j,k); }
+      MFEM_VERIFY(d > 0.0, "JacobiEigensystem: B is not positive definite");
+      L(j,j) = sqrt(d);
+      for (int i = j+1; i < n; i++)
+      {
+         double v = b(j,i);
+         for (int k = 0; k < j; k++) { v -= L(i,k)*L(j,k); }
+         L(i,j) = v/L(j,j);
+      }
+   }
+
+   // C = L^{-1} A L^{-t}, using the upper triangular part of A
+   DenseMatrix C(n);
+   for (int j = 0; j < n; j++)
+   {
+      for (int i = 0; i <= j; i++) { C(i,j) = C(j,i) = a(i,j); }
+   }
+   for (int j = 0; j < n; j++) // C <- L^{-1} C
+   {
+      for (int i = 0; i < n; i++)
+      {
+         for (int k = 0; k < i; k++) { C(i,j) -= L(i,k)*C(k,j); }
+         C(i,j) /= L(i,i);
+      }
+   }
+   for (int i = 0; i < n; i++) // C <- C L^{-t}
+   {
+      for (int j = 0; j < n; j++)
+      {
+         for (int k = 0; k < j; k++) { C(i,j) -= C(i,k)*L(j,k); }
+         C(i,j) /= L(j,j);
+      }
+   }
+
+   DenseMatrix Q;
+   JacobiEigensystem(C, ev, evect ? &Q : NULL);
+   if (evect)
+   {
+      // X = L^{-t} Q
+      evect->SetSize(n);
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = n-1; i >= 0; i--)
+         {
+            double v = Q(i,j);
+            for (int k = i+1; k < n; k++) { v -= L(k,i)*(*evect)(k,j); }
+            (*evect)(i,j) = v/L(i,i);
+         }
+      }
+   }
+}
+
 void DenseMatrix::Eigensystem(Vector &ev, DenseMatrix *evect)
 {
 #ifdef MFEM_USE_LAPACK
@@ -1081,9 +1220,7 @@ void DenseMatrix::Eigensystem(Vector &ev, DenseMatrix *evect)
 
 #else
 
-   MFEM_CONTRACT_VAR(ev);
-   MFEM_CONTRACT_VAR(evect);
-   mfem_error("DenseMatrix::Eigensystem: Compiled without LAPACK");
+   JacobiEigensystem(*this, ev, evect);
 
 #endif
 }
@@ -1161,10 +1298,7 @@ void DenseMatrix::Eigensystem(DenseMatrix &b, Vector &ev,
    dsygv_Eigensystem(*this, b, ev, evect);
 
 #else
-   MFEM_CONTRACT_VAR(b);
-   MFEM_CONTRACT_VAR(ev);
-   MFEM_CONTRACT_VAR(evect);
-   mfem_error("DenseMatrix::Eigensystem(generalized): Compiled without LAPACK");
+   JacobiEigensystem(*this, b, ev, evect);
 #endif
 }
 
@@ -3511,88 +3645,155 @@ DenseTensor &DenseTensor::operator=(double c)
    return *this;
 }
 
-void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL)
+// Batched LU factorization kernel; when T_M > 0 the matrix size is a
+// compile-time constant which allows the compiler to fully unroll the loops.
+template<int T_M = 0>
+static void BatchLUFactorKernel(const int m_, const int NE, double *data,
+                                int *ipiv, const double TOL)
 {
-   const int m = Mlu.SizeI();
-   const int NE = Mlu.SizeK();
-   P.SetSize(m*NE);
-
-   auto data_all = mfem::Reshape(Mlu.ReadWrite(), m, m, NE);
-   auto ipiv_all = mfem::Reshape(P.Write(), m, NE);
+   const int m = T_M ? T_M : m_;
+   auto data_all = mfem::Reshape(data, m, m, NE);
+   auto ipiv_all = mfem::Reshape(ipiv, m, NE);
    Array<bool> pivot_flag(1);
    pivot_flag[0] = true;
    bool *d_pivot_flag = pivot_flag.ReadWrite();
 
    MFEM_FORALL(e, NE,
    {
-      for (int i = 0; i < m; i++)
+      const int M = T_M ? T_M : m;
+      if (!kernels::LUFactor(&data_all(0,0,e), M, &ipiv_all(0,e), TOL))
       {
-         // pivoting
-         {
-            int piv = i;
-            double a = fabs(data_all(piv,i,e));
-            for (int j = i+1; j < m; j++)
-            {
-               const double b = fabs(data_all(j,i,e));
-               if (b > a)
-               {
-                  a = b;
-                  piv = j;
-               }
-            }
-            ipiv_all(i,e) = piv;
-            if (piv != i)
-            {
-               // swap rows i and piv in both L and U parts
-               for (int j = 0; j < m; j++)
-               {
-                  mfem::kernels::internal::Swap<double>(data_all(i,j,e), data_all(piv,j,e));
-               }
-            }
-         } // pivot end
+         d_pivot_flag[0] = false;
+      }
+   });
 
-         if (abs(data_all(i,i,e)) <= TOL)
-         {
-            d_pivot_flag[0] = false;
-         }
+   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+}
 
-         const double a_ii_inv = 1.0 / data_all(i,i,e);
-         for (int j = i+1; j < m; j++)
-         {
-            data_all(j,i,e) *= a_ii_inv;
-         }
+// Batched LU solve kernel, see BatchLUFactorKernel.
+template<int T_M = 0>
+static void BatchLUSolveKernel(const int m_, const int NE, const double *data,
+                               const int *ipiv, double *x)
+{
+   const int m = T_M ? T_M : m_;
+   auto data_all = mfem::Reshape(data, m, m, NE);
+   auto piv_all = mfem::Reshape(ipiv, m, NE);
+   auto x_all = mfem::Reshape(x, m, NE);
 
-         for (int k = i+1; k < m; k++)
-         {
-            const double a_ik = data_all(i,k,e);
-            for (int j = i+1; j < m; j++)
-            {
-               data_all(j,k,e) -= a_ik * data_all(j,i,e);
-            }
-         }
+   MFEM_FORALL(e, NE,
+   {
+      const int M = T_M ? T_M : m;
+      kernels::LUSolve(&data_all(0,0,e), M, &piv_all(0,e), &x_all(0,e));
+   });
+}
 
-      } // m loop
+// Batched inverse kernel from LU factors, see BatchLUFactorKernel.
+template<int T_M = 0>
+static void BatchInverseKernel(const int m_, const int NE, const double *data,
+                               const int *ipiv, double *inv)
+{
+   const int m = T_M ? T_M : m_;
+   auto data_all = mfem::Reshape(data, m, m, NE);
+   auto piv_all = mfem::Reshape(ipiv, m, NE);
+   auto inv_all = mfem::Reshape(inv, m, m, NE);
 
+   MFEM_FORALL(e, NE,
+   {
+      const int M = T_M ? T_M : m;
+      for (int k = 0; k < M; k++)
+      {
+         for (int i = 0; i < M; i++) { inv_all(i,k,e) = 0.0; }
+         inv_all(k,k,e) = 1.0;
+         kernels::LUSolve(&data_all(0,0,e), M, &piv_all(0,e), &inv_all(0,k,e));
+      }
    });
+}
 
-   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL)
+{
+   const int m = Mlu.SizeI();
+   const int NE = Mlu.SizeK();
+   P.SetSize(m*NE);
+
+   double *data = Mlu.ReadWrite();
+   int *ipiv = P.Write();
+
+   switch (m)
+   {
+      case 1: return BatchLUFactorKernel<1>(m, NE, data, ipiv, TOL);
+      case 2: return BatchLUFactorKernel<2>(m, NE, data, ipiv, TOL);
+      case 3: return BatchLUFactorKernel<3>(m, NE, data, ipiv, TOL);
+      case 4: return BatchLUFactorKernel<4>(m, NE, data, ipiv, TOL);
+      case 8: return BatchLUFactorKernel<8>(m, NE, data, ipiv, TOL);
+      case 9: return BatchLUFactorKernel<9>(m, NE, data, ipiv, TOL);
+      case 16: return BatchLUFactorKernel<16>(m, NE, data, ipiv, TOL);
+      case 27: return BatchLUFactorKernel<27>(m, NE, data, ipiv, TOL);
+      case 64: return BatchLUFactorKernel<64>(m, NE, data, ipiv, TOL);
+      default: return BatchLUFactorKernel(m, NE, data, ipiv, TOL);
+   }
 }
 
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
 {
+   const int m = Mlu.SizeI();
+   const int NE = Mlu.SizeK();
+   MFEM_VERIFY(P.Size() == m*NE && X.Size() == m*NE, "invalid sizes");
+
+   const double *data = Mlu.Read();
+   const int *ipiv = P.Read();
+   double *x = X.ReadWrite();
+
+   switch (m)
+   {
+      case 1: return BatchLUSolveKernel<1>(m, NE, data, ipiv, x);
+      case 2: return BatchLUSolveKernel<2>(m, NE, data, ipiv, x);
+      case 3: return BatchLUSolveKernel<3>(m, NE, data, ipiv, x);
+      case 4: return BatchLUSolveKernel<4>(m, NE, data, ipiv, x);
+      case 8: return BatchLUSolveKernel<8>(m, NE, data, ipiv, x);
+      case 9: return BatchLUSolveKernel<9>(m, NE, data, ipiv, x);
+      case 16: return BatchLUSolveKernel<16>(m, NE, data, ipiv, x);
+      case 27: return BatchLUSolveKernel<27>(m, NE, data, ipiv, x);
+      case 64: return BatchLUSolveKernel<64>(m, NE, data, ipiv, x);
+      default: return BatchLUSolveKernel(m, NE, data, ipiv, x);
+   }
+}
 
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv)
+{
    const int m = Mlu.SizeI();
    const int NE = Mlu.SizeK();
+   MFEM_VERIFY(P.Size() == m*NE, "invalid pivot array size");
+   if (Minv.SizeI() != m || Minv.SizeJ() != m || Minv.SizeK() != NE)
+   {
+      Minv.SetSize(m, m, NE);
+   }
 
-   auto data_all = mfem::Reshape(Mlu.Read(), m, m, NE);
-   auto piv_all = mfem::Reshape(P.Read(), m, NE);
-   auto x_all = mfem::Reshape(X.ReadWrite(), m, NE);
+   const double *data = Mlu.Read();
+   const int *ipiv = P.Read();
+   double *inv = Minv.Write();
 
-   MFEM_FORALL(e, NE,
+   switch (m)
    {
-      kernels::LUSolve(&data_all(0, 0,e), m, &piv_all(0, e), &x_all(0,e));
-   });
+      case 1: return BatchInverseKernel<1>(m, NE, data, ipiv, inv);
+      case 2: return BatchInverseKernel<2>(m, NE, data, ipiv, inv);
+      case 3: return BatchInverseKernel<3>(m, NE, data, ipiv, inv);
+      case 4: return BatchInverseKernel<4>(m, NE, data, ipiv, inv);
+      case 8: return BatchInverseKernel<8>(m, NE, data, ipiv, inv);
+      case 9: return BatchInverseKernel<9>(m, NE, data, ipiv, inv);
+      case 16: return BatchInverseKernel<16>(m, NE, data, ipiv, inv);
+      case 27: return BatchInverseKernel<27>(m, NE, data, ipiv, inv);
+      case 64: return BatchInverseKernel<64>(m, NE, data, ipiv, inv);
+      default: return BatchInverseKernel(m, NE, data, ipiv, inv);
+   }
+}
 
+void BatchInverseMatrix(DenseTensor &M, const double TOL)
+{
+   Array<int> P;
+   DenseTensor Mlu(M);
+   BatchLUFactor(Mlu, P, TOL);
+   BatchInverseMatrix(Mlu, P, M);
 }
 
 } // namespace mfem
@@ -868,6 +868,10 @@ public:
     with the LU factors. The factorization is such that L.U = Piv.A, where A is
     the original matrix and Piv is a permutation matrix represented by P.
 
+    The batched kernels run through MFEM_FORALL, i.e. in parallel across the
+    matrices of the batch, with compile-time specializations for the common
+    element matrix sizes 1-4, 8, 9, 16, 27 and 64.
+
     @param [in, out] Mlu batch of square matrices - dimension m x m x n.
     @param [out] P array storing pivot information - dimension m x n.
     @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0. */
@@ -884,6 +888,27 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Compute the inverses of a batch of matrices from their LU factors
+
+    Assuming L.U = P.A for n factored matrices (m x m), compute the inverses
+    A^{-1} and store them in @a Minv, which is resized if needed.
+
+    @param [in] Mlu batch of LU factors, as computed by BatchLUFactor() -
+    dimension m x m x n.
+    @param [in] P array storing pivot information - dimension m x n.
+    @param [out] Minv batch of inverse matrices - dimension m x m x n. */
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv);
+
+/** @brief Invert a batch of matrices in place
+
+    Equivalent to calling BatchLUFactor() on a copy of @a M followed by
+    BatchInverseMatrix().
+
+    @param [in, out] M batch of square matrices - dimension m x m x n.
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0. */
+void BatchInverseMatrix(DenseTensor &M, const double TOL = 0.0);
+
 
 // Inline methods
 
@@ -20,6 +20,7 @@
 #include <iomanip>
 #include <cmath>
 #include <cstdlib>
+#include <algorithm>
 
 #ifdef MFEM_USE_SUNDIALS
 #include <nvector/nvector_parallel.h>
@@ -1691,6 +1692,116 @@ HypreParMatrix * RAP(const HypreParMatrix * Rt, const HypreParMatrix *A,
    return new HypreParMatrix(rap);
 }
 
+HypreRAPPlan::HypreRAPPlan(const HypreParMatrix &P_)
+   : Rt(NULL), P(&P_), C(NULL) { }
+
+HypreRAPPlan::HypreRAPPlan(const HypreParMatrix &Rt_, const HypreParMatrix &P_)
+   : Rt(&Rt_), P(&P_), C(NULL) { }
+
+// Do the local CSR matrices a and b have the same sparsity pattern?
+static bool SameSparsity(hypre_CSRMatrix *a, hypre_CSRMatrix *b)
+{
+   const HYPRE_Int nrows = hypre_CSRMatrixNumRows(a);
+   const HYPRE_Int nnz = hypre_CSRMatrixNumNonzeros(a);
+   if (nrows != hypre_CSRMatrixNumRows(b) ||
+       hypre_CSRMatrixNumCols(a) != hypre_CSRMatrixNumCols(b) ||
+       nnz != hypre_CSRMatrixNumNonzeros(b))
+   {
+      return false;
+   }
+   return (std::equal(hypre_CSRMatrixI(a), hypre_CSRMatrixI(a) + nrows + 1,
+                      hypre_CSRMatrixI(b)) &&
+           std::equal(hypre_CSRMatrixJ(a), hypre_CSRMatrixJ(a) + nnz,
+                      hypre_CSRMatrixJ(b)));
+}
+
+HypreParMatrix &HypreRAPPlan::Mult(const HypreParMatrix &A)
+{
+   const HypreParMatrix *R_t = Rt ? Rt : P;
+   HYPRE_Int P_owns_its_col_starts =
+      hypre_ParCSRMatrixOwnsColStarts((hypre_ParCSRMatrix*)(*P));
+   HYPRE_Int Rt_owns_its_col_starts =
+      hypre_ParCSRMatrixOwnsColStarts((hypre_ParCSRMatrix*)(*R_t));
+
+   hypre_ParCSRMatrix * rap;
+#if MFEM_HYPRE_VERSION >= 21100
+   // Keep the transpose of R_t, stored in R_t by hypre, for the next calls
+   hypre_BoomerAMGBuildCoarseOperatorKT(*R_t, A, *P, 1, &rap);
+#else
+   hypre_BoomerAMGBuildCoarseOperator(*R_t, A, *P, &rap);
+#endif
+   hypre_ParCSRMatrixSetNumNonzeros(rap);
+
+   /* Warning: hypre_BoomerAMGBuildCoarseOperator steals the col_starts
+      from Rt and P (even if they do not own them)! */
+   hypre_ParCSRMatrixSetRowStartsOwner(rap,0);
+   hypre_ParCSRMatrixSetColStartsOwner(rap,0);
+
+   if (P_owns_its_col_starts)
+   {
+      hypre_ParCSRMatrixSetColStartsOwner(*P, 1);
+   }
+   if (Rt_owns_its_col_starts)
+   {
+      hypre_ParCSRMatrixSetColStartsOwner(*R_t, 1);
+   }
+
+   // Update the previous result in place if the sparsity is unchanged on all
+   // processors; the decision must be collective since the communication
+   // package of the result is reused.
+   int same = 0;
+   if (C)
+   {
+      hypre_ParCSRMatrix *c = *C;
+      hypre_CSRMatrix *rap_offd = hypre_ParCSRMatrixOffd(rap);
+      const HYPRE_Int num_cols_offd = hypre_CSRMatrixNumCols(rap_offd);
+      int loc_same =
+         SameSparsity(hypre_ParCSRMatrixDiag(rap), hypre_ParCSRMatrixDiag(c)) &&
+         SameSparsity(rap_offd, hypre_ParCSRMatrixOffd(c)) &&
+         std::equal(hypre_ParCSRMatrixColMapOffd(rap),
+                    hypre_ParCSRMatrixColMapOffd(rap) + num_cols_offd,
+                    hypre_ParCSRMatrixColMapOffd(c));
+      MPI_Allreduce(&loc_same, &same, 1, MPI_INT, MPI_MIN, C->GetComm());
+   }
+   if (same)
+   {
+      hypre_ParCSRMatrix *c = *C;
+      hypre_CSRMatrix *diag = hypre_ParCSRMatrixDiag(rap);
+      hypre_CSRMatrix *offd = hypre_ParCSRMatrixOffd(rap);
+      std::copy(hypre_CSRMatrixData(diag),
+                hypre_CSRMatrixData(diag) + hypre_CSRMatrixNumNonzeros(diag),
+                hypre_CSRMatrixData(hypre_ParCSRMatrixDiag(c)));
+      std::copy(hypre_CSRMatrixData(offd),
+                hypre_CSRMatrixData(offd) + hypre_CSRMatrixNumNonzeros(offd),
+                hypre_CSRMatrixData(hypre_ParCSRMatrixOffd(c)));
+      hypre_ParCSRMatrixDestroy(rap);
+   }
+   else
+   {
+      delete C;
+      C = new HypreParMatrix(rap);
+   }
+   return *C;
+}
+
+void HypreRAPPlan::ReleaseTranspose()
+{
+#if MFEM_HYPRE_VERSION >= 21100
+   // Release the transpose kept by hypre in Rt (or P)
+   hypre_ParCSRMatrix *R_t = Rt ? *Rt : *P;
+   if (hypre_ParCSRMatrixDiagT(R_t))
+   {
+      hypre_CSRMatrixDestroy(hypre_ParCSRMatrixDiagT(R_t));
+      hypre_ParCSRMatrixDiagT(R_t) = NULL;
+   }
+   if (hypre_ParCSRMatrixOffdT(R_t))
+   {
+      hypre_CSRMatrixDestroy(hypre_ParCSRMatrixOffdT(R_t));
+      hypre_ParCSRMatrixOffdT(R_t) = NULL;
+   }
+#endif
+}
+
 // Helper function for HypreParMatrixFromBlocks. Note that scalability to
 // extremely large processor counts is limited by the use of MPI_Allgather.
 void GatherBlockOffsetData(MPI_Comm comm, const int rank, const int nprocs,
@@ -570,6 +570,49 @@ HypreParMatrix * RAP(const HypreParMatrix *A, const HypreParMatrix *P);
 HypreParMatrix * RAP(const HypreParMatrix * Rt, const HypreParMatrix *A,
                      const HypreParMatrix *P);
 
+/** @brief Reusable parallel Galerkin triple product Rt^t A P or P^t A P for a
+    sequence of matrices A with the same sparsity pattern and fixed Rt and P,
+    see also the serial RAPPlan.
+
+    Since hypre does not provide a separate numeric phase for the triple
+    product, every call of Mult() computes the full (symbolic and numeric)
+    product. The plan only keeps the local transpose of Rt (or P) inside hypre
+    between the calls (requires HYPRE version >= 2.11.0) and updates the values
+    of the result in place when its sparsity pattern is unchanged. Solvers and
+    preconditioners referencing the result remain valid in that case. The
+    matrices Rt and P must not be modified while the plan is in use.
+
+    The transpose is freed by ReleaseTranspose() or with Rt (or P). The
+    destructor of the plan does not access Rt and P, which may be destroyed
+    before the plan. */
+class HypreRAPPlan
+{
+private:
+   const HypreParMatrix *Rt, *P;
+   HypreParMatrix *C;
+
+public:
+   /// Plan for the product P^t A P.
+   explicit HypreRAPPlan(const HypreParMatrix &P);
+
+   /// Plan for the product Rt^t A P.
+   HypreRAPPlan(const HypreParMatrix &Rt, const HypreParMatrix &P);
+
+   /** @brief Compute the triple product and return the result, which is owned
+       by the plan and updated by subsequent calls. If the sparsity pattern of
+       the product changes, the result is replaced by a new matrix. */
+   HypreParMatrix &Mult(const HypreParMatrix &A);
+
+   /// Discard the result returned by Mult().
+   void Reset() { delete C; C = NULL; }
+
+   /** @brief Free the transpose of Rt (or P) kept between the calls of
+       Mult(). Rt and P must still exist. */
+   void ReleaseTranspose();
+
+   ~HypreRAPPlan() { delete C; }
+};
+
 /// Returns a merged hypre matrix constructed from hypre matrix blocks.
 /** It is assumed that all block matrices use the same communicator, and the
     block sizes are consistent in rows and columns. Rows and columns are
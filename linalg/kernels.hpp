@@ -1372,6 +1372,69 @@ have_aa:
 }
 
 
+/// Compute the LU factorization of the m x m matrix stored in @a data,
+//  overwriting it with the factors, such that L.U = P.A
+//
+// @param [in, out] data matrix A on input, LU factors on output
+// @param [in] m square matrix height
+// @param [out] ipiv array storing pivot information
+// @param [in] TOL fuzzy comparison tolerance for the pivots
+//
+// Returns false if a pivot with absolute value <= TOL was encountered.
+MFEM_HOST_DEVICE
+inline bool LUFactor(double *data, const int m, int *ipiv,
+                     const double TOL = 0.0)
+{
+   bool pivot_flag = true;
+   for (int i = 0; i < m; i++)
+   {
+      // pivoting
+      {
+         int piv = i;
+         double a = fabs(data[piv + i * m]);
+         for (int j = i + 1; j < m; j++)
+         {
+            const double b = fabs(data[j + i * m]);
+            if (b > a)
+            {
+               a = b;
+               piv = j;
+            }
+         }
+         ipiv[i] = piv;
+         if (piv != i)
+         {
+            // swap rows i and piv in both L and U parts
+            for (int j = 0; j < m; j++)
+            {
+               internal::Swap<double>(data[i + j * m], data[piv + j * m]);
+            }
+         }
+      }
+
+      if (fabs(data[i + i * m]) <= TOL)
+      {
+         pivot_flag = false;
+      }
+
+      const double a_ii_inv = 1.0 / data[i + i * m];
+      for (int j = i + 1; j < m; j++)
+      {
+         data[j + i * m] *= a_ii_inv;
+      }
+
+      for (int k = i + 1; k < m; k++)
+      {
+         const double a_ik = data[i + k * m];
+         for (int j = i + 1; j < m; j++)
+         {
+            data[j + k * m] -= a_ik * data[j + i * m];
+         }
+      }
+   }
+   return pivot_flag;
+}
+
 /// Assuming L.U = P.A for a factored matrix (m x m),
 //  compute x <- A x
 //
@@ -0,0 +1,358 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "lobpcg.hpp"
+#include <iomanip>
+
+namespace mfem
+{
+
+LOBPCGSolver::LOBPCGSolver()
+   : A(NULL), B(NULL), prec(NULL),
+     nev(1), seed(75), max_iter(100), print_level(0),
+     abs_tol(1e-8), rel_tol(0.0), num_iter(0), num_conv(0)
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+LOBPCGSolver::LOBPCGSolver(MPI_Comm comm_)
+   : LOBPCGSolver()
+{
+   comm = comm_;
+}
+#endif
+
+void LOBPCGSolver::SetInitialVectors(int num_vecs, const Vector *const *vecs)
+{
+   init_vecs.SetSize(num_vecs);
+   for (int i = 0; i < num_vecs; i++) { init_vecs[i] = vecs[i]; }
+}
+
+double LOBPCGSolver::Dot(const Vector &x, const Vector &y) const
+{
+   double d = x*y;
+   GlobalSum(&d, 1);
+   return d;
+}
+
+void LOBPCGSolver::GlobalSum(double *data, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, data, n, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#else
+   MFEM_CONTRACT_VAR(data);
+   MFEM_CONTRACT_VAR(n);
+#endif
+}
+
+void LOBPCGSolver::ApplyA(const Array<Vector *> &U, Array<Vector *> &AU) const
+{
+   Array<const Vector *> cU(U.Size());
+   for (int i = 0; i < U.Size(); i++) { cU[i] = U[i]; }
+   A->ArrayMult(cU, AU);
+}
+
+void LOBPCGSolver::ApplyB(const Array<Vector *> &U, Array<Vector *> &BU) const
+{
+   if (!B)
+   {
+      for (int i = 0; i < U.Size(); i++) { *BU[i] = *U[i]; }
+      return;
+   }
+   Array<const Vector *> cU(U.Size());
+   for (int i = 0; i < U.Size(); i++) { cU[i] = U[i]; }
+   B->ArrayMult(cU, BU);
+}
+
+void LOBPCGSolver::Gram(const Array<Vector *> &U, const Array<Vector *> &V,
+                        DenseMatrix &G) const
+{
+   G.SetSize(U.Size(), V.Size());
+   for (int j = 0; j < V.Size(); j++)
+   {
+      for (int i = 0; i < U.Size(); i++)
+      {
+         G(i,j) = (*U[i])*(*V[j]);
+      }
+   }
+   GlobalSum(G.Data(), U.Size()*V.Size());
+}
+
+void LOBPCGSolver::Orthonormalize(Array<Vector *> &Y, Array<Vector *> &AY,
+                                  Array<Vector *> &BY) const
+{
+   const int m = X.Size();
+   Vector c;
+   int q = 0; // number of accepted vectors
+   for (int k = 0; k < Y.Size(); k++)
+   {
+      Vector &y = *Y[k], &Ay = *AY[k], &By = *BY[k];
+      // Classical Gram-Schmidt with reorthogonalization, in the B-inner
+      // product, against X and the accepted vectors Y[0..q).
+      double norm0 = -1.0, norm = 0.0;
+      for (int pass = 0; pass < 2; pass++)
+      {
+         c.SetSize(m + q + 1);
+         for (int i = 0; i < m; i++) { c(i) = (*BX[i])*y; }
+         for (int l = 0; l < q; l++) { c(m+l) = (*BY[l])*y; }
+         c(m+q) = y*By;
+         GlobalSum(c.GetData(), c.Size());
+         if (norm0 < 0.0) { norm0 = sqrt(std::max(c(m+q), 0.0)); }
+         for (int i = 0; i < m; i++)
+         {
+            y.Add(-c(i), *X[i]);
+            Ay.Add(-c(i), *AX[i]);
+            By.Add(-c(i), *BX[i]);
+         }
+         for (int l = 0; l < q; l++)
+         {
+            y.Add(-c(m+l), *Y[l]);
+            Ay.Add(-c(m+l), *AY[l]);
+            By.Add(-c(m+l), *BY[l]);
+         }
+      }
+      norm = sqrt(std::max(Dot(y, By), 0.0));
+      if (norm <= 1e-10*norm0 || norm == 0.0)
+      {
+         continue; // drop the linearly dependent vector
+      }
+      y *= 1.0/norm;
+      Ay *= 1.0/norm;
+      By *= 1.0/norm;
+      if (q != k)
+      {
+         Swap(Y[q], Y[k]);
+         Swap(AY[q], AY[k]);
+         Swap(BY[q], BY[k]);
+      }
+      q++;
+   }
+   // The dropped vectors are not owned by Y, AY and BY
+   Y.SetSize(q);
+   AY.SetSize(q);
+   BY.SetSize(q);
+}
+
+void LOBPCGSolver::Combine(const Array<Vector *> &S, const DenseMatrix &C,
+                           int row0, Array<Vector *> &U) const
+{
+   for (int j = 0; j < U.Size(); j++)
+   {
+      *U[j] = 0.0;
+      for (int i = 0; i < S.Size(); i++)
+      {
+         U[j]->Add(C(row0+i,j), *S[i]);
+      }
+   }
+}
+
+void LOBPCGSolver::NewBlock(Array<Vector *> &U, int size)
+{
+   DeleteBlock(U);
+   U.SetSize(nev);
+   for (int i = 0; i < nev; i++) { U[i] = new Vector(size); }
+}
+
+void LOBPCGSolver::DeleteBlock(Array<Vector *> &U)
+{
+   for (int i = 0; i < U.Size(); i++) { delete U[i]; }
+   U.SetSize(0);
+}
+
+void LOBPCGSolver::DeleteBlocks()
+{
+   for (Array<Vector *> *U : { &X, &AX, &BX, &W, &AW, &BW, &P, &AP, &BP,
+                                  &T, &AT, &BT })
+   {
+      DeleteBlock(*U);
+   }
+}
+
+void LOBPCGSolver::Solve()
+{
+   MFEM_VERIFY(A, "the operator is not set");
+   MFEM_VERIFY(nev > 0, "invalid number of modes: " << nev);
+   const int n = A->Height(), m = nev;
+   for (Array<Vector *> *U : { &X, &AX, &BX, &W, &AW, &BW, &P, &AP, &BP,
+                                  &T, &AT, &BT })
+   {
+      NewBlock(*U, n);
+   }
+
+   // Initial vectors
+   int myid = 0;
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL) { MPI_Comm_rank(comm, &myid); }
+#endif
+   for (int i = 0; i < m; i++)
+   {
+      if (i < init_vecs.Size()) { *X[i] = *init_vecs[i]; }
+      else
+      {
+         X[i]->Randomize(seed + 1 + i + m*myid);
+         *X[i] -= 0.5;
+      }
+   }
+
+   // Rayleigh-Ritz on X, which also B-orthonormalizes X
+   DenseMatrix gA, gB, C;
+   Vector ev;
+   ApplyA(X, AX);
+   ApplyB(X, BX);
+   Gram(X, AX, gA);
+   Gram(X, BX, gB);
+   gA.Symmetrize();
+   gB.Symmetrize();
+   gA.Eigensystem(gB, ev, C);
+   for (Array<Vector *> *U : { &X, &AX, &BX })
+   {
+      Combine(*U, C, 0, W);
+      Swap(*U, W);
+   }
+   eigenvalues.SetSize(m);
+   for (int j = 0; j < m; j++) { eigenvalues[j] = ev(j); }
+
+   Array<bool> locked(m);
+   locked = false;
+   Vector res(m);
+   Array<Vector *> Wa, AWa, BWa, Y, AY, BY, S, AS, BS;
+   num_conv = 0;
+   for (num_iter = 0; true; num_iter++)
+   {
+      // Residuals and soft locking of the converged eigenpairs
+      for (int j = 0; j < m; j++)
+      {
+         add(*AX[j], -eigenvalues[j], *BX[j], *W[j]); // W = A X - lambda B X
+         res(j) = (*W[j])*(*W[j]);
+      }
+      GlobalSum(res.GetData(), m);
+      Wa.SetSize(0);
+      AWa.SetSize(0);
+      BWa.SetSize(0);
+      Array<int> active;
+      double max_res = 0.0;
+      for (int j = 0; j < m; j++)
+      {
+         res(j) = sqrt(res(j));
+         if (!locked[j] &&
+             res(j) <= std::max(abs_tol, rel_tol*fabs(eigenvalues[j])))
+         {
+            locked[j] = true;
+         }
+         if (!locked[j])
+         {
+            active.Append(j);
+            Wa.Append(W[j]);
+            AWa.Append(AW[j]);
+            BWa.Append(BW[j]);
+            max_res = std::max(max_res, res(j));
+         }
+      }
+      num_conv = m - active.Size();
+      if (print_level == 1)
+      {
+         mfem::out << "LOBPCG iteration " << std::setw(3) << num_iter
+                   << ": converged " << num_conv << '/' << m
+                   << ", max residual norm = " << max_res << '\n';
+      }
+      if (active.Size() == 0 || num_iter >= max_iter) { break; }
+
+      // Preconditioned residuals of the active eigenpairs and their images
+      if (prec)
+      {
+         Array<const Vector *> cR(active.Size());
+         Array<Vector *> Z(active.Size());
+         for (int k = 0; k < active.Size(); k++)
+         {
+            cR[k] = Wa[k];
+            Z[k] = T[k];
+         }
+         prec->ArrayMult(cR, Z);
+         for (int k = 0; k < active.Size(); k++) { *Wa[k] = *T[k]; }
+      }
+      ApplyA(Wa, AWa);
+      ApplyB(Wa, BWa);
+
+      // The basis Y = [W_a, P_a] of the new search directions
+      Y = Wa;
+      AY = AWa;
+      BY = BWa;
+      if (num_iter > 0)
+      {
+         for (int k = 0; k < active.Size(); k++)
+         {
+            Y.Append(P[active[k]]);
+            AY.Append(AP[active[k]]);
+            BY.Append(BP[active[k]]);
+         }
+      }
+      Orthonormalize(Y, AY, BY);
+
+      // Rayleigh-Ritz on S = [X, Y]
+      S = X;
+      AS = AX;
+      BS = BX;
+      S.Append(Y);
+      AS.Append(AY);
+      BS.Append(BY);
+      Gram(S, AS, gA);
+      Gram(S, BS, gB);
+      gA.Symmetrize();
+      gB.Symmetrize();
+      gA.Eigensystem(gB, ev, C);
+
+      // New search directions P = Y C_Y and eigenvectors X = X C_X + P, where
+      // C = [C_X; C_Y]. The old X block is reused for the residuals.
+      Combine(Y, C, m, T);
+      Combine(AY, C, m, AT);
+      Combine(BY, C, m, BT);
+      Combine(X, C, 0, W);
+      Combine(AX, C, 0, AW);
+      Combine(BX, C, 0, BW);
+      for (int j = 0; j < m; j++)
+      {
+         *W[j] += *T[j];
+         *AW[j] += *AT[j];
+         *BW[j] += *BT[j];
+      }
+      Swap(X, W);
+      Swap(AX, AW);
+      Swap(BX, BW);
+      Swap(P, T);
+      Swap(AP, AT);
+      Swap(BP, BT);
+      for (int j = 0; j < m; j++) { eigenvalues[j] = ev(j); }
+   }
+
+   if (print_level >= 0 && num_conv < m)
+   {
+      mfem::err << "LOBPCG: " << m - num_conv << " of " << m
+                << " eigenpairs did not converge in " << num_iter
+                << " iterations!\n";
+   }
+   if (print_level >= 2)
+   {
+      for (int j = 0; j < m; j++)
+      {
+         mfem::out << "Eigenvalue " << std::setw(3) << j << ": "
+                   << std::setw(16) << std::setprecision(10) << eigenvalues[j]
+                   << ", residual norm = " << res(j) << '\n';
+      }
+   }
+}
+
+} // namespace mfem
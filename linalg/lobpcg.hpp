@@ -0,0 +1,147 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LOBPCG
+#define MFEM_LOBPCG
+
+#include "../config/config.hpp"
+#include "operator.hpp"
+#include "densemat.hpp"
+
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace mfem
+{
+
+/** @brief Locally optimal block preconditioned conjugate gradient (LOBPCG)
+    eigensolver for the lowest eigenpairs of the generalized eigenvalue problem
+    A x = lambda B x, where A is symmetric and B is symmetric positive definite
+    (B = I if no mass matrix is set).
+
+    Unlike HypreLOBPCG, this is a native implementation working with any
+    Operator%s, e.g. partially assembled or matrix-free operators, in serial and
+    in parallel. The operators and the preconditioner are applied to blocks of
+    vectors with Operator::ArrayMult().
+
+    Each iteration applies the Rayleigh-Ritz procedure to the subspace spanned
+    by the current eigenvector approximations X, the preconditioned residuals W
+    and the previous search directions P, see Knyazev, "Toward the optimal
+    preconditioned eigensolver: locally optimal block preconditioned conjugate
+    gradient method", SIAM J. Sci. Comput. 23 (2001). The blocks W and P are
+    B-orthonormalized against X and each other, dropping (numerically) linearly
+    dependent vectors. Converged eigenpairs are soft locked: they remain in the
+    Rayleigh-Ritz procedure, but no new search directions are computed for
+    them. An eigenpair is converged when the residual norm satisfies
+
+        || A x - lambda B x || <= max(tol, rel_tol |lambda|),
+
+    with B-normalized x, see SetTol() and SetRelTol(). */
+class LOBPCGSolver
+{
+private:
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   const Operator *A, *B;
+   Solver *prec;
+
+   int nev, seed, max_iter, print_level;
+   double abs_tol, rel_tol;
+
+   int num_iter, num_conv;
+   Array<double> eigenvalues;
+   Array<const Vector *> init_vecs;
+
+   // Blocks of vectors: the eigenvector approximations X, the (preconditioned)
+   // residuals W and the search directions P, with their images under A and B,
+   // and the work block T.
+   Array<Vector *> X, AX, BX, W, AW, BW, P, AP, BP, T, AT, BT;
+
+   double Dot(const Vector &x, const Vector &y) const;
+   void GlobalSum(double *data, int n) const;
+
+   void ApplyA(const Array<Vector *> &U, Array<Vector *> &AU) const;
+   void ApplyB(const Array<Vector *> &U, Array<Vector *> &BU) const;
+
+   /// Compute G(i,j) = U[i] . V[j] with a single global reduction.
+   void Gram(const Array<Vector *> &U, const Array<Vector *> &V,
+             DenseMatrix &G) const;
+
+   /** B-orthonormalize the vectors Y against the B-orthonormal vectors X and
+       each other, updating AY and BY accordingly. Linearly dependent vectors
+       are removed from Y, AY and BY. */
+   void Orthonormalize(Array<Vector *> &Y, Array<Vector *> &AY,
+                       Array<Vector *> &BY) const;
+
+   /// Compute U[j] = sum_i C(row0+i,j) S[i] for j < U.Size().
+   void Combine(const Array<Vector *> &S, const DenseMatrix &C, int row0,
+                Array<Vector *> &U) const;
+
+   void NewBlock(Array<Vector *> &U, int size);
+   void DeleteBlock(Array<Vector *> &U);
+   void DeleteBlocks();
+
+public:
+   LOBPCGSolver();
+
+#ifdef MFEM_USE_MPI
+   /// Construct a solver for operators distributed over @a comm.
+   LOBPCGSolver(MPI_Comm comm);
+#endif
+
+   /// Set the absolute tolerance of the residual norm (default: 1e-8).
+   void SetTol(double tol) { abs_tol = tol; }
+   /// Set the relative tolerance of the residual norm (default: 0).
+   void SetRelTol(double rtol) { rel_tol = rtol; }
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+   /** @brief Set the print level: -1 - no output, 0 - warnings, 1 - residual
+       norms in each iteration, 2 - eigenvalues and residuals at the end. */
+   void SetPrintLevel(int print_lvl) { print_level = print_lvl; }
+   /// Set the number of eigenpairs to compute.
+   void SetNumModes(int num_eigs) { nev = num_eigs; }
+   /// Set the random seed for the initial vectors.
+   void SetRandomSeed(int s) { seed = s; }
+   /** @brief Set the initial approximations of the first @a num_vecs
+       eigenvectors; the remaining ones are random. The vectors are copied
+       when Solve() is called. */
+   void SetInitialVectors(int num_vecs, const Vector *const *vecs);
+
+   /// Set the preconditioner, which approximates the inverse of A.
+   void SetPreconditioner(Solver &precond) { prec = &precond; }
+   /// Set the symmetric operator A.
+   void SetOperator(const Operator &op) { A = &op; }
+   /// Set the symmetric positive definite mass operator B.
+   void SetMassMatrix(const Operator &M) { B = &M; }
+
+   /// Solve the eigenproblem.
+   void Solve();
+
+   /// Return the eigenvalues, in ascending order.
+   void GetEigenvalues(Array<double> &evals) const { evals = eigenvalues; }
+
+   /// Return the B-normalized eigenvector @a i.
+   const Vector &GetEigenvector(int i) const { return *X[i]; }
+
+   /// Return the number of iterations of the last Solve().
+   int GetNumIterations() const { return num_iter; }
+
+   /// Return the number of converged eigenpairs of the last Solve().
+   int GetNumConverged() const { return num_conv; }
+
+   ~LOBPCGSolver() { DeleteBlocks(); }
+};
+
+} // namespace mfem
+
+#endif
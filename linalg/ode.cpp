@@ -11,6 +11,7 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include "vector_expr.hpp"
 
 namespace mfem
 {
@@ -102,8 +103,10 @@ void RK4Solver::Init(TimeDependentOperator &_f)
    ODESolver::Init(_f);
    int n = f->Width();
    y.SetSize(n, mem_type);
-   k.SetSize(n, mem_type);
-   z.SetSize(n, mem_type);
+   for (int i = 0; i < 4; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
 }
 
 void RK4Solver::Step(Vector &x, double &t, double &dt)
@@ -116,22 +119,22 @@ void RK4Solver::Step(Vector &x, double &t, double &dt)
    //      | 1/6  1/3  1/3  1/6
 
    f->SetTime(t);
-   f->Mult(x, k); // k1
-   add(x, dt/2, k, y);
-   add(x, dt/6, k, z);
+   f->Mult(x, k[0]); // k1
+   add(x, dt/2, k[0], y);
 
    f->SetTime(t + dt/2);
-   f->Mult(y, k); // k2
-   add(x, dt/2, k, y);
-   z.Add(dt/3, k);
+   f->Mult(y, k[1]); // k2
+   add(x, dt/2, k[1], y);
 
-   f->Mult(y, k); // k3
-   add(x, dt, k, y);
-   z.Add(dt/3, k);
+   f->Mult(y, k[2]); // k3
+   add(x, dt, k[2], y);
 
    f->SetTime(t + dt);
-   f->Mult(y, k); // k4
-   add(z, dt/6, k, x);
+   f->Mult(y, k[3]); // k4
+
+   // x += dt/6*(k1 + 2*k2 + 2*k3 + k4), evaluated in a single pass
+   Lazy(x) += (dt/6)*(Lazy(k[0]) + 2.0*Lazy(k[1]) + 2.0*Lazy(k[2]) +
+                      Lazy(k[3]));
    t += dt;
 }
 
@@ -156,6 +159,25 @@ void ExplicitRKSolver::Init(TimeDependentOperator &_f)
    }
 }
 
+// Compute y = x + dt*sum_j c[j]*k[j], j = 0,...,n-1, n > 0, in as few passes
+// over the data as possible (one pass when n <= LinearCombinationExpr::MaxTerms).
+static void AddStages(const Vector &x, double dt, int n, const double *c,
+                      const Vector *k, Vector &y)
+{
+   MFEM_ASSERT(n > 0, "invalid number of stages");
+   const int max_terms = LinearCombinationExpr::MaxTerms;
+   for (int j0 = 0; j0 < n; j0 += max_terms)
+   {
+      LinearCombinationExpr sum;
+      for (int j = j0; j < std::min(n, j0 + max_terms); j++)
+      {
+         sum.Add(c[j]*dt, k[j]);
+      }
+      if (j0 == 0) { Lazy(y) = Lazy(x) + sum; }
+      else { Lazy(y) += sum; }
+   }
+}
+
 void ExplicitRKSolver::Step(Vector &x, double &t, double &dt)
 {
    //   0     |
@@ -168,21 +190,14 @@ void ExplicitRKSolver::Step(Vector &x, double &t, double &dt)
 
    f->SetTime(t);
    f->Mult(x, k[0]);
-   for (int l = 0, i = 1; i < s; i++)
+   for (int l = 0, i = 1; i < s; l += i, i++)
    {
-      add(x, a[l++]*dt, k[0], y);
-      for (int j = 1; j < i; j++)
-      {
-         y.Add(a[l++]*dt, k[j]);
-      }
+      AddStages(x, dt, i, a + l, k, y); // y = x + dt*sum_j a[l+j]*k[j]
 
       f->SetTime(t + c[i-1]*dt);
       f->Mult(y, k[i]);
    }
-   for (int i = 0; i < s; i++)
-   {
-      x.Add(b[i]*dt, k[i]);
-   }
+   AddStages(x, dt, s, b, k, x); // x += dt*sum_i b[i]*k[i]
    t += dt;
 }
 
@@ -343,6 +358,285 @@ const double RK8Solver::c[] =
    1.,
 };
 
+AdaptiveODESolver::AdaptiveODESolver()
+{
+   InitAdaptive();
+#ifdef MFEM_USE_MPI
+   parallel = false;
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+AdaptiveODESolver::AdaptiveODESolver(MPI_Comm comm_)
+{
+   InitAdaptive();
+   parallel = true;
+   comm = comm_;
+}
+#endif
+
+void AdaptiveODESolver::InitAdaptive()
+{
+   rel_tol = 1e-6;
+   abs_tol = 1e-6;
+   dt_min = 0.0;
+   dt_max = infinity();
+   t_stop = infinity();
+   safety = 0.9;
+   fac_min = 0.2;
+   fac_max = 5.0;
+   alpha = 0.7;
+   beta = 0.4;
+   err_old = 1e-4;
+   dt_next = 0.0;
+   last_rejected = false;
+   num_accepted = num_rejected = 0;
+}
+
+void AdaptiveODESolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   x_new.SetSize(f->Width(), mem_type);
+   err.SetSize(f->Width(), mem_type);
+   err_old = 1e-4;
+   dt_next = 0.0;
+   last_rejected = false;
+   num_accepted = num_rejected = 0;
+}
+
+void AdaptiveODESolver::SetController(double safety_factor, double min_factor,
+                                      double max_factor, double a, double b)
+{
+   safety = safety_factor;
+   fac_min = min_factor;
+   fac_max = max_factor;
+   alpha = a;
+   beta = b;
+}
+
+double AdaptiveODESolver::ErrorNorm(const Vector &e, const Vector &x0,
+                                    const Vector &x1) const
+{
+   const int n = e.Size();
+   const double rtol = rel_tol, atol = abs_tol;
+   const double *d_e = e.Read(), *d_x0 = x0.Read(), *d_x1 = x1.Read();
+   Vector w(n);
+   double *d_w = w.Write();
+   MFEM_FORALL(i, n,
+   {
+      const double sc = atol + rtol*fmax(fabs(d_x0[i]), fabs(d_x1[i]));
+      d_w[i] = d_e[i]/sc;
+   });
+   double sums[2] = { w*w, double(n) };
+#ifdef MFEM_USE_MPI
+   if (parallel)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return (sums[1] > 0.0) ? sqrt(sums[0]/sums[1]) : 0.0;
+}
+
+void AdaptiveODESolver::Step(Vector &x, double &t, double &dt)
+{
+   const double k = GetErrorOrder();
+   double h = (dt_next > 0.0) ? dt_next : dt;
+   h = std::max(std::min(h, dt_max), dt_min);
+   while (true)
+   {
+      const double h_full = h;
+      const bool stop = (t + h >= t_stop);
+      if (stop) { h = t_stop - t; }
+
+      TrialStep(x, t, h, x_new, err);
+      const double err_norm = std::max(ErrorNorm(err, x, x_new), 1e-10);
+
+      if (err_norm <= 1.0 || h <= dt_min)
+      {
+         // Accept the step; PI controller for the next step size
+         double fac = safety*pow(err_norm, -alpha/k)*pow(err_old, beta/k);
+         fac = std::min(fac_max, std::max(fac_min, fac));
+         if (last_rejected) { fac = std::min(fac, 1.0); }
+         dt_next = std::max(std::min((stop ? h_full : h)*fac, dt_max), dt_min);
+         err_old = err_norm;
+         last_rejected = false;
+         num_accepted++;
+
+         x = x_new;
+         t = stop ? t_stop : t + h;
+         dt = h;
+         AcceptStep(x, t);
+         return;
+      }
+
+      // Reject the step; I controller for the retry
+      num_rejected++;
+      last_rejected = true;
+      const double fac = safety*pow(err_norm, -1.0/k);
+      h = std::max(h*std::max(fac_min, fac), dt_min);
+   }
+}
+
+void AdaptiveODESolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   const double t_stop_save = t_stop;
+   t_stop = std::min(t_stop, tf);
+   while (t < tf) { Step(x, t, dt); }
+   t_stop = t_stop_save;
+}
+
+
+EmbeddedRKSolver::EmbeddedRKSolver(int _s, int q, const double *_a,
+                                   const double *_b, const double *_bh,
+                                   const double *_c, bool _fsal)
+   : s(_s), err_order(q + 1), a(_a), b(_b), bh(_bh), c(_c), fsal(_fsal),
+     k0_valid(false), t_k0(0.0), e(_s)
+{
+   k = new Vector[s];
+   for (int i = 0; i < s; i++) { e[i] = b[i] - bh[i]; }
+}
+
+#ifdef MFEM_USE_MPI
+EmbeddedRKSolver::EmbeddedRKSolver(MPI_Comm comm_, int _s, int q,
+                                   const double *_a, const double *_b,
+                                   const double *_bh, const double *_c,
+                                   bool _fsal)
+   : AdaptiveODESolver(comm_), s(_s), err_order(q + 1), a(_a), b(_b),
+     bh(_bh), c(_c), fsal(_fsal), k0_valid(false), t_k0(0.0), e(_s)
+{
+   k = new Vector[s];
+   for (int i = 0; i < s; i++) { e[i] = b[i] - bh[i]; }
+}
+#endif
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveODESolver::Init(_f);
+   int n = f->Width();
+   x_k0.SetSize(n, mem_type);
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void EmbeddedRKSolver::TrialStep(const Vector &x, double t, double dt,
+                                 Vector &x1, Vector &e1)
+{
+   // The first stage is reused when retrying a rejected step and, for FSAL
+   // methods, after an accepted step, unless the caller changed the state.
+   if (!k0_valid || t != t_k0 || !SameState(x))
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      t_k0 = t;
+      x_k0 = x;
+      k0_valid = true;
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      AddStages(x, dt, i, a + l, k, y); // y = x + dt*sum_j a[l+j]*k[j]
+      l += i;
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(y, k[i]);
+   }
+   AddStages(x, dt, s, b, k, x1); // x1 = x + dt*sum_i b[i]*k[i]
+
+   // e1 = dt*sum_i (b[i] - bh[i])*k[i]
+   y = 0.0;
+   AddStages(y, dt, s, e, k, e1);
+}
+
+void EmbeddedRKSolver::AcceptStep(const Vector &x1, double t1)
+{
+   // With FSAL, the last stage k[s-1] = f(x1, t1) is the first stage of the
+   // next step.
+   if (fsal)
+   {
+      k[0] = k[s-1];
+      t_k0 = t1;
+      x_k0 = x1;
+   }
+   else
+   {
+      k0_valid = false;
+   }
+}
+
+bool EmbeddedRKSolver::SameState(const Vector &x)
+{
+   subtract(x, x_k0, y);
+   double d = y*y;
+#ifdef MFEM_USE_MPI
+   if (parallel)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &d, 1, MPI_DOUBLE, MPI_MAX, comm);
+   }
+#endif
+   return d == 0.0;
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double BogackiShampineSolver::a[] =
+{
+   1./2,
+   0., 3./4,
+   2./9, 1./3, 4./9
+};
+const double BogackiShampineSolver::b[] = { 2./9, 1./3, 4./9, 0. };
+const double BogackiShampineSolver::bh[] = { 7./24, 1./4, 1./3, 1./8 };
+const double BogackiShampineSolver::c[] = { 1./2, 3./4, 1. };
+
+const double DormandPrinceSolver::a[] =
+{
+   1./5,
+   3./40, 9./40,
+   44./45, -56./15, 32./9,
+   19372./6561, -25360./2187, 64448./6561, -212./729,
+   9017./3168, -355./33, 46732./5247, 49./176, -5103./18656,
+   35./384, 0., 500./1113, 125./192, -2187./6784, 11./84
+};
+const double DormandPrinceSolver::b[] =
+{
+   35./384, 0., 500./1113, 125./192, -2187./6784, 11./84, 0.
+};
+const double DormandPrinceSolver::bh[] =
+{
+   5179./57600, 0., 7571./16695, 393./640, -92097./339200, 187./2100, 1./40
+};
+const double DormandPrinceSolver::c[] =
+{
+   1./5, 3./10, 4./5, 8./9, 1., 1.
+};
+
+const double CashKarpSolver::a[] =
+{
+   1./5,
+   3./40, 9./40,
+   3./10, -9./10, 6./5,
+   -11./54, 5./2, -70./27, 35./27,
+   1631./55296, 175./512, 575./13824, 44275./110592, 253./4096
+};
+const double CashKarpSolver::b[] =
+{
+   37./378, 0., 250./621, 125./594, 0., 512./1771
+};
+const double CashKarpSolver::bh[] =
+{
+   2825./27648, 0., 18575./48384, 13525./55296, 277./14336, 1./4
+};
+const double CashKarpSolver::c[] =
+{
+   1./5, 3./10, 3./5, 1., 7./8
+};
+
 
 AdamsBashforthSolver::AdamsBashforthSolver(int _s, const double *_a)
 {
@@ -413,10 +707,13 @@ void AdamsBashforthSolver::Step(Vector &x, double &t, double &dt)
    {
       f->SetTime(t);
       f->Mult(x, k[idx[0]]);
+      // x += dt*sum_i a[i]*k[idx[i]], evaluated in a single pass
+      LinearCombinationExpr sum;
       for (int i = 0; i < s; i++)
       {
-         x.Add(a[i]*dt, k[idx[i]]);
+         sum.Add(a[i]*dt, k[idx[i]]);
       }
+      Lazy(x) += sum;
    }
    else
    {
@@ -781,6 +1078,216 @@ void ESDIRK33Solver::Step(Vector &x, double &t, double &dt)
    t += dt;
 }
 
+IMEXRKSolver::IMEXRKSolver(int _s, const double *_ae, const double *_be,
+                           const double *_ai, const double *_bi,
+                           const double *_c)
+   : s(_s), ae(_ae), be(_be), ai(_ai), bi(_bi), c(_c),
+     need_ke(_s), need_ki(_s)
+{
+   ke = new Vector[s];
+   ki = new Vector[s];
+   for (int j = 0; j < s; j++)
+   {
+      need_ke[j] = (be[j] != 0.0);
+      need_ki[j] = (bi[j] != 0.0);
+      for (int i = j + 1; i < s; i++)
+      {
+         need_ke[j] = need_ke[j] || (ae[i*(i-1)/2 + j] != 0.0);
+         need_ki[j] = need_ki[j] || (ai[i*(i+1)/2 + j] != 0.0);
+      }
+   }
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      ke[i].SetSize(n, mem_type);
+      ki[i].SetSize(n, mem_type);
+   }
+}
+
+// Compute y = x + dt*sum_j (ae[j]*ke[j] + ai[j]*ki[j]), j = 0,...,n-1, skipping
+// the zero coefficients, in as few passes over the data as possible.
+static void AddIMEXStages(const Vector &x, double dt, int n,
+                          const double *ae, const Vector *ke,
+                          const double *ai, const Vector *ki, Vector &y)
+{
+   LinearCombinationExpr sum;
+   int nterms = 0;
+   bool first = true;
+   auto flush = [&]()
+   {
+      if (first) { Lazy(y) = Lazy(x) + sum; }
+      else { Lazy(y) += sum; }
+      sum = LinearCombinationExpr();
+      nterms = 0;
+      first = false;
+   };
+   for (int j = 0; j < 2*n; j++)
+   {
+      const double cj = (j < n) ? ae[j] : ai[j-n];
+      if (cj == 0.0) { continue; }
+      sum.Add(cj*dt, (j < n) ? ke[j] : ki[j-n]);
+      if (++nterms == LinearCombinationExpr::MaxTerms) { flush(); }
+   }
+   if (nterms > 0) { flush(); }
+   else if (first && &y != &x) { y = x; }
+}
+
+void IMEXRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   const TimeDependentOperator::EvalMode mode = f->GetEvalMode();
+   for (int i = 0; i < s; i++)
+   {
+      // y = x + dt*sum_{j<i} (ae[i,j]*ke[j] + ai[i,j]*ki[j])
+      const Vector *yi = &x;
+      if (i > 0)
+      {
+         AddIMEXStages(x, dt, i, ae + i*(i-1)/2, ke, ai + i*(i+1)/2, ki, y);
+         yi = &y;
+      }
+      const double gi = ai[i*(i+1)/2 + i];
+
+      f->SetTime(t + c[i]*dt);
+      if (gi != 0.0)
+      {
+         // ki[i] = f2(y + gi*dt*ki[i]), then the stage value y += gi*dt*ki[i]
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->ImplicitSolve(gi*dt, *yi, ki[i]);
+         if (need_ke[i])
+         {
+            add(*yi, gi*dt, ki[i], y);
+            yi = &y;
+         }
+      }
+      else if (need_ki[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->Mult(*yi, ki[i]);
+      }
+      if (need_ke[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+         f->Mult(*yi, ke[i]);
+      }
+   }
+   // x += dt*sum_i (be[i]*ke[i] + bi[i]*ki[i])
+   AddIMEXStages(x, dt, s, be, ke, bi, ki, x);
+   f->SetEvalMode(mode);
+   t += dt;
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] ki;
+   delete [] ke;
+}
+
+// ARS(2,3,2) with gamma = 1 - 1/sqrt(2) and delta = -2 sqrt(2)/3; the explicit
+// weights equal the implicit ones, (0, 1 - gamma, gamma)
+const double ARS232Solver::ae[] =
+{
+   .29289321881345247559915563789515,
+   -.94280904158206336586779248280647, 1.9428090415820633658677924828065
+};
+const double ARS232Solver::be[] =
+{
+   0., .70710678118654752440084436210485, .29289321881345247559915563789515
+};
+const double ARS232Solver::ai[] =
+{
+   0.,
+   0., .29289321881345247559915563789515,
+   0., .70710678118654752440084436210485, .29289321881345247559915563789515
+};
+const double ARS232Solver::bi[] =
+{
+   0., .70710678118654752440084436210485, .29289321881345247559915563789515
+};
+const double ARS232Solver::c[] =
+{
+   0., .29289321881345247559915563789515, 1.
+};
+
+const double ARS443Solver::ae[] =
+{
+   1./2,
+   11./18, 1./18,
+   5./6, -5./6, 1./2,
+   1./4, 7./4, 3./4, -7./4
+};
+const double ARS443Solver::be[] = { 1./4, 7./4, 3./4, -7./4, 0. };
+const double ARS443Solver::ai[] =
+{
+   0.,
+   0., 1./2,
+   0., 1./6, 1./2,
+   0., -1./2, 1./2, 1./2,
+   0., 3./2, -3./2, 1./2, 1./2
+};
+const double ARS443Solver::bi[] = { 0., 3./2, -3./2, 1./2, 1./2 };
+const double ARS443Solver::c[] = { 0., 1./2, 2./3, 1./2, 1. };
+
+const double ARK3Solver::ae[] =
+{
+   1767732205903./2027836641118,
+   5535828885825./10492691773637, 788022342437./10882634858940,
+   6485989280629./16251701735622, -4246266847089./9704473918619,
+   10755448449292./10357097424841
+};
+const double ARK3Solver::b[] =
+{
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK3Solver::ai[] =
+{
+   0.,
+   1767732205903./4055673282236, 1767732205903./4055673282236,
+   2746238789719./10658868560708, -640167445237./6845629431997,
+   1767732205903./4055673282236,
+   1471266399579./7840856788654, -4482444167858./7529755066697,
+   11266239266428./11593286722821, 1767732205903./4055673282236
+};
+const double ARK3Solver::c[] =
+{
+   0., 1767732205903./2027836641118, 3./5, 1.
+};
+
+const double ARK4Solver::ae[] =
+{
+   1./2,
+   13861./62500, 6889./62500,
+   -116923316275./2393684061468, -2731218467317./15368042101831,
+   9408046702089./11113171139209,
+   -451086348788./2902428689909, -2682348792572./7519795681897,
+   12662868775082./11960479115383, 3355817975965./11060851509271,
+   647845179188./3216320057751, 73281519250./8382639484533,
+   552539513391./3454668386233, 3354512671639./8306763924573, 4040./17871
+};
+const double ARK4Solver::b[] =
+{
+   82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4
+};
+const double ARK4Solver::ai[] =
+{
+   0.,
+   1./4, 1./4,
+   8611./62500, -1743./31250, 1./4,
+   5012029./34652500, -654441./2922500, 174375./388108, 1./4,
+   15267082809./155376265600, -71443401./120774400, 730878875./902184768,
+   2285395./8070912, 1./4,
+   82889./524892, 0., 15625./83664, 69875./102672, -2260./8211, 1./4
+};
+const double ARK4Solver::c[] =
+{
+   0., 1./2, 83./250, 31./50, 17./20, 1.
+};
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
@@ -162,7 +162,7 @@ public:
 class RK4Solver : public ODESolver
 {
 private:
-   Vector y, k, z;
+   Vector y, k[4];
 
 public:
    void Init(TimeDependentOperator &_f) override;
@@ -222,6 +222,227 @@ public:
    RK8Solver() : ExplicitRKSolver(12, a, b, c) { }
 };
 
+/** @brief Abstract class for ODE solvers with adaptive time step control.
+
+    Each call to Step() performs one accepted time step: a trial step is
+    retried with smaller sizes until the estimated local error is acceptable,
+    i.e. ErrorNorm() <= 1. The size of the first trial step after Init() is the
+    input @a dt of Step(); subsequent steps start with the size proposed by the
+    step size controller, see GetProposedStepSize(). The output @a dt is the
+    size of the accepted step. Steps do not go beyond the stop time, see
+    SetStopTime().
+
+    The step size is controlled with the PI controller of Gustafsson, see
+    Hairer and Wanner, "Solving Ordinary Differential Equations II", IV.2:
+
+        dt_new = dt * safety * err^(-alpha) * err_old^beta,
+
+    with alpha = 0.7/k and beta = 0.4/k by default, where k is the order of the
+    error estimator plus one. After a rejected step, the step size is reduced
+    using the I part only and it is not increased in the next step. */
+class AdaptiveODESolver : public ODESolver
+{
+protected:
+   double rel_tol, abs_tol;
+   double dt_min, dt_max;
+   double safety, fac_min, fac_max;
+   double alpha, beta;
+   double err_old;     // error of the last accepted step
+   double dt_next;     // proposed size of the next step, <= 0 after Init()
+   double t_stop;
+   bool last_rejected; // was the last trial step rejected?
+   int num_accepted, num_rejected;
+
+#ifdef MFEM_USE_MPI
+   bool parallel;
+   MPI_Comm comm;
+#endif
+
+   /** @brief Perform a trial step of size @a dt from (@a x, @a t): compute the
+       new solution @a x1 and the local error estimate @a e1. */
+   virtual void TrialStep(const Vector &x, double t, double dt, Vector &x1,
+                          Vector &e1) = 0;
+
+   /// Hook called after the trial step to (@a x1, @a t1) was accepted.
+   virtual void AcceptStep(const Vector &x1, double t1) { }
+
+   /// Return the order of the error estimator plus one.
+   virtual int GetErrorOrder() const = 0;
+
+   /// Work vectors for the trial solution and the local error estimate.
+   Vector x_new, err;
+
+   void InitAdaptive();
+
+public:
+   AdaptiveODESolver();
+
+#ifdef MFEM_USE_MPI
+   /** @brief Construct a solver using global (parallel) error norms over the
+       communicator @a comm. */
+   AdaptiveODESolver(MPI_Comm comm);
+#endif
+
+   void Init(TimeDependentOperator &_f) override;
+
+   /// Perform one accepted time step, see the class description.
+   void Step(Vector &x, double &t, double &dt) override;
+
+   /** @brief Perform time integration from time @a t [in] to time @a tf [in],
+       with the last step ending exactly at @a tf. */
+   void Run(Vector &x, double &t, double &dt, double tf) override;
+
+   /** @brief Return the norm of the local error estimate @a e of a step from
+       @a x0 to @a x1. A step is accepted if the norm is not greater than 1.
+
+       The default is the weighted RMS norm
+
+           sqrt( 1/N sum_i ( e_i / (abs_tol + rel_tol max(|x0_i|,|x1_i|)) )^2 )
+
+       computed over all processors, if a communicator was given. Derived
+       classes can override this method, e.g. to use a finite element norm. */
+   virtual double ErrorNorm(const Vector &e, const Vector &x0,
+                            const Vector &x1) const;
+
+   /// Set the relative and absolute tolerances of the local error.
+   void SetTolerances(double rtol, double atol)
+   { rel_tol = rtol; abs_tol = atol; }
+
+   /** @brief Set the time which the steps must not go beyond (default:
+       infinity). The step ending at the stop time is not used to propose the
+       next step size. */
+   void SetStopTime(double tstop) { t_stop = tstop; }
+
+   /// Set the minimal and maximal step sizes (defaults 0 and infinity).
+   void SetStepBounds(double min_dt, double max_dt)
+   { dt_min = min_dt; dt_max = max_dt; }
+
+   /** @brief Set the parameters of the step size controller: the safety
+       factor, the bounds for the step size ratio dt_new/dt and the exponents
+       of the PI controller, scaled with the error order k:
+       alpha = @a a/k and beta = @a b/k. Use @a b = 0 for an I controller. */
+   void SetController(double safety_factor, double min_factor,
+                      double max_factor, double a = 0.7, double b = 0.4);
+
+   /// Return the number of accepted steps since Init().
+   int GetNumAcceptedSteps() const { return num_accepted; }
+
+   /// Return the number of rejected trial steps since Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   /// Return the step size proposed by the controller for the next step.
+   double GetProposedStepSize() const { return dt_next; }
+};
+
+
+/** An embedded explicit Runge-Kutta pair with adaptive step size control. The
+    Butcher tableau has the same layout as in ExplicitRKSolver with the
+    additional row of weights @a bh of the embedded method:
+    +--------+----------------------+
+    | c[0]   | a[0]                 |
+    | ...    |    ...               |
+    | c[s-2] | ...   a[s(s-1)/2-1]  |
+    +--------+----------------------+
+    |        | b[0] b[1] ... b[s-1] |
+    |        | bh[0]  ...   bh[s-1] |
+    +--------+----------------------+
+    The solution is advanced with the weights @a b (local extrapolation) and
+    the error is estimated with the difference to the embedded solution. If the
+    method has the FSAL (first same as last) property, the last stage of an
+    accepted step is reused as the first stage of the next step. The first
+    stage is only reused when the time and the state of the step are the ones
+    it was computed with, see also ResetFirstStage(). */
+class EmbeddedRKSolver : public AdaptiveODESolver
+{
+private:
+   int s, err_order;
+   const double *a, *b, *bh, *c;
+   bool fsal, k0_valid;
+   double t_k0;     // time of the first stage k[0], if k0_valid
+   Vector x_k0;     // state of the first stage k[0], if k0_valid
+   Vector y, *k;
+   Array<double> e; // e = b - bh
+
+   /// Is @a x equal to #x_k0 (on all processors)?
+   bool SameState(const Vector &x);
+
+protected:
+   void TrialStep(const Vector &x, double t, double dt, Vector &x1,
+                  Vector &e1) override;
+
+   void AcceptStep(const Vector &x1, double t1) override;
+
+   int GetErrorOrder() const override { return err_order; }
+
+public:
+   /** @brief Construct the solver for the given tableau, where @a q is the
+       order of the embedded method (the order of the error estimate). */
+   EmbeddedRKSolver(int _s, int q, const double *_a, const double *_b,
+                    const double *_bh, const double *_c, bool _fsal);
+
+#ifdef MFEM_USE_MPI
+   EmbeddedRKSolver(MPI_Comm comm, int _s, int q, const double *_a,
+                    const double *_b, const double *_bh, const double *_c,
+                    bool _fsal);
+#endif
+
+   void Init(TimeDependentOperator &_f) override;
+
+   /** @brief Evaluate the first stage in the next step instead of reusing a
+       stored one, e.g. after changing the parameters of the operator. */
+   void ResetFirstStage() { k0_valid = false; }
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/** The 4-stage, 3rd order Bogacki-Shampine pair with an embedded 2nd order
+    method (FSAL). */
+class BogackiShampineSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], bh[4], c[3];
+
+public:
+   BogackiShampineSolver() : EmbeddedRKSolver(4, 2, a, b, bh, c, true) { }
+#ifdef MFEM_USE_MPI
+   BogackiShampineSolver(MPI_Comm comm)
+      : EmbeddedRKSolver(comm, 4, 2, a, b, bh, c, true) { }
+#endif
+};
+
+
+/** The 7-stage, 5th order Dormand-Prince pair with an embedded 4th order
+    method (FSAL). */
+class DormandPrinceSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], bh[7], c[6];
+
+public:
+   DormandPrinceSolver() : EmbeddedRKSolver(7, 4, a, b, bh, c, true) { }
+#ifdef MFEM_USE_MPI
+   DormandPrinceSolver(MPI_Comm comm)
+      : EmbeddedRKSolver(comm, 7, 4, a, b, bh, c, true) { }
+#endif
+};
+
+
+/** The 6-stage, 5th order Cash-Karp pair with an embedded 4th order
+    method. */
+class CashKarpSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[15], b[6], bh[6], c[5];
+
+public:
+   CashKarpSolver() : EmbeddedRKSolver(6, 4, a, b, bh, c, false) { }
+#ifdef MFEM_USE_MPI
+   CashKarpSolver(MPI_Comm comm)
+      : EmbeddedRKSolver(comm, 6, 4, a, b, bh, c, false) { }
+#endif
+};
+
 
 /** An explicit Adams-Bashforth method. */
 class AdamsBashforthSolver : public ODESolver
@@ -501,6 +722,100 @@ public:
    virtual void Step(Vector &x, double &t, double &dt);
 };
 
+/** @brief An additive implicit-explicit (IMEX) Runge-Kutta method for ODEs
+    with the split right-hand side f(x,t) = f1(x,t) + f2(x,t), where f1 is
+    treated explicitly and the stiff term f2 implicitly.
+
+    The terms are accessed through the evaluation mode of the associated
+    TimeDependentOperator, see TimeDependentOperator::SetEvalMode(), following
+    the convention of the IMEX mode of ARKStepSolver:
+    - TimeDependentOperator::ADDITIVE_TERM_1: Mult() evaluates f1.
+    - TimeDependentOperator::ADDITIVE_TERM_2: ImplicitSolve() solves the stage
+      equation k = f2(x + dt k, t) and Mult() evaluates f2. The latter is only
+      used by methods with an explicit first implicit stage which contributes
+      to the later stages, e.g. the ARK methods of Kennedy and Carpenter.
+    The evaluation mode of the operator is restored at the end of each step.
+
+    The two s-stage Butcher tableaux share the nodes @a c (s entries). The
+    explicit matrix @a ae is strictly lower triangular and the implicit matrix
+    @a ai is lower triangular; both are stored packed by rows:
+    +--------+---------------------+     +--------+-----------------------+
+    | c[0]   |                     |     | c[0]   | ai[0]                 |
+    | c[1]   | ae[0]               |     | c[1]   | ai[1]  ai[2]          |
+    | ...    |   ...               |     | ...    |   ...                 |
+    | c[s-1] | ... ae[s(s-1)/2-1]  |     | c[s-1] | ...   ai[s(s+1)/2-1]  |
+    +--------+---------------------+     +--------+-----------------------+
+    |        | be[0] ...  be[s-1]  |     |        | bi[0]  ...   bi[s-1]  |
+    +--------+---------------------+     +--------+-----------------------+ */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *ae, *be, *ai, *bi, *c;
+   Vector y, *ke, *ki;
+   Array<bool> need_ke, need_ki; // are the stage derivatives used later?
+
+public:
+   IMEXRKSolver(int _s, const double *_ae, const double *_be,
+                const double *_ai, const double *_bi, const double *_c);
+
+   void Init(TimeDependentOperator &_f) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The 3-stage, 2nd order IMEX method ARS(2,3,2) of Ascher, Ruuth and Spiteri,
+    "Implicit-explicit Runge-Kutta methods for time-dependent partial
+    differential equations", 1997. The implicit method is L-stable. */
+class ARS232Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[3], be[3], ai[6], bi[3], c[3];
+
+public:
+   ARS232Solver() : IMEXRKSolver(3, ae, be, ai, bi, c) { }
+};
+
+
+/** The 5-stage, 3rd order IMEX method ARS(4,4,3) of Ascher, Ruuth and Spiteri.
+    The implicit method is L-stable. */
+class ARS443Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[10], be[5], ai[15], bi[5], c[5];
+
+public:
+   ARS443Solver() : IMEXRKSolver(5, ae, be, ai, bi, c) { }
+};
+
+
+/** The 4-stage, 3rd order IMEX method ARK3(2)4L[2]SA of Kennedy and Carpenter,
+    "Additive Runge-Kutta schemes for convection-diffusion-reaction equations",
+    2003. The implicit method is an L-stable, stiffly accurate ESDIRK method. */
+class ARK3Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[6], b[4], ai[10], c[4];
+
+public:
+   ARK3Solver() : IMEXRKSolver(4, ae, b, ai, b, c) { }
+};
+
+
+/** The 6-stage, 4th order IMEX method ARK4(3)6L[2]SA of Kennedy and Carpenter.
+    The implicit method is an L-stable, stiffly accurate ESDIRK method. */
+class ARK4Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[15], b[6], ai[21], c[6];
+
+public:
+   ARK4Solver() : IMEXRKSolver(6, ae, b, ai, b, c) { }
+};
+
 
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier-Stokes equations with a stabilized finite element
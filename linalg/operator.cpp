@@ -19,6 +19,16 @@
 namespace mfem
 {
 
+void Operator::ArrayMult(const Array<const Vector *> &X,
+                         Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "incompatible arrays of Vectors");
+   for (int i = 0; i < X.Size(); i++)
+   {
+      Mult(*X[i], *Y[i]);
+   }
+}
+
 void Operator::InitTVectors(const Operator *Po, const Operator *Ri,
                             const Operator *Pi,
                             Vector &x, Vector &b,
@@ -358,6 +368,51 @@ RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
 }
 
 
+// Make sure that V contains at least k vectors of size n. The vectors are
+// allocated on first use and reused by subsequent calls.
+static void GetWorkVectors(Array<Vector *> &V, int k, int n, MemoryType mt)
+{
+   for (int i = V.Size(); i < k; i++)
+   {
+      V.Append(new Vector(n, mt));
+   }
+}
+
+static void DeleteWorkVectors(Array<Vector *> &V)
+{
+   for (int i = 0; i < V.Size(); i++) { delete V[i]; }
+   V.SetSize(0);
+}
+
+void RAPOperator::ArrayMult(const Array<const Vector *> &X,
+                            Array<Vector *> &Y) const
+{
+   const int k = X.Size();
+   MFEM_ASSERT(Y.Size() == k, "incompatible arrays of Vectors");
+   const MemoryType mem_type = Px.GetMemory().GetMemoryType();
+   GetWorkVectors(PX_work, k, P.Height(), mem_type);
+   GetWorkVectors(APX_work, k, A.Height(), mem_type);
+   PX_view.SetSize(k);
+   APX_view.SetSize(k);
+   for (int i = 0; i < k; i++)
+   {
+      P.Mult(*X[i], *PX_work[i]);
+      PX_view[i] = PX_work[i];
+      APX_view[i] = APX_work[i];
+   }
+   A.ArrayMult(PX_view, APX_view);
+   for (int i = 0; i < k; i++)
+   {
+      Rt.MultTranspose(*APX_view[i], *Y[i]);
+   }
+}
+
+RAPOperator::~RAPOperator()
+{
+   DeleteWorkVectors(PX_work);
+   DeleteWorkVectors(APX_work);
+}
+
 TripleProductOperator::TripleProductOperator(
    const Operator *A, const Operator *B, const Operator *C,
    bool ownA, bool ownB, bool ownC)
@@ -492,6 +547,59 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void ConstrainedOperator::ArrayMult(const Array<const Vector *> &X,
+                                    Array<Vector *> &Y) const
+{
+   const int k = X.Size();
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->ArrayMult(X, Y);
+      return;
+   }
+   if (diag_policy != DIAG_ONE && diag_policy != DIAG_ZERO)
+   {
+      // Same result as Mult() for the other policies
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+
+   auto idx = constraint_list.Read();
+   GetWorkVectors(Z_work, k, height, z.GetMemory().GetMemoryType());
+   Z_view.SetSize(k);
+   for (int i = 0; i < k; i++)
+   {
+      Vector &Zi = *Z_work[i];
+      Zi.UseDevice(true);
+      Zi = *X[i];
+      // Use read+write access - we are modifying sub-vector of Zi
+      auto d_z = Zi.ReadWrite();
+      MFEM_FORALL(j, csz, d_z[idx[j]] = 0.0;);
+      Z_view[i] = &Zi;
+   }
+
+   A->ArrayMult(Z_view, Y);
+
+   const bool diag_one = (diag_policy == DIAG_ONE);
+   for (int i = 0; i < k; i++)
+   {
+      auto d_x = X[i]->Read();
+      // Use read+write access - we are modifying sub-vector of Y[i]
+      auto d_y = Y[i]->ReadWrite();
+      MFEM_FORALL(j, csz,
+      {
+         const int id = idx[j];
+         d_y[id] = diag_one ? d_x[id] : 0.0;
+      });
+   }
+}
+
+ConstrainedOperator::~ConstrainedOperator()
+{
+   DeleteWorkVectors(Z_work);
+   if (own_A) { delete A; }
+}
+
 RectangularConstrainedOperator::RectangularConstrainedOperator(
    Operator *A,
    const Array<int> &trial_list,
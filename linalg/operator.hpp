@@ -92,6 +92,14 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Operator application on a set of vectors: `Y[i]=A(X[i])`.
+
+       The default implementation calls Mult() for every vector. Derived classes
+       can override this method to apply the operator to all vectors at once,
+       e.g. reading the operator data only once. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -746,6 +754,11 @@ private:
    const Operator & P;
    mutable Vector Px;
    mutable Vector APx;
+   /// Work vectors for ArrayMult(), allocated on first use and reused.
+   mutable Array<Vector *> PX_work, APX_work;
+   /// The first vectors of #PX_work and #APX_work used by ArrayMult().
+   mutable Array<const Vector *> PX_view;
+   mutable Array<Vector *> APX_view;
    MemoryClass mem_class;
 
 public:
@@ -758,9 +771,15 @@ public:
    virtual void Mult(const Vector & x, Vector & y) const
    { P.Mult(x, Px); A.Mult(Px, APx); Rt.MultTranspose(APx, y); }
 
+   /// Operator application on a set of vectors, using ArrayMult() of A.
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /// Application of the transpose.
    virtual void MultTranspose(const Vector & x, Vector & y) const
    { Rt.Mult(x, APx); A.MultTranspose(APx, Px); P.MultTranspose(Px, y); }
+
+   virtual ~RAPOperator();
 };
 
 
@@ -803,6 +822,9 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   /// Auxiliary vectors for ArrayMult(), allocated on first use and reused.
+   mutable Array<Vector *> Z_work;
+   mutable Array<const Vector *> Z_view; ///< The first vectors of #Z_work.
    MemoryClass mem_class;
    DiagonalPolicy diag_policy;  ///< Diagonal policy for constrained dofs
 
@@ -846,8 +868,15 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Constrained operator action on a set of vectors, using
+       ArrayMult() of the unconstrained Operator.
+
+       With the policy #DIAG_KEEP, Mult() is applied to each vector. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /// Destructor: destroys the unconstrained Operator, if owned.
-   virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
+   virtual ~ConstrainedOperator();
 };
 
 /** @brief Rectangular Operator for imposing essential boundary conditions on
@@ -17,6 +17,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <set>
 
 namespace mfem
@@ -99,7 +100,7 @@ void IterativeSolver::SetOperator(const Operator &op)
    oper = &op;
    height = op.Height();
    width = op.Width();
-   if (prec)
+   if (prec && update_prec)
    {
       prec->SetOperator(*oper);
    }
@@ -1549,205 +1550,1830 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
-void NewtonSolver::SetOperator(const Operator &op)
+void DeflatedCGSolver::UpdateVectors()
 {
-   oper = &op;
-   height = op.Height();
-   width = op.Width();
-   MFEM_ASSERT(height == width, "square Operator is required.");
-
    r.SetSize(width);
-   c.SetSize(width);
+   d.SetSize(width);
+   z.SetSize(width);
 }
 
-void NewtonSolver::Mult(const Vector &b, Vector &x) const
+void DeflatedCGSolver::SetOperator(const Operator &op)
 {
-   MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
-   MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
+   IterativeSolver::SetOperator(op);
+   UpdateVectors();
+   if (W.Size() > 0 && W[0]->Size() != width) { ClearDeflationSpace(); }
+   update_AW = (W.Size() > 0);
+}
 
-   int it;
-   double norm0, norm, norm_goal;
-   const bool have_b = (b.Size() == Height());
+void DeflatedCGSolver::ClearDeflationSpace()
+{
+   for (int i = 0; i < W.Size(); i++) { delete W[i]; delete AW[i]; }
+   for (int i = 0; i < P.Size(); i++) { delete P[i]; delete AP[i]; }
+   W.SetSize(0);
+   AW.SetSize(0);
+   P.SetSize(0);
+   AP.SetSize(0);
+   num_harvested = 0;
+   update_AW = false;
+}
 
-   ProcessNewState(x);
+void DeflatedCGSolver::SetupDeflation() const
+{
+   for (int i = 0; i < W.Size(); i++)
+   {
+      oper->Mult(*W[i], *AW[i]);
+   }
+   FactorDeflation();
+}
 
-   if (!iterative_mode)
+void DeflatedCGSolver::FactorDeflation() const
+{
+   const int k = W.Size();
+   if (k == 0) { return; }
+   E.SetSize(k);
+   for (int j = 0; j < k; j++)
    {
-      x = 0.0;
+      for (int i = 0; i <= j; i++)
+      {
+         E(i,j) = E(j,i) = 0.5*(Dot(*W[i], *AW[j]) + Dot(*W[j], *AW[i]));
+      }
    }
+   E_inv.Factor(E);
+   mu.SetSize(k);
+   Wz.SetSize(k);
+}
 
-   oper->Mult(x, r);
-   if (have_b)
+void DeflatedCGSolver::Deflate(Vector &d) const
+{
+   const int k = W.Size();
+   if (k == 0) { return; }
+   for (int i = 0; i < k; i++)
    {
-      r -= b;
+      Wz(i) = Dot(*AW[i], d);
+   }
+   E_inv.Mult(Wz, mu);
+   for (int i = 0; i < k; i++)
+   {
+      d.Add(-mu(i), *W[i]);
    }
+}
 
-   norm0 = norm = Norm(r);
-   norm_goal = std::max(rel_tol*norm, abs_tol);
+void DeflatedCGSolver::UpdateDeflationSpace() const
+{
+   const int k = W.Size(), l = num_harvested, n = k + l;
+   if (n == 0 || defl_dim <= 0) { return; }
 
-   prec->iterative_mode = false;
+   Array<Vector *> Z(n), AZ(n);
+   for (int i = 0; i < k; i++) { Z[i] = W[i]; AZ[i] = AW[i]; }
+   for (int i = 0; i < l; i++) { Z[k+i] = P[i]; AZ[k+i] = AP[i]; }
 
-   // x_{i+1} = x_i - [DF(x_i)]^{-1} [F(x_i)-b]
-   for (it = 0; true; it++)
+   // Rayleigh-Ritz for B A in the A-inner product over span(Z):
+   //    (A Z)^t B (A Z) y = theta (Z^t A Z) y
+   DenseMatrix G(n), H(n);
+   for (int j = 0; j < n; j++)
    {
-      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
-      if (print_level >= 0)
-      {
-         mfem::out << "Newton iteration " << setw(2) << it
-                   << " : ||r|| = " << norm;
-         if (it > 0)
-         {
-            mfem::out << ", ||r||/||r_0|| = " << norm/norm0;
-         }
-         mfem::out << '\n';
-      }
-      Monitor(it, norm, r, x);
-
-      if (norm <= norm_goal)
+      if (prec)
       {
-         converged = 1;
-         break;
+         prec->Mult(*AZ[j], z);
       }
-
-      if (it >= max_iter)
+      else
       {
-         converged = 0;
-         break;
+         z = *AZ[j];
       }
-
-      prec->SetOperator(oper->GetGradient(x));
-
-      prec->Mult(r, c);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
-
-      const double c_scale = ComputeScalingFactor(x, b);
-      if (c_scale == 0.0)
+      for (int i = 0; i < n; i++)
       {
-         converged = 0;
-         break;
+         G(i,j) = Dot(*Z[i], *AZ[j]);
+         H(i,j) = Dot(*AZ[i], z);
       }
-      add(x, -c_scale, c, x);
-
-      ProcessNewState(x);
-
-      oper->Mult(x, r);
-      if (have_b)
+   }
+   G.Symmetrize();
+   H.Symmetrize();
+
+   // The vectors in Z may be (nearly) linearly dependent, e.g. when the search
+   // directions of the last solve are close to span(W), so G is only positive
+   // semidefinite. Reduce Z to an A-orthonormal basis Z T of span(Z), dropping
+   // the directions with a relatively small eigenvalue of G, and solve the
+   // standard eigenproblem (T^t H T) y = theta y.
+   Vector g_ev;
+   DenseMatrix V;
+   G.Eigensystem(g_ev, V);
+   const double g_tol = 1e-10*g_ev.Max();
+   int m = 0;
+   for (int i = 0; i < n; i++) { if (g_ev(i) > g_tol) { m++; } }
+   DenseMatrix T(n, m);
+   for (int i = 0, c = 0; i < n; i++)
+   {
+      if (g_ev(i) <= g_tol) { continue; }
+      const double s = 1.0/sqrt(g_ev(i));
+      for (int j = 0; j < n; j++) { T(j,c) = s*V(j,i); }
+      c++;
+   }
+   DenseMatrix HT(n, m), H_red(m), Y_red, Y(n, m);
+   mfem::Mult(H, T, HT);
+   MultAtB(T, HT, H_red);
+   H_red.Symmetrize();
+
+   if (m > 0)
+   {
+      Vector theta;
+      H_red.Eigensystem(theta, Y_red);
+      mfem::Mult(T, Y_red, Y);
+   }
+
+   // The new deflation space is spanned by the Ritz vectors corresponding to
+   // the smallest Ritz values.
+   const int k_new = std::min(defl_dim, m);
+   Array<Vector *> W_new(k_new), AW_new(k_new);
+   for (int j = 0; j < k_new; j++)
+   {
+      W_new[j] = new Vector(width);
+      AW_new[j] = new Vector(width);
+      *W_new[j] = 0.0;
+      *AW_new[j] = 0.0;
+      for (int i = 0; i < n; i++)
       {
-         r -= b;
+         W_new[j]->Add(Y(i,j), *Z[i]);
+         AW_new[j]->Add(Y(i,j), *AZ[i]);
       }
-      norm = Norm(r);
    }
+   for (int i = 0; i < k; i++) { delete W[i]; delete AW[i]; }
+   W_new.Copy(W);
+   AW_new.Copy(AW);
+   num_harvested = 0;
 
-   final_iter = it;
-   final_norm = norm;
+   FactorDeflation();
 }
 
-void LBFGSSolver::Mult(const Vector &b, Vector &x) const
+void DeflatedCGSolver::Mult(const Vector &b, Vector &x) const
 {
-   MFEM_VERIFY(oper != NULL, "the Operator is not set (use SetOperator).");
-
-   // Quadrature points that are checked for negative Jacobians etc.
-   Vector sk, rk, yk, rho, alpha;
-   DenseMatrix skM(width, m), ykM(width, m);
-
-   // r - r_{k+1}, c - descent direction
-   sk.SetSize(width);    // x_{k+1}-x_k
-   rk.SetSize(width);    // nabla(f(x_{k}))
-   yk.SetSize(width);    // r_{k+1}-r_{k}
-   rho.SetSize(m);       // 1/(dot(yk,sk)
-   alpha.SetSize(m);     // rhok*sk'*c
-   int last_saved_id = -1;
+   int i;
+   double r0, den, nom, nom0, betanom, alpha, beta;
 
-   int it;
-   double norm0, norm, norm_goal;
-   const bool have_b = (b.Size() == Height());
+   if (update_AW)
+   {
+      SetupDeflation();
+      update_AW = false;
+   }
 
-   if (!iterative_mode)
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
    {
+      r = b;
       x = 0.0;
    }
 
-   // r = F(x)-b
-   oper->Mult(x, r);
-   if (have_b) { r -= b; }
+   // Initial guess from the deflation space: x = x + W E^{-1} W^t r
+   for (i = 0; i < W.Size(); i++)
+   {
+      Wz(i) = Dot(*W[i], r);
+   }
+   if (W.Size() > 0)
+   {
+      E_inv.Mult(Wz, mu);
+      for (i = 0; i < W.Size(); i++)
+      {
+         x.Add(mu(i), *W[i]);
+         r.Add(-mu(i), *AW[i]);
+      }
+   }
 
-   c = r;           // initial descent direction
+   // Allocate the storage for the search directions used to update W
+   const int l = (defl_dim > 0) ? harvest : 0;
+   for (i = P.Size(); i < l; i++)
+   {
+      P.Append(new Vector(width));
+      AP.Append(new Vector(width));
+   }
+   num_harvested = 0;
 
-   norm0 = norm = Norm(r);
-   norm_goal = std::max(rel_tol*norm, abs_tol);
-   for (it = 0; true; it++)
+   if (prec)
+   {
+      prec->Mult(r, z); // z = B r
+      d = z;
+   }
+   else
+   {
+      d = r;
+   }
+   Deflate(d);
+   nom0 = nom = Dot(d, r);
+   MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, nom, r, x);
+
+   if (nom < 0.0)
    {
-      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
       if (print_level >= 0)
       {
-         mfem::out << "LBFGS iteration " <<  it
-                   << " : ||r|| = " << norm;
-         if (it > 0)
-         {
-            mfem::out << ", ||r||/||r_0|| = " << norm/norm0;
-         }
-         mfem::out << '\n';
+         mfem::out << "DCG: The preconditioner is not positive definite. (Br, r) = "
+                   << nom << '\n';
       }
+      converged = 0;
+      final_iter = 0;
+      final_norm = nom;
+      return;
+   }
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (nom <= r0)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+      return;
+   }
 
-      if (norm <= norm_goal)
+   oper->Mult(d, z);  // z = A d
+   den = Dot(z, d);
+   MFEM_ASSERT(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
+   {
+      if (Dot(d, d) > 0.0 && print_level >= 0)
       {
-         converged = 1;
-         break;
+         mfem::out << "DCG: The operator is not positive definite. (Ad, d) = "
+                   << den << '\n';
       }
+      converged = 0;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+      return;
+   }
 
-      if (it >= max_iter)
+   // start iteration
+   converged = 0;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      if (num_harvested < l)
       {
-         converged = 0;
-         break;
+         // store the A-normalized search direction and its image
+         P[num_harvested]->Set(1.0/sqrt(den), d);
+         AP[num_harvested]->Set(1.0/sqrt(den), z);
+         num_harvested++;
       }
 
-      rk = r;
-      const double c_scale = ComputeScalingFactor(x, b);
-      if (c_scale == 0.0)
+      alpha = nom/den;
+      add(x,  alpha, d, x);     //  x = x + alpha d
+      add(r, -alpha, z, r);     //  r = r - alpha A d
+
+      if (prec)
+      {
+         prec->Mult(r, z);      //  z = B r
+         betanom = Dot(r, z);
+      }
+      else
+      {
+         betanom = Dot(r, r);
+      }
+      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      if (betanom < 0.0)
       {
+         if (print_level >= 0)
+         {
+            mfem::out << "DCG: The preconditioner is not positive definite. (Br, r) = "
+                      << betanom << '\n';
+         }
          converged = 0;
+         final_iter = i;
          break;
       }
-      add(x, -c_scale, c, x); // x_{k+1} = x_k - c_scale*c
-
-      ProcessNewState(x);
 
-      oper->Mult(x, r);
-      if (have_b)
+      if (print_level == 1)
       {
-         r -= b;
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << '\n';
       }
 
-      // LBFGS - construct descent direction
-      subtract(r, rk, yk);   // yk = r_{k+1} - r_{k}
-      sk = c; sk *= -c_scale; //sk = x_{k+1} - x_{k} = -c_scale*c
-      const double gamma = Dot(sk, yk)/Dot(yk, yk);
-
-      // Save last m vectors
-      last_saved_id = (last_saved_id == m-1) ? 0 : last_saved_id+1;
-      skM.SetCol(last_saved_id, sk);
-      ykM.SetCol(last_saved_id, yk);
+      Monitor(i, betanom, r, x);
 
-      c = r;
-      for (int i = last_saved_id; i > -1; i--)
-      {
-         skM.GetColumn(i, sk);
-         ykM.GetColumn(i, yk);
-         rho(i) = 1./Dot(sk, yk);
-         alpha(i) = rho(i)*Dot(sk,c);
-         add(c, -alpha(i), yk, c);
-      }
-      if (it > m-1)
+      if (betanom <= r0)
       {
-         for (int i = m-1; i > last_saved_id; i--)
+         if (print_level == 2)
          {
-            skM.GetColumn(i, sk);
-            ykM.GetColumn(i, yk);
-            rho(i) = 1./Dot(sk, yk);
-            alpha(i) = rho(i)*Dot(sk,c);
-            add(c, -alpha(i), yk, c);
+            mfem::out << "Number of DCG iterations: " << i << '\n';
          }
-      }
-
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << betanom << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      if (prec)
+      {
+         add(z, beta, d, d);   //  d = z + beta d
+      }
+      else
+      {
+         add(r, beta, d, d);
+      }
+      Deflate(d);             //  d = d - W E^{-1} (A W)^t d
+      oper->Mult(d, z);       //  z = A d
+      den = Dot(d, z);
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (Dot(d, d) > 0.0 && print_level >= 0)
+         {
+            mfem::out << "DCG: The operator is not positive definite. (Ad, d) = "
+                      << den << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      nom = betanom;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << nom0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                   << betanom << '\n';
+      }
+      mfem::out << "DCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (betanom/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+
+   UpdateDeflationSpace();
+}
+
+
+void GCROSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   if (U.Size() > 0 && U[0]->Size() != width) { ClearRecycledSpace(); }
+   update_C = (U.Size() > 0);
+}
+
+void GCROSolver::ClearRecycledSpace()
+{
+   for (int i = 0; i < U.Size(); i++) { delete U[i]; delete C[i]; }
+   U.SetSize(0);
+   C.SetSize(0);
+   update_C = false;
+}
+
+void GCROSolver::SetupRecycledSpace() const
+{
+   // Modified Gram-Schmidt on C = A U, applying the same operations to U
+   Array<Vector *> U_old(U), C_old(C);
+   U.SetSize(0);
+   C.SetSize(0);
+   for (int i = 0; i < U_old.Size(); i++)
+   {
+      oper->Mult(*U_old[i], *C_old[i]);
+      const double nrm0 = Norm(*C_old[i]);
+      for (int j = 0; j < C.Size(); j++)
+      {
+         const double a = Dot(*C[j], *C_old[i]);
+         C_old[i]->Add(-a, *C[j]);
+         U_old[i]->Add(-a, *U[j]);
+      }
+      const double nrm = Norm(*C_old[i]);
+      if (nrm <= 1e-12*nrm0 || nrm == 0.0)
+      {
+         // linearly dependent direction
+         delete U_old[i];
+         delete C_old[i];
+         continue;
+      }
+      *U_old[i] /= nrm;
+      *C_old[i] /= nrm;
+      U.Append(U_old[i]);
+      C.Append(C_old[i]);
+   }
+}
+
+void GCROSolver::AddRecycledPair(Vector *u, Vector *c) const
+{
+   if (recycle_dim <= 0)
+   {
+      delete u;
+      delete c;
+      return;
+   }
+   while (U.Size() >= recycle_dim)
+   {
+      // drop the oldest pair
+      delete U[0];
+      delete C[0];
+      for (int i = 1; i < U.Size(); i++)
+      {
+         U[i-1] = U[i];
+         C[i-1] = C[i];
+      }
+      U.DeleteLast();
+      C.DeleteLast();
+   }
+   U.Append(u);
+   C.Append(c);
+}
+
+void GCROSolver::Mult(const Vector &b, Vector &x) const
+{
+   // GCRO with right preconditioning: the inner GMRES method is applied to the
+   // operator (I - C C^t) A B, and each inner cycle adds its correction to the
+   // outer space. The outer space consists of the recycled space, (U, C), and
+   // the corrections of the inner cycles of this solve, (Uc, Cc).
+
+   const int n = width;
+
+   if (update_C)
+   {
+      SetupRecycledSpace();
+      update_C = false;
+   }
+
+   DenseMatrix H(m+1, m);
+   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector r(n), w(n), r_old(n), x0(n), r0(n);
+   Array<Vector *> v(m+1), zv(prec ? m : 0), Uc, Cc;
+   v = NULL;
+   zv = NULL;
+
+   int i = 0, j = 1, k;
+   double beta, resid = 0.0, tol;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r);
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   beta = Norm(r);
+   MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+   tol = std::max(rel_tol*beta, abs_tol);
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  ||r|| = " << beta << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, beta, r, x);
+
+   // Initial guess from the recycled space
+   for (k = 0; k < C.Size(); k++)
+   {
+      const double a = Dot(*C[k], r);
+      x.Add(a, *U[k]);
+      r.Add(-a, *C[k]);
+   }
+   x0 = x;
+   r0 = r;
+
+   converged = 0;
+   final_iter = max_iter;
+   while (true)
+   {
+      // Outer GCR step: minimize the residual over the outer space
+      const int nr = C.Size(), nc = nr + Cc.Size();
+      for (k = 0; k < nc; k++)
+      {
+         const Vector &c_k = (k < nr) ? *C[k] : *Cc[k-nr];
+         const Vector &u_k = (k < nr) ? *U[k] : *Uc[k-nr];
+         const double a = Dot(c_k, r);
+         x.Add(a, u_k);
+         r.Add(-a, c_k);
+      }
+      beta = Norm(r);
+      MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+      if (beta <= tol)
+      {
+         converged = 1;
+         final_iter = j-1;
+         break;
+      }
+      if (j > max_iter) { break; }
+
+      // Inner GMRES cycle on (I - C C^t) A B
+      DenseMatrix Bc(std::max(nc,1), m);
+      if (v[0] == NULL) { v[0] = new Vector(n); }
+      v[0]->Set(1.0/beta, r);
+      s = 0.0; s(0) = beta;
+
+      for (i = 0; i < m && j <= max_iter; i++, j++)
+      {
+         Vector *zi = v[i];
+         if (prec)
+         {
+            if (zv[i] == NULL) { zv[i] = new Vector(n); }
+            zi = zv[i];
+            prec->Mult(*v[i], *zi);   // z_i = B v_i
+         }
+         oper->Mult(*zi, w);          // w = A z_i
+
+         for (k = 0; k < nc; k++)
+         {
+            const Vector &c_k = (k < nr) ? *C[k] : *Cc[k-nr];
+            Bc(k,i) = Dot(w, c_k);
+            w.Add(-Bc(k,i), c_k);
+         }
+         for (k = 0; k <= i; k++)
+         {
+            H(k,i) = Dot(w, *v[k]);
+            w.Add(-H(k,i), *v[k]);
+         }
+
+         H(i+1,i) = Norm(w);
+         MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
+         if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
+         v[i+1]->Set(1.0/H(i+1,i), w);
+
+         for (k = 0; k < i; k++)
+         {
+            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+         }
+         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+
+         resid = fabs(s(i+1));
+         MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  ||r|| = " << resid << '\n';
+         }
+         Monitor(j, resid, r, x);
+
+         if (resid <= tol) { i++; j++; break; }
+      }
+      if (i == 0) { break; }
+
+      // Backsolve for the coefficients y of the correction
+      Vector y(s.GetData(), i);
+      for (int l = i-1; l >= 0; l--)
+      {
+         y(l) /= H(l,l);
+         for (k = l-1; k >= 0; k--)
+         {
+            y(k) -= H(k,l) * y(l);
+         }
+      }
+
+      // Correction u = Z y - U (Bc y)
+      Vector *u = new Vector(n);
+      *u = 0.0;
+      for (k = 0; k < i; k++)
+      {
+         u->Add(y(k), prec ? *zv[k] : *v[k]);
+      }
+      for (k = 0; k < nc; k++)
+      {
+         double a = 0.0;
+         for (int l = 0; l < i; l++) { a += Bc(k,l)*y(l); }
+         u->Add(-a, (k < nr) ? *U[k] : *Uc[k-nr]);
+      }
+      x += *u;
+
+      // Recompute the true residual; the new outer direction is c = A u,
+      // computed as c = r_old - r and orthonormalized against C and Cc.
+      r_old = r;
+      oper->Mult(x, r);
+      subtract(b, r, r);
+      Vector *c = new Vector(n);
+      subtract(r_old, r, *c);
+      for (k = 0; k < nc; k++)
+      {
+         const Vector &c_k = (k < nr) ? *C[k] : *Cc[k-nr];
+         const double a = Dot(c_k, *c);
+         c->Add(-a, c_k);
+         u->Add(-a, (k < nr) ? *U[k] : *Uc[k-nr]);
+      }
+      const double c_nrm = Norm(*c);
+      if (c_nrm > 0.0 && Cc.Size() < std::max(recycle_dim, 1))
+      {
+         *u /= c_nrm;
+         *c /= c_nrm;
+         Uc.Append(u);
+         Cc.Append(c);
+      }
+      else
+      {
+         delete u;
+         delete c;
+      }
+
+      if (print_level == 1 && j <= max_iter)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+   }
+   final_iter = std::min(final_iter, max_iter);
+   final_norm = beta;
+
+   // Update the recycled space with the total correction of this solve:
+   // u = x - x0, c = A u = r0 - r, orthonormalized against C.
+   if (recycle_dim > 0 && Cc.Size() > 0)
+   {
+      Vector *u = new Vector(n), *c = new Vector(n);
+      subtract(x, x0, *u);
+      subtract(r0, r, *c);
+      for (k = 0; k < C.Size(); k++)
+      {
+         const double a = Dot(*C[k], *c);
+         c->Add(-a, *C[k]);
+         u->Add(-a, *U[k]);
+      }
+      const double c_nrm = Norm(*c);
+      if (c_nrm > 0.0)
+      {
+         *u /= c_nrm;
+         *c /= c_nrm;
+         AddRecycledPair(u, c);
+      }
+      else
+      {
+         delete u;
+         delete c;
+      }
+   }
+   for (i = 0; i < Uc.Size(); i++) { delete Uc[i]; delete Cc[i]; }
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (final_iter-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  ||r|| = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      mfem::out << "GCRO: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "GCRO: No convergence!\n";
+   }
+
+   Monitor(final_iter, final_norm, r, x, true);
+
+   for (i = 0; i < v.Size(); i++) { delete v[i]; }
+   for (i = 0; i < zv.Size(); i++) { delete zv[i]; }
+}
+
+// Orthonormalize the first k vectors in V, using two passes of modified
+// Gram-Schmidt: V_in = V_out S. (Numerically) linearly dependent vectors are
+// dropped: on return the first s entries of V form the orthonormal basis and S
+// is an s x k matrix. Returns s.
+template <typename DotFunction>
+static int BlockOrthonormalize(Array<Vector *> &V, const int k, DenseMatrix &S,
+                               DotFunction dot)
+{
+   const double drop_tol = 1e-10;
+   DenseMatrix T(k);
+   T = 0.0;
+   int s = 0;
+   for (int j = 0; j < k; j++)
+   {
+      Vector &v = *V[j];
+      const double nrm0 = sqrt(dot(v, v));
+      for (int pass = 0; pass < 2; pass++)
+      {
+         for (int i = 0; i < s; i++)
+         {
+            const double h = dot(*V[i], v);
+            T(i,j) += h;
+            v.Add(-h, *V[i]);
+         }
+      }
+      const double nrm = sqrt(dot(v, v));
+      if (nrm > drop_tol*nrm0)
+      {
+         v /= nrm;
+         T(s,j) = nrm;
+         std::swap(V[s], V[j]);
+         s++;
+      }
+   }
+   S.SetSize(s, k);
+   for (int j = 0; j < k; j++)
+   {
+      for (int i = 0; i < s; i++)
+      {
+         S(i,j) = T(i,j);
+      }
+   }
+   return s;
+}
+
+void BlockCGSolver::UpdateVectors(int k) const
+{
+   if (R.Size() == k && (k == 0 || R[0]->Size() == width)) { return; }
+   for (int i = 0; i < R.Size(); i++)
+   {
+      delete R[i];
+      delete Z[i];
+      delete P[i];
+      delete Q[i];
+   }
+   R.SetSize(k);
+   Z.SetSize(k);
+   P.SetSize(k);
+   Q.SetSize(k);
+   for (int i = 0; i < k; i++)
+   {
+      R[i] = new Vector(width);
+      Z[i] = new Vector(width);
+      P[i] = new Vector(width);
+      Q[i] = new Vector(width);
+   }
+}
+
+void BlockCGSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   UpdateVectors(0);
+}
+
+BlockCGSolver::~BlockCGSolver()
+{
+   UpdateVectors(0);
+}
+
+void BlockCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   Array<const Vector *> B(1);
+   Array<Vector *> X(1);
+   B[0] = &b;
+   X[0] = &x;
+   ArrayMult(B, X);
+}
+
+void BlockCGSolver::ArrayMult(const Array<const Vector *> &B,
+                              Array<Vector *> &X) const
+{
+   // Breakdown-free block CG, see Ji and Li, "A breakdown-free block conjugate
+   // gradient method", BIT Numer. Math. 57 (2017).
+   const int k = B.Size();
+   MFEM_VERIFY(X.Size() == k, "incompatible arrays of Vectors");
+   UpdateVectors(k);
+   auto dot = [this](const Vector &u, const Vector &v) { return Dot(u, v); };
+
+   Array<const Vector *> cR(k), cP;
+   Array<Vector *> Qs;
+   for (int j = 0; j < k; j++) { cR[j] = R[j]; }
+
+   if (iterative_mode)
+   {
+      Array<const Vector *> cX(k);
+      for (int j = 0; j < k; j++) { cX[j] = X[j]; }
+      oper->ArrayMult(cX, R);
+      for (int j = 0; j < k; j++)
+      {
+         subtract(*B[j], *R[j], *R[j]); // R = B - A X
+      }
+   }
+   else
+   {
+      for (int j = 0; j < k; j++)
+      {
+         *R[j] = *B[j];
+         *X[j] = 0.0;
+      }
+   }
+
+   Vector nom(k), r0(k);
+   double max_nom;
+   int jmax;
+   bool done;
+   // Compute Z = M R, the (B r, r) norms of all right-hand sides, the largest
+   // of them and check for convergence.
+   auto check_residuals = [&]()
+   {
+      if (prec)
+      {
+         prec->ArrayMult(cR, Z);
+      }
+      else
+      {
+         for (int j = 0; j < k; j++) { *Z[j] = *R[j]; }
+      }
+      max_nom = 0.0;
+      jmax = 0;
+      done = true;
+      for (int j = 0; j < k; j++)
+      {
+         nom(j) = Dot(*Z[j], *R[j]);
+         MFEM_ASSERT(IsFinite(nom(j)), "nom = " << nom(j));
+         if (nom(j) > max_nom) { max_nom = nom(j); jmax = j; }
+         done = done && (nom(j) <= r0(j));
+      }
+      return nom.Min() >= 0.0;
+   };
+
+   r0 = 0.0;
+   if (!check_residuals())
+   {
+      if (print_level >= 0)
+      {
+         mfem::out << "BlockCG: The preconditioner is not positive definite. "
+                   << "(Br, r) = " << nom.Min() << '\n';
+      }
+      converged = 0;
+      final_iter = 0;
+      final_norm = sqrt(max_nom);
+      return;
+   }
+   done = true;
+   for (int j = 0; j < k; j++)
+   {
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+      done = done && (nom(j) <= r0(j));
+   }
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+                << max_nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, max_nom, *R[jmax], *X[jmax]);
+
+   if (done)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(max_nom);
+      return;
+   }
+
+   // P = orth(Z)
+   DenseMatrix S, PtQ, PtR, QtZ, alpha, beta;
+   DenseMatrixInverse PtQ_inv;
+   for (int j = 0; j < k; j++) { *P[j] = *Z[j]; }
+   int s = BlockOrthonormalize(P, k, S, dot);
+
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 1; s > 0; )
+   {
+      cP.SetSize(s);
+      Qs.SetSize(s);
+      for (int l = 0; l < s; l++)
+      {
+         cP[l] = P[l];
+         Qs[l] = Q[l];
+      }
+      oper->ArrayMult(cP, Qs); // Q = A P
+
+      PtQ.SetSize(s);
+      for (int l = 0; l < s; l++)
+      {
+         for (int q = 0; q <= l; q++)
+         {
+            PtQ(q,l) = PtQ(l,q) = 0.5*(Dot(*P[q], *Q[l]) + Dot(*P[l], *Q[q]));
+         }
+         if (PtQ(l,l) <= 0.0)
+         {
+            if (print_level >= 0)
+            {
+               mfem::out << "BlockCG: The operator is not positive definite. "
+                         << "(Ap, p) = " << PtQ(l,l) << '\n';
+            }
+            final_iter = i;
+            final_norm = sqrt(max_nom);
+            return;
+         }
+      }
+      PtQ_inv.Factor(PtQ);
+
+      PtR.SetSize(s, k);
+      for (int j = 0; j < k; j++)
+      {
+         for (int l = 0; l < s; l++)
+         {
+            PtR(l,j) = Dot(*P[l], *R[j]);
+         }
+      }
+      PtQ_inv.Mult(PtR, alpha);
+      for (int j = 0; j < k; j++)
+      {
+         for (int l = 0; l < s; l++)
+         {
+            X[j]->Add(alpha(l,j), *P[l]);  //  X = X + P alpha
+            R[j]->Add(-alpha(l,j), *Q[l]); //  R = R - Q alpha
+         }
+      }
+
+      if (!check_residuals())
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "BlockCG: The preconditioner is not positive "
+                      << "definite. (Br, r) = " << nom.Min() << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                   << max_nom << '\n';
+      }
+
+      Monitor(i, max_nom, *R[jmax], *X[jmax]);
+
+      if (done)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of BlockCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i
+                      << "  max (B r, r) = " << max_nom << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      // P = orth(Z + P beta), beta = -(P^t Q)^{-1} Q^t Z
+      QtZ.SetSize(s, k);
+      for (int j = 0; j < k; j++)
+      {
+         for (int l = 0; l < s; l++)
+         {
+            QtZ(l,j) = Dot(*Q[l], *Z[j]);
+         }
+      }
+      PtQ_inv.Mult(QtZ, beta);
+      for (int j = 0; j < k; j++)
+      {
+         for (int l = 0; l < s; l++)
+         {
+            Z[j]->Add(-beta(l,j), *P[l]);
+         }
+      }
+      for (int j = 0; j < k; j++) { std::swap(P[j], Z[j]); }
+      s = BlockOrthonormalize(P, k, S, dot);
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BlockCG: No convergence!\n";
+   }
+   final_norm = sqrt(max_nom);
+}
+
+void BlockGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   Array<const Vector *> B(1);
+   Array<Vector *> X(1);
+   B[0] = &b;
+   X[0] = &x;
+   ArrayMult(B, X);
+}
+
+void BlockGMRESSolver::ArrayMult(const Array<const Vector *> &B,
+                                 Array<Vector *> &X) const
+{
+   // Block GMRES with left preconditioning. The block upper Hessenberg matrix
+   // is reduced to triangular form with Givens rotations, eliminating the s
+   // subdiagonals of each column.
+   const int k = B.Size();
+   const int n = width;
+   MFEM_VERIFY(X.Size() == k, "incompatible arrays of Vectors");
+   auto dot = [this](const Vector &u, const Vector &v) { return Dot(u, v); };
+
+   Array<Vector *> R(k), T(k), V;
+   Array<const Vector *> cX(k), cT(k), cV;
+   for (int j = 0; j < k; j++)
+   {
+      R[j] = new Vector(n);
+      T[j] = new Vector(n);
+      cX[j] = X[j];
+      cT[j] = T[j];
+   }
+
+   Vector beta(k), tol(k);
+   // R = M (B - A X) and beta = ||R||
+   auto residuals = [&](bool zero_x)
+   {
+      if (zero_x)
+      {
+         for (int j = 0; j < k; j++)
+         {
+            *X[j] = 0.0;
+            *T[j] = *B[j];
+         }
+      }
+      else
+      {
+         oper->ArrayMult(cX, T);
+         for (int j = 0; j < k; j++)
+         {
+            subtract(*B[j], *T[j], *T[j]);
+         }
+      }
+      if (prec)
+      {
+         prec->ArrayMult(cT, R);
+      }
+      else
+      {
+         for (int j = 0; j < k; j++) { *R[j] = *T[j]; }
+      }
+      for (int j = 0; j < k; j++)
+      {
+         beta(j) = Norm(*R[j]);
+         MFEM_ASSERT(IsFinite(beta(j)), "beta = " << beta(j));
+      }
+   };
+
+   residuals(!iterative_mode);
+   for (int j = 0; j < k; j++)
+   {
+      tol(j) = std::max(rel_tol*beta(j), abs_tol);
+   }
+
+   DenseMatrix H, G, S, Sw, CS, SN;
+   Array<int> act;
+   Array<Vector *> Wb;
+   int j = 1;
+   converged = 0;
+   final_iter = max_iter;
+   final_norm = beta.Max();
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  max ||B r|| = " << final_norm
+                << (print_level == 3 ? " ...\n" : "\n");
+   }
+   Monitor(0, final_norm, *R[0], *X[0]);
+
+   while (true)
+   {
+      // The right-hand sides which have not converged yet
+      act.SetSize(0);
+      for (int a = 0; a < k; a++)
+      {
+         if (beta(a) > tol(a)) { act.Append(a); }
+      }
+      const int na = act.Size();
+      if (na == 0)
+      {
+         converged = 1;
+         final_iter = j-1;
+         break;
+      }
+      if (j > max_iter) { break; }
+
+      // V_0 = orth(R), R = V_0 S
+      for (int i = V.Size(); i < na; i++) { V.Append(new Vector(n)); }
+      for (int a = 0; a < na; a++) { *V[a] = *R[act[a]]; }
+      const int s = BlockOrthonormalize(V, na, S, dot);
+
+      H.SetSize((m+1)*s, m*s);
+      G.SetSize((m+1)*s, na);
+      CS.SetSize(m*s, s);
+      SN.SetSize(m*s, s);
+      H = 0.0;
+      G = 0.0;
+      for (int a = 0; a < na; a++)
+      {
+         for (int l = 0; l < s; l++) { G(l,a) = S(l,a); }
+      }
+
+      int i;
+      bool done = false, breakdown = false;
+      double max_resid = final_norm;
+      for (i = 0; i < m && j <= max_iter && !done && !breakdown; i++, j++)
+      {
+         for (int l = V.Size(); l < (i+2)*s; l++) { V.Append(new Vector(n)); }
+         cV.SetSize(s);
+         Wb.SetSize(s);
+         for (int l = 0; l < s; l++)
+         {
+            cV[l] = V[i*s+l];
+            Wb[l] = V[(i+1)*s+l];
+         }
+         // W = M A V_i
+         if (prec)
+         {
+            Array<Vector *> Ts(s);
+            Array<const Vector *> cTs(s);
+            for (int l = 0; l < s; l++) { Ts[l] = T[l]; cTs[l] = T[l]; }
+            oper->ArrayMult(cV, Ts);
+            prec->ArrayMult(cTs, Wb);
+         }
+         else
+         {
+            oper->ArrayMult(cV, Wb);
+         }
+
+         // Block Arnoldi: orthogonalize W against V_0, ..., V_i and then
+         // orthonormalize it, W = V_{i+1} H_{i+1,i}.
+         for (int l = 0; l < s; l++)
+         {
+            const int c = i*s+l;
+            for (int r = 0; r < (i+1)*s; r++)
+            {
+               H(r,c) = Dot(*Wb[l], *V[r]);
+               Wb[l]->Add(-H(r,c), *V[r]);
+            }
+         }
+         const int sw = BlockOrthonormalize(Wb, s, Sw, dot);
+         for (int l = 0; l < s; l++)
+         {
+            V[(i+1)*s+l] = Wb[l];
+            for (int r = 0; r < sw; r++)
+            {
+               H((i+1)*s+r,i*s+l) = Sw(r,l);
+            }
+         }
+         breakdown = (sw < s);
+
+         // Apply the previous rotations to the new columns and generate the
+         // rotations eliminating their subdiagonal entries.
+         for (int l = 0; l < s; l++)
+         {
+            const int c = i*s+l;
+            for (int cp = 0; cp < c; cp++)
+            {
+               for (int t = 1; t <= s; t++)
+               {
+                  ApplyPlaneRotation(H(cp,c), H(cp+t,c),
+                                     CS(cp,t-1), SN(cp,t-1));
+               }
+            }
+            for (int t = 1; t <= s; t++)
+            {
+               GeneratePlaneRotation(H(c,c), H(c+t,c), CS(c,t-1), SN(c,t-1));
+               ApplyPlaneRotation(H(c,c), H(c+t,c), CS(c,t-1), SN(c,t-1));
+               for (int a = 0; a < na; a++)
+               {
+                  ApplyPlaneRotation(G(c,a), G(c+t,a), CS(c,t-1), SN(c,t-1));
+               }
+            }
+         }
+
+         // The residual norms are given by the last block of rows of G
+         max_resid = 0.0;
+         done = true;
+         for (int a = 0; a < na; a++)
+         {
+            double resid = 0.0;
+            for (int r = (i+1)*s; r < (i+2)*s; r++)
+            {
+               resid += G(r,a)*G(r,a);
+            }
+            resid = sqrt(resid);
+            MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+            max_resid = std::max(max_resid, resid);
+            done = done && (resid <= tol(act[a]));
+         }
+
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  max ||B r|| = " << max_resid << '\n';
+         }
+
+         Monitor(j, max_resid, *R[act[0]], *X[act[0]]);
+      }
+
+      // Update the solutions: X += V Y, where H Y = G (back substitution)
+      const int ns = i*s;
+      for (int a = 0; a < na; a++)
+      {
+         Vector &x = *X[act[a]];
+         Vector y(ns);
+         for (int r = ns-1; r >= 0; r--)
+         {
+            double sum = G(r,a);
+            for (int c = r+1; c < ns; c++) { sum -= H(r,c)*y(c); }
+            y(r) = sum/H(r,r);
+         }
+         for (int r = 0; r < ns; r++) { x.Add(y(r), *V[r]); }
+      }
+      final_norm = max_resid;
+
+      if (done)
+      {
+         converged = 1;
+         final_iter = j-1;
+         break;
+      }
+
+      if (print_level == 1 && j <= max_iter)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+      residuals(false);
+      final_norm = beta.Max();
+   }
+
+   if (print_level == 2)
+   {
+      mfem::out << "BlockGMRES: Number of iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (j-2)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  max ||B r|| = " << final_norm << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BlockGMRES: No convergence!\n";
+   }
+
+   for (int l = 0; l < V.Size(); l++) { delete V[l]; }
+   for (int a = 0; a < k; a++)
+   {
+      delete T[a];
+      delete R[a];
+   }
+}
+
+void IterativeRefinementSolver::InnerSolver::Mult(const Vector &r,
+                                                 Vector &d) const
+{
+   MFEM_VERIFY(ir.prec, "the inner solver is not set");
+   if (!dynamic_cast<const SinglePrecisionSolver *>(ir.prec))
+   {
+      ir.prec->Mult(r, d);
+      return;
+   }
+
+   // Scale the residual to avoid underflow in single precision; the same
+   // scale is used on all processors.
+   const double scale = ir.Norm(r);
+   if (scale == 0.0) { d = 0.0; return; }
+   rs.SetSize(r.Size());
+   rs.Set(1.0/scale, r);
+   ir.prec->Mult(rs, d);
+   d *= scale;
+}
+
+void SinglePrecisionSolver::Mult(const Vector &r, Vector &d) const
+{
+   r_single.SetSize(width);
+   d_single.SetSize(height);
+   const double *h_r = r.HostRead();
+   for (int i = 0; i < width; i++) { r_single[i] = (float)h_r[i]; }
+   MultSingle(r_single.GetData(), d_single.GetData());
+   double *h_d = d.HostWrite();
+   for (int i = 0; i < height; i++) { h_d[i] = d_single[i]; }
+}
+
+void SinglePrecisionDenseSolver::SetOperator(const Operator &op)
+{
+   MFEM_VERIFY(op.Height() == op.Width(), "the matrix must be square");
+   const int n = op.Height();
+   height = width = n;
+   lu.SetSize(n*n);
+   ipiv.SetSize(n);
+
+   // Copy of the matrix in column-major order
+   if (const DenseMatrix *M = dynamic_cast<const DenseMatrix *>(&op))
+   {
+      const double *data = M->Data();
+      for (int k = 0; k < n*n; k++) { lu[k] = (float)data[k]; }
+   }
+   else if (const SparseMatrix *M = dynamic_cast<const SparseMatrix *>(&op))
+   {
+      MFEM_VERIFY(M->Finalized(), "the SparseMatrix must be finalized");
+      const int *I = M->HostReadI(), *J = M->HostReadJ();
+      const double *data = M->HostReadData();
+      lu = 0.0f;
+      for (int i = 0; i < n; i++)
+      {
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            lu[i + J[k]*n] += (float)data[k];
+         }
+      }
+   }
+   else
+   {
+      MFEM_ABORT("the operator must be a DenseMatrix or a SparseMatrix");
+   }
+
+   // LU factorization with partial pivoting, in single precision
+   float *A = lu.GetData();
+   for (int k = 0; k < n; k++)
+   {
+      int p = k;
+      float amax = std::abs(A[k + k*n]);
+      for (int i = k+1; i < n; i++)
+      {
+         const float aik = std::abs(A[i + k*n]);
+         if (aik > amax) { p = i; amax = aik; }
+      }
+      MFEM_VERIFY(amax > 0.0f, "the matrix is singular");
+      ipiv[k] = p;
+      if (p != k)
+      {
+         for (int j = 0; j < n; j++) { std::swap(A[k + j*n], A[p + j*n]); }
+      }
+      const float inv_akk = 1.0f/A[k + k*n];
+      for (int i = k+1; i < n; i++) { A[i + k*n] *= inv_akk; }
+      for (int j = k+1; j < n; j++)
+      {
+         const float akj = A[k + j*n];
+         if (akj == 0.0f) { continue; }
+         for (int i = k+1; i < n; i++) { A[i + j*n] -= A[i + k*n]*akj; }
+      }
+   }
+}
+
+void SinglePrecisionDenseSolver::MultSingle(const float *r, float *d) const
+{
+   const int n = height;
+   const float *A = lu.GetData();
+   for (int i = 0; i < n; i++) { d[i] = r[i]; }
+   for (int k = 0; k < n; k++) { std::swap(d[k], d[ipiv[k]]); }
+   for (int j = 0; j < n; j++)
+   {
+      const float dj = d[j];
+      for (int i = j+1; i < n; i++) { d[i] -= A[i + j*n]*dj; }
+   }
+   for (int j = n-1; j >= 0; j--)
+   {
+      d[j] /= A[j + j*n];
+      const float dj = d[j];
+      for (int i = 0; i < j; i++) { d[i] -= A[i + j*n]*dj; }
+   }
+}
+
+void SinglePrecisionGSSmoother::SetOperator(const Operator &op)
+{
+   const SparseMatrix *M = dynamic_cast<const SparseMatrix *>(&op);
+   MFEM_VERIFY(M && M->Finalized(), "a finalized SparseMatrix is required");
+   MFEM_VERIFY(M->Height() == M->Width(), "the matrix must be square");
+   const int n = M->Height(), nnz = M->NumNonZeroElems();
+   height = width = n;
+   I.SetSize(n+1);
+   J.SetSize(nnz);
+   a.SetSize(nnz);
+   const int *h_I = M->HostReadI(), *h_J = M->HostReadJ();
+   const double *h_a = M->HostReadData();
+   for (int i = 0; i <= n; i++) { I[i] = h_I[i]; }
+   for (int k = 0; k < nnz; k++)
+   {
+      J[k] = h_J[k];
+      a[k] = (float)h_a[k];
+   }
+}
+
+void SinglePrecisionGSSmoother::MultSingle(const float *r, float *d) const
+{
+   const int n = height;
+   for (int i = 0; i < n; i++) { d[i] = 0.0f; }
+   // Relaxation of row i, using the latest values of d
+   auto relax = [&](int i)
+   {
+      float sum = r[i], diag = 0.0f;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] == i) { diag += a[k]; }
+         else { sum -= a[k]*d[J[k]]; }
+      }
+      d[i] = sum/diag;
+   };
+   for (int it = 0; it < iterations; it++)
+   {
+      for (int i = 0; i < n; i++) { relax(i); }
+      for (int i = n-1; i >= 0; i--) { relax(i); }
+   }
+}
+
+IterativeRefinementSolver::IterativeRefinementSolver()
+   : inner(*this)
+{
+   gmres = new GMRESSolver;
+   Init();
+}
+
+#ifdef MFEM_USE_MPI
+IterativeRefinementSolver::IterativeRefinementSolver(MPI_Comm _comm)
+   : IterativeSolver(_comm), inner(*this)
+{
+   gmres = new GMRESSolver(_comm);
+   Init();
+}
+#endif
+
+void IterativeRefinementSolver::Init()
+{
+   mode = final_mode = IR;
+   stall_factor = 0.5;
+   SetGMRESParameters(1e-4, 100, 50);
+   gmres->iterative_mode = false;
+   gmres->SetPrintLevel(-1);
+   gmres->SetPreconditioner(inner);
+}
+
+void IterativeRefinementSolver::SetGMRESParameters(double rtol, int max_it,
+                                                   int kdim)
+{
+   gmres->SetRelTol(rtol);
+   gmres->SetAbsTol(0.0);
+   gmres->SetMaxIter(max_it);
+   gmres->SetKDim(kdim);
+}
+
+void IterativeRefinementSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   gmres->SetOperator(op);
+   r.SetSize(height);
+   rn.SetSize(height);
+   d.SetSize(width);
+}
+
+void IterativeRefinementSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(prec, "the inner solver is not set");
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   const double nom0 = Norm(r);
+   const double r0 = std::max(nom0*rel_tol, abs_tol);
+   double nom = nom0;
+
+   Mode m = mode;
+   converged = 0;
+   int i;
+   for (i = 0; true; i++)
+   {
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  ||r|| = "
+                   << nom << (m == IR ? "" : "  (GMRES-IR)") << '\n';
+      }
+      Monitor(i, nom, r, x);
+      if (nom <= r0) { converged = 1; break; }
+      if (i >= max_iter) { break; }
+
+      // Compute the correction and the new residual in double precision
+      if (m == IR) { inner.Mult(r, d); }
+      else { gmres->Mult(r, d); }
+      add(x, 1.0, d, x);
+      oper->Mult(x, rn);
+      subtract(b, rn, rn); // rn = b - A x
+      const double nom_new = Norm(rn);
+
+      if (nom_new > stall_factor*nom)
+      {
+         if (print_level == 1)
+         {
+            mfem::out << "   Refinement stalled, ||r|| = " << nom_new << '\n';
+         }
+         if (nom_new < nom)
+         {
+            r.Swap(rn);
+            nom = nom_new;
+         }
+         else
+         {
+            add(x, -1.0, d, x); // discard the correction
+         }
+         if (m == GMRES_IR) { i++; break; }
+         m = GMRES_IR;
+         continue;
+      }
+      r.Swap(rn);
+      nom = nom_new;
+   }
+   final_iter = i;
+   final_norm = nom;
+   final_mode = m;
+   Monitor(final_iter, final_norm, r, x, true);
+
+   if (print_level == 2 || print_level == 3)
+   {
+      mfem::out << "Number of IR iterations: " << final_iter
+                << (m == IR ? "" : " (GMRES-IR)") << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "IR: No convergence!" << '\n'
+                << "||r_0|| = " << nom0 << '\n'
+                << "||r_N|| = " << nom << '\n'
+                << "Number of IR iterations: " << final_iter << '\n';
+   }
+}
+
+void NewtonSolver::SetOperator(const Operator &op)
+{
+   oper = &op;
+   height = op.Height();
+   width = op.Width();
+   MFEM_ASSERT(height == width, "square Operator is required.");
+
+   r.SetSize(width);
+   c.SetSize(width);
+}
+
+void NewtonSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
+   MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
+
+   int it;
+   double norm0, norm, norm_goal;
+   const bool have_b = (b.Size() == Height());
+
+   ProcessNewState(x);
+
+   if (!iterative_mode)
+   {
+      x = 0.0;
+   }
+
+   oper->Mult(x, r);
+   if (have_b)
+   {
+      r -= b;
+   }
+
+   norm0 = norm = Norm(r);
+   norm_goal = std::max(rel_tol*norm, abs_tol);
+
+   prec->iterative_mode = false;
+
+   IterativeSolver *krylov = NULL;
+   if (jfnk)
+   {
+      krylov = dynamic_cast<IterativeSolver *>(prec);
+      MFEM_VERIFY(krylov, "JFNK requires an IterativeSolver as linear solver");
+   }
+
+   // x_{i+1} = x_i - [DF(x_i)]^{-1} [F(x_i)-b]
+   num_jac_updates = 0;
+   int jac_age = 0;
+   double norm_prev = norm;
+   for (it = 0; true; it++)
+   {
+      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
+      if (print_level >= 0)
+      {
+         mfem::out << "Newton iteration " << setw(2) << it
+                   << " : ||r|| = " << norm;
+         if (it > 0)
+         {
+            mfem::out << ", ||r||/||r_0|| = " << norm/norm0;
+         }
+         mfem::out << '\n';
+      }
+      Monitor(it, norm, r, x);
+
+      if (norm <= norm_goal)
+      {
+         converged = 1;
+         break;
+      }
+
+      if (it >= max_iter)
+      {
+         converged = 0;
+         break;
+      }
+
+      // Rebuild the gradient in the first iteration, when it is too old, or
+      // when the convergence of the lagged Newton iteration is too slow
+      const bool rebuild = (it == 0 || jac_age >= lag_max_age ||
+                            norm > lag_rate*norm_prev);
+      if (jfnk)
+      {
+         if (rebuild && jac_prec)
+         {
+            jac_prec->SetOperator(oper->GetGradient(x));
+            jac_age = 0;
+            num_jac_updates++;
+         }
+         c = r;
+         if (have_b) { c += b; }
+         jf_oper.SetState(x, c);
+         // Set the operator of the linear solver without passing it to the
+         // preconditioner, which keeps the (lagged) gradient or its own
+         // operator
+         const bool update_prec = krylov->GetPreconditionerOperatorUpdate();
+         krylov->SetPreconditionerOperatorUpdate(false);
+         krylov->SetOperator(jf_oper);
+         krylov->SetPreconditionerOperatorUpdate(update_prec);
+      }
+      else if (rebuild)
+      {
+         prec->SetOperator(oper->GetGradient(x));
+         jac_age = 0;
+         num_jac_updates++;
+      }
+      jac_age++;
+      norm_prev = norm;
+
+      prec->Mult(r, c);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
+
+      const double c_scale = ComputeScalingFactor(x, b);
+      if (c_scale == 0.0)
+      {
+         converged = 0;
+         break;
+      }
+      add(x, -c_scale, c, x);
+
+      ProcessNewState(x);
+
+      oper->Mult(x, r);
+      if (have_b)
+      {
+         r -= b;
+      }
+      norm = Norm(r);
+   }
+
+   final_iter = it;
+   final_norm = norm;
+}
+
+void NewtonSolver::JacobianFreeOperator::SetState(const Vector &x_,
+                                                   const Vector &Fx_)
+{
+   height = width = x_.Size();
+   x = &x_;
+   Fx = Fx_;
+   xnorm = newton.Norm(x_);
+}
+
+void NewtonSolver::JacobianFreeOperator::Mult(const Vector &v,
+                                              Vector &Jv) const
+{
+   const double vnorm = newton.Norm(v);
+   if (vnorm == 0.0)
+   {
+      Jv = 0.0;
+      return;
+   }
+   const double eps_mach = std::numeric_limits<double>::epsilon();
+   const double eps = sqrt((1.0 + xnorm)*eps_mach)/vnorm;
+   xp.SetSize(width);
+   add(*x, eps, v, xp);
+   newton.oper->Mult(xp, Jv);
+   Jv -= Fx;
+   Jv *= 1.0/eps;
+}
+
+void LBFGSSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(oper != NULL, "the Operator is not set (use SetOperator).");
+
+   // Quadrature points that are checked for negative Jacobians etc.
+   Vector sk, rk, yk, rho, alpha;
+   DenseMatrix skM(width, m), ykM(width, m);
+
+   // r - r_{k+1}, c - descent direction
+   sk.SetSize(width);    // x_{k+1}-x_k
+   rk.SetSize(width);    // nabla(f(x_{k}))
+   yk.SetSize(width);    // r_{k+1}-r_{k}
+   rho.SetSize(m);       // 1/(dot(yk,sk)
+   alpha.SetSize(m);     // rhok*sk'*c
+   int last_saved_id = -1;
+
+   int it;
+   double norm0, norm, norm_goal;
+   const bool have_b = (b.Size() == Height());
+
+   if (!iterative_mode)
+   {
+      x = 0.0;
+   }
+
+   // r = F(x)-b
+   oper->Mult(x, r);
+   if (have_b) { r -= b; }
+
+   c = r;           // initial descent direction
+
+   norm0 = norm = Norm(r);
+   norm_goal = std::max(rel_tol*norm, abs_tol);
+   for (it = 0; true; it++)
+   {
+      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
+      if (print_level >= 0)
+      {
+         mfem::out << "LBFGS iteration " <<  it
+                   << " : ||r|| = " << norm;
+         if (it > 0)
+         {
+            mfem::out << ", ||r||/||r_0|| = " << norm/norm0;
+         }
+         mfem::out << '\n';
+      }
+
+      if (norm <= norm_goal)
+      {
+         converged = 1;
+         break;
+      }
+
+      if (it >= max_iter)
+      {
+         converged = 0;
+         break;
+      }
+
+      rk = r;
+      const double c_scale = ComputeScalingFactor(x, b);
+      if (c_scale == 0.0)
+      {
+         converged = 0;
+         break;
+      }
+      add(x, -c_scale, c, x); // x_{k+1} = x_k - c_scale*c
+
+      ProcessNewState(x);
+
+      oper->Mult(x, r);
+      if (have_b)
+      {
+         r -= b;
+      }
+
+      // LBFGS - construct descent direction
+      subtract(r, rk, yk);   // yk = r_{k+1} - r_{k}
+      sk = c; sk *= -c_scale; //sk = x_{k+1} - x_{k} = -c_scale*c
+      const double gamma = Dot(sk, yk)/Dot(yk, yk);
+
+      // Save last m vectors
+      last_saved_id = (last_saved_id == m-1) ? 0 : last_saved_id+1;
+      skM.SetCol(last_saved_id, sk);
+      ykM.SetCol(last_saved_id, yk);
+
+      c = r;
+      for (int i = last_saved_id; i > -1; i--)
+      {
+         skM.GetColumn(i, sk);
+         ykM.GetColumn(i, yk);
+         rho(i) = 1./Dot(sk, yk);
+         alpha(i) = rho(i)*Dot(sk,c);
+         add(c, -alpha(i), yk, c);
+      }
+      if (it > m-1)
+      {
+         for (int i = m-1; i > last_saved_id; i--)
+         {
+            skM.GetColumn(i, sk);
+            ykM.GetColumn(i, yk);
+            rho(i) = 1./Dot(sk, yk);
+            alpha(i) = rho(i)*Dot(sk,c);
+            add(c, -alpha(i), yk, c);
+         }
+      }
+
       c *= gamma;   // scale search direction
       if (it > m-1)
       {
@@ -1774,6 +3400,200 @@ void LBFGSSolver::Mult(const Vector &b, Vector &x) const
    final_norm = norm;
 }
 
+void AndersonSolver::SetOperator(const Operator &op)
+{
+   oper = &op;
+   height = op.Height();
+   width = op.Width();
+   MFEM_ASSERT(height == width, "square Operator is required.");
+
+   g.SetSize(width);
+   f.SetSize(width);
+   f_old.SetSize(width);
+   x_old.SetSize(width);
+   df.SetSize(width);
+}
+
+bool AndersonSolver::AppendColumn(const Vector &df) const
+{
+   const int k = Q.Size();
+   const double df_norm = Norm(df);
+   Vector *q = new Vector(df);
+   for (int i = 0; i < k; i++) { R(i,k) = 0.0; }
+   // Modified Gram-Schmidt with reorthogonalization
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int i = 0; i < k; i++)
+      {
+         const double h = Dot(*Q[i], *q);
+         R(i,k) += h;
+         q->Add(-h, *Q[i]);
+      }
+   }
+   const double r_kk = Norm(*q);
+   if (r_kk <= 1e-12*df_norm || r_kk == 0.0)
+   {
+      delete q;
+      return false;
+   }
+   *q *= 1.0/r_kk;
+   R(k,k) = r_kk;
+   Q.Append(q);
+   return true;
+}
+
+void AndersonSolver::RemoveFirstColumn() const
+{
+   const int k = Q.Size();
+   // Removing the first column of R gives an upper Hessenberg matrix, which is
+   // made upper triangular with Givens rotations, also applied to Q.
+   for (int j = 0; j < k-1; j++)
+   {
+      for (int i = 0; i <= j+1; i++) { R(i,j) = R(i,j+1); }
+   }
+   for (int i = 0; i < k-1; i++)
+   {
+      const double a = R(i,i), b = R(i+1,i);
+      const double r = sqrt(a*a + b*b);
+      const double cs = a/r, sn = b/r;
+      for (int j = i; j < k-1; j++)
+      {
+         const double t = cs*R(i,j) + sn*R(i+1,j);
+         R(i+1,j) = -sn*R(i,j) + cs*R(i+1,j);
+         R(i,j) = t;
+      }
+      Vector &qi = *Q[i], &qi1 = *Q[i+1];
+      for (int l = 0; l < qi.Size(); l++)
+      {
+         const double t = cs*qi(l) + sn*qi1(l);
+         qi1(l) = -sn*qi(l) + cs*qi1(l);
+         qi(l) = t;
+      }
+   }
+   delete Q.Last();
+   Q.DeleteLast();
+   Vector *dx0 = dX[0];
+   dX.DeleteFirst(dx0);
+   delete dx0;
+}
+
+void AndersonSolver::ClearHistory() const
+{
+   for (int i = 0; i < Q.Size(); i++) { delete Q[i]; }
+   for (int i = 0; i < dX.Size(); i++) { delete dX[i]; }
+   Q.SetSize(0);
+   dX.SetSize(0);
+}
+
+void AndersonSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(oper != NULL, "the Operator is not set (use SetOperator).");
+   MFEM_VERIFY(beta > 0.0 && beta <= 1.0, "invalid damping factor: " << beta);
+
+   int it;
+   double norm0 = 0.0, norm = 0.0, norm_goal = 0.0;
+   const bool have_b = (b.Size() == Height());
+
+   if (!iterative_mode)
+   {
+      x = 0.0;
+   }
+
+   ClearHistory();
+   R.SetSize(m);
+
+   for (it = 0; true; it++)
+   {
+      // Fixed-point residual f = G(x) + b - x
+      oper->Mult(x, g);
+      if (have_b)
+      {
+         g += b;
+      }
+      subtract(g, x, f);
+      norm = Norm(f);
+      if (it == 0)
+      {
+         norm0 = norm;
+         norm_goal = std::max(rel_tol*norm, abs_tol);
+      }
+
+      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
+      if (print_level >= 0)
+      {
+         mfem::out << "Anderson iteration " << setw(2) << it
+                   << " : ||r|| = " << norm;
+         if (it > 0)
+         {
+            mfem::out << ", ||r||/||r_0|| = " << norm/norm0;
+         }
+         mfem::out << '\n';
+      }
+      Monitor(it, norm, f, x);
+
+      if (norm <= norm_goal)
+      {
+         converged = 1;
+         break;
+      }
+
+      if (it >= max_iter)
+      {
+         converged = 0;
+         break;
+      }
+
+      if (m > 0)
+      {
+         if (it > 0)
+         {
+            if (restart > 0 && it % restart == 0) { ClearHistory(); }
+            if (Q.Size() == m) { RemoveFirstColumn(); }
+            subtract(f, f_old, df);
+            if (AppendColumn(df))
+            {
+               dX.Append(new Vector(width));
+               subtract(x, x_old, *dX.Last());
+            }
+            else
+            {
+               ClearHistory();
+            }
+         }
+         f_old = f;
+         x_old = x;
+      }
+
+      // Solve min || f - dF gamma || = min || f - Q R gamma ||, and overwrite
+      // f with the residual f - Q Q^T f of the least squares problem
+      const int k = Q.Size();
+      gamma.SetSize(k);
+      for (int i = 0; i < k; i++)
+      {
+         gamma(i) = Dot(*Q[i], f);
+      }
+      for (int i = 0; i < k; i++)
+      {
+         f.Add(-gamma(i), *Q[i]);
+      }
+      for (int i = k-1; i >= 0; i--)
+      {
+         for (int j = i+1; j < k; j++) { gamma(i) -= R(i,j)*gamma(j); }
+         gamma(i) /= R(i,i);
+      }
+
+      // x_{k+1} = x_k - dX gamma + beta (f_k - dF gamma)
+      for (int i = 0; i < k; i++)
+      {
+         x.Add(-gamma(i), *dX[i]);
+      }
+      x.Add(beta, f);
+   }
+
+   final_iter = it;
+   final_norm = norm;
+}
+
 int aGMRES(const Operator &A, Vector &x, const Vector &b,
            const Operator &M, int &max_iter,
            int m_max, int m_min, int m_step, double cf,
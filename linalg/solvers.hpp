@@ -73,6 +73,7 @@ protected:
    const Operator *oper;
    Solver *prec;
    IterativeSolverMonitor *monitor = nullptr;
+   bool update_prec = true;
 
    int max_iter, print_level;
    double rel_tol, abs_tol;
@@ -105,9 +106,18 @@ public:
    /// This should be called before SetOperator
    virtual void SetPreconditioner(Solver &pr);
 
-   /// Also calls SetOperator for the preconditioner if there is one
+   /** @brief Also calls SetOperator for the preconditioner if there is one,
+       unless disabled with SetPreconditionerOperatorUpdate(). */
    virtual void SetOperator(const Operator &op);
 
+   /** @brief Set whether SetOperator() also sets the operator of the
+       preconditioner (default: true). */
+   /** Disable it when the operator is not suitable for building the
+       preconditioner, e.g. a matrix-free approximation of a Jacobian. */
+   void SetPreconditionerOperatorUpdate(bool update) { update_prec = update; }
+
+   bool GetPreconditionerOperatorUpdate() const { return update_prec; }
+
    /// Set the iterative solver monitor
    void SetMonitor(IterativeSolverMonitor &m)
    { monitor = &m; m.SetIterativeSolver(*this); }
@@ -399,6 +409,367 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
             double rtol = 1e-12, double atol = 1e-24);
 
 
+/** @brief Deflated (preconditioned) conjugate gradient method with subspace
+    recycling for sequences of SPD linear systems.
+
+    The solver keeps a deflation subspace W of dimension at most k (see
+    SetDeflationDim()) across calls to Mult(). Each solve starts from the
+    Galerkin projection of the solution onto W and keeps the search directions
+    A-orthogonal to W, following the Def-CG method of Saad, Yeung, Erhel and
+    Guyomarc'h (SIAM J. Sci. Comput., 2000). After each solve, W is updated
+    with the Ritz vectors corresponding to the smallest Ritz values (of B A,
+    where B is the preconditioner) over the span of W and the first search
+    directions of the solve. Linearly dependent directions in that span are
+    dropped before the Rayleigh-Ritz projection.
+
+    The subspace is retained when SetOperator() is called with a new (e.g.
+    time-step dependent) operator, in which case A W is recomputed in the next
+    call to Mult(). Use ClearDeflationSpace() to discard it. */
+class DeflatedCGSolver : public IterativeSolver
+{
+protected:
+   int defl_dim; // maximum dimension of the deflation subspace
+   int harvest;  // number of search directions used to update W
+   mutable Array<Vector *> W, AW, P, AP;
+   mutable DenseMatrixInverse E_inv; // (W^t A W)^{-1}
+   mutable DenseMatrix E;
+   mutable int num_harvested;
+   mutable bool update_AW;
+   mutable Vector r, d, z, mu, Wz;
+
+   void UpdateVectors();
+
+   /// Compute A W, E = W^t A W and its inverse.
+   void SetupDeflation() const;
+
+   /// Factor E = W^t A W, assuming A W is up to date.
+   void FactorDeflation() const;
+
+   /// d <- d - W E^{-1} (A W)^t d
+   void Deflate(Vector &d) const;
+
+   /// Update W with the Ritz vectors from span{W, P}.
+   void UpdateDeflationSpace() const;
+
+public:
+   DeflatedCGSolver()
+      : defl_dim(8), harvest(16), num_harvested(0), update_AW(false) { }
+
+#ifdef MFEM_USE_MPI
+   DeflatedCGSolver(MPI_Comm _comm)
+      : IterativeSolver(_comm), defl_dim(8), harvest(16), num_harvested(0),
+        update_AW(false) { }
+#endif
+
+   /** @brief Set the maximum dimension, @a k, of the deflation subspace and
+       the number of search directions, @a l, used to update it after each
+       solve. The defaults are k = 8 and l = 16. */
+   void SetDeflationDim(int k, int l = -1)
+   { defl_dim = k; harvest = (l < 0) ? 2*k : l; }
+
+   /// Return the current dimension of the deflation subspace.
+   int GetDeflationDim() const { return W.Size(); }
+
+   /// Return the i-th vector of the deflation subspace.
+   const Vector &GetDeflationVector(int i) const { return *W[i]; }
+
+   /// Discard the deflation subspace.
+   void ClearDeflationSpace();
+
+   /** @brief Set the operator; the deflation subspace is retained and A W is
+       recomputed in the next call to Mult(). */
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual ~DeflatedCGSolver() { ClearDeflationSpace(); }
+};
+
+/** @brief GCRO method with subspace recycling for sequences of general linear
+    systems.
+
+    GCRO (de Sturler, 1996) is an outer GCR method whose search directions are
+    computed by an inner right-preconditioned GMRES method orthogonalized
+    against the outer space. This implementation keeps a part of the outer
+    space, given by U and C = A U with C^t C = I, across calls to Mult() and
+    uses it to deflate the initial residual of the next solve, which makes it
+    well suited for sequences of nearly identical systems, e.g. in implicit
+    time stepping. Within a solve, the corrections of the inner GMRES cycles are
+    added to the outer space. At the end of each solve, the recycled space of
+    dimension at most k (see SetRecycleDim()) is updated with the total
+    correction of the solve, dropping the oldest direction (truncation as in
+    GCROT). For time dependent problems, this amounts to projecting the next
+    solution onto the span of the previous solution updates.
+
+    The recycled space is retained when SetOperator() is called with a new
+    operator, in which case C = A U is recomputed and re-orthonormalized in the
+    next call to Mult(). Use ClearRecycledSpace() to discard it. */
+class GCROSolver : public IterativeSolver
+{
+protected:
+   int m;          // inner GMRES iterations per cycle, see SetKDim()
+   int recycle_dim; // maximum dimension of the recycled space
+   mutable Array<Vector *> U, C;
+   mutable bool update_C;
+
+   /// Recompute C = A U and make it orthonormal (updating U accordingly).
+   void SetupRecycledSpace() const;
+
+   /** @brief Add the pair (u, c = A u) with c orthogonal to C to the recycled
+       space, dropping the oldest pair if needed. */
+   void AddRecycledPair(Vector *u, Vector *c) const;
+
+public:
+   GCROSolver() : m(50), recycle_dim(10), update_C(false) { }
+
+#ifdef MFEM_USE_MPI
+   GCROSolver(MPI_Comm _comm)
+      : IterativeSolver(_comm), m(50), recycle_dim(10), update_C(false) { }
+#endif
+
+   /// Set the number of inner GMRES iterations per cycle, default is 50.
+   void SetKDim(int dim) { m = dim; }
+
+   /// Set the maximum dimension of the recycled space, default is 10.
+   void SetRecycleDim(int k) { recycle_dim = k; }
+
+   /// Return the current dimension of the recycled space.
+   int GetRecycledDim() const { return U.Size(); }
+
+   /// Discard the recycled space.
+   void ClearRecycledSpace();
+
+   /** @brief Set the operator; the recycled space is retained and A U is
+       recomputed in the next call to Mult(). */
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual ~GCROSolver() { ClearRecycledSpace(); }
+};
+
+
+/** @brief Block conjugate gradient method for solving a symmetric positive
+    definite system with multiple right-hand sides.
+
+    All right-hand sides are processed simultaneously, using the multi-vector
+    actions Operator::ArrayMult() of the operator and the preconditioner, which
+    can be much more efficient than repeated applications, e.g. for partially
+    assembled operators, see BilinearFormIntegrator::AddMultBatchedPA(). The
+    search space of each right-hand side is the sum of the Krylov spaces of all
+    right-hand sides, which typically reduces the number of iterations.
+
+    This is the breakdown-free variant of Ji and Li (2017), where the block of
+    search directions is orthonormalized in each iteration and (numerically)
+    linearly dependent directions are dropped. The tolerances are applied to
+    each right-hand side separately, as in CGSolver, and the iteration stops
+    when all of them have converged. */
+class BlockCGSolver : public IterativeSolver
+{
+protected:
+   mutable Array<Vector *> R, Z, P, Q; // work vectors, one per right-hand side
+
+   void UpdateVectors(int k) const;
+
+public:
+   BlockCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BlockCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op);
+
+   /// Solve for a single right-hand side.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Solve A X[i] = B[i] for all right-hand sides simultaneously.
+   virtual void ArrayMult(const Array<const Vector *> &B,
+                          Array<Vector *> &X) const;
+
+   virtual ~BlockCGSolver();
+};
+
+/** @brief Block GMRES method for solving a general system with multiple
+    right-hand sides.
+
+    The block Krylov space of all (not yet converged) right-hand sides is built
+    with the multi-vector actions Operator::ArrayMult() of the operator and the
+    preconditioner. As in GMRESSolver, the method uses left preconditioning and
+    restarts after SetKDim() block iterations. The tolerances are applied to the
+    preconditioned residual of each right-hand side separately. */
+class BlockGMRESSolver : public IterativeSolver
+{
+protected:
+   int m; // see SetKDim()
+
+public:
+   BlockGMRESSolver() { m = 50; }
+
+#ifdef MFEM_USE_MPI
+   BlockGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+#endif
+
+   /// Set the number of block iterations before restart, default is 50.
+   void SetKDim(int dim) { m = dim; }
+
+   /// Solve for a single right-hand side.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Solve A X[i] = B[i] for all right-hand sides simultaneously.
+   virtual void ArrayMult(const Array<const Vector *> &B,
+                          Array<Vector *> &X) const;
+};
+
+
+/** @brief Iterative refinement with an inexact inner solver, and GMRES-based
+    iterative refinement (GMRES-IR).
+
+    The inner solver, set with SetPreconditioner(), can be any Solver, e.g. a
+    direct solver, a loose-tolerance Krylov solver or a partial assembly based
+    preconditioner. The outer iteration computes the residual r = b - A x and
+    updates the solution in double precision:
+
+        x = x + d,   where d = B r (IR)  or  A d = r is solved with GMRES
+                     preconditioned with B (GMRES-IR).
+
+    The outer iteration converges to double precision accuracy as long as the
+    inner solver is an accurate enough approximation of the inverse. In
+    particular, the inner solver can work in single precision, see
+    SinglePrecisionSolver; its input is then scaled by the norm of the
+    residual.
+
+    When an IR step reduces the residual norm by less than the stall factor,
+    see SetStallFactor(), the solver switches to GMRES-IR, which converges for
+    much less accurate inner solvers. If GMRES-IR stalls as well, the iteration
+    stops without convergence. Corrections that increase the residual norm are
+    discarded. The tolerances are applied to the norm of the residual. */
+class IterativeRefinementSolver : public IterativeSolver
+{
+public:
+   enum Mode { IR, GMRES_IR };
+
+protected:
+   /** @brief Applies the inner solver, with a scaled input for single
+       precision solvers; used as the GMRES-IR preconditioner without setting
+       the operator of the inner solver a second time. */
+   class InnerSolver : public Solver
+   {
+   private:
+      const IterativeRefinementSolver &ir;
+      mutable Vector rs;
+
+   public:
+      InnerSolver(const IterativeRefinementSolver &ir_)
+         : Solver(0, false), ir(ir_) { }
+      virtual void SetOperator(const Operator &op)
+      { height = op.Height(); width = op.Width(); }
+      virtual void Mult(const Vector &r, Vector &d) const;
+   };
+
+   Mode mode;
+   mutable Mode final_mode;
+   double stall_factor;
+
+   InnerSolver inner;
+   GMRESSolver *gmres;
+   mutable Vector r, rn, d;
+
+   void Init();
+
+public:
+   IterativeRefinementSolver();
+
+#ifdef MFEM_USE_MPI
+   IterativeRefinementSolver(MPI_Comm _comm);
+#endif
+
+   virtual void SetOperator(const Operator &op);
+
+   /// Set the initial mode, IR (default) or GMRES_IR.
+   void SetMode(Mode m) { mode = m; }
+
+   /** @brief Switch from IR to GMRES-IR, or stop in GMRES-IR mode, when the
+       residual norm is reduced by a factor greater than @a factor in one
+       iteration (default: 0.5). */
+   void SetStallFactor(double factor) { stall_factor = factor; }
+
+   /** @brief Set the relative tolerance, the maximal number of iterations and
+       the restart dimension of the GMRES solves of GMRES-IR (defaults: 1e-4,
+       100 and 50). */
+   void SetGMRESParameters(double rtol, int max_it, int kdim);
+
+   /// Return the mode used at the end of the last Mult().
+   Mode GetFinalMode() const { return final_mode; }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual ~IterativeRefinementSolver() { delete gmres; }
+};
+
+
+/** @brief Base class for solvers working in single precision, e.g. the inner
+    solver of IterativeRefinementSolver.
+
+    Mult() rounds the input to single precision, calls MultSingle() and
+    converts the result back to double precision. Derived classes set up their
+    single precision data in SetOperator() and implement MultSingle(). */
+class SinglePrecisionSolver : public Solver
+{
+protected:
+   mutable Array<float> r_single, d_single;
+
+public:
+   SinglePrecisionSolver() : Solver(0, false) { }
+
+   /// Compute @a d = B @a r in single precision, where B ~ A^{-1}.
+   /** The arrays @a r and @a d have Width() and Height() entries. */
+   virtual void MultSingle(const float *r, float *d) const = 0;
+
+   virtual void Mult(const Vector &r, Vector &d) const;
+};
+
+
+/** @brief Direct solver with an LU factorization (with partial pivoting) of a
+    DenseMatrix or a SparseMatrix, stored and applied in single precision. */
+/** The factorization is dense: this solver is only meant for small systems. */
+class SinglePrecisionDenseSolver : public SinglePrecisionSolver
+{
+protected:
+   Array<float> lu;
+   Array<int> ipiv;
+
+public:
+   SinglePrecisionDenseSolver() { }
+
+   /** @brief Copy @a op, a DenseMatrix or a SparseMatrix, to single precision
+       and factor it. */
+   virtual void SetOperator(const Operator &op);
+
+   virtual void MultSingle(const float *r, float *d) const;
+};
+
+
+/** @brief Symmetric Gauss-Seidel smoother for a SparseMatrix, stored and
+    applied in single precision. */
+/** Each application performs the given number of symmetric sweeps starting
+    from zero. */
+class SinglePrecisionGSSmoother : public SinglePrecisionSolver
+{
+protected:
+   Array<int> I, J;
+   Array<float> a;
+   int iterations;
+
+public:
+   SinglePrecisionGSSmoother(int it = 1) : iterations(it) { }
+
+   /// Copy the SparseMatrix @a op to single precision.
+   virtual void SetOperator(const Operator &op);
+
+   virtual void MultSingle(const float *r, float *d) const;
+};
+
 /// Newton's method for solving F(x)=b for a given operator F.
 /** The method GetGradient() must be implemented for the operator F.
     The preconditioner is used (in non-iterative mode) to evaluate
@@ -408,6 +779,37 @@ class NewtonSolver : public IterativeSolver
 protected:
    mutable Vector r, c;
 
+   /// Finite difference approximation of the Jacobian action, used by JFNK.
+   class JacobianFreeOperator : public Operator
+   {
+   protected:
+      const NewtonSolver &newton;
+      const Vector *x;
+      Vector Fx;
+      mutable Vector xp;
+      double xnorm;
+
+   public:
+      JacobianFreeOperator(const NewtonSolver &newton_)
+         : newton(newton_), x(NULL), xnorm(0.0) { }
+
+      /// Set the state @a x_ and the value of the nonlinear operator F(x_).
+      void SetState(const Vector &x_, const Vector &Fx_);
+
+      /** Compute J v ~ (F(x + eps v) - F(x))/eps with
+          eps = sqrt((1 + ||x||) eps_mach)/||v||, see Knoll and Keyes,
+          "Jacobian-free Newton-Krylov methods: a survey of approaches and
+          applications", J. Comput. Phys. 193 (2004). */
+      virtual void Mult(const Vector &v, Vector &Jv) const;
+   };
+
+   bool jfnk = false;
+   Solver *jac_prec = nullptr;
+   int lag_max_age = 1;
+   double lag_rate = 1.0;
+   mutable int num_jac_updates = 0;
+   mutable JacobianFreeOperator jf_oper{*this};
+
 public:
    NewtonSolver() { }
 
@@ -420,6 +822,33 @@ public:
    /** This method is equivalent to calling SetPreconditioner(). */
    virtual void SetSolver(Solver &solver) { prec = &solver; }
 
+   /** @brief Enable the Jacobian-free Newton-Krylov (JFNK) method, where the
+       action of the Jacobian is approximated by finite differences of the
+       action of the nonlinear operator, see JacobianFreeOperator. */
+   /** The linear solver, see SetSolver(), must be an IterativeSolver, e.g.
+       GMRESSolver. Its operator is set to the JacobianFreeOperator without
+       setting the operator of its preconditioner, see
+       IterativeSolver::SetPreconditionerOperatorUpdate(). If @a jac_prec is not
+       NULL, it should be the preconditioner of the linear solver, and its
+       operator is set to Operator::GetGradient() according to the Jacobian
+       lagging policy, see SetJacobianLagging(). Otherwise, the gradient of the
+       nonlinear operator is never computed, and the preconditioner of the
+       linear solver, if any, is used with its own operator. */
+   void SetJacobianFree(bool use_jfnk = true, Solver *jac_prec_ = NULL)
+   { jfnk = use_jfnk; jac_prec = jac_prec_; }
+
+   /** @brief Set the policy for reusing the gradient of the nonlinear operator
+       and the linear solver (or JFNK preconditioner) built from it. */
+   /** The gradient is rebuilt every @a max_age iterations, or when the last
+       iteration reduced the residual norm by a factor worse than @a rate,
+       i.e. ||r_i|| > rate ||r_{i-1}||. The default, @a max_age = 1, rebuilds
+       the gradient in every iteration (the standard Newton method). */
+   void SetJacobianLagging(int max_age, double rate = 1.0)
+   { lag_max_age = max_age; lag_rate = rate; }
+
+   /// Return the number of gradient updates during the last Mult() call.
+   int GetNumJacobianUpdates() const { return num_jac_updates; }
+
    /// Solve the nonlinear system with right-hand side @a b.
    /** If `b.Size() != Height()`, then @a b is assumed to be zero. */
    virtual void Mult(const Vector &b, Vector &x) const;
@@ -462,6 +891,73 @@ public:
    { MFEM_WARNING("L-BFGS won't use the given solver."); }
 };
 
+/** @brief Anderson acceleration of the fixed-point iteration x = G(x) + b for
+    a given fixed-point map G, see Walker and Ni, "Anderson acceleration for
+    fixed-point iterations", SIAM J. Numer. Anal. 49 (2011). */
+/** The operator G, see SetOperator(), is only required to implement Mult(),
+    e.g. one step of a Picard iteration. In each iteration, the residual
+    f_k = G(x_k) + b - x_k is combined with the differences of the last m
+    residuals, see SetWindowSize(), by solving the least squares problem
+
+        min || f_k - dF_k gamma ||,
+
+    with a QR factorization of dF_k that is updated when columns are added or
+    removed. The next iterate is x_{k+1} = x_k - dX_k gamma + beta (f_k -
+    dF_k gamma), where dX_k contains the differences of the last iterates and
+    beta is the damping factor, see SetDamping(). The history is cleared
+    periodically, see SetRestart(), and when the new residual difference is
+    (numerically) linearly dependent on the stored ones. With a window size of
+    zero, the method reduces to the damped fixed-point iteration. The
+    tolerances are applied to the norm of the fixed-point residual f_k. */
+class AndersonSolver : public IterativeSolver
+{
+protected:
+   int m = 5, restart = 0;
+   double beta = 1.0;
+
+   mutable Vector g, f, f_old, x_old, df, gamma;
+   /// Differences of the iterates, and the QR factors of the differences of
+   /// the residuals, dF = Q R.
+   mutable Array<Vector *> dX, Q;
+   mutable DenseMatrix R;
+
+   /// Append the column @a df to the QR factorization, returns false if the
+   /// column is (numerically) linearly dependent on the stored ones.
+   bool AppendColumn(const Vector &df) const;
+   /// Remove the oldest column from the QR factorization and from dX.
+   void RemoveFirstColumn() const;
+   void ClearHistory() const;
+
+public:
+   AndersonSolver() { }
+
+#ifdef MFEM_USE_MPI
+   AndersonSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Set the fixed-point map G.
+   virtual void SetOperator(const Operator &op);
+
+   /// Set the number of stored differences, m (default: 5).
+   void SetWindowSize(int window) { m = window; }
+
+   /// Set the damping factor, 0 < beta <= 1 (default: 1, no damping).
+   void SetDamping(double damping) { beta = damping; }
+
+   /** @brief Clear the history every @a k iterations (default: 0, only when
+       the least squares problem becomes ill-conditioned). */
+   void SetRestart(int k) { restart = k; }
+
+   virtual void SetPreconditioner(Solver &pr)
+   { MFEM_WARNING("Anderson acceleration won't use the given solver."); }
+
+   /// Solve the fixed-point problem x = G(x) + b.
+   /** If `b.Size() != Height()`, then @a b is assumed to be zero. */
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   virtual ~AndersonSolver() { ClearHistory(); }
+};
+
 /** Adaptive restarted GMRES.
     m_max and m_min(=1) are the maximal and minimal restart parameters.
     m_step(=1) is the step to use for going from m_max and m_min.
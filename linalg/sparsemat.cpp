@@ -1455,6 +1455,323 @@ int SparseMatrix::CheckFinite() const
    }
 }
 
+int SparseMatrix::GetBandwidth() const
+{
+   MFEM_VERIFY(Finalized(), "the matrix must be finalized");
+
+   HostReadI();
+   HostReadJ();
+   int bw = 0;
+   for (int i = 0; i < height; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         bw = std::max(bw, std::abs(J[k] - i));
+      }
+   }
+   return bw;
+}
+
+namespace internal
+{
+
+// Symmetric adjacency graph of the square matrix A, without self-loops: the
+// vertices i and j are connected if A(i,j) or A(j,i) is in the sparsity.
+static void GetSymmetricGraph(const SparseMatrix &A, Array<int> &gI,
+                              Array<int> &gJ)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(A.Height() == A.Width(), "the matrix must be square");
+
+   const int n = A.Height();
+   const int *Ai = A.HostReadI(), *Aj = A.HostReadJ();
+
+   gI.SetSize(n+1);
+   gI = 0;
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = Ai[i]; k < Ai[i+1]; k++)
+      {
+         if (Aj[k] != i) { gI[i+1]++; gI[Aj[k]+1]++; }
+      }
+   }
+   gI.PartialSum();
+
+   Array<int> pos(n);
+   for (int i = 0; i < n; i++) { pos[i] = gI[i]; }
+   gJ.SetSize(gI[n]);
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = Ai[i]; k < Ai[i+1]; k++)
+      {
+         const int j = Aj[k];
+         if (j != i) { gJ[pos[i]++] = j; gJ[pos[j]++] = i; }
+      }
+   }
+
+   // Remove the duplicate entries, in place
+   Array<int> marker(n);
+   marker = -1;
+   for (int i = 0, k0 = 0, nnz = 0; i < n; i++)
+   {
+      const int k1 = gI[i+1];
+      for (int k = k0; k < k1; k++)
+      {
+         const int j = gJ[k];
+         if (marker[j] != i) { marker[j] = i; gJ[nnz++] = j; }
+      }
+      gI[i+1] = nnz;
+      k0 = k1;
+   }
+   gJ.SetSize(gI[n]);
+}
+
+// Fill-reducing and bandwidth-reducing orderings of the vertices of a graph in
+// CSR format, see SparseMatrix::GetRCMOrdering() and
+// SparseMatrix::GetNestedDissectionOrdering(). The orderings are computed for
+// subsets of the vertices: the vertices v with mark[v] == id.
+class GraphOrdering
+{
+private:
+   const int *I, *J;
+   Array<int> mark;      // id of the subset containing each vertex
+   Array<int> level;     // BFS level of each vertex, -1 if not visited
+   Array<int> queue;     // the visited vertices in BFS order
+   Array<int> level_ptr; // offsets of the BFS levels in 'queue'
+   int num_ids;
+
+   int Degree(int v) const { return I[v+1] - I[v]; }
+
+   // Breadth-first search from 'root' in the subset 'id'. The neighbors of each
+   // vertex are visited in order of increasing degree, if 'by_degree' is true.
+   // Returns the number of visited vertices.
+   int BFS(int root, int id, bool by_degree)
+   {
+      int head = 0, tail = 0;
+      queue[tail++] = root;
+      level[root] = 0;
+      while (head < tail)
+      {
+         const int v = queue[head++];
+         const int start = tail;
+         for (int k = I[v]; k < I[v+1]; k++)
+         {
+            const int u = J[k];
+            if (mark[u] == id && level[u] < 0)
+            {
+               level[u] = level[v] + 1;
+               queue[tail++] = u;
+            }
+         }
+         if (by_degree)
+         {
+            std::sort(queue.GetData() + start, queue.GetData() + tail,
+                      [this](int a, int b) { return Degree(a) < Degree(b); });
+         }
+      }
+      const int num_levels = level[queue[tail-1]] + 1;
+      level_ptr.SetSize(num_levels + 1);
+      level_ptr = 0;
+      for (int k = 0; k < tail; k++) { level_ptr[level[queue[k]]+1]++; }
+      level_ptr.PartialSum();
+      return tail;
+   }
+
+   void ClearLevels(int cnt)
+   {
+      for (int k = 0; k < cnt; k++) { level[queue[k]] = -1; }
+   }
+
+   // Find a pseudo-peripheral vertex in the connected component of 'start' in
+   // the subset 'id', using the algorithm of George and Liu.
+   int PseudoPeripheral(int start, int id)
+   {
+      int root = start;
+      int cnt = BFS(root, id, false);
+      int num_levels = level_ptr.Size() - 1;
+      while (true)
+      {
+         // vertex of minimal degree in the last level
+         int cand = queue[level_ptr[num_levels-1]];
+         for (int k = level_ptr[num_levels-1]; k < cnt; k++)
+         {
+            if (Degree(queue[k]) < Degree(cand)) { cand = queue[k]; }
+         }
+         ClearLevels(cnt);
+         cnt = BFS(cand, id, false);
+         if (level_ptr.Size() - 1 <= num_levels) { break; }
+         root = cand;
+         num_levels = level_ptr.Size() - 1;
+      }
+      ClearLevels(cnt);
+      return root;
+   }
+
+public:
+   GraphOrdering(int n, const int *gI, const int *gJ)
+      : I(gI), J(gJ), mark(n), level(n), queue(n), num_ids(1)
+   {
+      mark = 0;
+      level = -1;
+   }
+
+   int NewId() { return num_ids++; }
+
+   // Order the 'nv' vertices 'verts' of the subset 'id' with the reverse
+   // Cuthill-McKee algorithm: 'out' is the list of the vertices in the new
+   // order. Each connected component starts at a pseudo-peripheral vertex.
+   void RCM(const int *verts, int nv, int id, int *out)
+   {
+      Array<int> sorted(nv);
+      for (int i = 0; i < nv; i++) { sorted[i] = verts[i]; }
+      std::sort(sorted.begin(), sorted.end(),
+                [this](int a, int b) { return Degree(a) < Degree(b); });
+
+      const int done = NewId();
+      for (int i = 0, pos = 0; pos < nv; i++)
+      {
+         if (mark[sorted[i]] != id) { continue; }
+         const int root = PseudoPeripheral(sorted[i], id);
+         const int cnt = BFS(root, id, true);
+         ClearLevels(cnt);
+         for (int k = 0; k < cnt; k++)
+         {
+            out[pos+k] = queue[k];
+            mark[queue[k]] = done;
+         }
+         pos += cnt;
+      }
+      std::reverse(out, out + nv);
+   }
+
+   // Order the 'nv' vertices 'verts' of the subset 'id' by nested dissection:
+   // 'out' is the list of the vertices in the new order. Subsets with at most
+   // 'leaf_size' vertices are ordered with RCM().
+   void ND(const int *verts, int nv, int id, int leaf_size, int *out)
+   {
+      if (nv <= leaf_size) { RCM(verts, nv, id, out); return; }
+
+      // Split the subset into its connected components
+      for (int i = 0, pos = 0; pos < nv; i++)
+      {
+         if (mark[verts[i]] != id) { continue; }
+         const int cnt = BFS(verts[i], id, false);
+         if (cnt == nv)
+         {
+            ClearLevels(cnt);
+            Dissect(verts, nv, id, leaf_size, out);
+            return;
+         }
+         const int cid = NewId();
+         Array<int> comp(cnt);
+         for (int k = 0; k < cnt; k++)
+         {
+            comp[k] = queue[k];
+            mark[queue[k]] = cid;
+         }
+         ClearLevels(cnt);
+         Dissect(comp.GetData(), cnt, cid, leaf_size, out + pos);
+         pos += cnt;
+      }
+   }
+
+   // Nested dissection of a connected subset: the middle level of a rooted
+   // level structure is a separator which is numbered last.
+   void Dissect(const int *verts, int nv, int id, int leaf_size, int *out)
+   {
+      if (nv <= leaf_size) { RCM(verts, nv, id, out); return; }
+
+      const int root = PseudoPeripheral(verts[0], id);
+      const int cnt = BFS(root, id, false);
+      const int num_levels = level_ptr.Size() - 1;
+      if (num_levels < 3)
+      {
+         ClearLevels(cnt);
+         RCM(verts, nv, id, out);
+         return;
+      }
+
+      // The separator is the level containing the median vertex, excluding the
+      // first and the last levels.
+      int m = 1;
+      while (m < num_levels-2 && level_ptr[m+1] <= nv/2) { m++; }
+      const int n1 = level_ptr[m], ns = level_ptr[m+1] - n1, n2 = cnt - n1 - ns;
+
+      Array<int> part(cnt);
+      for (int k = 0; k < cnt; k++) { part[k] = queue[k]; }
+      ClearLevels(cnt);
+      const int id1 = NewId(), ids = NewId(), id2 = NewId();
+      for (int k = 0; k < n1; k++) { mark[part[k]] = id1; }
+      for (int k = n1; k < n1+ns; k++) { mark[part[k]] = ids; }
+      for (int k = n1+ns; k < cnt; k++) { mark[part[k]] = id2; }
+
+      const int *p = part.GetData();
+      ND(p, n1, id1, leaf_size, out);
+      ND(p + n1 + ns, n2, id2, leaf_size, out + n1);
+      RCM(p + n1, ns, ids, out + n1 + n2);
+   }
+};
+
+} // namespace internal
+
+void SparseMatrix::GetRCMOrdering(Array<int> &ordering) const
+{
+   Array<int> gI, gJ, verts(height), order(height);
+   internal::GetSymmetricGraph(*this, gI, gJ);
+   internal::GraphOrdering graph(height, gI.GetData(), gJ.GetData());
+   for (int i = 0; i < height; i++) { verts[i] = i; }
+   graph.RCM(verts.GetData(), height, 0, order.GetData());
+
+   ordering.SetSize(height);
+   for (int k = 0; k < height; k++) { ordering[order[k]] = k; }
+}
+
+void SparseMatrix::GetNestedDissectionOrdering(Array<int> &ordering,
+                                               int leaf_size) const
+{
+   MFEM_VERIFY(leaf_size > 0, "invalid leaf size: " << leaf_size);
+
+   Array<int> gI, gJ, verts(height), order(height);
+   internal::GetSymmetricGraph(*this, gI, gJ);
+   internal::GraphOrdering graph(height, gI.GetData(), gJ.GetData());
+   for (int i = 0; i < height; i++) { verts[i] = i; }
+   graph.ND(verts.GetData(), height, 0, leaf_size, order.GetData());
+
+   ordering.SetSize(height);
+   for (int k = 0; k < height; k++) { ordering[order[k]] = k; }
+}
+
+SparseMatrix *PermuteRowsCols(const SparseMatrix &A,
+                              const Array<int> &ordering)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(A.Height() == A.Width(), "the matrix must be square");
+   MFEM_VERIFY(ordering.Size() == A.Height(), "invalid ordering size");
+
+   const int n = A.Height(), nnz = A.NumNonZeroElems();
+   const int *Ai = A.HostReadI(), *Aj = A.HostReadJ();
+   const double *Ad = A.HostReadData();
+
+   int *Bi = Memory<int>(n+1);
+   int *Bj = Memory<int>(nnz);
+   double *Bd = Memory<double>(nnz);
+   Bi[0] = 0;
+   for (int i = 0; i < n; i++) { Bi[ordering[i]+1] = Ai[i+1] - Ai[i]; }
+   for (int i = 0; i < n; i++) { Bi[i+1] += Bi[i]; }
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = Ai[i], kb = Bi[ordering[i]]; k < Ai[i+1]; k++, kb++)
+      {
+         Bj[kb] = ordering[Aj[k]];
+         Bd[kb] = Ad[k];
+      }
+   }
+
+   SparseMatrix *B = new SparseMatrix(Bi, Bj, Bd, n, n);
+   B->SortColumnIndices();
+   return B;
+}
+
 MatrixInverse *SparseMatrix::Inverse() const
 {
    return NULL;
@@ -3627,6 +3944,59 @@ SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
    return out;
 }
 
+RAPPlan::RAPPlan(const SparseMatrix &P_)
+   : P(&P_), R(Transpose(P_)), AP(NULL), C(NULL), A_width(-1)
+{ }
+
+RAPPlan::RAPPlan(const SparseMatrix &Rt, const SparseMatrix &P_)
+   : P(&P_), R(Transpose(Rt)), AP(NULL), C(NULL), A_width(-1)
+{ }
+
+SparseMatrix &RAPPlan::Mult(const SparseMatrix &A)
+{
+   const int height = A.Height(), nnz = A.NumNonZeroElems();
+   const int *I = A.HostReadI(), *J = A.HostReadJ();
+   if (C == NULL)
+   {
+      // Symbolic and numeric phases
+      AP = mfem::Mult(A, *P);
+      C = mfem::Mult(*R, *AP);
+      A_width = A.Width();
+      A_I.SetSize(height + 1);
+      A_J.SetSize(nnz);
+      std::copy(I, I + height + 1, A_I.begin());
+      std::copy(J, J + nnz, A_J.begin());
+   }
+   else
+   {
+      // Numeric phase only, using the sparsity of the previous products
+      MFEM_VERIFY(height + 1 == A_I.Size() && A.Width() == A_width &&
+                  nnz == A_J.Size() &&
+                  std::equal(A_I.begin(), A_I.end(), I) &&
+                  std::equal(A_J.begin(), A_J.end(), J),
+                  "the sparsity pattern of A has changed, call Reset() first");
+      mfem::Mult(A, *P, AP);
+      mfem::Mult(*R, *AP, C);
+   }
+   return *C;
+}
+
+void RAPPlan::Reset()
+{
+   delete C;
+   delete AP;
+   C = AP = NULL;
+   A_width = -1;
+   A_I.DeleteAll();
+   A_J.DeleteAll();
+}
+
+RAPPlan::~RAPPlan()
+{
+   Reset();
+   delete R;
+}
+
 SparseMatrix *Mult_AtDA (const SparseMatrix &A, const Vector &D,
                          SparseMatrix *OAtDA)
 {
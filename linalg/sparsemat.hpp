@@ -592,6 +592,30 @@ public:
    /// Count the number of entries that are NOT finite, i.e. Inf or Nan.
    int CheckFinite() const;
 
+   /// Returns max_{i,j} |i-j| over the entries (i,j) of a finalized matrix.
+   int GetBandwidth() const;
+
+   /** @brief Compute the reverse Cuthill-McKee ordering of the rows of a
+       finalized square matrix, which reduces the bandwidth and the profile.
+
+       The ordering is computed for the graph of the sparsity of A + A^t. Each
+       connected component is ordered starting from a pseudo-peripheral vertex.
+       On return, @a ordering[i] is the new index of row (and column) i, as in
+       Mesh::ReorderElements(), see also PermuteRowsCols(). */
+   void GetRCMOrdering(Array<int> &ordering) const;
+
+   /** @brief Compute a nested dissection ordering of the rows of a finalized
+       square matrix, which reduces the fill-in of sparse direct solvers.
+
+       The graph of the sparsity of A + A^t is recursively bisected with
+       separators given by the middle level of a rooted level structure; the
+       separators are numbered after the two parts they separate. Subgraphs
+       with at most @a leaf_size vertices are ordered with reverse
+       Cuthill-McKee. The output @a ordering has the same meaning as in
+       GetRCMOrdering(). */
+   void GetNestedDissectionOrdering(Array<int> &ordering,
+                                    int leaf_size = 64) const;
+
    /// Set the graph ownership flag (I and J arrays).
    void SetGraphOwner(bool ownij)
    { I.SetHostPtrOwner(ownij); J.SetHostPtrOwner(ownij); }
@@ -677,11 +701,55 @@ SparseMatrix *RAP(const SparseMatrix &A, const SparseMatrix &R,
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
                   const SparseMatrix &P);
 
+/** @brief Reusable Galerkin triple product R A P with R = Rt^T or R = P^T, for
+    a sequence of matrices A with the same sparsity pattern and fixed Rt and P,
+    e.g. coarse operators rebuilt when coefficients change on a fixed mesh.
+
+    The first call to Mult() computes R and the sparsity of the products A P
+    and R (A P). Subsequent calls only recompute the numerical values, in place.
+    The matrices Rt and P must be finalized and must not be modified while the
+    plan is in use. */
+class RAPPlan
+{
+private:
+   const SparseMatrix *P;
+   SparseMatrix *R, *AP, *C;
+   int A_width;
+   Array<int> A_I, A_J; // sparsity pattern of A used by the symbolic phase
+
+public:
+   /// Plan for the product P^T A P.
+   explicit RAPPlan(const SparseMatrix &P);
+
+   /// Plan for the product Rt^T A P.
+   RAPPlan(const SparseMatrix &Rt, const SparseMatrix &P);
+
+   /** @brief Compute R A P and return the result, which is owned by the plan
+       and overwritten by subsequent calls. The finalized matrix @a A must have
+       the same sparsity pattern in all calls, unless Reset() is called; note
+       that this requires keeping the zero entries, e.g. when assembling A with
+       BilinearForm::Assemble(0) and BilinearForm::Finalize(0). The pattern is
+       compared with a copy of the I and J arrays saved in the first call. */
+   SparseMatrix &Mult(const SparseMatrix &A);
+
+   /** @brief Discard the cached products, e.g. when the sparsity pattern of A
+       changes. Invalidates the result returned by Mult(). */
+   void Reset();
+
+   ~RAPPlan();
+};
+
 /// Matrix multiplication A^t D A. All matrices must be finalized.
 SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
                         SparseMatrix *OAtDA = NULL);
 
 
+/** @brief Symmetric permutation of a finalized square matrix: returns B with
+    B(ordering[i], ordering[j]) = A(i,j), see SparseMatrix::GetRCMOrdering(). */
+SparseMatrix *PermuteRowsCols(const SparseMatrix &A,
+                              const Array<int> &ordering);
+
+
 /// Matrix addition result = A + B.
 SparseMatrix * Add(const SparseMatrix & A, const SparseMatrix & B);
 /// Matrix addition result = a*A + b*B
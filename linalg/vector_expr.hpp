@@ -0,0 +1,316 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_VECTOR_EXPR
+#define MFEM_VECTOR_EXPR
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "vector.hpp"
+
+// This header defines an opt-in lazy expression layer for element-wise Vector
+// arithmetic. Expressions are formed from Vectors wrapped with mfem::Lazy() and
+// are evaluated in a single MFEM_FORALL pass when assigned, e.g.
+//
+//    Lazy(z) = a*Lazy(x) + b*Lazy(y) - c*Lazy(w);
+//    Lazy(x) += dt*(Lazy(k1) + 2.0*Lazy(k2));
+//
+// The evaluation respects the host/device validity of the memory manager: it
+// runs on the device if any of the participating Vectors has UseDevice() set.
+// Note that the regular Vector operators are not affected, in particular
+// Vector*Vector remains the inner product.
+
+namespace mfem
+{
+
+namespace vexpr
+{
+
+// Device-copyable views of the expression tree, captured by value in the
+// evaluation kernel.
+
+struct LeafView
+{
+   const double *d;
+   MFEM_HOST_DEVICE inline double operator[](int i) const { return d[i]; }
+};
+
+template <typename E>
+struct ScaleView
+{
+   double a;
+   E e;
+   MFEM_HOST_DEVICE inline double operator[](int i) const { return a*e[i]; }
+};
+
+template <typename L, typename R>
+struct SumView
+{
+   L l;
+   R r;
+   MFEM_HOST_DEVICE inline double operator[](int i) const { return l[i] + r[i]; }
+};
+
+template <typename L, typename R>
+struct DiffView
+{
+   L l;
+   R r;
+   MFEM_HOST_DEVICE inline double operator[](int i) const { return l[i] - r[i]; }
+};
+
+template <int N>
+struct LinCombView
+{
+   int n;
+   double c[N];
+   const double *d[N];
+   MFEM_HOST_DEVICE inline double operator[](int i) const
+   {
+      double s = 0.0;
+      for (int j = 0; j < n; j++) { s += c[j]*d[j][i]; }
+      return s;
+   }
+};
+
+} // namespace vexpr
+
+/// Base class (CRTP) for the lazy Vector expressions, see mfem::Lazy().
+template <typename E>
+class VectorExpr
+{
+public:
+   const E &Expr() const { return static_cast<const E&>(*this); }
+   int Size() const { return Expr().Size(); }
+   bool UseDevice() const { return Expr().UseDevice(); }
+};
+
+/// Leaf of a lazy expression referencing a constant Vector.
+class ConstVectorRef : public VectorExpr<ConstVectorRef>
+{
+protected:
+   const Vector &v;
+
+public:
+   typedef vexpr::LeafView view_type;
+
+   explicit ConstVectorRef(const Vector &v_) : v(v_) { }
+
+   int Size() const { return v.Size(); }
+   bool UseDevice() const { return v.UseDevice(); }
+   view_type View(bool use_dev) const { return view_type{v.Read(use_dev)}; }
+};
+
+/** @brief Leaf of a lazy expression referencing a Vector that can also be
+    assigned a lazy expression. */
+class VectorRef : public VectorExpr<VectorRef>
+{
+protected:
+   Vector &v;
+
+public:
+   typedef vexpr::LeafView view_type;
+
+   explicit VectorRef(Vector &v_) : v(v_) { }
+
+   /// Copy the reference, not the referenced Vector.
+   VectorRef(const VectorRef &) = default;
+
+   int Size() const { return v.Size(); }
+   bool UseDevice() const { return v.UseDevice(); }
+   view_type View(bool use_dev) const { return view_type{v.Read(use_dev)}; }
+
+   /// Evaluate the expression @a expr in a single pass: v = expr.
+   template <typename E>
+   VectorRef &operator=(const VectorExpr<E> &expr)
+   {
+      const E &e = expr.Expr();
+      MFEM_ASSERT(e.Size() == v.Size(), "incompatible Vectors!");
+      const int N = v.Size();
+      const bool use_dev = v.UseDevice() || e.UseDevice();
+      const typename E::view_type ev = e.View(use_dev);
+      double *d_v = v.Write(use_dev);
+      MFEM_FORALL_SWITCH(use_dev, i, N, d_v[i] = ev[i];);
+      return *this;
+   }
+
+   /// Copy the referenced Vector of @a other: v = other.v.
+   VectorRef &operator=(const VectorRef &other)
+   { return operator=(static_cast<const VectorExpr<VectorRef>&>(other)); }
+
+   /// Evaluate the expression @a expr in a single pass: v += expr.
+   template <typename E>
+   VectorRef &operator+=(const VectorExpr<E> &expr)
+   {
+      const E &e = expr.Expr();
+      MFEM_ASSERT(e.Size() == v.Size(), "incompatible Vectors!");
+      const int N = v.Size();
+      const bool use_dev = v.UseDevice() || e.UseDevice();
+      const typename E::view_type ev = e.View(use_dev);
+      double *d_v = v.ReadWrite(use_dev);
+      MFEM_FORALL_SWITCH(use_dev, i, N, d_v[i] += ev[i];);
+      return *this;
+   }
+
+   /// Evaluate the expression @a expr in a single pass: v -= expr.
+   template <typename E>
+   VectorRef &operator-=(const VectorExpr<E> &expr)
+   {
+      const E &e = expr.Expr();
+      MFEM_ASSERT(e.Size() == v.Size(), "incompatible Vectors!");
+      const int N = v.Size();
+      const bool use_dev = v.UseDevice() || e.UseDevice();
+      const typename E::view_type ev = e.View(use_dev);
+      double *d_v = v.ReadWrite(use_dev);
+      MFEM_FORALL_SWITCH(use_dev, i, N, d_v[i] -= ev[i];);
+      return *this;
+   }
+};
+
+/// Lazy expression node for a*e.
+template <typename E>
+class ScaledVectorExpr : public VectorExpr<ScaledVectorExpr<E> >
+{
+protected:
+   const double a;
+   const E e;
+
+public:
+   typedef vexpr::ScaleView<typename E::view_type> view_type;
+
+   ScaledVectorExpr(double a_, const E &e_) : a(a_), e(e_) { }
+
+   int Size() const { return e.Size(); }
+   bool UseDevice() const { return e.UseDevice(); }
+   view_type View(bool use_dev) const { return view_type{a, e.View(use_dev)}; }
+};
+
+/// Lazy expression node for l + r.
+template <typename L, typename R>
+class SumVectorExpr : public VectorExpr<SumVectorExpr<L,R> >
+{
+protected:
+   const L l;
+   const R r;
+
+public:
+   typedef vexpr::SumView<typename L::view_type,
+           typename R::view_type> view_type;
+
+   SumVectorExpr(const L &l_, const R &r_) : l(l_), r(r_)
+   { MFEM_ASSERT(l.Size() == r.Size(), "incompatible Vectors!"); }
+
+   int Size() const { return l.Size(); }
+   bool UseDevice() const { return l.UseDevice() || r.UseDevice(); }
+   view_type View(bool use_dev) const
+   { return view_type{l.View(use_dev), r.View(use_dev)}; }
+};
+
+/// Lazy expression node for l - r.
+template <typename L, typename R>
+class DiffVectorExpr : public VectorExpr<DiffVectorExpr<L,R> >
+{
+protected:
+   const L l;
+   const R r;
+
+public:
+   typedef vexpr::DiffView<typename L::view_type,
+           typename R::view_type> view_type;
+
+   DiffVectorExpr(const L &l_, const R &r_) : l(l_), r(r_)
+   { MFEM_ASSERT(l.Size() == r.Size(), "incompatible Vectors!"); }
+
+   int Size() const { return l.Size(); }
+   bool UseDevice() const { return l.UseDevice() || r.UseDevice(); }
+   view_type View(bool use_dev) const
+   { return view_type{l.View(use_dev), r.View(use_dev)}; }
+};
+
+/** @brief Lazy expression node for the linear combination sum_j c_j v_j with a
+    number of terms known only at runtime (at most MaxTerms), e.g. the stages of
+    a Runge-Kutta method. */
+class LinearCombinationExpr : public VectorExpr<LinearCombinationExpr>
+{
+public:
+   static constexpr int MaxTerms = 16;
+   typedef vexpr::LinCombView<MaxTerms> view_type;
+
+protected:
+   int n, size;
+   double c[MaxTerms];
+   const Vector *v[MaxTerms];
+
+public:
+   LinearCombinationExpr() : n(0), size(0) { }
+
+   /// Add the term @a a * @a x to the linear combination.
+   LinearCombinationExpr &Add(double a, const Vector &x)
+   {
+      MFEM_VERIFY(n < MaxTerms, "too many terms in LinearCombinationExpr");
+      MFEM_ASSERT(n == 0 || x.Size() == size, "incompatible Vectors!");
+      size = x.Size();
+      c[n] = a;
+      v[n++] = &x;
+      return *this;
+   }
+
+   int Size() const { return size; }
+   bool UseDevice() const
+   {
+      bool use_dev = false;
+      for (int j = 0; j < n; j++) { use_dev = use_dev || v[j]->UseDevice(); }
+      return use_dev;
+   }
+   view_type View(bool use_dev) const
+   {
+      view_type view;
+      view.n = n;
+      for (int j = 0; j < n; j++)
+      {
+         view.c[j] = c[j];
+         view.d[j] = v[j]->Read(use_dev);
+      }
+      return view;
+   }
+};
+
+/// Wrap the Vector @a v as a leaf of a lazy expression (opt-in).
+inline VectorRef Lazy(Vector &v) { return VectorRef(v); }
+
+/// Wrap the constant Vector @a v as a leaf of a lazy expression (opt-in).
+inline ConstVectorRef Lazy(const Vector &v) { return ConstVectorRef(v); }
+
+template <typename E>
+inline ScaledVectorExpr<E> operator*(double a, const VectorExpr<E> &e)
+{ return ScaledVectorExpr<E>(a, e.Expr()); }
+
+template <typename E>
+inline ScaledVectorExpr<E> operator*(const VectorExpr<E> &e, double a)
+{ return ScaledVectorExpr<E>(a, e.Expr()); }
+
+template <typename E>
+inline ScaledVectorExpr<E> operator-(const VectorExpr<E> &e)
+{ return ScaledVectorExpr<E>(-1.0, e.Expr()); }
+
+template <typename L, typename R>
+inline SumVectorExpr<L,R> operator+(const VectorExpr<L> &l,
+                                    const VectorExpr<R> &r)
+{ return SumVectorExpr<L,R>(l.Expr(), r.Expr()); }
+
+template <typename L, typename R>
+inline DiffVectorExpr<L,R> operator-(const VectorExpr<L> &l,
+                                     const VectorExpr<R> &r)
+{ return DiffVectorExpr<L,R>(l.Expr(), r.Expr()); }
+
+} // namespace mfem
+
+#endif
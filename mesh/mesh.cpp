@@ -782,6 +782,7 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
       GeometricFactors *gf = geom_factors[i];
       if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
       {
+         if (gf->nodes_sequence != nodes_sequence) { gf->Compute(); }
          return gf;
       }
    }
@@ -803,6 +804,7 @@ const FaceGeometricFactors* Mesh::GetFaceGeometricFactors(
       if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags &&
           gf->type==type)
       {
+         if (gf->nodes_sequence != nodes_sequence) { gf->Compute(); }
          return gf;
       }
    }
@@ -1084,6 +1086,7 @@ void Mesh::Init()
    nbBoundaryFaces = -1;
    meshgen = mesh_geoms = 0;
    sequence = 0;
+   nodes_sequence = 0;
    Nodes = NULL;
    own_nodes = 1;
    NURBSext = NULL;
@@ -3117,6 +3120,7 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
 
    // Create the new Mesh instance without a record of its refinement history
    sequence = 0;
+   nodes_sequence = 0;
    last_operation = Mesh::NONE;
 
    // Duplicate the elements
@@ -6543,6 +6547,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -6563,6 +6568,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -6609,6 +6615,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    if (Nodes)
    {
       (*Nodes) += displacements;
+      NodesUpdated();
    }
    else
    {
@@ -6633,6 +6640,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    if (Nodes)
    {
       (*Nodes) = node_coord;
+      NodesUpdated();
    }
    else
    {
@@ -6652,12 +6660,14 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
       delete NURBSext;
       NURBSext = nodes.FESpace()->StealNURBSext();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
+   NodesUpdated();
    // TODO:
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
@@ -7911,6 +7921,17 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
    mfem::Swap(geom_factors, other.geom_factors);
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      geom_factors[i]->mesh = this;
+   }
+   for (int i = 0; i < other.geom_factors.Size(); i++)
+   {
+      other.geom_factors[i]->mesh = &other;
+   }
+   // Force the recomputation of the geometric factors
+   NodesUpdated();
+   other.NodesUpdated();
 
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
@@ -10236,6 +10257,7 @@ void Mesh::ScaleSubdomains(double sf)
    delete [] cg;
    delete [] nbea;
    delete [] vn;
+   NodesUpdated();
 }
 
 void Mesh::ScaleElements(double sf)
@@ -10306,6 +10328,7 @@ void Mesh::ScaleElements(double sf)
    delete [] cg;
    delete [] nbea;
    delete [] vn;
+   NodesUpdated();
 }
 
 void Mesh::Transform(void (*f)(const Vector&, Vector&))
@@ -10331,6 +10354,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -10355,6 +10379,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -10698,6 +10723,12 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   Compute();
+}
+
+void GeometricFactors::Compute()
+{
+   nodes_sequence = mesh->GetNodesSequence();
 
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
@@ -10706,42 +10737,54 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
    const int vdim = fespace->GetVDim();
    const int NE   = fespace->GetNE();
    const int ND   = fe->GetDof();
-   const int NQ   = ir.GetNPoints();
+   const int NQ   = IntRule->GetNPoints();
+
+   // Use a private interpolator: the one owned by the FiniteElementSpace may
+   // have been configured by the user, e.g. with DisableTensorProducts().
+   QuadratureInterpolator qi(*fespace, *IntRule);
 
-   // For now, we are not using tensor product evaluation
-   const Operator *elem_restr = fespace->GetElementRestriction(
-                                   ElementDofOrdering::NATIVE);
+   // The tensor product evaluations use the lexicographic E-vector ordering
+   const bool use_tensor = qi.UseTensorProducts(QVectorLayout::byNODES);
+   const ElementDofOrdering ordering = use_tensor ?
+                                       ElementDofOrdering::LEXICOGRAPHIC :
+                                       ElementDofOrdering::NATIVE;
+   const Operator *elem_restr = fespace->GetElementRestriction(ordering);
 
    unsigned eval_flags = 0;
-   if (flags & GeometricFactors::COORDINATES)
+   if (computed_factors & GeometricFactors::COORDINATES)
    {
       X.SetSize(vdim*NQ*NE);
       eval_flags |= QuadratureInterpolator::VALUES;
    }
-   if (flags & GeometricFactors::JACOBIANS)
+   if (computed_factors & GeometricFactors::JACOBIANS)
    {
       J.SetSize(dim*vdim*NQ*NE);
       eval_flags |= QuadratureInterpolator::DERIVATIVES;
    }
-   if (flags & GeometricFactors::DETERMINANTS)
+   if (computed_factors & GeometricFactors::DETERMINANTS)
    {
       detJ.SetSize(NQ*NE);
       eval_flags |= QuadratureInterpolator::DETERMINANTS;
    }
 
-   const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(ir);
-   // For now, we are not using tensor product evaluation (not implemented)
-   qi->DisableTensorProducts();
-   qi->SetOutputLayout(QVectorLayout::byNODES);
-   if (elem_restr)
+   // The tensor product kernels gather the nodes of the elements directly
+   // from the L-vector; the E-vector is only used by the full evaluations and
+   // with discontinuous nodes.
+   const ElementRestriction *R =
+      dynamic_cast<const ElementRestriction*>(elem_restr);
+   if (use_tensor && R)
+   {
+      qi.MultFused(*R, *nodes, eval_flags, X, J, detJ);
+   }
+   else if (elem_restr)
    {
-      Vector Enodes(vdim*ND*NE);
+      Vector Enodes(vdim*ND*NE, Device::GetDeviceMemoryType());
       elem_restr->Mult(*nodes, Enodes);
-      qi->Mult(Enodes, eval_flags, X, J, detJ);
+      qi.Mult(Enodes, eval_flags, X, J, detJ);
    }
    else
    {
-      qi->Mult(*nodes, eval_flags, X, J, detJ);
+      qi.Mult(*nodes, eval_flags, X, J, detJ);
    }
 }
 
@@ -10753,44 +10796,50 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   Compute();
+}
+
+void FaceGeometricFactors::Compute()
+{
+   nodes_sequence = mesh->GetNodesSequence();
 
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
    const int vdim = fespace->GetVDim();
    const int NF   = fespace->GetNFbyType(type);
-   const int NQ   = ir.GetNPoints();
+   const int NQ   = IntRule->GetNPoints();
 
    const Operator *face_restr = fespace->GetFaceRestriction(
                                    ElementDofOrdering::LEXICOGRAPHIC,
                                    type,
                                    L2FaceValues::SingleValued );
-   Vector Fnodes(face_restr->Height());
+   Vector Fnodes(face_restr->Height(), Device::GetDeviceMemoryType());
    face_restr->Mult(*nodes, Fnodes);
 
    unsigned eval_flags = 0;
-   if (flags & FaceGeometricFactors::COORDINATES)
+   if (computed_factors & FaceGeometricFactors::COORDINATES)
    {
       X.SetSize(vdim*NQ*NF);
       eval_flags |= FaceQuadratureInterpolator::VALUES;
    }
-   if (flags & FaceGeometricFactors::JACOBIANS)
+   if (computed_factors & FaceGeometricFactors::JACOBIANS)
    {
       J.SetSize(vdim*vdim*NQ*NF);
       eval_flags |= FaceQuadratureInterpolator::DERIVATIVES;
    }
-   if (flags & FaceGeometricFactors::DETERMINANTS)
+   if (computed_factors & FaceGeometricFactors::DETERMINANTS)
    {
       detJ.SetSize(NQ*NF);
       eval_flags |= FaceQuadratureInterpolator::DETERMINANTS;
    }
-   if (flags & FaceGeometricFactors::NORMALS)
+   if (computed_factors & FaceGeometricFactors::NORMALS)
    {
       normal.SetSize(vdim*NQ*NF);
       eval_flags |= FaceQuadratureInterpolator::NORMALS;
    }
 
-   const FaceQuadratureInterpolator *qi = fespace->GetFaceQuadratureInterpolator(
-                                             ir, type);
+   const FaceQuadratureInterpolator *qi =
+      fespace->GetFaceQuadratureInterpolator(*IntRule, type);
    qi->Mult(Fnodes, eval_flags, X, J, detJ, normal);
 }
 
@@ -82,6 +82,10 @@ protected:
    // Mesh, such as FiniteElementSpace, GridFunction, etc.
    long sequence;
 
+   // Counter for modifications of the mesh vertices or nodes. Used for lazy
+   // recomputation of the GeometricFactors and FaceGeometricFactors.
+   long nodes_sequence;
+
    Array<Element *> elements;
    // Vertices are only at the corners of elements, where you would expect them
    // in the lowest-order mesh. In some cases, e.g. in a Mesh that defines the
@@ -778,8 +782,10 @@ public:
                                                        FaceType type);
 
    /// Destroy all GeometricFactors stored by the Mesh.
-   /** This method can be used to force recomputation of the GeometricFactors,
-       for example, after the mesh nodes are modified externally. */
+   /** This method can be used to force recomputation of the GeometricFactors.
+       After the mesh nodes are modified externally, calling NodesUpdated() is
+       sufficient: the stored factors are then recomputed in place, keeping
+       the pointers returned by GetGeometricFactors() valid. */
    void DeleteGeometricFactors();
 
    /// Equals 1 + num_holes - num_loops
@@ -1230,6 +1236,18 @@ public:
        Update() calls. */
    long GetSequence() const { return sequence; }
 
+   /** @brief Return the update counter of the mesh vertices and nodes. The
+       counter is incremented by NodesUpdated(). */
+   long GetNodesSequence() const { return nodes_sequence; }
+
+   /** @brief Notify the Mesh that its vertices or nodes were modified
+       externally, e.g. through the GridFunction returned by GetNodes(). */
+   /** The GeometricFactors and FaceGeometricFactors stored by the Mesh are
+       recomputed the next time they are requested. This method is called by
+       the Mesh methods modifying the vertices or the nodes, such as
+       MoveNodes(), SetNodes() and Transform(). */
+   void NodesUpdated() { nodes_sequence++; }
+
    /// Print the mesh to the given stream using Netgen/Truegrid format.
    virtual void PrintXG(std::ostream &out = mfem::out) const;
 
@@ -1409,8 +1427,16 @@ public:
       DETERMINANTS = 1 << 2,
    };
 
+   /// Mesh::GetNodesSequence() at the time of the last computation.
+   long nodes_sequence;
+
    GeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags);
 
+   /// Compute the factors from the current nodes of the mesh.
+   /** For tensor-product meshes, the sum factorized evaluations of the
+       QuadratureInterpolator are used. */
+   void Compute();
+
    /// Mapped (physical) coordinates of all quadrature points.
    /** This array uses a column-major layout with dimensions (NQ x SDIM x NE)
        where
@@ -1455,9 +1481,15 @@ public:
       NORMALS      = 1 << 3,
    };
 
+   /// Mesh::GetNodesSequence() at the time of the last computation.
+   long nodes_sequence;
+
    FaceGeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags,
                         FaceType type);
 
+   /// Compute the factors from the current nodes of the mesh.
+   void Compute();
+
    /// Mapped (physical) coordinates of all quadrature points.
    /** This array uses a column-major layout with dimensions (NQ x SDIM x NF)
        where
@@ -0,0 +1,97 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_UNIT_TEST_FEM_UTILS
+#define MFEM_UNIT_TEST_FEM_UTILS
+
+#include "mfem.hpp"
+
+// Helpers shared by the tests comparing the assembly levels and the kernels of
+// the bilinear, nonlinear and linear forms with the legacy assembly.
+namespace fem_test
+{
+
+/// Smooth, non-constant scalar coefficient.
+inline double coeff_func(const mfem::Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+/// Non-affine perturbation of the mesh nodes.
+inline void perturb(const mfem::Vector &x, mfem::Vector &y)
+{
+   y = x;
+   y(0) += 0.05*x(0)*x(1);
+   y(1) += 0.05*sin(M_PI*x(0));
+}
+
+/// Return a 3 x 3 mesh of the unit square in 2D and a 2 x 2 x 2 mesh of the
+/// unit cube in 3D, made of simplices if @a simplex is true.
+inline mfem::Mesh *MakeCartesianMesh(int dim, bool simplex = false)
+{
+   using mfem::Element;
+   if (dim == 2)
+   {
+      return new mfem::Mesh(3, 3, simplex ? Element::TRIANGLE :
+                            Element::QUADRILATERAL, true);
+   }
+   return new mfem::Mesh(2, 2, 2, simplex ? Element::TETRAHEDRON :
+                         Element::HEXAHEDRON, true);
+}
+
+/// Transform the nodes of @a mesh with perturb(), after making the mesh
+/// curved of order @a curvature when it is positive.
+inline void PerturbMesh(mfem::Mesh &mesh, int curvature = 0)
+{
+   if (curvature > 0) { mesh.SetCurvature(curvature); }
+   mesh.Transform(perturb);
+}
+
+/// Return MakeCartesianMesh(dim, simplex) transformed by PerturbMesh().
+inline mfem::Mesh *MakePerturbedMesh(int dim, bool simplex = false,
+                                     int curvature = 0)
+{
+   mfem::Mesh *mesh = MakeCartesianMesh(dim, simplex);
+   PerturbMesh(*mesh, curvature);
+   return mesh;
+}
+
+/// Scalar and vector problems for which the partially assembled operator is
+/// compared with a reference.
+enum Problem { MASS, DIFFUSION, VECTOR_DIFFUSION };
+
+/// Return a new domain integrator for @a pb using the quadrature rule @a ir
+/// when it is not NULL.
+inline mfem::BilinearFormIntegrator *NewIntegrator(
+   Problem pb, mfem::Coefficient &q, const mfem::IntegrationRule *ir = NULL)
+{
+   mfem::BilinearFormIntegrator *integ;
+   switch (pb)
+   {
+      case MASS: integ = new mfem::MassIntegrator(q); break;
+      case DIFFUSION: integ = new mfem::DiffusionIntegrator(q); break;
+      default: integ = new mfem::VectorDiffusionIntegrator(q); break;
+   }
+   if (ir) { integ->SetIntRule(ir); }
+   return integ;
+}
+
+/// Return ||x - y||_inf / ||y||_inf.
+inline double RelativeDifference(const mfem::Vector &x, const mfem::Vector &y)
+{
+   mfem::Vector d(x);
+   d -= y;
+   return d.Normlinf() / y.Normlinf();
+}
+
+} // namespace fem_test
+
+#endif
@@ -147,4 +147,97 @@ TEST_CASE("Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
    }
 } // test case
 
+// Compare the sparse matrix of the FULL assembly level with the legacy one,
+// including the CSR structure.
+void test_full_assembly_csr(const char *meshname, int order, int pb,
+                            int ordering)
+{
+   INFO("mesh=" << meshname << ", order=" << order << ", pb=" << pb
+        << ", ordering=" << ordering);
+   Mesh mesh(meshname, 1, 1);
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+   const bool dg = (pb == 1);
+   FiniteElementCollection *fec;
+   if (dg)
+   {
+      fec = new L2_FECollection(order, dim, BasisType::GaussLobatto);
+   }
+   else
+   {
+      fec = new H1_FECollection(order, dim);
+   }
+   FiniteElementSpace fes(&mesh, fec, (pb == 2) ? dim : 1, ordering);
+
+   ConstantCoefficient one(1.0);
+   VectorFunctionCoefficient vel_coeff(dim, velocity_function);
+   BilinearForm k_ref(&fes), k_fa(&fes);
+   if (pb == 0) // Diffusion
+   {
+      k_ref.AddDomainIntegrator(new DiffusionIntegrator(one));
+      k_fa.AddDomainIntegrator(new DiffusionIntegrator(one));
+   }
+   else if (pb == 1) // DG convection
+   {
+      AddConvectionIntegrators(k_ref, vel_coeff, dg);
+      AddConvectionIntegrators(k_fa, vel_coeff, dg);
+   }
+   else // Elasticity
+   {
+      k_ref.AddDomainIntegrator(new ElasticityIntegrator(one, one));
+      k_fa.AddDomainIntegrator(new ElasticityIntegrator(one, one));
+   }
+   // Keep the zero entries, e.g. some cross-component elasticity terms
+   const int skip_zeros = 0;
+   k_ref.Assemble(skip_zeros);
+   k_ref.Finalize(skip_zeros);
+   const SparseMatrix &A_ref = k_ref.SpMat();
+
+   FABilinearFormExtension fa(&k_fa);
+   fa.Assemble();
+   const SparseMatrix &A_fa = fa.SpMat();
+
+   SparseMatrix *diff = Add(1.0, A_fa, -1.0, A_ref);
+   REQUIRE(diff->MaxNorm() < 1e-12*A_ref.MaxNorm());
+   delete diff;
+
+   // The sorted rows have no duplicate column indices and are contained in
+   // the rows of the legacy matrix. With DG, only the face dofs are coupled to
+   // the neighbor elements, the legacy matrix stores the full blocks.
+   SparseMatrix A_sorted(A_fa), A_ref_sorted(A_ref);
+   A_sorted.SortColumnIndices();
+   A_ref_sorted.SortColumnIndices();
+   const int n = A_sorted.Height();
+   const int *I = A_sorted.HostReadI(), *I_ref = A_ref_sorted.HostReadI();
+   const int *J = A_sorted.HostReadJ(), *J_ref = A_ref_sorted.HostReadJ();
+   int mismatch = 0;
+   for (int i = 0; i < n; i++)
+   {
+      int k_ref = I_ref[i];
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (k > I[i] && J[k] <= J[k-1]) { mismatch++; }
+         while (k_ref < I_ref[i+1] && J_ref[k_ref] < J[k]) { k_ref++; }
+         if (k_ref == I_ref[i+1] || J_ref[k_ref] != J[k]) { mismatch++; }
+      }
+   }
+   REQUIRE(mismatch == 0);
+   if (!dg)
+   {
+      REQUIRE(A_sorted.NumNonZeroElems() == A_ref_sorted.NumNonZeroElems());
+   }
+
+   delete fec;
+}
+
+TEST_CASE("Full Assembly CSR", "[AssemblyLevel]")
+{
+   auto pb = GENERATE(0, 1, 2);
+   auto order = GENERATE(1, 2, 3);
+   auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+
+   test_full_assembly_csr("../../data/star-q3.mesh", order, pb, ordering);
+   test_full_assembly_csr("../../data/fichera.mesh", order, pb, ordering);
+} // test case
+
 } // namespace pa_kernels
@@ -65,3 +65,55 @@ TEST_CASE("Test order of boundary integrators",
       delete D;
    }
 }
+
+TEST_CASE("Reassembly with scatter map", "[BilinearForm]")
+{
+   Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+   H1_FECollection h1_fec(2, 2);
+   ND_FECollection nd_fec(2, 2); // element dofs with signs
+   FiniteElementSpace h1_fes(&mesh, &h1_fec, 2), nd_fes(&mesh, &nd_fec);
+
+   double k = 0.0;
+   FunctionCoefficient coeff([&k](const Vector &x)
+   {
+      return 1.0 + k*x(0)*x(1);
+   });
+
+   for (FiniteElementSpace *fes : { &h1_fes, &nd_fes })
+   {
+      for (bool stored_elmats : { false, true })
+      {
+         BilinearForm a(fes);
+         if (fes == &h1_fes)
+         {
+            a.AddDomainIntegrator(new VectorMassIntegrator(coeff));
+            a.AddDomainIntegrator(new VectorDiffusionIntegrator(coeff));
+         }
+         else
+         {
+            a.AddDomainIntegrator(new VectorFEMassIntegrator(coeff));
+            a.AddDomainIntegrator(new CurlCurlIntegrator(coeff));
+         }
+         a.UseScatterMap();
+         a.Assemble(0);
+         a.Finalize(0);
+
+         for (k = 1.0; k <= 3.0; k += 1.0)
+         {
+            a = 0.0;
+            if (stored_elmats) { a.ComputeElementMatrices(); }
+            a.Assemble();
+            a.Finalize();
+            a.FreeElementMatrices();
+
+            BilinearForm a_ref(fes, &a);
+            a_ref.Assemble(0);
+            a_ref.Finalize(0);
+
+            SparseMatrix *D = Add(1.0, a.SpMat(), -1.0, a_ref.SpMat());
+            REQUIRE(D->MaxNorm() < 1e-12*a_ref.SpMat().MaxNorm());
+            delete D;
+         }
+      }
+   }
+}
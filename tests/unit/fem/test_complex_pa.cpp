@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace complex_pa
+{
+
+double coeff_r(const Vector &x) { return 1.0 + x(0)*x(1); }
+
+double coeff_i(const Vector &x) { return 0.5 + x(0) - x(1); }
+
+// Add the integrators of a complex mass + diffusion problem to 'a'. If
+// 'mismatched' is true, the real and imaginary integrators of the pairs have
+// different types.
+void AddIntegrators(SesquilinearForm &a, Coefficient &q_r, Coefficient &q_i,
+                    MatrixCoefficient &mq_i, bool mismatched)
+{
+   if (mismatched)
+   {
+      a.AddDomainIntegrator(new MassIntegrator(q_r),
+                            new DiffusionIntegrator(q_i));
+      a.AddDomainIntegrator(new DiffusionIntegrator(q_r),
+                            new MassIntegrator(q_i));
+   }
+   else
+   {
+      a.AddDomainIntegrator(new MassIntegrator(q_r), new MassIntegrator(q_i));
+      a.AddDomainIntegrator(new DiffusionIntegrator(q_r),
+                            new DiffusionIntegrator(mq_i));
+   }
+}
+
+} // namespace complex_pa
+
+TEST_CASE("Fused complex partial assembly", "[PartialAssembly][Complex]")
+{
+   using namespace complex_pa;
+
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(3, 3, Element::QUADRILATERAL, true) :
+                      new Mesh(2, 2, 2, Element::HEXAHEDRON, true);
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+
+         Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+         ess_bdr = 0;
+         ess_bdr[0] = 1;
+         fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+         FunctionCoefficient q_r(coeff_r), q_i(coeff_i);
+         // Non-symmetric matrix coefficient
+         DenseMatrix M(dim);
+         M = 0.25;
+         for (int i = 0; i < dim; i++) { M(i,i) = 1.0 + i; }
+         M(0,1) = -0.5;
+         MatrixConstantCoefficient mq_i(M);
+
+         const int vsize = fes.GetVSize();
+         Vector x(2*vsize), b(2*vsize);
+         x.Randomize(1);
+         b.Randomize(2);
+
+         for (bool mismatched : { false, true })
+         {
+            for (auto conv : { ComplexOperator::HERMITIAN,
+                               ComplexOperator::BLOCK_SYMMETRIC })
+            {
+               SesquilinearForm a_fa(&fes, conv), a_pa(&fes, conv);
+               AddIntegrators(a_fa, q_r, q_i, mq_i, mismatched);
+               AddIntegrators(a_pa, q_r, q_i, mq_i, mismatched);
+               a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+               a_pa.EnableFusedPA();
+               a_fa.Assemble();
+               a_fa.Finalize();
+               a_pa.Assemble();
+
+               OperatorHandle A_fa, A_pa;
+               Vector x_fa(x), b_fa(b), X_fa, B_fa;
+               Vector x_pa(x), b_pa(b), X_pa, B_pa;
+               a_fa.FormLinearSystem(ess_tdof_list, x_fa, b_fa, A_fa, X_fa,
+                                     B_fa);
+               a_pa.FormLinearSystem(ess_tdof_list, x_pa, b_pa, A_pa, X_pa,
+                                     B_pa);
+               REQUIRE(A_pa.Is<ComplexPAOperator>());
+
+               B_pa -= B_fa;
+               REQUIRE(B_pa.Normlinf() < 1e-12*B_fa.Normlinf());
+
+               Vector y_fa(A_fa->Height()), y_pa(A_pa->Height());
+               A_fa->Mult(X_fa, y_fa);
+               A_pa->Mult(X_fa, y_pa);
+               y_pa -= y_fa;
+               REQUIRE(y_pa.Normlinf() < 1e-12*y_fa.Normlinf());
+
+               OperatorHandle S_pa;
+               a_pa.FormSystemMatrix(ess_tdof_list, S_pa);
+               REQUIRE(S_pa.Is<ComplexPAOperator>());
+               S_pa->Mult(X_fa, y_pa);
+               y_pa -= y_fa;
+               REQUIRE(y_pa.Normlinf() < 1e-12*y_fa.Normlinf());
+            }
+         }
+         delete mesh;
+      }
+   }
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace fespace_reorder
+{
+
+double u_exact(const Vector &x)
+{
+   return sin(x(0)) * cos(x(1)) * (1.0 + x(x.Size()-1));
+}
+
+void E_exact(const Vector &x, Vector &E)
+{
+   E(0) = sin(x(1));
+   E(1) = cos(x(2));
+   E(2) = x(0)*x(1);
+}
+
+// Assemble and solve a mass projection problem with Dirichlet boundary
+// conditions on the space 'fes'. Return the assembled matrix and the error.
+void Solve(FiniteElementSpace &fes, bool curl, SparseMatrix &A_out,
+           double &error)
+{
+   const int dim = fes.GetMesh()->Dimension();
+   FunctionCoefficient u_coeff(u_exact);
+   VectorFunctionCoefficient E_coeff(dim, E_exact);
+
+   Array<int> ess_tdof_list, ess_bdr(fes.GetMesh()->bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   GridFunction x(&fes);
+   x = 0.0;
+   LinearForm b(&fes);
+   BilinearForm a(&fes);
+   if (curl)
+   {
+      x.ProjectBdrCoefficientTangent(E_coeff, ess_bdr);
+      b.AddDomainIntegrator(new VectorFEDomainLFIntegrator(E_coeff));
+      a.AddDomainIntegrator(new VectorFEMassIntegrator);
+   }
+   else
+   {
+      x.ProjectBdrCoefficient(u_coeff, ess_bdr);
+      b.AddDomainIntegrator(new DomainLFIntegrator(u_coeff));
+      a.AddDomainIntegrator(new MassIntegrator);
+   }
+   b.Assemble();
+   a.Assemble();
+   a.Finalize();
+   A_out = a.SpMat();
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   DSmoother jacobi(A);
+   PCG(A, jacobi, B, X, 0, 2000, 1e-24, 0.0);
+   a.RecoverFEMSolution(X, b, x);
+
+   error = curl ? x.ComputeL2Error(E_coeff) : x.ComputeL2Error(u_coeff);
+}
+
+} // namespace fespace_reorder
+
+TEST_CASE("FiniteElementSpace::ReorderDofs", "[FiniteElementSpace]")
+{
+   using namespace fespace_reorder;
+
+   for (int type : { 0, 1 })
+   {
+      const bool curl = (type == 1);
+      Mesh mesh(4, 3, 3, curl ? Element::TETRAHEDRON : Element::HEXAHEDRON,
+                true);
+      if (curl) { mesh.ReorientTetMesh(); }
+      FiniteElementCollection *fec;
+      if (curl) { fec = new ND_FECollection(2, 3); }
+      else { fec = new H1_FECollection(3, 3); }
+      FiniteElementSpace fes(&mesh, fec), fes_rcm(&mesh, fec);
+
+      Array<int> ordering;
+      fes_rcm.GetRCMDofOrdering(ordering);
+      fes_rcm.ReorderDofs(ordering);
+      auto renumber = [&ordering](int d)
+      {
+         return (d >= 0) ? ordering[d] : -1-ordering[-1-d];
+      };
+
+      // All dof queries are renumbered consistently
+      Array<int> dofs, dofs_rcm;
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         fes.GetElementDofs(e, dofs);
+         fes_rcm.GetElementDofs(e, dofs_rcm);
+         REQUIRE(dofs.Size() == dofs_rcm.Size());
+         for (int i = 0; i < dofs.Size(); i++)
+         {
+            REQUIRE(dofs_rcm[i] == renumber(dofs[i]));
+         }
+      }
+      for (int f = 0; f < mesh.GetNumFaces(); f++)
+      {
+         fes.GetFaceDofs(f, dofs);
+         fes_rcm.GetFaceDofs(f, dofs_rcm);
+         for (int i = 0; i < dofs.Size(); i++)
+         {
+            REQUIRE(dofs_rcm[i] == renumber(dofs[i]));
+         }
+      }
+      for (int ed = 0; ed < mesh.GetNEdges(); ed++)
+      {
+         fes.GetEdgeDofs(ed, dofs);
+         fes_rcm.GetEdgeDofs(ed, dofs_rcm);
+         for (int i = 0; i < dofs.Size(); i++)
+         {
+            REQUIRE(dofs_rcm[i] == ordering[dofs[i]]);
+         }
+      }
+
+      // The solution does not depend on the dof numbering and the bandwidth
+      // of the matrix is reduced
+      SparseMatrix A, A_rcm;
+      double error, error_rcm;
+      Solve(fes, curl, A, error);
+      Solve(fes_rcm, curl, A_rcm, error_rcm);
+      REQUIRE(A_rcm.GetBandwidth() < A.GetBandwidth());
+      REQUIRE(error_rcm == MFEM_Approx(error));
+
+      // The matrices are symmetric permutations of each other
+      SparseMatrix *A_perm = PermuteRowsCols(A, ordering);
+      SparseMatrix *D = Add(1.0, *A_perm, -1.0, A_rcm);
+      REQUIRE(D->MaxNorm() < 1e-12*A.MaxNorm());
+      delete D;
+      delete A_perm;
+
+      delete fec;
+   }
+}
@@ -198,4 +198,155 @@ TEST_CASE("Simplex integration rules", "[SimplexRules]")
          }
       }
    }
+
+   SECTION("collapsed rules on the reference triangle and tetrahedron")
+   {
+      for (int q = 2; q <= 8; q++)
+      {
+         const IntegrationRule &tri =
+            my_intrules.GetCollapsed(Geometry::TRIANGLE, q);
+         const IntegrationRule &tet =
+            my_intrules.GetCollapsed(Geometry::TETRAHEDRON, q);
+         REQUIRE(&tri == &my_intrules.GetCollapsed(Geometry::TRIANGLE, q));
+         REQUIRE(tri.GetNPoints() == q*q);
+         REQUIRE(tet.GetNPoints() == q*q*q);
+         REQUIRE(tri.GetOrder() == 2*q - 2);
+         REQUIRE(tet.GetOrder() == 2*q - 3);
+
+         for (int p = 0; p <= tri.GetOrder(); p++)
+         {
+            for (int m = p; m >= 0; m--)
+            {
+               const int n = p - m;
+               double integral = 0.0;
+               for (int i = 0; i < tri.GetNPoints(); i++)
+               {
+                  const IntegrationPoint &ip = tri.IntPoint(i);
+                  integral += ip.weight*poly2d(ip, m, n);
+               }
+               const double exact = 1.0/binom[p][m]/(p + 1)/(p + 2);
+               INFO("q=" << q << ", p=" << p << ", m=" << m << ", n=" << n);
+               REQUIRE(fabs(1. - integral/exact) < 1e-11);
+            }
+         }
+
+         for (int p = 0; p <= tet.GetOrder(); p++)
+         {
+            for (int l = p; l >= 0; l--)
+            {
+               for (int m = p - l; m >= 0; m--)
+               {
+                  const int n = p - l - m;
+                  double integral = 0.0;
+                  for (int i = 0; i < tet.GetNPoints(); i++)
+                  {
+                     const IntegrationPoint &ip = tet.IntPoint(i);
+                     integral += ip.weight*poly3d(ip, l, m, n);
+                  }
+                  const double exact =
+                     1.0/binom[p][l+m]/binom[l+m][l]/(p+1)/(p+2)/(p+3);
+                  INFO("q=" << q << ", p=" << p << ", l=" << l << ", m=" << m
+                       << ", n=" << n);
+                  REQUIRE(fabs(1. - integral/exact) < 1e-11);
+               }
+            }
+         }
+      }
+   }
+}
+
+TEST_CASE("Concurrent integration rule and DofToQuad lookups",
+          "[IntegrationRules]")
+{
+   // With MFEM_USE_LEGACY_OPENMP the rules and the DofToQuad maps are created
+   // and looked up concurrently; the results must match the serial lookups.
+   const int num_geoms = 5;
+   const int geoms[num_geoms] = { Geometry::SEGMENT, Geometry::SQUARE,
+                                  Geometry::CUBE, Geometry::TRIANGLE,
+                                  Geometry::PRISM
+                                };
+   const int num_orders[num_geoms] = { 80, 80, 40, 20, 12 };
+   Array<int> geom, order;
+   for (int g = 0; g < num_geoms; g++)
+   {
+      for (int o = 0; o < num_orders[g]; o++)
+      {
+         geom.Append(geoms[g]);
+         order.Append(o);
+      }
+   }
+   const int n = geom.Size();
+
+   IntegrationRules my_intrules(0, Quadrature1D::GaussLegendre);
+   Array<const IntegrationRule *> irs(2*n);
+
+   // Every rule is requested twice, in opposite orders
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < 2*n; k++)
+   {
+      const int i = (k < n) ? k : 2*n - 1 - k;
+      irs[k] = &my_intrules.Get(geom[i], order[i]);
+   }
+
+   for (int i = 0; i < n; i++)
+   {
+      const IntegrationRule &ir = my_intrules.Get(geom[i], order[i]);
+      REQUIRE(ir.GetOrder() >= order[i]);
+      REQUIRE(ir.GetWeights().Size() == ir.GetNPoints());
+      REQUIRE(irs[i] == &ir);
+      REQUIRE(irs[2*n - 1 - i] == &ir);
+   }
+
+   // Collapsed simplex rules, also generating the segment rules they use
+   IntegrationRules my_collapsed(0, Quadrature1D::GaussLegendre);
+   const int num_collapsed = 2*12;
+   Array<const IntegrationRule *> cirs(2*num_collapsed);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < 2*num_collapsed; k++)
+   {
+      const int i = k % num_collapsed;
+      cirs[k] = &my_collapsed.GetCollapsed((i % 2) ? Geometry::TETRAHEDRON :
+                                           Geometry::TRIANGLE, 1 + i/2);
+   }
+   for (int i = 0; i < num_collapsed; i++)
+   {
+      const IntegrationRule &ir =
+         my_collapsed.GetCollapsed((i % 2) ? Geometry::TETRAHEDRON :
+                                   Geometry::TRIANGLE, 1 + i/2);
+      REQUIRE(ir.GetWeights().Size() == ir.GetNPoints());
+      REQUIRE(cirs[i] == &ir);
+      REQUIRE(cirs[i + num_collapsed] == &ir);
+   }
+
+   // More DofToQuad maps than can be found without locking
+   H1_QuadrilateralElement fe(2);
+   const int num_maps = 2*12;
+   Array<const DofToQuad *> maps(2*num_maps);
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < 2*num_maps; k++)
+   {
+      const int i = k % num_maps;
+      const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 2*(i/2));
+      maps[k] = &fe.GetDofToQuad(ir, (i % 2) ? DofToQuad::TENSOR :
+                                 DofToQuad::FULL);
+   }
+
+   for (int i = 0; i < num_maps; i++)
+   {
+      const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 2*(i/2));
+      const DofToQuad::Mode mode =
+         (i % 2) ? DofToQuad::TENSOR : DofToQuad::FULL;
+      const DofToQuad &d2q = fe.GetDofToQuad(ir, mode);
+      REQUIRE(d2q.IntRule == &ir);
+      REQUIRE(d2q.mode == mode);
+      REQUIRE(maps[i] == &d2q);
+      REQUIRE(maps[i + num_maps] == &d2q);
+   }
 }
@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using fem_test::coeff_func;
+using fem_test::MakePerturbedMesh;
+using fem_test::RelativeDifference;
+
+namespace linearform_ext
+{
+
+void vf_func(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 1.0;
+   y(1) *= x(0);
+}
+
+enum Problem { DOMAIN, VECTOR_DOMAIN, BOUNDARY };
+
+void AddIntegrators(LinearForm &b, Problem pb, Coefficient &q,
+                    VectorCoefficient &vq, Array<int> &bdr_marker)
+{
+   switch (pb)
+   {
+      case DOMAIN:
+         b.AddDomainIntegrator(new DomainLFIntegrator(q));
+         break;
+      case VECTOR_DOMAIN:
+         b.AddDomainIntegrator(new VectorDomainLFIntegrator(vq));
+         break;
+      case BOUNDARY:
+         b.AddDomainIntegrator(new DomainLFIntegrator(q));
+         b.AddBoundaryIntegrator(new BoundaryLFIntegrator(q), bdr_marker);
+         b.AddBoundaryIntegrator(new BoundaryLFIntegrator(q, 2, 0));
+         break;
+   }
+}
+
+void test_linearform_ext(int dim, int order, Problem pb, bool func)
+{
+   INFO("dim = " << dim << ", order = " << order << ", problem = " << pb
+        << ", func = " << func);
+
+   Mesh *mesh = MakePerturbedMesh(dim);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, pb == VECTOR_DOMAIN ? dim : 1);
+
+   Array<int> bdr_marker(mesh->bdr_attributes.Max());
+   bdr_marker = 0;
+   bdr_marker[0] = 1;
+   bdr_marker[bdr_marker.Size() - 1] = 1;
+
+   Vector c(dim);
+   c.Randomize(1);
+   ConstantCoefficient const_q(2.0);
+   FunctionCoefficient func_q(coeff_func);
+   VectorConstantCoefficient const_vq(c);
+   VectorFunctionCoefficient func_vq(dim, vf_func);
+   Coefficient &q = func ? static_cast<Coefficient&>(func_q) : const_q;
+   VectorCoefficient &vq = func ? static_cast<VectorCoefficient&>(func_vq) :
+                           const_vq;
+
+   LinearForm b_ref(&fes), b_test(&fes);
+   AddIntegrators(b_ref, pb, q, vq, bdr_marker);
+   AddIntegrators(b_test, pb, q, vq, bdr_marker);
+   b_test.UseFastAssembly(true);
+   REQUIRE(b_test.SupportsDevice());
+
+   b_ref.Assemble();
+   b_test.Assemble();
+   REQUIRE(RelativeDifference(b_test, b_ref) < 1e-12);
+
+   // Reassembling must overwrite the previous values
+   b_test.Assemble();
+   REQUIRE(RelativeDifference(b_test, b_ref) < 1e-12);
+
+   delete mesh;
+}
+
+} // namespace linearform_ext
+
+TEST_CASE("LinearForm fast assembly", "[LinearForm], [PartialAssembly]")
+{
+   using namespace linearform_ext;
+
+   auto pb = GENERATE(DOMAIN, VECTOR_DOMAIN, BOUNDARY);
+   auto func = GENERATE(false, true);
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+
+   test_linearform_ext(dim, order, pb, func);
+}
+
+TEST_CASE("LinearForm fast assembly fallback", "[LinearForm]")
+{
+   using namespace linearform_ext;
+
+   // Simplices are not supported by the device assembly, the legacy assembly
+   // is used instead.
+   Mesh mesh(3, 3, Element::TRIANGLE, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient f(coeff_func);
+
+   LinearForm b_ref(&fes), b_test(&fes);
+   b_ref.AddDomainIntegrator(new DomainLFIntegrator(f));
+   b_test.AddDomainIntegrator(new DomainLFIntegrator(f));
+   b_test.UseFastAssembly(true);
+   REQUIRE(!b_test.SupportsDevice());
+
+   b_ref.Assemble();
+   b_test.Assemble();
+   b_test -= b_ref;
+   REQUIRE(b_test.Normlinf() == 0.0);
+}
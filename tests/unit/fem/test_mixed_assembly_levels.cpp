@@ -0,0 +1,170 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using fem_test::coeff_func;
+using fem_test::MakePerturbedMesh;
+using fem_test::RelativeDifference;
+
+namespace mixed_assembly_levels
+{
+
+enum Problem { GRADIENT, VECTOR_DIVERGENCE, SCALAR_DIVERGENCE, VECTOR_FE_DIV };
+
+BilinearFormIntegrator *NewIntegrator(Problem pb, Coefficient &q)
+{
+   switch (pb)
+   {
+      case GRADIENT: return new GradientIntegrator(q);
+      case VECTOR_DIVERGENCE: return new VectorDivergenceIntegrator(q);
+      case SCALAR_DIVERGENCE: return new MixedScalarDivergenceIntegrator(q);
+      case VECTOR_FE_DIV: return new VectorFEDivergenceIntegrator(q);
+   }
+   return NULL;
+}
+
+void test_mixed_assembly_level(int dim, int order, Problem pb,
+                               AssemblyLevel assembly)
+{
+   INFO("dim = " << dim << ", order = " << order << ", problem = " << pb
+        << ", assembly = " << int(assembly));
+
+   Mesh *mesh = MakePerturbedMesh(dim);
+
+   FiniteElementCollection *trial_fec, *test_fec;
+   int trial_vdim = 1, test_vdim = 1;
+   if (pb == GRADIENT || pb == VECTOR_DIVERGENCE)
+   {
+      trial_fec = new H1_FECollection(order, dim);
+      test_fec = new H1_FECollection(order, dim);
+      (pb == GRADIENT ? test_vdim : trial_vdim) = dim;
+   }
+   else
+   {
+      trial_fec = new RT_FECollection(order - 1, dim);
+      test_fec = new L2_FECollection(order - 1, dim);
+   }
+   FiniteElementSpace trial_fes(mesh, trial_fec, trial_vdim);
+   FiniteElementSpace test_fes(mesh, test_fec, test_vdim);
+
+   // The default quadrature rules of the legacy and partial assembly versions
+   // of VectorFEDivergenceIntegrator differ, so use the same one for all forms.
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 3);
+   FunctionCoefficient q(coeff_func);
+   BilinearFormIntegrator *integ_ref = NewIntegrator(pb, q);
+   BilinearFormIntegrator *integ_test = NewIntegrator(pb, q);
+   if (pb == VECTOR_FE_DIV)
+   {
+      integ_ref->SetIntRule(&ir);
+      integ_test->SetIntRule(&ir);
+   }
+   MixedBilinearForm a_ref(&trial_fes, &test_fes);
+   MixedBilinearForm a_test(&trial_fes, &test_fes);
+   a_ref.AddDomainIntegrator(integ_ref);
+   a_test.AddDomainIntegrator(integ_test);
+
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_test.SetAssemblyLevel(assembly);
+   a_test.Assemble();
+
+   const int trial_n = trial_fes.GetTrueVSize();
+   const int test_n = test_fes.GetTrueVSize();
+   Vector x(trial_n), y_ref(test_n), y_test(test_n);
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_test.Mult(x, y_test);
+   REQUIRE(RelativeDifference(y_test, y_ref) < 1e-12);
+
+   Vector xt(test_n), yt_ref(trial_n), yt_test(trial_n);
+   xt.Randomize(2);
+   a_ref.MultTranspose(xt, yt_ref);
+   a_test.MultTranspose(xt, yt_test);
+   REQUIRE(RelativeDifference(yt_test, yt_ref) < 1e-12);
+
+   // The element-wise diagonal of A D A^T is only available with partial
+   // assembly for the H(div)-L2 pair, use it as the reference.
+   if (pb == VECTOR_FE_DIV && assembly != AssemblyLevel::PARTIAL)
+   {
+      MixedBilinearForm a_pa(&trial_fes, &test_fes);
+      BilinearFormIntegrator *integ_pa = NewIntegrator(pb, q);
+      integ_pa->SetIntRule(&ir);
+      a_pa.AddDomainIntegrator(integ_pa);
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_pa.Assemble();
+
+      Vector D(trial_n), diag_pa(test_n), diag_test(test_n);
+      D.Randomize(3);
+      a_pa.AssembleDiagonal_ADAt(D, diag_pa);
+      a_test.AssembleDiagonal_ADAt(D, diag_test);
+      REQUIRE(RelativeDifference(diag_test, diag_pa) < 1e-12);
+   }
+
+   delete test_fec;
+   delete trial_fec;
+   delete mesh;
+}
+
+} // namespace mixed_assembly_levels
+
+TEST_CASE("Mixed Assembly Levels",
+          "[AssemblyLevel], [PartialAssembly], [MixedBilinearForm]")
+{
+   using namespace mixed_assembly_levels;
+
+   auto assembly = GENERATE(AssemblyLevel::PARTIAL, AssemblyLevel::ELEMENT,
+                            AssemblyLevel::NONE);
+   auto pb = GENERATE(GRADIENT, VECTOR_DIVERGENCE, SCALAR_DIVERGENCE,
+                      VECTOR_FE_DIV);
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+
+   test_mixed_assembly_level(dim, order, pb, assembly);
+}
+
+TEST_CASE("Mixed Assembly Levels any integrator",
+          "[AssemblyLevel], [MixedBilinearForm]")
+{
+   using namespace mixed_assembly_levels;
+
+   // Integrators without partial assembly support are handled by the element
+   // assembly level.
+   auto dim = GENERATE(2, 3);
+
+   Mesh *mesh = MakePerturbedMesh(dim);
+   ND_FECollection trial_fec(2, dim);
+   H1_FECollection test_fec(2, dim);
+   FiniteElementSpace trial_fes(mesh, &trial_fec);
+   FiniteElementSpace test_fes(mesh, &test_fec);
+
+   MixedBilinearForm a_ref(&trial_fes, &test_fes);
+   MixedBilinearForm a_test(&trial_fes, &test_fes);
+   a_ref.AddDomainIntegrator(new VectorFEWeakDivergenceIntegrator);
+   a_test.AddDomainIntegrator(new VectorFEWeakDivergenceIntegrator);
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_test.SetAssemblyLevel(AssemblyLevel::ELEMENT);
+   a_test.Assemble();
+
+   Vector x(trial_fes.GetTrueVSize()), y_ref(test_fes.GetTrueVSize());
+   Vector y_test(test_fes.GetTrueVSize());
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_test.Mult(x, y_test);
+   REQUIRE(RelativeDifference(y_test, y_ref) < 1e-12);
+
+   delete mesh;
+}
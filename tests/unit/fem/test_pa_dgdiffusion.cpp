@@ -0,0 +1,105 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using namespace fem_test;
+
+namespace pa_dgdiffusion
+{
+
+void AddIntegrators(BilinearForm &a, Coefficient &q, double sigma,
+                    double kappa)
+{
+   a.AddDomainIntegrator(new DiffusionIntegrator(q));
+   a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(q, sigma, kappa));
+   a.AddBdrFaceIntegrator(new DGDiffusionIntegrator(q, sigma, kappa));
+}
+
+// Compare the partially and element assembled actions of the interior penalty
+// DG discretization of the diffusion operator with the legacy assembly.
+void test_pa_dgdiffusion(Mesh &mesh, int order, bool func_coeff, double sigma)
+{
+   const int dim = mesh.Dimension();
+   const double kappa = (order+1)*(order+1);
+   DG_FECollection fec(order, dim, BasisType::GaussLobatto);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient func_q(coeff_func);
+   ConstantCoefficient const_q(2.0);
+   Coefficient &q = func_coeff ? static_cast<Coefficient&>(func_q) : const_q;
+
+   BilinearForm a_legacy(&fes), a_pa(&fes), a_ea(&fes);
+   AddIntegrators(a_legacy, q, sigma, kappa);
+   AddIntegrators(a_pa, q, sigma, kappa);
+   AddIntegrators(a_ea, q, sigma, kappa);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_ea.SetAssemblyLevel(AssemblyLevel::ELEMENT);
+   a_legacy.Assemble();
+   a_legacy.Finalize();
+   a_pa.Assemble();
+   a_ea.Assemble();
+
+   const int n = fes.GetVSize();
+   Vector x(n), y_legacy(n), y_pa(n), y_ea(n);
+   x.Randomize(1);
+   a_legacy.Mult(x, y_legacy);
+   a_pa.Mult(x, y_pa);
+   a_ea.Mult(x, y_ea);
+   REQUIRE(RelativeDifference(y_pa, y_legacy) < 1e-11);
+   REQUIRE(RelativeDifference(y_ea, y_legacy) < 1e-11);
+
+   // Transposed action of the face terms (the domain integrators do not
+   // implement AddMultTransposePA)
+   BilinearForm f_legacy(&fes), f_pa(&fes);
+   f_legacy.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(q, sigma,
+                                                                kappa));
+   f_legacy.AddBdrFaceIntegrator(new DGDiffusionIntegrator(q, sigma, kappa));
+   f_pa.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(q, sigma, kappa));
+   f_pa.AddBdrFaceIntegrator(new DGDiffusionIntegrator(q, sigma, kappa));
+   f_legacy.Assemble();
+   f_legacy.Finalize();
+   PABilinearFormExtension pa_ext(&f_pa);
+   pa_ext.Assemble();
+   f_legacy.SpMat().MultTranspose(x, y_legacy);
+   pa_ext.MultTranspose(x, y_pa);
+   REQUIRE(RelativeDifference(y_pa, y_legacy) < 1e-11);
+}
+
+} // namespace pa_dgdiffusion
+
+TEST_CASE("PA DG Diffusion", "[PartialAssembly]")
+{
+   using namespace pa_dgdiffusion;
+
+   auto mesh_fname = GENERATE("", "../../data/star.mesh",
+                              "../../data/fichera.mesh");
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto func_coeff = GENERATE(false, true);
+   auto sigma = GENERATE(-1.0, 0.0, 1.0);
+
+   Mesh *mesh = (*mesh_fname == '\0') ? MakePerturbedMesh(dim, false, 2) :
+                new Mesh(mesh_fname, 1, 1);
+   if (*mesh_fname != '\0' && mesh->Dimension() != dim)
+   {
+      delete mesh;
+      return;
+   }
+
+   INFO("mesh = " << mesh_fname << ", dim = " << dim << ", order = " << order
+        << ", func_coeff = " << func_coeff << ", sigma = " << sigma);
+
+   test_pa_dgdiffusion(*mesh, order, func_coeff, sigma);
+   delete mesh;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using namespace fem_test;
+
+namespace pa_elasticity
+{
+
+double lambda_func(const Vector &x) { return 1.0 + x(0)*x(1); }
+
+double mu_func(const Vector &x) { return 2.0 + x(0) - x(1); }
+
+} // namespace pa_elasticity
+
+TEST_CASE("Elasticity partial and element assembly",
+          "[PartialAssembly][ElementAssembly][Elasticity]")
+{
+   using namespace pa_elasticity;
+
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+
+   INFO("dim = " << dim << ", order = " << order << ", ordering = "
+        << ordering);
+
+   Mesh *mesh = MakePerturbedMesh(dim);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim, ordering);
+
+   FunctionCoefficient lambda(lambda_func), mu(mu_func);
+   BilinearForm a_fa(&fes), a_pa(&fes), a_ea(&fes), a_full(&fes);
+   for (BilinearForm *a : { &a_fa, &a_pa, &a_ea, &a_full })
+   {
+      a->AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   }
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_ea.SetAssemblyLevel(AssemblyLevel::ELEMENT);
+   a_full.SetAssemblyLevel(AssemblyLevel::FULL);
+   a_fa.Assemble();
+   a_fa.Finalize();
+   a_pa.Assemble();
+   a_ea.Assemble();
+   a_full.Assemble();
+
+   const int n = fes.GetVSize();
+   Vector x(n), y_fa(n), y(n);
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+
+   for (BilinearForm *a : { &a_pa, &a_ea, &a_full })
+   {
+      a->Mult(x, y);
+      REQUIRE(RelativeDifference(y, y_fa) < 1e-12);
+   }
+
+   Vector diag_fa(n), diag_pa(n);
+   a_fa.SpMat().GetDiag(diag_fa);
+   a_pa.AssembleDiagonal(diag_pa);
+   REQUIRE(RelativeDifference(diag_pa, diag_fa) < 1e-12);
+
+   delete mesh;
+}
+
+TEST_CASE("Elasticity partial assembly with scaled coefficient",
+          "[PartialAssembly][Elasticity]")
+{
+   using namespace pa_elasticity;
+
+   Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true);
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec, 3);
+
+   FunctionCoefficient mu(mu_func);
+   BilinearForm a_fa(&fes), a_pa(&fes);
+   a_fa.AddDomainIntegrator(new ElasticityIntegrator(mu, 0.5, 1.5));
+   a_pa.AddDomainIntegrator(new ElasticityIntegrator(mu, 0.5, 1.5));
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_fa.Assemble();
+   a_pa.Assemble();
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   // Jacobi-preconditioned CG converges in (nearly) the same number of
+   // iterations for the assembled and the matrix-free operators
+   Vector x(fes.GetVSize()), b(fes.GetVSize());
+   x = 0.0;
+   b.Randomize(2);
+   OperatorHandle A_fa, A_pa;
+   a_fa.FormSystemMatrix(ess_tdof_list, A_fa);
+   a_pa.FormSystemMatrix(ess_tdof_list, A_pa);
+   for (int ess : ess_tdof_list) { b(ess) = 0.0; }
+
+   OperatorJacobiSmoother jacobi_fa(a_fa, ess_tdof_list);
+   OperatorJacobiSmoother jacobi_pa(a_pa, ess_tdof_list);
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(500);
+   cg.SetPrintLevel(-1);
+
+   Vector x_fa(x), x_pa(x);
+   cg.SetOperator(*A_fa);
+   cg.SetPreconditioner(jacobi_fa);
+   cg.Mult(b, x_fa);
+   REQUIRE(cg.GetConverged());
+   const int iter_fa = cg.GetNumIterations();
+
+   cg.SetOperator(*A_pa);
+   cg.SetPreconditioner(jacobi_pa);
+   cg.Mult(b, x_pa);
+   REQUIRE(cg.GetConverged());
+   REQUIRE(std::abs(cg.GetNumIterations() - iter_fa) <= 1);
+
+   REQUIRE(RelativeDifference(x_pa, x_fa) < 1e-8);
+}
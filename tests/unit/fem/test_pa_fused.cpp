@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using namespace fem_test;
+
+namespace pa_fused
+{
+
+// Compare the fused partially assembled action with the one using E-vectors.
+void test_pa_fused(Mesh &mesh, int order, Problem pb, int ordering)
+{
+   const int dim = mesh.Dimension();
+   const int vdim = (pb == VECTOR_DIFFUSION) ? dim : 1;
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vdim, ordering);
+   // VectorDiffusionIntegrator supports only constant coefficients with PA
+   FunctionCoefficient func_q(coeff_func);
+   ConstantCoefficient const_q(2.0);
+   Coefficient &q = (pb == VECTOR_DIFFUSION) ?
+                    static_cast<Coefficient&>(const_q) : func_q;
+
+   BilinearForm a_ref(&fes), a_fused(&fes);
+   a_ref.AddDomainIntegrator(NewIntegrator(pb, q));
+   a_fused.AddDomainIntegrator(NewIntegrator(pb, q));
+   a_ref.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_fused.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_fused.UseFusedRestriction();
+   REQUIRE(a_fused.FusedRestriction());
+   a_ref.Assemble();
+   a_fused.Assemble();
+
+   const int n = fes.GetVSize();
+   Vector x(n), y_ref(n), y_fused(n);
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_fused.Mult(x, y_fused);
+   REQUIRE(RelativeDifference(y_fused, y_ref) < 1e-12);
+
+   // The diagonal still uses E-vectors
+   if (pb != VECTOR_DIFFUSION || ordering == Ordering::byNODES)
+   {
+      a_ref.AssembleDiagonal(y_ref);
+      a_fused.AssembleDiagonal(y_fused);
+      REQUIRE(RelativeDifference(y_fused, y_ref) < 1e-12);
+   }
+}
+
+Mesh *MakeMesh(int dim, bool nc)
+{
+   Mesh *mesh = MakeCartesianMesh(dim);
+   if (nc)
+   {
+      Array<int> elements(1);
+      elements[0] = 0;
+      mesh->GeneralRefinement(elements, 1);
+   }
+   PerturbMesh(*mesh, 2);
+   return mesh;
+}
+
+} // namespace pa_fused
+
+TEST_CASE("PA Fused Restriction", "[PartialAssembly]")
+{
+   using namespace pa_fused;
+
+   auto pb = GENERATE(MASS, DIFFUSION, VECTOR_DIFFUSION);
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto nc = GENERATE(false, true);
+   auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+
+   INFO("dim = " << dim << ", order = " << order << ", problem = " << pb
+        << ", nc = " << nc << ", ordering = " << ordering);
+
+   Mesh *mesh = MakeMesh(dim, nc);
+   test_pa_fused(*mesh, order, pb, ordering);
+   delete mesh;
+}
+
+TEST_CASE("PA Fused Restriction element groups", "[PartialAssembly]")
+{
+   using namespace pa_fused;
+
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2);
+   auto nc = GENERATE(false, true);
+
+   Mesh *mesh = MakeMesh(dim, nc);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   ElementRestriction R(fes, ElementDofOrdering::LEXICOGRAPHIC);
+
+   // Color the elements also without a device or OpenMP backend
+   R.ForceColoredElementGroups();
+
+   // Every element belongs to exactly one group, and the elements of a group
+   // share no dofs.
+   const int ne = mesh->GetNE(), ng = R.GetNumElementGroups();
+   REQUIRE(ng > 1);
+   Array<int> elem_count(ne), dof_marker(fes.GetNDofs());
+   elem_count = 0;
+   for (int g = 0; g < ng; g++)
+   {
+      const ElementGather gather = R.GetElementGather(g);
+      REQUIRE(gather.Fused());
+      dof_marker = -1;
+      for (int i = 0; i < gather.Size(ne); i++)
+      {
+         const int e = gather.Element(i);
+         elem_count[e]++;
+         for (int k = 0; k < gather.dof; k++)
+         {
+            const int gid = gather.map[k + gather.dof*e];
+            const int j = (gid >= 0) ? gid : -1-gid;
+            REQUIRE(dof_marker[j] < 0);
+            dof_marker[j] = e;
+         }
+      }
+   }
+   for (int e = 0; e < ne; e++) { REQUIRE(elem_count[e] == 1); }
+
+   // Without coloring, all the elements form a single group on the host
+   R.ForceColoredElementGroups(false);
+   if (!Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK))
+   {
+      REQUIRE(R.GetNumElementGroups() == 1);
+   }
+   delete mesh;
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using namespace fem_test;
+
+namespace pa_hyperelastic
+{
+
+double mu_func(const Vector &x) { return 1.0 + 0.5*x(0)*x(1); }
+
+double K_func(const Vector &x) { return 5.0 + x(0) - x(1); }
+
+// Deformed configuration
+void deform(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*x(1)*x(1);
+   y(1) -= 0.1*x(0)*x(1);
+   if (x.Size() == 3) { y(2) += 0.05*sin(M_PI*x(0)); }
+}
+
+} // namespace pa_hyperelastic
+
+TEST_CASE("Hyperelastic partial assembly",
+          "[PartialAssembly][NonlinearPA][Hyperelastic]")
+{
+   using namespace pa_hyperelastic;
+
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto coeffs = GENERATE(false, true);
+
+   INFO("dim = " << dim << ", order = " << order << ", coeffs = " << coeffs);
+
+   Mesh *mesh = MakePerturbedMesh(dim);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   FunctionCoefficient mu(mu_func), K(K_func);
+   NeoHookeanModel *model_fa = coeffs ? new NeoHookeanModel(mu, K) :
+                               new NeoHookeanModel(1.5, 10.0);
+   NeoHookeanModel *model_pa = coeffs ? new NeoHookeanModel(mu, K) :
+                               new NeoHookeanModel(1.5, 10.0);
+   NonlinearForm n_fa(&fes), n_pa(&fes);
+   n_fa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model_fa));
+   n_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model_pa));
+   n_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   n_fa.SetEssentialTrueDofs(ess_tdof_list);
+   n_pa.SetEssentialTrueDofs(ess_tdof_list);
+   n_pa.Setup();
+
+   GridFunction x(&fes);
+   VectorFunctionCoefficient deformation(dim, deform);
+   x.ProjectCoefficient(deformation);
+
+   const int n = fes.GetTrueVSize();
+   Vector y_fa(n), y_pa(n);
+   n_fa.Mult(x, y_fa);
+   n_pa.Mult(x, y_pa);
+   REQUIRE(RelativeDifference(y_pa, y_fa) < 1e-12);
+
+   Vector dx(n);
+   dx.Randomize(1);
+   Operator &grad_fa = n_fa.GetGradient(x);
+   Operator &grad_pa = n_pa.GetGradient(x);
+   REQUIRE(dynamic_cast<SparseMatrix*>(&grad_pa) == NULL);
+   grad_fa.Mult(dx, y_fa);
+   grad_pa.Mult(dx, y_pa);
+   REQUIRE(RelativeDifference(y_pa, y_fa) < 1e-12);
+
+   delete model_pa;
+   delete model_fa;
+   delete mesh;
+}
+
+TEST_CASE("Hyperelastic partial assembly Newton solve",
+          "[PartialAssembly][NonlinearPA][Hyperelastic]")
+{
+   using namespace pa_hyperelastic;
+
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   ess_bdr[2] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   // Perturb the reference configuration and recover it with Newton's method
+   // using the matrix-free gradient
+   NeoHookeanModel model(1.0, 10.0);
+   NonlinearForm n_pa(&fes);
+   n_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+   n_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   n_pa.SetEssentialTrueDofs(ess_tdof_list);
+   n_pa.Setup();
+
+   GridFunction x_ref(&fes), x(&fes);
+   mesh.GetNodes(x_ref);
+   Vector dx(x.Size());
+   dx.Randomize(1);
+   for (int ess : ess_tdof_list) { dx(ess) = 0.0; }
+   add(x_ref, 0.01, dx, x);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(500);
+   cg.SetPrintLevel(-1);
+
+   NewtonSolver newton;
+   newton.SetOperator(n_pa);
+   newton.SetSolver(cg);
+   newton.SetRelTol(1e-10);
+   newton.SetAbsTol(0.0);
+   newton.SetMaxIter(10);
+   newton.SetPrintLevel(-1);
+   newton.iterative_mode = true;
+
+   Vector zero;
+   newton.Mult(zero, x);
+   REQUIRE(newton.GetConverged());
+
+   x -= x_ref;
+   REQUIRE(x.Normlinf() < 1e-8);
+}
@@ -459,4 +459,46 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
 
 } // test case
 
+TEST_CASE("PA Batched Action", "[PartialAssembly]")
+{
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   const int nvec = 3;
+
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 3, Element::QUADRILATERAL, true) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x(0)*x(1); });
+
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.AddDomainIntegrator(new MassIntegrator(coeff));
+   a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   a.Assemble();
+
+   const int n = fes.GetVSize();
+   Vector x(nvec*n), y(nvec*n), y_ref(n);
+   x.Randomize(1);
+   Array<const Vector *> X(nvec);
+   Array<Vector *> Y(nvec);
+   for (int i = 0; i < nvec; i++)
+   {
+      X[i] = new Vector(x.GetData() + i*n, n);
+      Y[i] = new Vector(y.GetData() + i*n, n);
+   }
+   a.ArrayMult(X, Y);
+
+   for (int i = 0; i < nvec; i++)
+   {
+      a.Mult(*X[i], y_ref);
+      y_ref -= *Y[i];
+      REQUIRE(y_ref.Normlinf() == MFEM_Approx(0.0));
+      delete X[i];
+      delete Y[i];
+   }
+   delete mesh;
+}
+
 } // namespace pa_kernels
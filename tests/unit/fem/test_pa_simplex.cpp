@@ -0,0 +1,99 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using namespace fem_test;
+
+namespace pa_simplex
+{
+
+// Compare the action and the diagonal of the partially assembled form with the
+// ones of the legacy assembly.
+void test_pa_simplex(Mesh &mesh, int order, int btype, Problem pb,
+                     Coefficient &q, const IntegrationRule *ir)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim, btype);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm a_ref(&fes), a_pa(&fes);
+   a_ref.AddDomainIntegrator(NewIntegrator(pb, q, ir));
+   a_pa.AddDomainIntegrator(NewIntegrator(pb, q, ir));
+   a_ref.Assemble();
+   a_ref.Finalize();
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.Assemble();
+
+   const int n = fes.GetTrueVSize();
+   Vector x(n), y_ref(n), y_pa(n);
+   x.Randomize(1);
+   a_ref.Mult(x, y_ref);
+   a_pa.Mult(x, y_pa);
+   REQUIRE(RelativeDifference(y_pa, y_ref) < 1e-12);
+
+   Vector diag_ref(n), diag_pa(n);
+   a_ref.AssembleDiagonal(diag_ref);
+   a_pa.AssembleDiagonal(diag_pa);
+   REQUIRE(RelativeDifference(diag_pa, diag_ref) < 1e-12);
+}
+
+} // namespace pa_simplex
+
+TEST_CASE("PA Simplex Bernstein", "[PartialAssembly]")
+{
+   using namespace pa_simplex;
+
+   // Affine meshes and constant coefficients: the legacy and the collapsed
+   // quadrature rules are both exact.
+   auto pb = GENERATE(MASS, DIFFUSION);
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3, 4);
+
+   INFO("dim = " << dim << ", order = " << order << ", problem = " << pb);
+
+   Mesh *mesh = MakeCartesianMesh(dim, true);
+   ConstantCoefficient q(2.0);
+   test_pa_simplex(*mesh, order, BasisType::Positive, pb, q, NULL);
+   delete mesh;
+}
+
+TEST_CASE("PA Simplex", "[PartialAssembly]")
+{
+   using namespace pa_simplex;
+
+   // Curved meshes, variable coefficients and nodal bases with a user-defined
+   // quadrature rule use the generic kernels.
+   auto pb = GENERATE(MASS, DIFFUSION);
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto btype = GENERATE(BasisType::GaussLobatto, BasisType::Positive);
+
+   INFO("dim = " << dim << ", order = " << order << ", problem = " << pb
+        << ", btype = " << btype);
+
+   Mesh *mesh = MakePerturbedMesh(dim, true, 2);
+   FunctionCoefficient q(coeff_func);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 2);
+   test_pa_simplex(*mesh, order, btype, pb, q, &ir);
+
+   // Without a user-defined rule, the nodal bases use the default rules of the
+   // legacy assembly.
+   if (btype == BasisType::GaussLobatto)
+   {
+      test_pa_simplex(*mesh, order, btype, pb, q, NULL);
+   }
+   delete mesh;
+}
@@ -0,0 +1,342 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "fem_test_utils.hpp"
+
+using namespace mfem;
+using namespace fem_test;
+
+namespace quadinterpolator
+{
+
+// Reorder a Q-vector of size NQ x vdim x NE (values) or NQ x vdim x dim x NE
+// (derivatives) from the byNODES to the byVDIM layout
+void NodesToVDim(int NQ, int vdim, int NE, const Vector &x, Vector &y)
+{
+   y.SetSize(x.Size());
+   const int n = x.Size()/(NQ*vdim*NE);
+   auto X = Reshape(x.HostRead(), NQ, vdim, n, NE);
+   auto Y = Reshape(y.HostWrite(), vdim, n, NQ, NE);
+   for (int e = 0; e < NE; e++)
+   {
+      for (int k = 0; k < n; k++)
+      {
+         for (int c = 0; c < vdim; c++)
+         {
+            for (int q = 0; q < NQ; q++) { Y(c,k,q,e) = X(q,c,k,e); }
+         }
+      }
+   }
+}
+
+} // namespace quadinterpolator
+
+TEST_CASE("QuadratureInterpolator transpose",
+          "[QuadratureInterpolator], [PartialAssembly]")
+{
+   using namespace quadinterpolator;
+
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto vector = GENERATE(false, true);
+   auto layout = GENERATE(QVectorLayout::byNODES, QVectorLayout::byVDIM);
+
+   INFO("dim = " << dim << ", order = " << order << ", vector = " << vector
+        << ", layout = " << int(layout));
+
+   Mesh *mesh = MakePerturbedMesh(dim, false);
+   H1_FECollection fec(order, dim);
+   const int vdim = vector ? dim : 1;
+   FiniteElementSpace fes(mesh, &fec, vdim);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(layout);
+
+   const int NE = mesh->GetNE();
+   const int NQ = ir.GetNPoints();
+   const int ND = fes.GetFE(0)->GetDof();
+   Vector x(ND*vdim*NE), val(NQ*vdim*NE), der(NQ*vdim*dim*NE), det;
+   Vector q_val(val.Size()), q_der(der.Size()), y(x.Size());
+   x.Randomize(1);
+   q_val.Randomize(2);
+   q_der.Randomize(3);
+
+   // Check the transposes with the dot products (Mult(x), q) = (x, Mult^T(q))
+   if (layout == QVectorLayout::byNODES)
+   {
+      qi->Mult(x, QuadratureInterpolator::VALUES |
+               QuadratureInterpolator::DERIVATIVES, val, der, det);
+   }
+   else
+   {
+      qi->Values(x, val);
+      qi->Derivatives(x, der);
+   }
+   qi->MultTranspose(QuadratureInterpolator::VALUES |
+                     QuadratureInterpolator::DERIVATIVES, q_val, q_der, y);
+   double ref = (val*q_val) + (der*q_der);
+   REQUIRE(fabs((x*y) - ref) < 1e-12*fabs(ref));
+
+   qi->MultTranspose(QuadratureInterpolator::VALUES, q_val, q_der, y);
+   ref = val*q_val;
+   REQUIRE(fabs((x*y) - ref) < 1e-12*fabs(ref));
+
+   qi->MultTranspose(QuadratureInterpolator::DERIVATIVES, q_val, q_der, y);
+   ref = der*q_der;
+   REQUIRE(fabs((x*y) - ref) < 1e-12*fabs(ref));
+
+   // Physical derivatives: compare with the dot product with PhysDerivatives()
+   // in the byVDIM layout, and with the byVDIM transpose in the byNODES layout
+   Vector q_pder(der.Size());
+   q_pder.Randomize(4);
+   const unsigned phys = QuadratureInterpolator::PHYSICAL_DERIVATIVES;
+   if (layout == QVectorLayout::byVDIM)
+   {
+      qi->PhysDerivatives(x, der);
+      qi->MultTranspose(phys, q_val, q_pder, y);
+      ref = der*q_pder;
+      REQUIRE(fabs((x*y) - ref) < 1e-12*fabs(ref));
+   }
+   else
+   {
+      // Without tensor products, the byNODES layout uses the native E-vector
+      // ordering, while the byVDIM layout uses the lexicographic one
+      const Operator *R_nat =
+         fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+      const Operator *R_lex =
+         fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+      Vector q_pder_v, y_lex(y.Size());
+      NodesToVDim(NQ, vdim, NE, q_pder, q_pder_v);
+      qi->DisableTensorProducts();
+      qi->MultTranspose(phys, q_val, q_pder, y);
+      qi->DisableTensorProducts(false);
+      qi->SetOutputLayout(QVectorLayout::byVDIM);
+      qi->MultTranspose(phys, q_val, q_pder_v, y_lex);
+      qi->SetOutputLayout(QVectorLayout::byNODES);
+
+      Vector b_nat(fes.GetVSize()), b_lex(fes.GetVSize());
+      R_nat->MultTranspose(y, b_nat);
+      R_lex->MultTranspose(y_lex, b_lex);
+      REQUIRE(RelativeDifference(b_nat, b_lex) < 1e-12);
+   }
+
+   delete mesh;
+}
+
+TEST_CASE("QuadratureInterpolator transpose simplices",
+          "[QuadratureInterpolator]")
+{
+   using namespace quadinterpolator;
+
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2);
+
+   INFO("dim = " << dim << ", order = " << order);
+
+   Mesh *mesh = MakePerturbedMesh(dim, true);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+
+   const int NE = mesh->GetNE();
+   const int NQ = ir.GetNPoints();
+   const int ND = fes.GetFE(0)->GetDof();
+   Vector x(ND*dim*NE), val(NQ*dim*NE), der(NQ*dim*dim*NE), det;
+   Vector q_val(val.Size()), q_der(der.Size()), y(x.Size());
+   x.Randomize(1);
+   q_val.Randomize(2);
+   q_der.Randomize(3);
+
+   const unsigned flags = QuadratureInterpolator::VALUES |
+                          QuadratureInterpolator::DERIVATIVES;
+   qi->Mult(x, flags, val, der, det);
+   qi->MultTranspose(flags, q_val, q_der, y);
+   const double ref = (val*q_val) + (der*q_der);
+   REQUIRE(fabs((x*y) - ref) < 1e-12*fabs(ref));
+
+   // The byVDIM layout uses the same (native) E-vector ordering
+   const unsigned phys_flags = QuadratureInterpolator::VALUES |
+                               QuadratureInterpolator::PHYSICAL_DERIVATIVES;
+   Vector q_val_v, q_der_v, y_v(x.Size());
+   NodesToVDim(NQ, dim, NE, q_val, q_val_v);
+   NodesToVDim(NQ, dim, NE, q_der, q_der_v);
+   qi->MultTranspose(phys_flags, q_val, q_der, y);
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+   qi->MultTranspose(phys_flags, q_val_v, q_der_v, y_v);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   REQUIRE(RelativeDifference(y_v, y) < 1e-12);
+
+   delete mesh;
+}
+
+TEST_CASE("QuadratureInterpolator tensor products",
+          "[QuadratureInterpolator], [PartialAssembly]")
+{
+   using namespace quadinterpolator;
+
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+   auto vector = GENERATE(false, true);
+   auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+
+   INFO("dim = " << dim << ", order = " << order << ", vector = " << vector
+        << ", ordering = " << ordering);
+
+   Mesh *mesh = MakePerturbedMesh(dim, false);
+   H1_FECollection fec(order, dim);
+   const int vdim = vector ? dim : 1;
+   FiniteElementSpace fes(mesh, &fec, vdim, ordering);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   REQUIRE(qi->UseTensorProducts(QVectorLayout::byNODES));
+
+   // The tensor product evaluations use the lexicographic E-vector ordering,
+   // the full evaluations use the native one
+   const Operator *R_nat =
+      fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   const Operator *R_lex =
+      fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   GridFunction x(&fes);
+   x.Randomize(1);
+   Vector e_nat(R_nat->Height()), e_lex(R_lex->Height());
+   R_nat->Mult(x, e_nat);
+   R_lex->Mult(x, e_lex);
+
+   const int NE = mesh->GetNE();
+   const int NQ = ir.GetNPoints();
+   unsigned flags = QuadratureInterpolator::VALUES |
+                    QuadratureInterpolator::DERIVATIVES;
+   if (vector) { flags |= QuadratureInterpolator::DETERMINANTS; }
+   Vector val(NQ*vdim*NE), der(NQ*vdim*dim*NE), det(vector ? NQ*NE : 0);
+   Vector val_f(val.Size()), der_f(der.Size()), det_f(det.Size());
+
+   qi->Mult(e_lex, flags, val, der, det);
+   qi->DisableTensorProducts();
+   REQUIRE(!qi->UseTensorProducts(QVectorLayout::byNODES));
+   qi->Mult(e_nat, flags, val_f, der_f, det_f);
+   qi->DisableTensorProducts(false);
+
+   REQUIRE(RelativeDifference(val_f, val) < 1e-12);
+   REQUIRE(RelativeDifference(der_f, der) < 1e-12);
+   if (vector)
+   {
+      REQUIRE(RelativeDifference(det_f, det) < 1e-12);
+
+      // The determinants alone use a temporary gradient
+      Vector det_only(det.Size());
+      qi->Mult(e_lex, QuadratureInterpolator::DETERMINANTS, val, der,
+               det_only);
+      REQUIRE(RelativeDifference(det_only, det) < 1e-12);
+   }
+
+   // The fused evaluations gather the dofs from the L-vector
+   const ElementRestriction *R = dynamic_cast<const ElementRestriction*>(R_lex);
+   REQUIRE(R != NULL);
+   for (auto layout : { QVectorLayout::byNODES, QVectorLayout::byVDIM })
+   {
+      qi->SetOutputLayout(layout);
+      qi->Mult(e_lex, flags, val, der, det);
+      qi->MultFused(*R, x, flags, val_f, der_f, det_f);
+      REQUIRE(RelativeDifference(val_f, val) < 1e-12);
+      REQUIRE(RelativeDifference(der_f, der) < 1e-12);
+      if (vector) { REQUIRE(RelativeDifference(det_f, det) < 1e-12); }
+   }
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+
+   delete mesh;
+}
+
+TEST_CASE("GeometricFactors", "[QuadratureInterpolator], [Mesh]")
+{
+   using namespace quadinterpolator;
+
+   auto dim = GENERATE(2, 3);
+   auto simplex = GENERATE(false, true);
+   auto order = GENERATE(1, 3);
+
+   INFO("dim = " << dim << ", simplex = " << simplex << ", order = " << order);
+
+   Mesh *mesh = MakePerturbedMesh(dim, simplex);
+   mesh->SetCurvature(order);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+   const int flags = GeometricFactors::COORDINATES |
+                     GeometricFactors::JACOBIANS |
+                     GeometricFactors::DETERMINANTS;
+
+   // Compare with the element transformations
+   auto check = [&](const GeometricFactors *geom)
+   {
+      const int NQ = ir.GetNPoints();
+      const int NE = mesh->GetNE();
+      auto X = Reshape(geom->X.HostRead(), NQ, dim, NE);
+      auto J = Reshape(geom->J.HostRead(), NQ, dim, dim, NE);
+      auto D = Reshape(geom->detJ.HostRead(), NQ, NE);
+      double err = 0.0;
+      Vector x;
+      for (int e = 0; e < NE; e++)
+      {
+         ElementTransformation *T = mesh->GetElementTransformation(e);
+         for (int q = 0; q < NQ; q++)
+         {
+            T->SetIntPoint(&ir.IntPoint(q));
+            T->Transform(ir.IntPoint(q), x);
+            const DenseMatrix &Jq = T->Jacobian();
+            for (int i = 0; i < dim; i++)
+            {
+               err = fmax(err, fabs(X(q,i,e) - x(i)));
+               for (int j = 0; j < dim; j++)
+               {
+                  err = fmax(err, fabs(J(q,i,j,e) - Jq(i,j)));
+               }
+            }
+            err = fmax(err, fabs(D(q,e) - T->Weight()));
+         }
+      }
+      return err;
+   };
+
+   // The settings of the interpolator of the nodes space are not used and
+   // not modified
+   const QuadratureInterpolator *qi =
+      mesh->GetNodes()->FESpace()->GetQuadratureInterpolator(ir);
+   qi->DisableTensorProducts();
+   qi->SetOutputLayout(QVectorLayout::byVDIM);
+
+   const GeometricFactors *geom = mesh->GetGeometricFactors(ir, flags);
+   REQUIRE(check(geom) < 1e-12);
+   REQUIRE(!qi->UseTensorProducts(QVectorLayout::byNODES));
+   REQUIRE(qi->GetOutputLayout() == QVectorLayout::byVDIM);
+
+   // The stored factors are reused until the nodes are modified, then they
+   // are recomputed in place
+   REQUIRE(mesh->GetGeometricFactors(ir, flags) == geom);
+   const long seq = mesh->GetNodesSequence();
+   mesh->Transform(perturb);
+   REQUIRE(mesh->GetNodesSequence() > seq);
+   REQUIRE(mesh->GetGeometricFactors(ir, flags) == geom);
+   REQUIRE(check(geom) < 1e-12);
+
+   *mesh->GetNodes() *= 2.0;
+   mesh->NodesUpdated();
+   REQUIRE(mesh->GetGeometricFactors(ir, flags) == geom);
+   REQUIRE(check(geom) < 1e-12);
+
+   delete mesh;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace anderson
+{
+
+// Picard map G(u) = A^{-1} (b - lambda u^3) for the semilinear problem
+// A u + lambda u^3 = b, where A is symmetric positive definite.
+class PicardMap : public Operator
+{
+private:
+   const SparseMatrix &A;
+   const Vector &b;
+   double lambda;
+   CGSolver cg;
+   DSmoother jacobi;
+   mutable Vector rhs;
+
+public:
+   PicardMap(const SparseMatrix &A_, const Vector &b_, double lambda_)
+      : Operator(A_.Height()), A(A_), b(b_), lambda(lambda_), jacobi(A_),
+        rhs(A_.Height())
+   {
+      cg.SetOperator(A);
+      cg.SetPreconditioner(jacobi);
+      cg.SetRelTol(1e-14);
+      cg.SetMaxIter(1000);
+      cg.SetPrintLevel(-1);
+      cg.iterative_mode = false;
+   }
+
+   virtual void Mult(const Vector &u, Vector &Gu) const
+   {
+      for (int i = 0; i < u.Size(); i++)
+      {
+         rhs(i) = b(i) - lambda*u(i)*u(i)*u(i);
+      }
+      cg.Mult(rhs, Gu);
+   }
+};
+
+} // namespace anderson
+
+TEST_CASE("Anderson acceleration", "[AndersonSolver]")
+{
+   using namespace anderson;
+
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0), f_coeff(50.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   LinearForm lf(&fes);
+   lf.AddDomainIntegrator(new DomainLFIntegrator(f_coeff));
+   lf.Assemble();
+
+   GridFunction u(&fes);
+   u = 0.0;
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, u, lf, A, X, B);
+
+   const double lambda = 0.01;
+   PicardMap G(A, B, lambda);
+
+   AndersonSolver picard, anderson;
+   for (AndersonSolver *solver : { &picard, &anderson })
+   {
+      solver->SetOperator(G);
+      solver->SetRelTol(1e-10);
+      solver->SetAbsTol(0.0);
+      solver->SetMaxIter(500);
+      solver->SetPrintLevel(-1);
+   }
+   picard.SetWindowSize(0);
+
+   Vector u_picard(X.Size()), u_anderson(X.Size()), zero;
+   u_picard = 0.0;
+   picard.Mult(zero, u_picard);
+   REQUIRE(picard.GetConverged());
+
+   // Checks the residual of the semilinear problem
+   auto check_solution = [&](const Vector &x)
+   {
+      Vector r(x.Size());
+      A.Mult(x, r);
+      for (int i = 0; i < x.Size(); i++) { r(i) += lambda*x(i)*x(i)*x(i); }
+      r -= B;
+      REQUIRE(r.Norml2() < 1e-8*B.Norml2());
+   };
+   check_solution(u_picard);
+
+   SECTION("Default parameters")
+   {
+      u_anderson = 0.0;
+      anderson.Mult(zero, u_anderson);
+      REQUIRE(anderson.GetConverged());
+      REQUIRE(2*anderson.GetNumIterations() < picard.GetNumIterations());
+      check_solution(u_anderson);
+   }
+
+   SECTION("Damping and restart")
+   {
+      anderson.SetWindowSize(3);
+      anderson.SetDamping(0.8);
+      anderson.SetRestart(6);
+      u_anderson = 0.0;
+      anderson.Mult(zero, u_anderson);
+      REQUIRE(anderson.GetConverged());
+      REQUIRE(anderson.GetNumIterations() < picard.GetNumIterations());
+      check_solution(u_anderson);
+   }
+}
@@ -0,0 +1,221 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace block_krylov
+{
+
+// Solve the k systems A X[i] = B[i] one by one with the solver 'single' and
+// simultaneously with the solver 'block'. Check that the solutions agree and
+// return the total number of iterations of 'single' and 'block'.
+void SolveMultipleRHS(const Operator &A, Solver *prec, IterativeSolver &single,
+                      IterativeSolver &block, const Array<Vector *> &B,
+                      int &single_iter, int &block_iter)
+{
+   const int k = B.Size(), n = A.Height();
+   Array<const Vector *> cB(k);
+   Array<Vector *> X(k);
+   for (int i = 0; i < k; i++)
+   {
+      cB[i] = B[i];
+      X[i] = new Vector(n);
+   }
+
+   for (IterativeSolver *solver : { &single, &block })
+   {
+      solver->SetRelTol(1e-12);
+      solver->SetAbsTol(0.0);
+      solver->SetMaxIter(2000);
+      solver->SetPrintLevel(-1);
+      solver->SetOperator(A);
+      if (prec) { solver->SetPreconditioner(*prec); }
+   }
+
+   Vector x(n), r(n);
+   single_iter = 0;
+   for (int i = 0; i < k; i++)
+   {
+      single.Mult(*B[i], *X[i]);
+      REQUIRE(single.GetConverged());
+      single_iter += single.GetNumIterations();
+   }
+
+   Array<Vector *> Xb(k);
+   for (int i = 0; i < k; i++) { Xb[i] = new Vector(n); }
+   block.ArrayMult(cB, Xb);
+   REQUIRE(block.GetConverged());
+   block_iter = block.GetNumIterations();
+
+   for (int i = 0; i < k; i++)
+   {
+      A.Mult(*Xb[i], r);
+      r -= *B[i];
+      REQUIRE(r.Norml2() < 1e-8*B[i]->Norml2());
+
+      x = *Xb[i];
+      x -= *X[i];
+      REQUIRE(x.Normlinf() < 1e-8*X[i]->Normlinf());
+      delete Xb[i];
+      delete X[i];
+   }
+}
+
+} // namespace block_krylov
+
+TEST_CASE("Block Krylov solvers", "[BlockCGSolver][BlockGMRESSolver]")
+{
+   using namespace block_krylov;
+
+   const int k = 4;
+   Mesh mesh(8, 8, 8, Element::HEXAHEDRON, true);
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   // Right-hand sides: point loads at different locations
+   Array<Vector *> b(k);
+   for (int i = 0; i < k; i++)
+   {
+      Vector center(3);
+      center = 0.25 + 0.15*i;
+      FunctionCoefficient load([center](const Vector &x)
+      {
+         Vector d(x);
+         d -= center;
+         return exp(-50.0*(d*d));
+      });
+      LinearForm lf(&fes);
+      lf.AddDomainIntegrator(new DomainLFIntegrator(load));
+      lf.Assemble();
+      b[i] = new Vector(lf);
+   }
+
+   SECTION("BlockCGSolver")
+   {
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+
+      Array<Vector *> B(k);
+      OperatorPtr A;
+      Vector x(fes.GetVSize()), X;
+      x = 0.0;
+      for (int i = 0; i < k; i++)
+      {
+         B[i] = new Vector;
+         a.FormLinearSystem(ess_tdof_list, x, *b[i], A, X, *B[i]);
+      }
+      OperatorJacobiSmoother jacobi(a, ess_tdof_list);
+
+      CGSolver cg;
+      BlockCGSolver bcg;
+      int cg_iter, bcg_iter;
+      SolveMultipleRHS(*A, &jacobi, cg, bcg, B, cg_iter, bcg_iter);
+      mfem::out << "Poisson, total iterations: CG = " << cg_iter
+                << ", block CG = " << bcg_iter << '\n';
+      REQUIRE(k*bcg_iter < cg_iter);
+
+      for (int i = 0; i < k; i++) { delete B[i]; }
+   }
+
+   SECTION("BlockGMRESSolver")
+   {
+      Vector velocity(3);
+      velocity(0) = 20.0;
+      velocity(1) = 10.0;
+      velocity(2) = 5.0;
+      VectorConstantCoefficient vel(velocity);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.AddDomainIntegrator(new ConvectionIntegrator(vel));
+      a.Assemble();
+
+      Array<Vector *> B(k);
+      SparseMatrix A;
+      Vector x(fes.GetVSize()), X;
+      x = 0.0;
+      for (int i = 0; i < k; i++)
+      {
+         B[i] = new Vector;
+         a.FormLinearSystem(ess_tdof_list, x, *b[i], A, X, *B[i]);
+      }
+      DSmoother jacobi(A);
+
+      GMRESSolver gmres;
+      BlockGMRESSolver bgmres;
+      gmres.SetKDim(30);
+      bgmres.SetKDim(30);
+      int gmres_iter, bgmres_iter;
+      SolveMultipleRHS(A, &jacobi, gmres, bgmres, B, gmres_iter, bgmres_iter);
+      mfem::out << "Convection-diffusion, total iterations: GMRES = "
+                << gmres_iter << ", block GMRES = " << bgmres_iter << '\n';
+      REQUIRE(k*bgmres_iter < 1.2*gmres_iter);
+
+      for (int i = 0; i < k; i++) { delete B[i]; }
+   }
+
+   for (int i = 0; i < k; i++) { delete b[i]; }
+}
+
+TEST_CASE("ConstrainedOperator ArrayMult", "[ConstrainedOperator]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   a.Finalize();
+
+   const int k = 3, n = fes.GetVSize();
+   Array<const Vector *> X(k);
+   Array<Vector *> Y(k);
+   for (int i = 0; i < k; i++)
+   {
+      Vector *x = new Vector(n);
+      x->Randomize(i + 1);
+      X[i] = x;
+      Y[i] = new Vector(n);
+   }
+
+   // The action on a set of vectors is the same as the one on each vector
+   Vector y(n);
+   for (auto policy : { Operator::DIAG_ONE, Operator::DIAG_ZERO })
+   {
+      ConstrainedOperator A(&a.SpMat(), ess_tdof_list, false, policy);
+      A.ArrayMult(X, Y);
+      for (int i = 0; i < k; i++)
+      {
+         A.Mult(*X[i], y);
+         y -= *Y[i];
+         REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+      }
+   }
+
+   for (int i = 0; i < k; i++)
+   {
+      delete X[i];
+      delete Y[i];
+   }
+}
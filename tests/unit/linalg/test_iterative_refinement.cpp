@@ -0,0 +1,127 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("Iterative refinement", "[IterativeRefinementSolver]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   ConstantCoefficient eps(0.01);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.AddDomainIntegrator(new DiffusionIntegrator(eps));
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix &A = a.SpMat();
+
+   const int n = A.Height();
+   Vector b(n), x(n), r(n);
+   b.Randomize(1);
+   x = 0.0;
+
+   IterativeRefinementSolver ir;
+   ir.SetRelTol(1e-13);
+   ir.SetAbsTol(0.0);
+   ir.SetMaxIter(50);
+   ir.SetPrintLevel(-1);
+
+   SECTION("Inexact inner solver")
+   {
+      // Inner solver with a loose tolerance
+      CGSolver cg;
+      cg.SetRelTol(1e-3);
+      cg.SetMaxIter(200);
+      cg.SetPrintLevel(-1);
+      ir.SetPreconditioner(cg);
+      ir.SetOperator(A);
+      ir.Mult(b, x);
+
+      REQUIRE(ir.GetConverged());
+      REQUIRE(ir.GetFinalMode() == IterativeRefinementSolver::IR);
+      REQUIRE(ir.GetNumIterations() < 10);
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-13*b.Norml2());
+   }
+
+   SECTION("Fallback to GMRES-IR")
+   {
+      // Jacobi is too weak for IR alone, the solver switches to GMRES-IR
+      DSmoother jacobi(A);
+      ir.SetPreconditioner(jacobi);
+      ir.SetOperator(A);
+      ir.Mult(b, x);
+
+      REQUIRE(ir.GetConverged());
+      REQUIRE(ir.GetFinalMode() == IterativeRefinementSolver::GMRES_IR);
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-13*b.Norml2());
+   }
+
+   SECTION("Single precision direct solver")
+   {
+      // A solve in single precision alone is not accurate
+      SinglePrecisionDenseSolver lu;
+      lu.SetOperator(A);
+      Vector xs(n);
+      lu.Mult(b, xs);
+      A.Mult(xs, r);
+      r -= b;
+      REQUIRE(r.Norml2() > 1e-10*b.Norml2());
+
+      ir.SetPreconditioner(lu);
+      ir.SetOperator(A);
+      ir.Mult(b, x);
+
+      REQUIRE(ir.GetConverged());
+      REQUIRE(ir.GetFinalMode() == IterativeRefinementSolver::IR);
+      REQUIRE(ir.GetNumIterations() < 10);
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-13*b.Norml2());
+   }
+
+   SECTION("Single precision smoother")
+   {
+      SinglePrecisionGSSmoother gs(2);
+      ir.SetPreconditioner(gs);
+      ir.SetOperator(A);
+      ir.Mult(b, x);
+
+      REQUIRE(ir.GetConverged());
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-13*b.Norml2());
+   }
+
+   SECTION("Stagnation")
+   {
+      // A tolerance below the round-off level cannot be reached
+      DSmoother jacobi(A);
+      ir.SetRelTol(1e-20);
+      ir.SetPreconditioner(jacobi);
+      ir.SetOperator(A);
+      ir.Mult(b, x);
+
+      REQUIRE(!ir.GetConverged());
+      REQUIRE(ir.GetNumIterations() < 50);
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-12*b.Norml2());
+   }
+}
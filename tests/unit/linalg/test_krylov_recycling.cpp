@@ -0,0 +1,177 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace krylov_recycling
+{
+
+// Backward Euler time stepping for the heat equation du/dt = div(grad u) + 1,
+// solving (M + dt K) u_{n+1} = M u_n + dt b with the given solver. The time
+// step is halved once in the middle of the run, which changes the operator.
+// Returns the total number of linear solver iterations.
+int HeatEquation(IterativeSolver &solver, Vector &u)
+{
+   Mesh mesh(16, 16, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm m(&fes), k(&fes);
+   m.AddDomainIntegrator(new MassIntegrator);
+   k.AddDomainIntegrator(new DiffusionIntegrator);
+   m.Assemble();
+   m.Finalize();
+   k.Assemble();
+   k.Finalize();
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+
+   FunctionCoefficient u0([](const Vector &x)
+   {
+      return sin(M_PI*x(0))*cos(2*M_PI*x(1)) + x(0)*x(1);
+   });
+   GridFunction u_gf(&fes);
+   u_gf.ProjectCoefficient(u0);
+   u = u_gf;
+
+   const int nsteps = 20;
+   double dt = 1e-2;
+   SparseMatrix *A = NULL;
+   DSmoother *jacobi = NULL;
+   Vector rhs(fes.GetVSize());
+   int total_iter = 0;
+   for (int step = 0; step < nsteps; step++)
+   {
+      if (step == 0 || step == nsteps/2)
+      {
+         if (step > 0) { dt /= 2; }
+         delete A;
+         delete jacobi;
+         A = Add(1.0, m.SpMat(), dt, k.SpMat());
+         jacobi = new DSmoother(*A);
+         solver.SetPreconditioner(*jacobi);
+         solver.SetOperator(*A);
+      }
+      m.Mult(u, rhs);
+      rhs.Add(dt, b);
+      solver.Mult(rhs, u);
+      REQUIRE(solver.GetConverged());
+      total_iter += solver.GetNumIterations();
+
+      Vector res(rhs.Size());
+      A->Mult(u, res);
+      res -= rhs;
+      REQUIRE(res.Norml2() < 1e-8*rhs.Norml2());
+   }
+   delete jacobi;
+   delete A;
+   return total_iter;
+}
+
+} // namespace krylov_recycling
+
+TEST_CASE("Krylov subspace recycling", "[DeflatedCGSolver][GCROSolver]")
+{
+   using namespace krylov_recycling;
+
+   SECTION("DeflatedCGSolver")
+   {
+      CGSolver cg;
+      cg.SetRelTol(0.0);
+      cg.SetAbsTol(1e-12);
+      cg.SetMaxIter(1000);
+      cg.iterative_mode = true;
+      Vector u_cg;
+      const int cg_iter = HeatEquation(cg, u_cg);
+
+      DeflatedCGSolver dcg;
+      dcg.SetRelTol(0.0);
+      dcg.SetAbsTol(1e-12);
+      dcg.SetMaxIter(1000);
+      dcg.SetDeflationDim(16);
+      dcg.iterative_mode = true;
+      Vector u_dcg;
+      const int dcg_iter = HeatEquation(dcg, u_dcg);
+
+      REQUIRE(dcg.GetDeflationDim() == 16);
+      REQUIRE(dcg_iter < 0.8*cg_iter);
+
+      u_dcg -= u_cg;
+      REQUIRE(u_dcg.Normlinf() < 1e-8);
+   }
+
+   SECTION("GCROSolver")
+   {
+      GMRESSolver gmres;
+      gmres.SetRelTol(0.0);
+      gmres.SetAbsTol(1e-12);
+      gmres.SetMaxIter(1000);
+      gmres.SetKDim(20);
+      gmres.iterative_mode = true;
+      Vector u_gmres;
+      const int gmres_iter = HeatEquation(gmres, u_gmres);
+
+      GCROSolver gcro;
+      gcro.SetRelTol(0.0);
+      gcro.SetAbsTol(1e-12);
+      gcro.SetMaxIter(1000);
+      gcro.SetKDim(20);
+      gcro.SetRecycleDim(10);
+      gcro.iterative_mode = true;
+      Vector u_gcro;
+      const int gcro_iter = HeatEquation(gcro, u_gcro);
+
+      REQUIRE(gcro.GetRecycledDim() == 10);
+      REQUIRE(gcro_iter < 0.8*gmres_iter);
+
+      u_gcro -= u_gmres;
+      REQUIRE(u_gcro.Normlinf() < 1e-8);
+   }
+}
+
+TEST_CASE("Deflated CG with a dependent recycled space", "[DeflatedCGSolver]")
+{
+   // CG needs more than n iterations for this small ill-conditioned system due
+   // to the loss of orthogonality, so the deflation space and the harvested
+   // search directions are linearly dependent.
+   const int n = 12;
+   SparseMatrix A(n);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, pow(10.0, -8.0*i/(n-1)));
+   }
+   A.Finalize();
+
+   DeflatedCGSolver dcg;
+   dcg.SetRelTol(1e-12);
+   dcg.SetAbsTol(0.0);
+   dcg.SetMaxIter(10*n);
+   dcg.SetDeflationDim(4, 4*n);
+   dcg.SetOperator(A);
+
+   Vector b(n), x(n), r(n);
+   for (int k = 0; k < 4; k++)
+   {
+      b.Randomize(k + 1);
+      dcg.Mult(b, x);
+      REQUIRE(dcg.GetConverged());
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() < 1e-10*b.Norml2());
+      REQUIRE(dcg.GetDeflationDim() == 4);
+   }
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace lobpcg
+{
+
+// Check the eigenpairs computed by 'lobpcg' against the reference eigenvalues
+// 'ref' of the problem A x = lambda M x.
+void CheckEigenpairs(const LOBPCGSolver &lobpcg, const Operator &A,
+                     const Operator &M, const Vector &ref, int nev)
+{
+   REQUIRE(lobpcg.GetNumConverged() == nev);
+   Array<double> evals;
+   lobpcg.GetEigenvalues(evals);
+   REQUIRE(evals.Size() == nev);
+
+   const int n = A.Height();
+   Vector Ax(n), Mx(n), My(n);
+   for (int i = 0; i < nev; i++)
+   {
+      REQUIRE(evals[i] == MFEM_Approx(ref(i), 1e-8));
+
+      const Vector &x = lobpcg.GetEigenvector(i);
+      A.Mult(x, Ax);
+      M.Mult(x, Mx);
+      Ax.Add(-evals[i], Mx);
+      REQUIRE(Ax.Norml2() < 1e-6);
+
+      // The eigenvectors are M-orthonormal
+      for (int j = 0; j < nev; j++)
+      {
+         M.Mult(lobpcg.GetEigenvector(j), My);
+         REQUIRE(fabs(x*My - (i == j)) < 1e-8);
+      }
+   }
+}
+
+} // namespace lobpcg
+
+TEST_CASE("LOBPCG eigensolver", "[LOBPCGSolver]")
+{
+   using namespace lobpcg;
+
+   const int nev = 5;
+   Mesh mesh(6, 6, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   // Neumann eigenproblem -Delta u + u = lambda u
+   BilinearForm a(&fes), m(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   m.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   m.Assemble();
+   m.Finalize();
+
+   // Reference eigenvalues
+   DenseMatrix Ad, Md;
+   a.SpMat().ToDenseMatrix(Ad);
+   m.SpMat().ToDenseMatrix(Md);
+   Vector ref;
+   Ad.Eigenvalues(Md, ref);
+   REQUIRE(ref(0) == MFEM_Approx(1.0));
+   REQUIRE(fabs(ref(1) - (1.0 + M_PI*M_PI)) < 1e-2);
+
+   LOBPCGSolver lobpcg;
+   lobpcg.SetNumModes(nev);
+   lobpcg.SetTol(1e-10);
+   lobpcg.SetMaxIter(200);
+   lobpcg.SetPrintLevel(-1);
+
+   SECTION("Assembled operators")
+   {
+      DSmoother jacobi(a.SpMat());
+      lobpcg.SetOperator(a.SpMat());
+      lobpcg.SetMassMatrix(m.SpMat());
+      lobpcg.SetPreconditioner(jacobi);
+      lobpcg.Solve();
+      CheckEigenpairs(lobpcg, a.SpMat(), m.SpMat(), ref, nev);
+   }
+
+   SECTION("Partially assembled operators")
+   {
+      BilinearForm a_pa(&fes), m_pa(&fes);
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      m_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_pa.AddDomainIntegrator(new DiffusionIntegrator);
+      a_pa.AddDomainIntegrator(new MassIntegrator);
+      m_pa.AddDomainIntegrator(new MassIntegrator);
+      a_pa.Assemble();
+      m_pa.Assemble();
+
+      Array<int> ess_tdof_list;
+      OperatorJacobiSmoother jacobi(a_pa, ess_tdof_list);
+      lobpcg.SetOperator(a_pa);
+      lobpcg.SetMassMatrix(m_pa);
+      lobpcg.SetPreconditioner(jacobi);
+      lobpcg.Solve();
+      CheckEigenpairs(lobpcg, a_pa, m_pa, ref, nev);
+   }
+
+   SECTION("Standard eigenproblem without preconditioner")
+   {
+      DenseMatrix Id(Ad.Height());
+      Id = 0.0;
+      for (int i = 0; i < Ad.Height(); i++) { Id(i,i) = 1.0; }
+      Vector ref_std;
+      Ad.Eigenvalues(Id, ref_std);
+
+      IdentityOperator I(Ad.Height());
+      lobpcg.SetOperator(a.SpMat());
+      lobpcg.SetMaxIter(1000);
+      lobpcg.Solve();
+      CheckEigenpairs(lobpcg, a.SpMat(), I, ref_std, nev);
+   }
+}
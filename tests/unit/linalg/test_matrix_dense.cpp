@@ -293,3 +293,42 @@ TEST_CASE("DenseTensor LinearSolve methods",
       }
    }
 }
+
+TEST_CASE("DenseTensor BatchInverseMatrix",
+          "[DenseMatrix]")
+{
+   const int NE = 7;
+   // Test both a specialized (8) and a generic (5) matrix size
+   for (int N : {5, 8})
+   {
+      DenseTensor A_batch(N,N,NE);
+      for (int e=0; e<NE; ++e)
+      {
+         for (int j=0; j<N; ++j)
+         {
+            for (int i=0; i<N; ++i)
+            {
+               A_batch(i,j,e) = (i == j) ? N + e : sin(1.0 + i + 2*j + 3*e);
+            }
+         }
+      }
+
+      DenseTensor A_inv(A_batch);
+      BatchInverseMatrix(A_inv);
+
+      DenseMatrix I(N);
+      A_inv.HostRead();
+      for (int e=0; e<NE; ++e)
+      {
+         Mult(A_batch(e), A_inv(e), I);
+         for (int i=0; i<N; ++i) { I(i,i) -= 1.0; }
+         REQUIRE(I.MaxMaxNorm() == MFEM_Approx(0.0));
+
+         DenseMatrixInverse A_dinv(A_batch(e));
+         DenseMatrix A_e_inv;
+         A_dinv.GetInverseMatrix(A_e_inv);
+         A_e_inv -= A_inv(e);
+         REQUIRE(A_e_inv.MaxMaxNorm() == MFEM_Approx(0.0));
+      }
+   }
+}
@@ -99,6 +99,53 @@ TEST_CASE("HypreParMatrixAbsMult",  "[Parallel], [HypreParMatrixAbsMult]")
    }
 }
 
+TEST_CASE("HypreRAPPlan", "[Parallel], [HypreRAPPlan]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec1(1, 2), fec2(2, 2);
+   ParFiniteElementSpace fes1(&pmesh, &fec1), fes2(&pmesh, &fec2);
+
+   ParMixedBilinearForm p(&fes1, &fes2);
+   p.AddDomainIntegrator(new MixedScalarMassIntegrator);
+   p.Assemble();
+   p.Finalize();
+   HypreParMatrix *P = p.ParallelAssemble();
+
+   HypreRAPPlan plan(*P);
+   const HypreParMatrix *C_prev = NULL;
+   for (int k = 0; k < 3; k++)
+   {
+      FunctionCoefficient kappa([k](const Vector &x)
+      {
+         return 1.0 + k*x(0)*x(1);
+      });
+      ParBilinearForm a(&fes2);
+      a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+      a.Assemble(0);
+      a.Finalize(0);
+      HypreParMatrix *A = a.ParallelAssemble();
+
+      HypreParMatrix &C = plan.Mult(*A);
+      if (C_prev) { REQUIRE(&C == C_prev); }
+      C_prev = &C;
+
+      HypreParMatrix *C_ref = RAP(A, P);
+      Vector x(C.Width()), y(C.Height()), y_ref(C.Height());
+      x.Randomize(1);
+      C.Mult(x, y);
+      C_ref->Mult(x, y_ref);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+      delete C_ref;
+      delete A;
+   }
+   plan.ReleaseTranspose();
+   // The plan does not access P after this point
+   delete P;
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem
@@ -12,6 +12,9 @@
 #include "mfem.hpp"
 #include "unit_tests.hpp"
 
+#include <set>
+#include <vector>
+
 namespace mfem
 {
 
@@ -83,4 +86,153 @@ TEST_CASE("SparseMatrixAbsMult", "[SparseMatrixAbsMult]")
    }
 }
 
+TEST_CASE("SparseMatrix RAPPlan", "[RAPPlan]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   H1_FECollection fec1(1, 2), fec2(2, 2);
+   FiniteElementSpace fes1(&mesh, &fec1), fes2(&mesh, &fec2);
+
+   // Rectangular "prolongation" and "restriction" matrices
+   Vector dir(2);
+   dir(0) = 1.0;
+   dir(1) = 2.0;
+   VectorConstantCoefficient dir_coeff(dir);
+   MixedBilinearForm p(&fes1, &fes2), rt(&fes1, &fes2);
+   p.AddDomainIntegrator(new MixedScalarMassIntegrator);
+   rt.AddDomainIntegrator(new MixedScalarMassIntegrator);
+   rt.AddDomainIntegrator(new MixedDirectionalDerivativeIntegrator(dir_coeff));
+   p.Assemble();
+   p.Finalize();
+   rt.Assemble();
+   rt.Finalize();
+   SparseMatrix &P = p.SpMat(), &Rt = rt.SpMat();
+   SparseMatrix *R = Transpose(P);
+
+   RAPPlan plan_p(P), plan_rp(Rt, P);
+   const SparseMatrix *C_prev = NULL;
+   for (int k = 0; k < 3; k++)
+   {
+      // Diffusion matrices with the same sparsity and different values
+      FunctionCoefficient kappa([k](const Vector &x)
+      {
+         return 1.0 + k*x(0)*x(1);
+      });
+      BilinearForm a(&fes2);
+      a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+      a.Assemble(0);
+      a.Finalize(0);
+
+      SparseMatrix &C = plan_p.Mult(a.SpMat());
+      if (C_prev) { REQUIRE(&C == C_prev); }
+      C_prev = &C;
+      SparseMatrix *C_ref = RAP(a.SpMat(), *R);
+      SparseMatrix *D = Add(1.0, C, -1.0, *C_ref);
+      REQUIRE(D->MaxNorm() < 1e-12*C_ref->MaxNorm());
+      delete D;
+      delete C_ref;
+
+      SparseMatrix &C2 = plan_rp.Mult(a.SpMat());
+      C_ref = RAP(Rt, a.SpMat(), P);
+      D = Add(1.0, C2, -1.0, *C_ref);
+      REQUIRE(D->MaxNorm() < 1e-12*C_ref->MaxNorm());
+      delete D;
+      delete C_ref;
+   }
+   delete R;
+}
+
+// Number of nonzeros in the Cholesky factor of the matrix with the given
+// ordering, computed by symbolic elimination.
+static int CholeskyFill(const SparseMatrix &A, const Array<int> &ordering)
+{
+   const int n = A.Height();
+   std::vector<std::set<int>> adj(n);
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = A.GetI()[i]; k < A.GetI()[i+1]; k++)
+      {
+         const int j = A.GetJ()[k];
+         if (j != i) { adj[ordering[i]].insert(ordering[j]); }
+      }
+   }
+   int fill = n;
+   for (int k = 0; k < n; k++)
+   {
+      std::vector<int> higher;
+      for (int j : adj[k]) { if (j > k) { higher.push_back(j); } }
+      fill += higher.size();
+      for (int i : higher)
+      {
+         for (int j : higher) { if (i != j) { adj[i].insert(j); } }
+      }
+   }
+   return fill;
+}
+
+TEST_CASE("SparseMatrix orderings", "[SparseMatrix]")
+{
+   Mesh mesh(24, 24, Element::QUADRILATERAL, true);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator);
+   a.Assemble();
+   a.Finalize();
+   const int n = a.Height();
+
+   // Scramble the natural ordering
+   Array<int> scramble(n);
+   for (int i = 0; i < n; i++) { scramble[i] = (7919*i) % n; }
+   SparseMatrix *A = PermuteRowsCols(a.SpMat(), scramble);
+
+   Array<int> identity(n), rcm, nd;
+   for (int i = 0; i < n; i++) { identity[i] = i; }
+   A->GetRCMOrdering(rcm);
+   A->GetNestedDissectionOrdering(nd, 16);
+
+   for (Array<int> *ordering : { &rcm, &nd })
+   {
+      // The ordering is a permutation
+      Array<int> marker(n);
+      marker = 0;
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE((0 <= (*ordering)[i] && (*ordering)[i] < n));
+         marker[(*ordering)[i]]++;
+      }
+      REQUIRE(marker.Min() == 1);
+
+      // B P x = P A x, where (P x)[ordering[i]] = x[i]
+      SparseMatrix *B = PermuteRowsCols(*A, *ordering);
+      Vector x(n), Px(n), y(n), Py(n), z(n);
+      x.Randomize(1);
+      A->Mult(x, y);
+      for (int i = 0; i < n; i++) { Px((*ordering)[i]) = x(i); }
+      for (int i = 0; i < n; i++) { Py((*ordering)[i]) = y(i); }
+      B->Mult(Px, z);
+      z -= Py;
+      REQUIRE(z.Normlinf() < 1e-12*y.Normlinf());
+      delete B;
+   }
+
+   // RCM reduces the bandwidth of the scrambled matrix to the order of the
+   // number of vertices along one side of the mesh
+   SparseMatrix *B = PermuteRowsCols(*A, rcm);
+   REQUIRE(B->GetBandwidth() < 2*(24+1) + 2);
+   REQUIRE(B->GetBandwidth() < A->GetBandwidth());
+   delete B;
+
+   // Nested dissection reduces the fill-in of the Cholesky factor
+   const int fill_natural = CholeskyFill(a.SpMat(), identity);
+   const int fill_rcm = CholeskyFill(*A, rcm);
+   const int fill_nd = CholeskyFill(*A, nd);
+   mfem::out << "Cholesky fill: natural = " << fill_natural << ", RCM = "
+             << fill_rcm << ", ND = " << fill_nd << '\n';
+   REQUIRE(fill_nd < fill_natural);
+   REQUIRE(fill_nd < fill_rcm);
+
+   delete A;
+}
+
 } // namespace mfem
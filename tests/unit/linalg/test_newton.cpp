@@ -0,0 +1,142 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+// Identity preconditioner counting the calls of SetOperator() and Mult().
+class CountingIdentity : public Solver
+{
+public:
+   int num_set = 0;
+   mutable int num_mult = 0;
+
+   CountingIdentity(int n) : Solver(n) { }
+   virtual void SetOperator(const Operator &op) { num_set++; }
+   virtual void Mult(const Vector &x, Vector &y) const { y = x; num_mult++; }
+};
+
+TEST_CASE("Newton solver variants", "[NewtonSolver]")
+{
+   // Neo-Hookean block, clamped on the left and stretched on the right
+   const int dim = 2;
+   Mesh mesh(4, 2, Element::QUADRILATERAL, true, 2.0, 1.0);
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim, Ordering::byVDIM);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[1] = 1; // right
+   ess_bdr[3] = 1; // left
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   NeoHookeanModel model(0.25, 5.0);
+   NonlinearForm F(&fes);
+   F.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+   F.SetEssentialTrueDofs(ess_tdof_list);
+
+   // Initial guess: a uniform stretch by 5% in the x-direction, which
+   // satisfies the boundary conditions but not the lateral contraction
+   GridFunction x0(&fes);
+   mesh.GetNodes(x0);
+   for (int i = 0; i < fes.GetNDofs(); i++)
+   {
+      x0(fes.DofToVDof(i, 0)) *= 1.05;
+   }
+
+   // Reference solution with the standard Newton method
+   GMRESSolver gmres;
+   gmres.SetRelTol(1e-12);
+   gmres.SetAbsTol(0.0);
+   gmres.SetMaxIter(500);
+   gmres.SetKDim(100);
+   gmres.SetPrintLevel(-1);
+
+   NewtonSolver newton;
+   newton.SetOperator(F);
+   newton.SetSolver(gmres);
+   newton.SetRelTol(1e-10);
+   newton.SetAbsTol(0.0);
+   newton.SetMaxIter(50);
+   newton.SetPrintLevel(-1);
+
+   Vector x_ref(x0), zero;
+   newton.Mult(zero, x_ref);
+   REQUIRE(newton.GetConverged());
+   const int newton_iter = newton.GetNumIterations();
+   REQUIRE(newton.GetNumJacobianUpdates() == newton_iter);
+
+   Vector x(x0);
+   SECTION("Jacobian lagging")
+   {
+      newton.SetJacobianLagging(3);
+      newton.Mult(zero, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(newton.GetNumJacobianUpdates() < newton.GetNumIterations());
+   }
+
+   SECTION("Jacobian-free Newton-Krylov")
+   {
+      newton.SetJacobianFree();
+      newton.Mult(zero, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(newton.GetNumJacobianUpdates() == 0);
+      REQUIRE(newton.GetNumIterations() <= newton_iter + 1);
+   }
+
+   SECTION("JFNK with a lagged preconditioner")
+   {
+      DSmoother jacobi;
+      gmres.SetPreconditioner(jacobi);
+      newton.SetJacobianFree(true, &jacobi);
+      newton.SetJacobianLagging(100, 0.5);
+      newton.Mult(zero, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(newton.GetNumJacobianUpdates() < newton.GetNumIterations());
+   }
+
+   SECTION("JFNK keeps the operator of the preconditioner")
+   {
+      CountingIdentity id(fes.GetTrueVSize());
+      gmres.SetPreconditioner(id);
+
+      // Without a lagged preconditioner it is used with its own operator
+      newton.SetJacobianFree(true);
+      newton.Mult(zero, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(id.num_set == 0);
+      REQUIRE(id.num_mult > 0);
+      REQUIRE(gmres.GetPreconditionerOperatorUpdate());
+
+      // As a lagged preconditioner, it is only set up with the gradient
+      x = x0;
+      newton.SetJacobianFree(true, &id);
+      newton.SetJacobianLagging(2);
+      newton.Mult(zero, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(id.num_set == newton.GetNumJacobianUpdates());
+      REQUIRE(id.num_set < newton.GetNumIterations());
+
+      id.num_set = 0;
+
+      // The standard Newton method sets it up again with the gradient
+      x = x0;
+      newton.SetJacobianFree(false);
+      newton.Mult(zero, x);
+      REQUIRE(newton.GetConverged());
+      REQUIRE(id.num_set > 0);
+   }
+
+   x -= x_ref;
+   REQUIRE(x.Normlinf() < 1e-8);
+}
@@ -412,3 +412,215 @@ TEST_CASE("First order ODE methods",
       REQUIRE(conv_rate + tol > 5.0);
    }
 }
+
+TEST_CASE("Adaptive ODE methods",
+          "[ODE1]")
+{
+   // Damped oscillator du/dt = A u, A = [-a -w; w -a], with the exact solution
+   // u(t) = exp(-a t) R(w t) u(0), where R is a rotation.
+   class Oscillator : public TimeDependentOperator
+   {
+   public:
+      double a, w;
+      Oscillator(double a_, double w_)
+         : TimeDependentOperator(2, 0.0), a(a_), w(w_) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt(0) = -a*u(0) - w*u(1);
+         dudt(1) =  w*u(0) - a*u(1);
+      }
+
+      void Exact(double t, const Vector &u0, Vector &u) const
+      {
+         const double d = exp(-a*t), cs = cos(w*t), sn = sin(w*t);
+         u(0) = d*(cs*u0(0) - sn*u0(1));
+         u(1) = d*(sn*u0(0) + cs*u0(1));
+      }
+   };
+
+   Oscillator oper(0.5, 10.0);
+   Vector u0(2), u(2), u_ex(2);
+   u0(0) = 1.0;
+   u0(1) = 0.5;
+   const double tf = 2.0;
+   oper.Exact(tf, u0, u_ex);
+
+   // Integrate with the given tolerance; return the final error and the
+   // number of accepted steps.
+   auto run = [&](AdaptiveODESolver &ode, double tol, int &steps)
+   {
+      ode.SetTolerances(tol, tol);
+      ode.Init(oper);
+      double t = 0.0, dt = 1.0; // too large on purpose: triggers rejections
+      u = u0;
+      ode.Run(u, t, dt, tf);
+      REQUIRE(t == tf);
+      REQUIRE(ode.GetNumRejectedSteps() > 0);
+      steps = ode.GetNumAcceptedSteps();
+      u -= u_ex;
+      return u.Normlinf();
+   };
+
+   BogackiShampineSolver bs;
+   DormandPrinceSolver dp;
+   CashKarpSolver ck;
+   AdaptiveODESolver *solvers[] = { &bs, &dp, &ck };
+   const char *names[] = { "BogackiShampineSolver", "DormandPrinceSolver",
+                           "CashKarpSolver"
+                         };
+   const int orders[] = { 3, 5, 5 };
+   for (int i = 0; i < 3; i++)
+   {
+      int steps_coarse, steps_fine;
+      const double err_coarse = run(*solvers[i], 1e-5, steps_coarse);
+      const double err_fine = run(*solvers[i], 1e-9, steps_fine);
+      std::cout << names[i] << ": steps = " << steps_coarse << ", "
+                << steps_fine << ", errors = " << err_coarse << ", "
+                << err_fine << std::endl;
+      REQUIRE(err_coarse < 1e-3);
+      REQUIRE(err_fine < 1e-7);
+      REQUIRE(err_fine < err_coarse);
+      // The number of steps of a method of order p scales like tol^(-1/p)
+      const double ratio = double(steps_fine)/steps_coarse;
+      REQUIRE(ratio > 1.0);
+      REQUIRE(ratio < 1.5*pow(1e4, 1.0/orders[i]));
+   }
+}
+
+TEST_CASE("Embedded RK first stage reuse",
+          "[ODE1]")
+{
+   // du/dt = -a u, counting the evaluations of the right-hand side
+   class Decay : public TimeDependentOperator
+   {
+   public:
+      double a = 1.0;
+      mutable int num_mult = 0;
+      Decay() : TimeDependentOperator(1, 0.0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt.Set(-a, u);
+         num_mult++;
+      }
+   };
+
+   Decay oper;
+   DormandPrinceSolver dp; // 7 stages, FSAL
+   dp.SetTolerances(1e-6, 1e-6);
+   dp.Init(oper);
+   Vector u(1);
+   u = 1.0;
+   double t = 0.0, dt = 1e-2;
+
+   // Number of evaluations in one step
+   auto step = [&]()
+   {
+      const int num_mult = oper.num_mult;
+      dp.Step(u, t, dt);
+      return oper.num_mult - num_mult;
+   };
+
+   REQUIRE(step() == 7);
+   REQUIRE(step() == 6);
+
+   // The state was changed by the caller
+   u *= 2.0;
+   REQUIRE(step() == 7);
+   REQUIRE(step() == 6);
+
+   // The operator was changed by the caller
+   oper.a = 2.0;
+   dp.ResetFirstStage();
+   REQUIRE(step() == 7);
+   REQUIRE(step() == 6);
+   REQUIRE(dp.GetNumRejectedSteps() == 0);
+}
+
+TEST_CASE("IMEX ODE methods",
+          "[ODE1]")
+{
+   // Split ODE du/dt = f1(u) + f2(u) with the non-stiff rotation f1 = w J u,
+   // treated explicitly, and the stiff damping f2 = -a u, treated implicitly.
+   // The exact solution is u(t) = exp(-a t) R(w t) u(0).
+   class SplitODE : public TimeDependentOperator
+   {
+   public:
+      double a, w;
+      SplitODE(double a_, double w_)
+         : TimeDependentOperator(2, 0.0), a(a_), w(w_) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         const double ae = (eval_mode == ADDITIVE_TERM_2) ? 0.0 : w;
+         const double ai = (eval_mode == ADDITIVE_TERM_1) ? 0.0 : a;
+         dudt(0) = -ai*u(0) - ae*u(1);
+         dudt(1) =  ae*u(0) - ai*u(1);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &k)
+      {
+         REQUIRE(eval_mode == ADDITIVE_TERM_2);
+         // k = -a (u + dt k)
+         k.Set(-a/(1.0 + a*dt), u);
+      }
+
+      void Exact(double t, const Vector &u0, Vector &u) const
+      {
+         const double d = exp(-a*t), cs = cos(w*t), sn = sin(w*t);
+         u(0) = d*(cs*u0(0) - sn*u0(1));
+         u(1) = d*(sn*u0(0) + cs*u0(1));
+      }
+   };
+
+   Vector u0(2), u(2), u_ex(2);
+   u0(0) = 1.0;
+   u0(1) = 0.5;
+
+   // Integrate up to time tf with n uniform steps; return the final error.
+   auto run = [&](ODESolver &ode, SplitODE &oper, double tf, int n)
+   {
+      ode.Init(oper);
+      double t = 0.0, dt = tf/n;
+      u = u0;
+      for (int i = 0; i < n; i++) { ode.Step(u, t, dt); }
+      REQUIRE(oper.GetEvalMode() == TimeDependentOperator::NORMAL);
+      oper.Exact(t, u0, u_ex);
+      u -= u_ex;
+      return u.Normlinf();
+   };
+
+   ARS232Solver ars232;
+   ARS443Solver ars443;
+   ARK3Solver ark3;
+   ARK4Solver ark4;
+   ODESolver *solvers[] = { &ars232, &ars443, &ark3, &ark4 };
+   const char *names[] = { "ARS232Solver", "ARS443Solver", "ARK3Solver",
+                           "ARK4Solver"
+                         };
+   const int orders[] = { 2, 3, 3, 4 };
+   for (int i = 0; i < 4; i++)
+   {
+      // Order of convergence for a non-stiff split
+      SplitODE oper(1.0, 2.0);
+      const double err1 = run(*solvers[i], oper, 1.0, 40);
+      const double err2 = run(*solvers[i], oper, 1.0, 80);
+      const double rate = log(err1/err2)/log(2.0);
+      std::cout << names[i] << ": convergence rate = " << rate << std::endl;
+      REQUIRE(rate > orders[i] - 0.1);
+
+      // Stability for a stiff implicit term, with a time step far beyond the
+      // explicit stability limit dt < 2/a
+      SplitODE stiff(1e4, 2.0);
+      REQUIRE(run(*solvers[i], stiff, 1.0, 10) < 1e-6);
+   }
+
+   // The explicit part of ARS(2,3,2) on its own: with b = (0, 1-gamma, gamma)
+   // and delta = -2 sqrt(2)/3 it satisfies b^t A c = 1/6, so it is third
+   // order accurate on linear problems.
+   SplitODE rotation(0.0, 2.0);
+   const double err1 = run(ars232, rotation, 1.0, 20);
+   const double err2 = run(ars232, rotation, 1.0, 40);
+   REQUIRE(log(err1/err2)/log(2.0) > 2.9);
+}
@@ -123,3 +123,52 @@ TEST_CASE("Vector Tests", "[Vector]")
       REQUIRE(diff.Norml2() < tol);
    }
 }
+
+TEST_CASE("Vector Lazy Expressions", "[Vector]")
+{
+   double tol = 1e-12;
+
+   const int n = 17;
+   Vector x(n), y(n), w(n), z(n), diff(n);
+   for (int i = 0; i < n; i++)
+   {
+      x(i) = sin(i + 1.0);
+      y(i) = cos(2.0*i);
+      w(i) = 1.0/(i + 1.0);
+   }
+   const double a = 2.0, b = -0.5, c = 3.0;
+
+   SECTION("Assign expression")
+   {
+      Lazy(z) = a*Lazy(x) + b*Lazy(y) - c*Lazy(w);
+      for (int i = 0; i < n; i++)
+      {
+         diff(i) = z(i) - (a*x(i) + b*y(i) - c*w(i));
+      }
+      REQUIRE(diff.Normlinf() < tol);
+   }
+
+   SECTION("Update expression")
+   {
+      z = x;
+      Lazy(z) += a*(Lazy(y) - Lazy(w));
+      Lazy(z) -= -Lazy(z)*b;
+      for (int i = 0; i < n; i++)
+      {
+         diff(i) = z(i) - (1.0 + b)*(x(i) + a*(y(i) - w(i)));
+      }
+      REQUIRE(diff.Normlinf() < tol);
+   }
+
+   SECTION("Linear combination")
+   {
+      LinearCombinationExpr sum;
+      sum.Add(a, x).Add(b, y).Add(c, w);
+      Lazy(z) = Lazy(x) - sum;
+      for (int i = 0; i < n; i++)
+      {
+         diff(i) = z(i) - ((1.0 - a)*x(i) - b*y(i) - c*w(i));
+      }
+      REQUIRE(diff.Normlinf() < tol);
+   }
+}